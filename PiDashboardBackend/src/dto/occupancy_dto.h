@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../utils/time_converter.h"
+#include <cstdint>
+#include <string>
+
+
+namespace dto
+{
+	class occupancy_dto
+	{
+	public:
+		occupancy_dto() : m_individual_name(""), m_start(std::chrono::system_clock::now()), m_end(std::chrono::system_clock::now()), m_event_count(0) {	}
+
+		occupancy_dto(std::string individual_name, std::chrono::time_point<std::chrono::system_clock> start, std::chrono::time_point<std::chrono::system_clock> end, uint32_t event_count) :
+			m_individual_name(individual_name), m_start(start), m_end(end), m_event_count(event_count) {	}
+
+		occupancy_dto(std::string individual_name, std::string start, std::string end, uint32_t event_count) :
+			m_individual_name(individual_name), m_start(utils::time_converter::string_to_timepoint(start)),
+			m_end(utils::time_converter::string_to_timepoint(end)), m_event_count(event_count) { }
+
+		~occupancy_dto() { }
+
+		void set_individual_name(std::string new_individual_name) { m_individual_name = new_individual_name; }
+
+		void set_start(std::chrono::time_point<std::chrono::system_clock> new_start) { m_start = new_start; }
+
+		void set_start(std::string new_start) { m_start = utils::time_converter::string_to_timepoint(new_start); }
+
+		void set_end(std::chrono::time_point<std::chrono::system_clock> new_end) { m_end = new_end; }
+
+		void set_end(std::string new_end) { m_end = utils::time_converter::string_to_timepoint(new_end); }
+
+		void set_event_count(uint32_t new_event_count) { m_event_count = new_event_count; }
+
+		std::string get_individual_name() const { return m_individual_name; }
+
+		std::chrono::time_point<std::chrono::system_clock> get_start_as_chrono() const { return m_start; }
+
+		std::string get_start_as_string() const { return utils::time_converter::timepoint_to_string(m_start); }
+
+		std::chrono::time_point<std::chrono::system_clock> get_end_as_chrono() const { return m_end; }
+
+		std::string get_end_as_string() const { return utils::time_converter::timepoint_to_string(m_end); }
+
+		uint32_t get_event_count() const { return m_event_count; }
+
+		double get_duration_in_seconds() const { return std::chrono::duration<double>(m_end - m_start).count(); }
+
+
+	private:
+		std::string m_individual_name;
+		std::chrono::time_point<std::chrono::system_clock> m_start;
+		std::chrono::time_point<std::chrono::system_clock> m_end;
+		uint32_t m_event_count;
+	};
+}
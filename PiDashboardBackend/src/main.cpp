@@ -17,6 +17,8 @@
 #include "../../PiHardwareAbstractionLayer/Sensor.h"
 #include "../../PiHardwareAbstractionLayer/utils/EnumConverter.h"
 #include "../../PiHardwareAbstractionLayer/utils/Timezone.h"
+#include "../../PiHardwareAbstractionLayer/pipeline/OccupancyAggregator.h"
+#include "manager/occupancy_recorder.h"
 
 //
 //driver::sensors::bme280::barometer* bme280;
@@ -379,6 +381,21 @@
 //}
 //
 
+void occupancy_recording()
+{
+	// Stores one row per occupancy instead of every motion sample
+	auto mng = std::make_shared<manager::db_manager>("localhost", "test", "password123", "pi_sensor_db");
+	auto am312 = hal::SensorManager::instance().get_sensor(hal::SensorType::MOTION, hal::SensorName::AM312, 0, hal::Delay::FAST);
+	hal::pipeline::OccupancyAggregator aggregator(am312);
+	manager::occupancy_recorder recorder(mng, aggregator, "Wohnzimmer");
+	aggregator.start();
+
+	while (true)
+	{
+
+	}
+}
+
 void on_temperature(std::string new_temp)
 {
 	std::cout << "Temperature: " << new_temp << std::endl;
@@ -398,6 +415,7 @@ int main()
 	//ccs811_testing();
 	//am312_testing();
 	//ads1115_testing();
+	//occupancy_recording();
 
 	/*auto bme280 = hal::SensorManager::instance().get_sensor(hal::SensorType::TEMPERATURE, hal::SensorName::BME280, 8, hal::Delay::DEFAULT);
 	bme280->add_value_callback(on_temperature);
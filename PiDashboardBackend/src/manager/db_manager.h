@@ -2,6 +2,7 @@
 
 #include "../dto/sensor_dto.h"
 #include "../dto/extremas_dto.h"
+#include "../dto/occupancy_dto.h"
 #include "../dto/query_object.h"
 #include "../utils/time_converter.h"
 
@@ -466,6 +467,57 @@ namespace manager
 		*/
 		int8_t recalculate_extremum(std::string sensor_type_name, std::string individual_name);
 
+
+		//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		// db_manager_occupancy.cpp
+		//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+		//! Adds a completed occupancy interval to the occupancy table.
+		/*!
+		* Adds a completed occupancy interval to the occupancy table. One row replaces all motion samples of the interval.
+		* Does not close database connection in case of an error.
+		*
+		* \param new_value[in]: a dto containing the interval to add to the table.
+		* \return 1 (true) if adding the entry succeeded and -1 (null ptr error) or -2 (query error) if an error occured.
+		*/
+		int8_t add_occupancy_interval(std::shared_ptr<dto::occupancy_dto> new_value);
+
+		//! Returns multiple occupancy intervals.
+		/*!
+		* Returns all intervals of the given sensor that overlap the range between both input timestamps. Does not close
+		* database connection in case of an error.
+		*
+		* \param result[out]: a list of all intervals in the occupancy table that match the input params.
+		* \param individual_name[in]: the individual name in the rows to return.
+		* \param start_timestamp[in]: the start of the range.
+		* \param end_timestamp[in]: the end of the range.
+		* \return 1 (true) if getting the entries succeeded and -2 (query error) if an error occured.
+		*/
+		int8_t get_occupancy_intervals(std::vector<std::shared_ptr<dto::occupancy_dto>>& result, std::string individual_name, std::chrono::time_point<std::chrono::system_clock> start_timestamp, std::chrono::time_point<std::chrono::system_clock> end_timestamp);
+
+		//! Returns how long a room was occupied.
+		/*!
+		* Returns the sum of the durations of all intervals of the given sensor within the range between both input timestamps.
+		* Intervals that only partly overlap the range are clipped. Does not close database connection in case of an error.
+		*
+		* \param result[out]: the occupied time in seconds.
+		* \param individual_name[in]: the individual name in the rows to sum up.
+		* \param start_timestamp[in]: the start of the range.
+		* \param end_timestamp[in]: the end of the range.
+		* \return 1 (true) if getting the sum succeeded and -2 (query error) if an error occured.
+		*/
+		int8_t get_occupied_seconds(double& result, std::string individual_name, std::chrono::time_point<std::chrono::system_clock> start_timestamp, std::chrono::time_point<std::chrono::system_clock> end_timestamp);
+
+		//! Deletes multiple occupancy intervals.
+		/*!
+		* Deletes all intervals of the given sensor that ended before the given timestamp. Does not close database connection in case of an error.
+		*
+		* \param individual_name[in]: the individual name in the rows to delete.
+		* \param timestamp[in]: the timestamp threshold.
+		* \return 1 (true) if removing the entries succeeded and -2 (query error) if an error occured.
+		*/
+		int8_t delete_occupancy_intervals(std::string individual_name, std::chrono::time_point<std::chrono::system_clock> timestamp);
+
 	private:
 		int8_t get_single_sensor_query_result(std::shared_ptr<dto::sensor_dto>& result, std::string statement);
 		int8_t get_multiple_sensor_query_results(std::vector<std::shared_ptr<dto::sensor_dto>>& result, std::string statement);
@@ -485,6 +537,14 @@ namespace manager
 															 new dto::column("min", "DOUBLE")},
 								  "CREATE TABLE IF NOT EXISTS extremas(id INT UNSIGNED AUTO_INCREMENT PRIMARY KEY, sensor_type_name TEXT NOT NULL, individual_name TEXT NOT NULL, count DOUBLE, sum DOUBLE, max DOUBLE, min DOUBLE);")
 			},
+			{"occupancy", new dto::query_object("occupancy",
+								  std::vector<dto::column*>{ new dto::column("id", "INT"),
+															 new dto::column("individual_name", "VARCHAR"),
+															 new dto::column("start_time", "DATETIME"),
+															 new dto::column("end_time", "DATETIME"),
+															 new dto::column("event_count", "INT")},
+								  "CREATE TABLE IF NOT EXISTS occupancy(id INT UNSIGNED AUTO_INCREMENT PRIMARY KEY, individual_name VARCHAR(64) NOT NULL, start_time DATETIME NOT NULL, end_time DATETIME NOT NULL, event_count INT UNSIGNED, INDEX occupancy_range(individual_name, start_time, end_time));")
+			},
 			{"sensors", new dto::query_object("sensors",
 								  std::vector<dto::column*>{ new dto::column("id", "INT"),
 															 new dto::column("sensor_type_name", "TEXT"),
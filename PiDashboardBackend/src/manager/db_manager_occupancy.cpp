@@ -0,0 +1,99 @@
+#include "db_manager.h"
+
+int8_t manager::db_manager::add_occupancy_interval(std::shared_ptr<dto::occupancy_dto> new_value)
+{
+	if (new_value == nullptr)
+	{
+		handle_error("add_occupancy_interval", tables["occupancy"]->get_table_name(), "Input param is NULL", "Null Pointer Exception: Param 'value' is NULL", false);
+		return NULL_PTR;
+	}
+
+	std::string insert = "INSERT INTO " + std::string(tables["occupancy"]->get_table_name()) + "(individual_name, start_time, end_time, event_count)"
+		+ " values('" + new_value->get_individual_name() + "', "
+		+ "STR_TO_DATE('" + new_value->get_start_as_string() + "', '" + utils::time_converter::default_time_format + "'), "
+		+ "STR_TO_DATE('" + new_value->get_end_as_string() + "', '" + utils::time_converter::default_time_format + "'), "
+		+ std::to_string(new_value->get_event_count()) + ");";
+
+	if (mysql_query(db_connection, insert.c_str()) != 0)
+	{
+		handle_error("add_occupancy_interval", tables["occupancy"]->get_table_name(), insert.c_str(), mysql_error(db_connection));
+		return QUERY_ERROR;
+	}
+	return TRUE;
+}
+
+int8_t manager::db_manager::get_occupancy_intervals(std::vector<std::shared_ptr<dto::occupancy_dto>>& result, std::string individual_name, std::chrono::time_point<std::chrono::system_clock> start_timestamp, std::chrono::time_point<std::chrono::system_clock> end_timestamp)
+{
+	// Overlapping intervals: started before the end of the range and ended after its start
+	std::string select = "SELECT * FROM " + std::string(tables["occupancy"]->get_table_name()) +
+		" WHERE individual_name='" + individual_name +
+		"' AND start_time <= STR_TO_DATE('" + utils::time_converter::timepoint_to_string(end_timestamp) + "', '" + utils::time_converter::default_time_format + "')" +
+		" AND end_time >= STR_TO_DATE('" + utils::time_converter::timepoint_to_string(start_timestamp) + "', '" + utils::time_converter::default_time_format + "')" +
+		" ORDER BY start_time;";
+
+	if (mysql_query(db_connection, select.c_str()) != 0)
+	{
+		handle_error("get_occupancy_intervals", tables["occupancy"]->get_table_name(), select.c_str(), mysql_error(db_connection));
+		return QUERY_ERROR;
+	}
+
+	MYSQL_RES* res = mysql_use_result(db_connection);
+	MYSQL_ROW row;
+
+	if (res)
+	{
+		while ((row = mysql_fetch_row(res)))
+		{
+			// row[0] = id
+			result.push_back(std::make_shared<dto::occupancy_dto>(dto::occupancy_dto(row[1], row[2], row[3], static_cast<uint32_t>(atoi(row[4])))));
+		}
+	}
+
+	mysql_free_result(res);
+	return TRUE;
+}
+
+int8_t manager::db_manager::get_occupied_seconds(double& result, std::string individual_name, std::chrono::time_point<std::chrono::system_clock> start_timestamp, std::chrono::time_point<std::chrono::system_clock> end_timestamp)
+{
+	const std::string range_start = "STR_TO_DATE('" + utils::time_converter::timepoint_to_string(start_timestamp) + "', '" + utils::time_converter::default_time_format + "')";
+	const std::string range_end = "STR_TO_DATE('" + utils::time_converter::timepoint_to_string(end_timestamp) + "', '" + utils::time_converter::default_time_format + "')";
+
+	// Intervals at the borders of the range only count with the part inside the range
+	std::string select = "SELECT SUM(TIMESTAMPDIFF(SECOND, GREATEST(start_time, " + range_start + "), LEAST(end_time, " + range_end + "))) FROM " +
+		std::string(tables["occupancy"]->get_table_name()) +
+		" WHERE individual_name='" + individual_name +
+		"' AND start_time <= " + range_end +
+		" AND end_time >= " + range_start + ";";
+
+	if (mysql_query(db_connection, select.c_str()) != 0)
+	{
+		handle_error("get_occupied_seconds", tables["occupancy"]->get_table_name(), select.c_str(), mysql_error(db_connection));
+		return QUERY_ERROR;
+	}
+
+	MYSQL_RES* res = mysql_use_result(db_connection);
+	MYSQL_ROW row = mysql_fetch_row(res);
+	result = 0;
+
+	if (row != NULL && row[0] != NULL) // SUM returns NULL if no interval matches
+	{
+		result = atof(row[0]);
+	}
+
+	mysql_free_result(res);
+	return TRUE;
+}
+
+int8_t manager::db_manager::delete_occupancy_intervals(std::string individual_name, std::chrono::time_point<std::chrono::system_clock> timestamp)
+{
+	std::string statement = "DELETE FROM " + std::string(tables["occupancy"]->get_table_name()) +
+		" WHERE individual_name='" + individual_name +
+		"' AND end_time < STR_TO_DATE('" + utils::time_converter::timepoint_to_string(timestamp) + "', '" + utils::time_converter::default_time_format + "');";
+
+	if (mysql_query(db_connection, statement.c_str()) != 0)
+	{
+		handle_error("delete_occupancy_intervals", tables["occupancy"]->get_table_name(), statement.c_str(), mysql_error(db_connection));
+		return QUERY_ERROR;
+	}
+	return TRUE;
+}
@@ -0,0 +1,31 @@
+#include "occupancy_recorder.h"
+
+manager::occupancy_recorder::occupancy_recorder(std::shared_ptr<db_manager> db, hal::pipeline::OccupancyAggregator& aggregator, std::string individual_name)
+	: m_aggregator(aggregator), m_callback_handle(0), m_failure_count(std::make_shared<std::atomic_uint32_t>(0))
+{
+	if (db == nullptr)
+	{
+		throw std::invalid_argument("occupancy_recorder: Param 'db' is NULL");
+	}
+
+	// The callback does not capture this, the aggregator may still execute it after the recorder was destroyed
+	auto failure_count = m_failure_count;
+	m_callback_handle = m_aggregator.add_interval_callback([db, individual_name, failure_count](const hal::OccupancyInterval& interval)
+	{
+		const auto dto = std::make_shared<dto::occupancy_dto>(individual_name, interval.start, interval.end, interval.event_count);
+		if (db->add_occupancy_interval(dto) != TRUE)
+		{
+			(*failure_count)++;
+		}
+	});
+}
+
+manager::occupancy_recorder::~occupancy_recorder()
+{
+	m_aggregator.remove_interval_callback(m_callback_handle);
+}
+
+uint32_t manager::occupancy_recorder::get_failure_count() const
+{
+	return m_failure_count->load();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "db_manager.h"
+#include "../../../PiHardwareAbstractionLayer/pipeline/OccupancyAggregator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace manager
+{
+	//! Class that stores the occupancy intervals of a motion sensor.
+	/*!
+	* This class subscribes to an occupancy aggregator and adds every completed interval as one row to the
+	* occupancy table. The rows are written on the thread that completes the interval (the hold-off timer
+	* thread of the HAL), so the given db_manager must not be used by another thread at the same time.
+	*/
+	class occupancy_recorder
+	{
+	public:
+		occupancy_recorder(const occupancy_recorder&) = delete;
+		occupancy_recorder& operator=(const occupancy_recorder&) = delete;
+
+		//! Default constructor.
+		/*!
+		* Subscribes to the completed intervals of the aggregator.
+		*
+		* \param db[in]: the database connection the intervals are added with.
+		* \param aggregator[in]: the aggregator of the motion sensor. Has to outlive the recorder.
+		* \param individual_name[in]: the individual name the intervals are stored with.
+		*/
+		occupancy_recorder(std::shared_ptr<db_manager> db, hal::pipeline::OccupancyAggregator& aggregator, std::string individual_name);
+
+		//! Default destructor.
+		/*!
+		* Unsubscribes from the aggregator. An interval that is completed meanwhile is still stored.
+		*/
+		~occupancy_recorder();
+
+		//! Returns the number of intervals that could not be stored.
+		/*!
+		* Returns the number of intervals that could not be stored.
+		* \return the number of failed inserts.
+		*/
+		uint32_t get_failure_count() const;
+
+	private:
+		hal::pipeline::OccupancyAggregator& m_aggregator;
+		uint32_t m_callback_handle;
+		std::shared_ptr<std::atomic_uint32_t> m_failure_count;
+	};
+}
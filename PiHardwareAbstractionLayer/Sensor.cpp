@@ -7,6 +7,8 @@
 #include "sensors/i2c/DS3231.h"
 #include "utils/Helper.h"
 
+#include <iostream>
+
 hal::Sensor::~Sensor()
 {
 	shutdown();
@@ -30,6 +32,16 @@ hal::Sensor::Sensor(
 	m_sensor = sensor;
 	m_on_ready_to_delete = on_ready_to_delete;
 	m_delay_milliseconds = delay_milliseconds;
+
+	// Metrics are recorded per pin and measurement type
+	auto& registry = utils::MetricsRegistry::instance();
+	m_measurements_metric = &registry.counter("sensor.measurements", pin, type);
+	m_failures_metric = &registry.counter("sensor.failures", pin, type);
+	m_consecutive_failures_metric = &registry.gauge("sensor.consecutive_failures", pin, type);
+	m_measurement_duration = &registry.histogram("sensor.measurement_duration_ns", pin, type);
+	m_callback_duration = &registry.histogram("sensor.callback_duration_ns", pin, type);
+	m_tick_lateness = &registry.histogram("sensor.tick_lateness_ns", pin, type);
+
 	m_is_running = true;
 	m_is_sleeping = false;
 	m_sensor_thread = new std::thread(&Sensor::thread_loop, this);
@@ -54,10 +66,10 @@ void hal::Sensor::configure(const SensorSetting setting, const std::string& conf
 		dynamic_cast<sensors::i2c::ccs811::CCS811*>(m_sensor)->configure(setting, configuration);
 		break;
 	case SensorName::KY_018:
-		dynamic_cast<sensors::i2c::ads1115::ADS1115*>(m_sensor)->configure(setting, configuration);
+		dynamic_cast<sensors::analog::ky018::KY018OnADS1115*>(m_sensor)->configure(setting, configuration);
 		break;
 	case SensorName::ADS1115:
-		//static_cast<sensors::analog::ky018::KY018*>(m_sensor)->configure(setting, configuration);
+		dynamic_cast<sensors::i2c::ads1115::ADS1115*>(m_sensor)->configure(setting, configuration);
 		break;
 	case SensorName::AM312:
 		dynamic_cast<sensors::digital::am312::AM312*>(m_sensor)->configure(setting, configuration);
@@ -90,10 +102,10 @@ std::string hal::Sensor::get_configuration(const SensorSetting setting)
 		result = dynamic_cast<sensors::i2c::ccs811::CCS811*>(m_sensor)->get_configuration(setting);
 		break;
 	case SensorName::KY_018:
-		result = dynamic_cast<sensors::i2c::ads1115::ADS1115*>(m_sensor)->get_configuration(setting);
+		result = dynamic_cast<sensors::analog::ky018::KY018OnADS1115*>(m_sensor)->get_configuration(setting);
 		break;
 	case SensorName::ADS1115:
-		//result = static_cast<sensors::analog::ky018::KY018*>(m_sensor)->get_configuration(setting);
+		result = dynamic_cast<sensors::i2c::ads1115::ADS1115*>(m_sensor)->get_configuration(setting);
 		break;
 	case SensorName::AM312:
 		result = dynamic_cast<sensors::digital::am312::AM312*>(m_sensor)->get_configuration(setting);
@@ -127,10 +139,10 @@ std::vector<hal::SensorSetting> hal::Sensor::available_configurations()
 		result = static_cast<sensors::i2c::ccs811::CCS811*>(m_sensor)->available_configurations();
 		break;
 	case SensorName::KY_018:
-		result = static_cast<sensors::i2c::ads1115::ADS1115*>(m_sensor)->available_configurations();
+		result = static_cast<sensors::analog::ky018::KY018OnADS1115*>(m_sensor)->available_configurations();
 		break;
 	case SensorName::ADS1115:
-		//result = static_cast<sensors::analog::ky018::KY018*>(m_sensor)->available_configurations();
+		result = static_cast<sensors::i2c::ads1115::ADS1115*>(m_sensor)->available_configurations();
 		break;
 	case SensorName::AM312:
 		result = static_cast<sensors::digital::am312::AM312*>(m_sensor)->available_configurations();
@@ -180,7 +192,17 @@ void hal::Sensor::shutdown()
 
 std::shared_ptr<hal::CallbackHandle> hal::Sensor::add_value_callback(const std::function<void(std::string)>& on_value)
 {
-	auto handle = std::make_shared<CallbackHandle>(CallbackHandle(on_value, get_unique_handle()));
+	const auto duration = m_callback_duration;
+	const auto pin = m_pin;
+	const auto timed_on_value = [on_value, duration, pin](std::string value)
+	{
+		utils::TraceScope trace("sensor.callback", "callback", pin);
+		const auto start = std::chrono::steady_clock::now();
+		on_value(std::move(value));
+		duration->record_since(start);
+	};
+	auto handle = std::make_shared<CallbackHandle>(CallbackHandle(timed_on_value, get_unique_handle(),
+																						  m_delay_milliseconds > 0 ? static_cast<uint32_t>(m_delay_milliseconds) : 0));
 	std::lock_guard<std::mutex> guard(m_mutex);
 	m_value_callbacks_to_add.push_back(handle);
 	return handle;
@@ -194,11 +216,20 @@ void hal::Sensor::remove_value_callback(const std::shared_ptr<CallbackHandle>& h
 
 void hal::Sensor::thread_loop()
 {
+	utils::Tracer::instance().set_thread_name(std::string("sensor ").append(std::to_string(m_pin))
+																	.append(" type ").append(std::to_string(static_cast<int>(m_type))));
+
 	std::unique_lock<std::mutex> lock(m_wait_mutex);
 	while (m_is_running)
 	{
+		const auto due = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_delay_milliseconds);
 		if (m_cv.wait_for(lock, std::chrono::milliseconds(m_delay_milliseconds)) == std::cv_status::timeout)
 		{
+			const auto tick_start = std::chrono::steady_clock::now();
+			m_tick_lateness->record_since(due);
+			utils::Tracer::record("sensor.tick_lateness", "sensor", m_pin, due, tick_start);
+			utils::TraceScope trace("sensor.tick", "sensor", m_pin);
+
 			// Add new callbacks if necessary
 			{
 				std::lock_guard<std::mutex> guard(m_mutex);
@@ -224,20 +255,68 @@ void hal::Sensor::thread_loop()
 			// Trigger a new measurement if the sensor is currently not sleeping
 			if (!m_is_sleeping)
 			{
-				std::lock_guard<std::mutex> guard(m_mutex);
-				if (Helper::null_check(m_sensor) != OK)
+				std::unique_lock<std::mutex> guard(m_mutex, std::defer_lock);
 				{
-					throw exception::HALException("Sensor", "thread_loop", "Sensor pointer is null.");
+					utils::TraceScope lock_trace("sensor.lock_wait", "sensor", m_pin);
+					guard.lock();
 				}
 
 				// After measurement finished, the sensor will fire the appropriate 
 				// callback function (if the callback is not a nullptr).
-				m_sensor->trigger_measurement(m_type);
+				measure();
 			}
 		}
 	}
 }
 
+void hal::Sensor::measure() noexcept
+{
+	utils::Result<void> result;
+	if (Helper::null_check(m_sensor) != OK)
+	{
+		result = utils::Error{ErrorCode::INVALID_ARGUMENT, 0, m_pin, 0, "Sensor", "thread_loop"};
+	}
+	else
+	{
+		utils::TraceScope trace("sensor.measure", "sensor", m_pin);
+		const auto start = std::chrono::steady_clock::now();
+		try
+		{
+			result = m_sensor->measure(m_type);
+		}
+		catch (...)
+		{
+			// Value callbacks may throw anything
+			result = utils::Error{ErrorCode::EXCEPTION, 0, m_pin, 0, "Sensor", "thread_loop"};
+		}
+		m_measurement_duration->record_since(start);
+	}
+
+	++m_measurement_count;
+	m_measurements_metric->add();
+	if (result)
+	{
+		m_consecutive_failures = 0;
+		m_consecutive_failures_metric->set(0);
+		return;
+	}
+
+	++m_failure_count;
+	m_failures_metric->add();
+	m_last_error = result.error().code;
+	m_consecutive_failures_metric->set(m_consecutive_failures + 1);
+	if (m_consecutive_failures++ == 0)
+	{
+		try
+		{
+			std::cerr << "Sensor [thread_loop] Measurement failed: " << result.error().to_string() << std::endl;
+		}
+		catch (...)
+		{
+		}
+	}
+}
+
 uint32_t hal::Sensor::get_unique_handle()
 {
 	std::lock_guard<std::mutex> guard(m_mutex);
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "enums/CommunicationType.h"
+#include "enums/ErrorCode.h"
 #include "enums/SensorName.h"
 #include "enums/SensorSetting.h"
 #include "enums/SensorType.h"
 #include "interfaces/ISensor.h"
 #include "structs/CallbackHandle.h"
+#include "utils/Metrics.h"
+#include "utils/Tracer.h"
 
 #include <atomic>
 #include <condition_variable>
@@ -99,7 +102,8 @@ namespace hal
 		void shutdown();
 
 		/*!
-		* Adds a new callback to the sensor.
+		* Adds a new callback to the sensor. The duration of each call is recorded in the "sensor.callback_duration_ns"
+		* metric of the sensor.
 		* \param[in] on_value: The new callback to add.
 		* \returns a CallbackHandle object that contains the callback function together with its unique handle.
 		*/
@@ -141,6 +145,12 @@ namespace hal
 		*/
 		uint8_t get_pin() const { return m_pin; }
 
+		/*!
+		* Return the time between two measurements of the sensor.
+		* \returns the delay in milliseconds.
+		*/
+		int get_delay_milliseconds() const { return m_delay_milliseconds; }
+
 		/*!
 		* Return whether the sensor is in sleep mode.
 		* \returns True if the sensor is in sleep mode, False otherwise.
@@ -153,12 +163,45 @@ namespace hal
 		*/
 		bool is_running() const { return m_is_running; }
 
+		/*!
+		* Return the number of measurements the sensor thread performed (successful and failed ones).
+		* \returns the number of measurements.
+		*/
+		uint64_t get_measurement_count() const noexcept { return m_measurement_count; }
+
+		/*!
+		* Return the number of measurements that failed. A failed measurement does not stop the sensor thread, the
+		* next one is performed after the regular delay.
+		* \returns the number of failed measurements.
+		*/
+		uint64_t get_failure_count() const noexcept { return m_failure_count; }
+
+		/*!
+		* Return the number of measurements that failed since the last successful one.
+		* \returns the number of consecutive failed measurements.
+		*/
+		uint32_t get_consecutive_failures() const noexcept { return m_consecutive_failures; }
+
+		/*!
+		* Return why the last failed measurement failed.
+		* \returns the error code of the last failed measurement or ErrorCode::NONE if no measurement failed yet.
+		*/
+		ErrorCode get_last_error() const noexcept { return m_last_error; }
+
 	protected:
 		/*!
-		* The function that is executed by the sensor thread.
+		* The function that is executed by the sensor thread. The phases of each tick are traced with
+		* \sa { HAL::Utils::Tracer }.
 		*/
 		void thread_loop();
 
+		//! Performs one measurement of the sensor thread.
+		/*!
+		* Performs one measurement and updates the failure counters and the metrics of the sensor. Never throws, so a
+		* failing sensor cannot terminate the process. Only the first failure of a series is logged.
+		*/
+		void measure() noexcept;
+
 		//! Generates a new unique handle to identify a specific callback.
 		/*!
 		* Generates a new unique handle to identify a specific callback.
@@ -179,6 +222,16 @@ namespace hal
 		std::function<void(SensorType, SensorName, uint8_t)> m_on_ready_to_delete{};
 		std::atomic_bool m_is_sleeping = ATOMIC_VAR_INIT(false);
 		std::atomic_bool m_is_running = ATOMIC_VAR_INIT(false);;
+		std::atomic_uint64_t m_measurement_count = ATOMIC_VAR_INIT(0);
+		std::atomic_uint64_t m_failure_count = ATOMIC_VAR_INIT(0);
+		std::atomic_uint32_t m_consecutive_failures = ATOMIC_VAR_INIT(0);
+		std::atomic<ErrorCode> m_last_error = ATOMIC_VAR_INIT(ErrorCode::NONE);
+		utils::Counter* m_measurements_metric{};
+		utils::Counter* m_failures_metric{};
+		utils::Gauge* m_consecutive_failures_metric{};
+		utils::Histogram* m_measurement_duration{};
+		utils::Histogram* m_callback_duration{};
+		utils::Histogram* m_tick_lateness{};
 		interfaces::ISensor* m_sensor{};
 		std::vector<std::shared_ptr<CallbackHandle>> m_value_callbacks_to_add{};
 		std::vector<std::shared_ptr<CallbackHandle>> m_value_callbacks_to_remove{};
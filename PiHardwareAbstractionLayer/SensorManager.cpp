@@ -1,5 +1,8 @@
 #include "SensorManager.h"
 #include "exceptions/HALException.h"
+#include "sensors/analog/KY018.h"
+#include "sensors/digital/AM312.h"
+#include "sensors/i2c/ADS1115SharedConverter.h"
 #include "sensors/i2c/BME280.h"
 #include "sensors/i2c/DS3231.h"
 
@@ -121,9 +124,10 @@ void hal::SensorManager::create_hardware_pointer(const SensorType type, SensorNa
 		if (type == SensorType::CO2 || type == SensorType::TVOC)
 		{
 			auto sensor = new sensors::i2c::ccs811::CCS811();
+			sensor->enable_baseline_store();
 			sensor->init(true, 4, 5); // Todo add correct pin numbers (wake, i2c)
 			sensor->start();
-			sensor->set_operation_mode(sensors::i2c::ccs811::OperationMode::CONSTANT_POWER_1_S, false, false);
+			sensor->enable_automatic_mode_selection(false, false); // The callbacks of the sensors decide about the data rate
 			m_hardware_map[std::make_pair(name, pin)] = sensor;
 		}
 		else
@@ -137,8 +141,13 @@ void hal::SensorManager::create_hardware_pointer(const SensorType type, SensorNa
 	{
 		if (type == SensorType::LIGHT)
 		{
-			//auto sensor = new Sensors::Analog::KY_018::KY_018();
-			//m_hardware_map[std::make_pair(name, pin)] = sensor;
+			// The pin is the input of the converter. All KY-018 share the converter and its scans.
+			auto sensor = new sensors::analog::ky018::KY018OnADS1115();
+			sensor->init(sensors::i2c::ads1115::SharedConverter::for_address(),
+							 sensors::i2c::ads1115::SharedConverter::single_ended_input(pin),
+							 sensors::i2c::ads1115::GainAmplifier::GAIN_6144_mV);
+			sensor->set_auto_range(true);
+			m_hardware_map[std::make_pair(name, pin)] = sensor;
 		}
 		else
 		{
@@ -156,8 +165,9 @@ void hal::SensorManager::create_hardware_pointer(const SensorType type, SensorNa
 	{
 		if (type == SensorType::MOTION)
 		{
-			//auto sensor = new Sensors::Digital::AM312::AM312();
-			//m_hardware_map[std::make_pair(name, pin)] = sensor;
+			auto sensor = new sensors::digital::am312::AM312();
+			sensor->init(pin);
+			m_hardware_map[std::make_pair(name, pin)] = sensor;
 		}
 		else
 		{
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hal
+{
+	/*! Defines why a call that reports its failure with a result instead of an exception failed. */
+	enum class ErrorCode : uint8_t
+	{
+		/*! The call succeeded. */
+		NONE = 0,
+		/*! The connection to the device is not open. */
+		DEVICE_NOT_OPEN = 1,
+		/*! Writing to the device failed (e.g. the device did not acknowledge). */
+		WRITE_FAILED = 2,
+		/*! Reading from the device failed. */
+		READ_FAILED = 3,
+		/*! The device did not finish in time. */
+		TIMEOUT = 4,
+		/*! The device reported an error or returned invalid data. */
+		DEVICE_ERROR = 5,
+		/*! The call was made with an invalid argument (e.g. an unsupported sensor type). */
+		INVALID_ARGUMENT = 6,
+		/*! A function that still reports its failures with exceptions threw one. */
+		EXCEPTION = 7
+	};
+}
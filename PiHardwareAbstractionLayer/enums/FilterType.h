@@ -0,0 +1,15 @@
+#pragma once
+
+namespace hal
+{
+	/*! Defines the filters a decimation stage can apply to a stream of samples. */
+	enum class FilterType
+	{
+		/*! Average of the last window_size samples. Windows of consecutive outputs may overlap. */
+		MOVING_AVERAGE = 0,
+		/*! Average of the samples since the last output (CIC decimator of order 1, integrate and dump). */
+		BOXCAR = 1,
+		/*! Median of the last window_size samples. Removes single spikes instead of smearing them. */
+		MEDIAN = 2
+	};
+}
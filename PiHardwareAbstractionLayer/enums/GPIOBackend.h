@@ -0,0 +1,15 @@
+#pragma once
+
+namespace hal
+{
+	/*! Defines the implementations \sa { HAL::Utils::GPIOFactory } can create GPIO lines with. */
+	enum class GPIOBackend
+	{
+		/*! Linux GPIO character device (/dev/gpiochip*). Edges are timestamped by the kernel. */
+		CHARDEV = 0,
+		/*! wiringPi library. Edges are detected by wiringPi interrupt handlers and timestamped when they are handled. */
+		WIRING_PI = 1,
+		/*! In-process simulator. Lines are driven by \sa { HAL::Utils::GPIOSimulator } and work without GPIO hardware. */
+		SIMULATED = 2
+	};
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace hal
+{
+	/*! Defines the signal edges a GPIO line reports as events. */
+	enum class GPIOEdge
+	{
+		/*! No edge detection. The line can only be read or written. */
+		NONE = 0,
+		/*! Transition from LOW to HIGH. */
+		RISING = 1,
+		/*! Transition from HIGH to LOW. */
+		FALLING = 2,
+		/*! Transitions in both directions. */
+		BOTH = 3
+	};
+}
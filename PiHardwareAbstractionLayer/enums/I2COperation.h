@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hal
+{
+	/*! Defines the calls of an i2c transport that are recorded in a traffic log. */
+	enum class I2COperation : uint8_t
+	{
+		/*! A connection to a device was opened. */
+		OPEN = 0,
+		/*! A connection to a device was closed. */
+		CLOSE = 1,
+		/*! Bytes were written to a device. */
+		WRITE = 2,
+		/*! Bytes were read from a device. */
+		READ = 3
+	};
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hal
+{
+	/*! Defines the kinds of runtime metrics the HAL records. */
+	enum class MetricKind : uint8_t
+	{
+		/*! A value that only grows, e.g. the number of failed transfers. */
+		COUNTER = 0,
+		/*! A value that is set to the current state, e.g. the number of consecutive failures. */
+		GAUGE = 1,
+		/*! A distribution of durations in nanoseconds with fixed power of two buckets. */
+		HISTOGRAM = 2
+	};
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hal
+{
+	/*! Defines how a device accepts writes to several registers. */
+	enum class RegisterAccess : uint8_t
+	{
+		/*! The register pointer increments after each byte, so adjacent registers are written with one transaction. */
+		AUTO_INCREMENT = 0,
+		/*! Each data byte is preceded by its register address, so any registers are written with one transaction. */
+		ADDRESS_DATA_PAIRS = 1,
+		/*! Each transaction writes exactly one register. */
+		SINGLE_REGISTER = 2
+	};
+}
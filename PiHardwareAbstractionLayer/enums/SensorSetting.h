@@ -46,6 +46,10 @@ namespace hal
 		/*!< Allows to define whether a clock returns time as a formatted string or as a (stringified) int32. */
 		OUTPUT_FORMAT,
 		/*!< Allows to sync the time of a clock. */
-		TIME_SYNC
+		TIME_SYNC,
+		/*!< Allows to set the time in milliseconds in which further edges of an input are treated as bounces. */
+		DEBOUNCE_TIME,
+		/*!< Allows to set the time in milliseconds an input has to stay inactive until the end of an event is reported. */
+		RETRIGGER_TIME
 	};
 }
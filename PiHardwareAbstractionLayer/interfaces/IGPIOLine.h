@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../structs/GPIOEvent.h"
+
+namespace hal
+{
+	namespace interfaces
+	{
+		/*!
+		* Interface of a single GPIO line. Lines that were requested with edge detection expose a
+		* file descriptor that becomes readable as soon as an edge was detected. This way the line
+		* can be watched by \sa { HAL::Utils::EventScheduler } instead of polling it from a thread.
+		*/
+		class IGPIOLine
+		{
+		public:
+			IGPIOLine() = default;
+			IGPIOLine(const IGPIOLine&) = delete;
+			IGPIOLine(IGPIOLine&&) = delete;
+			virtual ~IGPIOLine() = default;
+			IGPIOLine& operator=(const IGPIOLine&) = delete;
+			IGPIOLine& operator=(IGPIOLine&&) = delete;
+
+			/*!
+			* Returns the current logical value of the line.
+			* \returns 0 if the line is LOW, 1 if it is HIGH.
+			*/
+			virtual int get_value() = 0;
+
+			/*!
+			* Sets the logical value of an output line.
+			* \param[in] value: 0 to drive the line LOW, any other value to drive it HIGH.
+			*/
+			virtual void set_value(int value) = 0;
+
+			/*!
+			* Returns the file descriptor that becomes readable if an edge was detected.
+			* \returns the event file descriptor or -1 if the line was not requested with edge detection.
+			*/
+			virtual int get_event_fd() const noexcept = 0;
+
+			/*!
+			* Reads the next pending edge event. Should only be called after the event file descriptor
+			* became readable, otherwise the call may block until the next edge is detected.
+			* \param[out] event: The detected edge and its timestamp.
+			* \returns True if an event was read, false otherwise.
+			*/
+			virtual bool read_event(GPIOEvent& event) = 0;
+
+			/*!
+			* Releases the line. Afterwards the line can not be used anymore.
+			*/
+			virtual void close() = 0;
+		};
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+namespace hal
+{
+	namespace interfaces
+	{
+		/*!
+		* Interface of the byte transport below \sa { HAL::Utils::I2CManager }. The functions follow the semantics of the
+		* Linux i2c-dev interface: every <write>"()" and <read>"()" call is one i2c transaction with the device the handle
+		* was opened for, failures return -1 and set errno. This way the drivers run unchanged against the kernel or
+		* against the in-process \sa { HAL::Utils::I2CSimulator }.
+		*/
+		class II2CTransport
+		{
+		public:
+			II2CTransport() = default;
+			II2CTransport(const II2CTransport&) = delete;
+			II2CTransport(II2CTransport&&) = delete;
+			virtual ~II2CTransport() = default;
+			II2CTransport& operator=(const II2CTransport&) = delete;
+			II2CTransport& operator=(II2CTransport&&) = delete;
+
+			/*!
+			* Opens a connection to a device on the bus.
+			* \param[in] path: The path of the bus (e.g. /dev/i2c-1).
+			* \param[in] address: The i2c address of the device (e.g. 0x76).
+			* \returns a handle greater than 0 or -1 if the connection could not be opened.
+			*/
+			virtual int open_device(const std::string& path, uint8_t address) = 0;
+
+			/*!
+			* Closes a connection.
+			* \param[in] handle: The handle returned by <open_device>"()".
+			* \returns 0 on success, -1 otherwise.
+			*/
+			virtual int close_device(int handle) = 0;
+
+			/*!
+			* Writes bytes to the device. The first byte usually selects the register of the device.
+			* \param[in] handle: The handle returned by <open_device>"()".
+			* \param[in] data: The bytes to write.
+			* \param[in] length: The number of bytes to write.
+			* \returns the number of written bytes or -1 if the device did not acknowledge them.
+			*/
+			virtual ssize_t write(int handle, const uint8_t* data, size_t length) = 0;
+
+			/*!
+			* Reads bytes from the device, starting at its current register.
+			* \param[in] handle: The handle returned by <open_device>"()".
+			* \param[out] data: The buffer to which the bytes will be read.
+			* \param[in] length: The number of bytes to read.
+			* \returns the number of read bytes or -1 if the device did not acknowledge the request.
+			*/
+			virtual ssize_t read(int handle, uint8_t* data, size_t length) = 0;
+		};
+	}
+}
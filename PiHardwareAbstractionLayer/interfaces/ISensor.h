@@ -2,10 +2,13 @@
 
 #include "../enums/SensorType.h"
 #include "../enums/SensorSetting.h"
+#include "../exceptions/HALException.h"
 #include "../structs/CallbackHandle.h"
+#include "../utils/Result.h"
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -37,6 +40,35 @@ namespace hal
 			{
 			}
 
+			/*!
+			* Performs a new measurement like <trigger_measurement>"()", but reports failures with the returned result
+			* instead of an exception. This is the entry point of the acquisition thread. Sensors with a non-throwing
+			* measurement path override it; the default implementation calls <trigger_measurement>"()" and converts a
+			* thrown exception into an error.
+			* \param[in] type: The type of measurement that has to do be done.
+			* \returns the result of the measurement.
+			*/
+			virtual utils::Result<void> measure(const SensorType type)
+			{
+				try
+				{
+					trigger_measurement(type);
+				}
+				catch (exception::HALException& ex)
+				{
+					utils::Error error{ErrorCode::EXCEPTION, 0, 0, 0, "ISensor", "measure"};
+					error.details = std::make_shared<const std::string>(ex.to_string());
+					return error;
+				}
+				catch (std::exception& ex)
+				{
+					utils::Error error{ErrorCode::EXCEPTION, 0, 0, 0, "ISensor", "measure"};
+					error.details = std::make_shared<const std::string>(ex.what());
+					return error;
+				}
+				return {};
+			}
+
 			/*!
 			* Changes one specific setting of a sensor.
 			* \param[in] setting: The type of setting to change. Use \sa { ISensor::available_configurations}
@@ -78,7 +110,11 @@ namespace hal
 			*/
 			void add_value_callback(const SensorType type, const std::shared_ptr<CallbackHandle>& callback) noexcept
 			{
-				m_callbacks[type].push_back(callback);
+				{
+					std::lock_guard<std::recursive_mutex> guard(m_callbacks_mutex);
+					m_callbacks[type].push_back(callback);
+				}
+				on_callbacks_changed();
 			}
 
 			/*!
@@ -88,11 +124,16 @@ namespace hal
 			*/
 			void remove_value_callback(const SensorType type, const std::shared_ptr<CallbackHandle>& callback) noexcept
 			{
-				int index;
-				if (has_value_callback(type, callback->callback_handle, index))
 				{
+					std::lock_guard<std::recursive_mutex> guard(m_callbacks_mutex);
+					int index;
+					if (!has_value_callback(type, callback->callback_handle, index))
+					{
+						return;
+					}
 					m_callbacks[type].erase(m_callbacks[type].begin() + index);
 				}
+				on_callbacks_changed();
 			}
 
 			/*!
@@ -119,6 +160,7 @@ namespace hal
 			*/
 			bool has_value_callback(const SensorType type, const uint32_t handle, int& index) noexcept
 			{
+				std::lock_guard<std::recursive_mutex> guard(m_callbacks_mutex);
 				auto idx = 0;
 				for (auto& i : m_callbacks[type])
 				{
@@ -134,8 +176,31 @@ namespace hal
 			}
 
 		protected:
+			/*!
+			* Executed after a callback was added or removed. Sensors that adapt their data rate to the
+			* registered callbacks override this method. It is executed without holding the callback lock.
+			*/
+			virtual void on_callbacks_changed() noexcept
+			{
+			}
+
+			/*!
+			* Returns a copy of the callbacks registered to the given measurement type. Use this method
+			* if callbacks are executed on a thread other than the one that registers them.
+			* \param[in] type: The measurement type of the callbacks to return.
+			* \returns a copy of the registered callbacks.
+			*/
+			std::vector<std::shared_ptr<CallbackHandle>> get_value_callbacks(const SensorType type) noexcept
+			{
+				std::lock_guard<std::recursive_mutex> guard(m_callbacks_mutex);
+				return m_callbacks[type];
+			}
+
 			/*! A map storing the registered callbacks of each measurement type this sensor supports. */
 			std::map<SensorType, std::vector<std::shared_ptr<CallbackHandle>>> m_callbacks{};
+
+			/*! Guards m_callbacks since callbacks may be registered and executed on different threads. */
+			std::recursive_mutex m_callbacks_mutex{};
 		};
 	}
 }
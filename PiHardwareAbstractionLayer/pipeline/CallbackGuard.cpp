@@ -0,0 +1,44 @@
+#include "CallbackGuard.h"
+
+hal::pipeline::CallbackGuard::~CallbackGuard()
+{
+	close();
+}
+
+std::function<void(std::string)> hal::pipeline::CallbackGuard::wrap(const std::function<void(const std::string&)>& callback)
+{
+	std::shared_ptr<State> state;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (m_state == nullptr)
+		{
+			m_state = std::make_shared<State>();
+		}
+		state = m_state;
+	}
+
+	return [state, callback](const std::string& value)
+	{
+		std::lock_guard<std::recursive_mutex> guard(state->mutex);
+		if (state->is_open)
+		{
+			callback(value);
+		}
+	};
+}
+
+void hal::pipeline::CallbackGuard::close()
+{
+	// Callbacks wrapped after this call get a new state, old ones stay disabled even if their removal is still queued
+	std::shared_ptr<State> state;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		state.swap(m_state);
+	}
+
+	if (state != nullptr)
+	{
+		std::lock_guard<std::recursive_mutex> guard(state->mutex);
+		state->is_open = false;
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hal
+{
+	namespace pipeline
+	{
+		//! Keeps the sensor callbacks of a pipeline stage from running after the stage stopped.
+		/*!
+		* \sa { HAL::Sensor::remove_value_callback() } only queues the removal, the sensor thread applies it with its
+		* next tick. A stage therefore registers its callbacks through <wrap>"()" and calls <close>"()" when it
+		* stops: close waits for a callback that is running and turns all wrapped callbacks into no-ops, so the
+		* stage may be destroyed right afterwards. The same guard can be reused after a restart.
+		*/
+		class CallbackGuard
+		{
+		public:
+			CallbackGuard() = default;
+			CallbackGuard(const CallbackGuard&) = delete;
+			CallbackGuard(CallbackGuard&&) = delete;
+			CallbackGuard& operator=(const CallbackGuard&) = delete;
+			CallbackGuard& operator=(CallbackGuard&&) = delete;
+
+			/*!
+			* Destructor. Closes the guard.
+			*/
+			~CallbackGuard();
+
+			//! Wraps a callback of the stage.
+			/*!
+			* Wraps a callback of the stage. The returned function forwards the values to the callback until the
+			* guard is closed.
+			* \param[in] callback: The callback of the stage.
+			* \returns the function to register at the sensor.
+			*/
+			std::function<void(std::string)> wrap(const std::function<void(const std::string&)>& callback);
+
+			//! Disables all callbacks wrapped so far.
+			/*!
+			* Disables all callbacks wrapped so far. Blocks until a callback that is running on another thread
+			* returned. Must not be called while holding a lock the wrapped callbacks take. May be called from a
+			* wrapped callback, which then keeps running.
+			*/
+			void close();
+
+		private:
+			/*!
+			* State shared with the wrapped callbacks, so it outlives the guard until all of them are removed.
+			*/
+			struct State
+			{
+				std::recursive_mutex mutex{};
+				bool is_open = true;
+			};
+
+			std::mutex m_mutex{};
+			std::shared_ptr<State> m_state{};
+		};
+	}
+}
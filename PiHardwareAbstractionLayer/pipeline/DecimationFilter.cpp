@@ -0,0 +1,113 @@
+#include "DecimationFilter.h"
+
+#include "../exceptions/HALException.h"
+
+#include <algorithm>
+
+hal::pipeline::DecimationFilter::DecimationFilter(const FilterType type, const uint32_t decimation_factor, const uint32_t window_size)
+	: m_type(type),
+		m_decimation_factor(decimation_factor),
+		m_window_size(window_size == 0 ? decimation_factor : window_size)
+{
+	if (m_decimation_factor == 0)
+	{
+		throw exception::HALException("DecimationFilter", "DecimationFilter", "The decimation factor must not be 0.");
+	}
+	if (m_type == FilterType::BOXCAR)
+	{
+		m_window_size = m_decimation_factor;
+		return; // Only needs the running sum
+	}
+	if (m_window_size > MAX_FILTER_WINDOW_SIZE)
+	{
+		throw exception::HALException("DecimationFilter", "DecimationFilter",
+												std::string("The window must not exceed ").append(std::to_string(MAX_FILTER_WINDOW_SIZE)).append(" samples."));
+	}
+
+	m_window.resize(m_window_size);
+	if (m_type == FilterType::MEDIAN)
+	{
+		m_scratch.resize(m_window_size);
+	}
+}
+
+bool hal::pipeline::DecimationFilter::push(const double value, double& output) noexcept
+{
+	if (m_type == FilterType::BOXCAR)
+	{
+		m_sum += value;
+		if (++m_samples_since_output < m_decimation_factor)
+		{
+			return false;
+		}
+		output = m_sum / m_decimation_factor;
+		m_sum = 0;
+		m_samples_since_output = 0;
+		return true;
+	}
+
+	// Ring buffer of the last m_window_size samples
+	if (m_filled == m_window_size)
+	{
+		m_sum -= m_window[m_next_index];
+	}
+	else
+	{
+		m_filled++;
+	}
+	m_window[m_next_index] = value;
+	m_sum += value;
+	m_next_index = (m_next_index + 1) % m_window_size;
+	if (m_next_index == 0 && m_type == FilterType::MOVING_AVERAGE)
+	{
+		// Recompute the sum once per round so rounding errors of the running sum do not accumulate
+		m_sum = 0;
+		for (size_t i = 0; i < m_filled; i++)
+		{
+			m_sum += m_window[i];
+		}
+	}
+
+	if (++m_samples_since_output < m_decimation_factor)
+	{
+		return false;
+	}
+	m_samples_since_output = 0;
+	output = m_type == FilterType::MEDIAN ? compute_median() : m_sum / static_cast<double>(m_filled);
+	return true;
+}
+
+void hal::pipeline::DecimationFilter::reset() noexcept
+{
+	m_next_index = 0;
+	m_filled = 0;
+	m_samples_since_output = 0;
+	m_sum = 0;
+}
+
+uint32_t hal::pipeline::DecimationFilter::get_decimation_factor() const noexcept
+{
+	return m_decimation_factor;
+}
+
+uint32_t hal::pipeline::DecimationFilter::get_window_size() const noexcept
+{
+	return m_window_size;
+}
+
+double hal::pipeline::DecimationFilter::compute_median() noexcept
+{
+	std::copy(m_window.begin(), m_window.begin() + m_filled, m_scratch.begin());
+	const auto begin = m_scratch.begin();
+	const auto end = m_scratch.begin() + m_filled;
+	const auto middle = begin + m_filled / 2;
+	std::nth_element(begin, middle, end);
+	if (m_filled % 2 == 1)
+	{
+		return *middle;
+	}
+
+	// Even number of samples: the lower middle value is the largest value of the lower half
+	const auto lower_middle = *std::max_element(begin, middle);
+	return (lower_middle + *middle) / 2;
+}
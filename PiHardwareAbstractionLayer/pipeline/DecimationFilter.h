@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../enums/FilterType.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hal
+{
+	namespace pipeline
+	{
+		/*! Largest window a decimation filter accepts. Bounds the memory of a filter. */
+		static constexpr uint32_t MAX_FILTER_WINDOW_SIZE = 1024;
+
+		//! Streaming filter that turns a fast stream of samples into a slower, smoothed stream.
+		/*!
+		* This class filters a stream of samples and outputs one value for each decimation_factor input samples.
+		* All memory is allocated by the constructor, pushing samples does not allocate. The filter is not thread
+		* safe, the owner has to serialize the calls.
+		*/
+		class DecimationFilter
+		{
+		public:
+			DecimationFilter() = delete;
+
+			//! Creates a new filter.
+			/*!
+			* Creates a new filter.
+			* \param[in] type: The filter to apply.
+			* \param[in] decimation_factor: The number of input samples per output value.
+			* \param[in] window_size: The number of samples a MOVING_AVERAGE or MEDIAN output is computed from.
+			* 0 uses the decimation factor. Ignored by BOXCAR, which always uses the samples since the last output.
+			* \throws HALException if the decimation factor is 0 or the window exceeds MAX_FILTER_WINDOW_SIZE.
+			*/
+			DecimationFilter(FilterType type, uint32_t decimation_factor, uint32_t window_size = 0);
+
+			//! Adds a sample to the filter.
+			/*!
+			* Adds a sample to the filter.
+			* \param[in] value: The new sample.
+			* \param[out] output: The filtered value. Only written if the function returns true.
+			* \returns True if the sample completed an output value, false otherwise.
+			*/
+			bool push(double value, double& output) noexcept;
+
+			//! Drops all samples.
+			/*!
+			* Drops all samples. The next output needs decimation_factor new samples.
+			*/
+			void reset() noexcept;
+
+			//! Returns the number of input samples per output value.
+			/*!
+			* Returns the number of input samples per output value.
+			* \returns the decimation factor.
+			*/
+			uint32_t get_decimation_factor() const noexcept;
+
+			//! Returns the number of samples an output value is computed from.
+			/*!
+			* Returns the number of samples an output value is computed from.
+			* \returns the window size.
+			*/
+			uint32_t get_window_size() const noexcept;
+
+		protected:
+			//! Computes the median of the samples in the window.
+			/*!
+			* Computes the median of the samples in the window. Uses the preallocated scratch buffer.
+			* \returns the median. The mean of both middle values if the window holds an even number of samples.
+			*/
+			double compute_median() noexcept;
+
+			FilterType m_type;
+			uint32_t m_decimation_factor;
+			uint32_t m_window_size;
+			std::vector<double> m_window{};
+			std::vector<double> m_scratch{};
+			size_t m_next_index = 0;
+			size_t m_filled = 0;
+			uint32_t m_samples_since_output = 0;
+			double m_sum = 0;
+		};
+	}
+}
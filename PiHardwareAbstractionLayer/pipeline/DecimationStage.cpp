@@ -0,0 +1,118 @@
+#include "DecimationStage.h"
+
+#include "../exceptions/HALException.h"
+#include "../utils/Helper.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+using namespace hal::utils;
+
+namespace
+{
+	// The sensor has to exist before the filter can be sized, so the pointer is checked here
+	uint32_t decimation_factor_of(hal::Sensor* sensor, const uint32_t output_interval_in_ms)
+	{
+		if (sensor == nullptr)
+		{
+			throw hal::exception::HALException("DecimationStage", "DecimationStage", "Sensor pointer is null.");
+		}
+		const auto delay = sensor->get_delay_milliseconds();
+		return delay > 0 ? std::max<uint32_t>(1, output_interval_in_ms / static_cast<uint32_t>(delay)) : 1;
+	}
+}
+
+hal::pipeline::DecimationStage::DecimationStage(Sensor* sensor, const FilterType type, const uint32_t output_interval_in_ms,
+																const uint32_t window_size)
+	: m_sensor(sensor),
+		m_output_interval_in_ms(output_interval_in_ms),
+		m_filter(type, decimation_factor_of(sensor, output_interval_in_ms), window_size)
+{
+}
+
+hal::pipeline::DecimationStage::~DecimationStage()
+{
+	stop();
+}
+
+void hal::pipeline::DecimationStage::start()
+{
+	// m_mutex is taken by on_value on the sensor thread, which holds the sensor lock, so it is not held here
+	std::lock_guard<std::mutex> guard(m_subscription_mutex);
+	if (m_sensor_handle == nullptr)
+	{
+		m_sensor_handle = m_sensor->add_value_callback(m_callback_guard.wrap([this](const std::string& value) { on_value(value); }));
+	}
+}
+
+void hal::pipeline::DecimationStage::stop()
+{
+	{
+		std::lock_guard<std::mutex> guard(m_subscription_mutex);
+		m_callback_guard.close();
+		if (m_sensor_handle != nullptr)
+		{
+			m_sensor->remove_value_callback(m_sensor_handle);
+			m_sensor_handle = nullptr;
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_filter.reset();
+}
+
+std::shared_ptr<hal::CallbackHandle> hal::pipeline::DecimationStage::add_value_callback(const std::function<void(std::string)>& on_value)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	auto handle = std::make_shared<CallbackHandle>(on_value, m_next_handle++, m_output_interval_in_ms);
+	m_callbacks.push_back(handle);
+	return handle;
+}
+
+void hal::pipeline::DecimationStage::remove_value_callback(const std::shared_ptr<CallbackHandle>& handle)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_callbacks.erase(std::remove(m_callbacks.begin(), m_callbacks.end(), handle), m_callbacks.end());
+}
+
+uint32_t hal::pipeline::DecimationStage::get_decimation_factor() const noexcept
+{
+	return m_filter.get_decimation_factor();
+}
+
+void hal::pipeline::DecimationStage::on_value(const std::string& value)
+{
+	double sample;
+	try
+	{
+		sample = Helper::string_to_double(value);
+	}
+	catch (std::exception&)
+	{
+		// Must not break the sensor that executes this callback
+		std::cerr << "DecimationStage [on_value] Dropped non numeric value '" << value << "'." << std::endl;
+		return;
+	}
+
+	std::vector<std::shared_ptr<CallbackHandle>> callbacks;
+	double output;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (!m_filter.push(sample, output))
+		{
+			return;
+		}
+		callbacks = m_callbacks;
+	}
+
+	// Subscribers may add or remove callbacks, so they are executed without the lock
+	const auto filtered = std::to_string(output);
+	for (const auto& handle : callbacks)
+	{
+		if (handle->callback != nullptr)
+		{
+			handle->callback(filtered);
+		}
+	}
+}
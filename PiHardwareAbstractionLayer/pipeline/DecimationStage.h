@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CallbackGuard.h"
+#include "DecimationFilter.h"
+#include "../Sensor.h"
+#include "../enums/FilterType.h"
+#include "../structs/CallbackHandle.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+	namespace pipeline
+	{
+		//! Pipeline stage that decimates the values of a fast sampled sensor before they are delivered.
+		/*!
+		* This class subscribes to a sensor that samples fast (e.g. a KY018 every few milliseconds) and delivers
+		* one filtered value per output interval to its own subscribers. The decimation factor follows from the
+		* output interval the subscribers want and the delay of the sensor, so downstream consumers see fewer and
+		* cleaner samples than the sensor produces. The stage is opt-in: values are only filtered while it is started.
+		*/
+		class DecimationStage
+		{
+		public:
+			DecimationStage() = delete;
+			DecimationStage(const DecimationStage&) = delete;
+			DecimationStage(DecimationStage&&) = delete;
+			DecimationStage& operator=(const DecimationStage&) = delete;
+			DecimationStage& operator=(DecimationStage&&) = delete;
+
+			//! Creates a new decimation stage.
+			/*!
+			* Creates a new decimation stage. The sensor is not owned by the stage and has to outlive it.
+			* \param[in] sensor: The sensor whose values are filtered. Has to deliver numeric values.
+			* \param[in] type: The filter to apply.
+			* \param[in] output_interval_in_ms: The time between two values delivered to the subscribers.
+			* \param[in] window_size: The number of samples a MOVING_AVERAGE or MEDIAN output is computed from.
+			* 0 uses the decimation factor.
+			* \throws HALException if the sensor is null or the filter could not be created.
+			*/
+			DecimationStage(Sensor* sensor, FilterType type, uint32_t output_interval_in_ms, uint32_t window_size = 0);
+
+			~DecimationStage();
+
+			//! Starts filtering.
+			/*!
+			* Registers the callback at the sensor. The first value is delivered after decimation factor samples.
+			*/
+			void start();
+
+			//! Stops filtering.
+			/*!
+			* Removes the callback from the sensor and drops the collected samples. Waits for a callback that is
+			* running, afterwards no value is delivered anymore.
+			*/
+			void stop();
+
+			//! Adds a subscriber for the filtered values.
+			/*!
+			* Adds a subscriber for the filtered values.
+			* \param[in] on_value: Function that is called with each filtered value. Executed on the thread of the sensor.
+			* \returns the handle to remove the subscriber again.
+			*/
+			std::shared_ptr<CallbackHandle> add_value_callback(const std::function<void(std::string)>& on_value);
+
+			//! Removes a subscriber.
+			/*!
+			* Removes a subscriber.
+			* \param[in] handle: The handle returned by <add_value_callback>"()".
+			*/
+			void remove_value_callback(const std::shared_ptr<CallbackHandle>& handle);
+
+			//! Returns the number of sensor values per filtered value.
+			/*!
+			* Returns the number of sensor values per filtered value.
+			* \returns the decimation factor.
+			*/
+			uint32_t get_decimation_factor() const noexcept;
+
+		protected:
+			/*!
+			* Callback for new sensor values. Delivers a filtered value to the subscribers once enough samples were collected.
+			* \param[in] value: The new sensor value.
+			*/
+			void on_value(const std::string& value);
+
+			Sensor* m_sensor;
+			uint32_t m_output_interval_in_ms;
+			DecimationFilter m_filter;
+
+			std::mutex m_subscription_mutex{};
+			CallbackGuard m_callback_guard{};
+			std::shared_ptr<CallbackHandle> m_sensor_handle{};
+
+			std::mutex m_mutex{};
+			std::vector<std::shared_ptr<CallbackHandle>> m_callbacks{};
+			uint32_t m_next_handle = 1;
+		};
+	}
+}
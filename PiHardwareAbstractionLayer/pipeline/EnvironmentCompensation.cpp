@@ -0,0 +1,148 @@
+#include "EnvironmentCompensation.h"
+
+#include "../exceptions/HALException.h"
+#include "../sensors/i2c/CCS811Constants.h"
+#include "../utils/Helper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace hal::utils;
+
+hal::pipeline::EnvironmentCompensation::EnvironmentCompensation(
+	Sensor* temperature_sensor,
+	Sensor* humidity_sensor,
+	Sensor* air_quality_sensor,
+	const double temperature_band,
+	const double humidity_band,
+	const uint32_t min_update_interval_s)
+	: m_temperature_sensor(temperature_sensor),
+		m_humidity_sensor(humidity_sensor),
+		m_air_quality_sensor(air_quality_sensor),
+		m_temperature_band(temperature_band),
+		m_humidity_band(humidity_band),
+		m_min_update_interval(min_update_interval_s)
+{
+	if (m_temperature_sensor == nullptr || m_humidity_sensor == nullptr || m_air_quality_sensor == nullptr)
+	{
+		throw exception::HALException("EnvironmentCompensation", "EnvironmentCompensation", "Sensor pointer is null.");
+	}
+
+	if (m_temperature_sensor->get_type() != SensorType::TEMPERATURE || m_humidity_sensor->get_type() != SensorType::AIR_HUMIDITY)
+	{
+		throw exception::HALException("EnvironmentCompensation", "EnvironmentCompensation",
+												"Temperature and humidity sensor have to be of type TEMPERATURE and AIR_HUMIDITY.");
+	}
+
+	const auto settings = m_air_quality_sensor->available_configurations();
+	if (std::find(settings.begin(), settings.end(), SensorSetting::ENVIRONMENT_DATA) == settings.end())
+	{
+		throw exception::HALException("EnvironmentCompensation", "EnvironmentCompensation",
+												"The air quality sensor does not support the ENVIRONMENT_DATA setting.");
+	}
+}
+
+hal::pipeline::EnvironmentCompensation::~EnvironmentCompensation()
+{
+	stop();
+}
+
+void hal::pipeline::EnvironmentCompensation::start()
+{
+	// m_mutex is taken by the callbacks on the sensor threads, which hold the sensor lock, so it is not held here
+	std::lock_guard<std::mutex> guard(m_subscription_mutex);
+	if (m_temperature_handle == nullptr)
+	{
+		m_temperature_handle = m_temperature_sensor->add_value_callback(
+			m_callback_guard.wrap([this](const std::string& value) { on_temperature(value); }));
+	}
+	if (m_humidity_handle == nullptr)
+	{
+		m_humidity_handle = m_humidity_sensor->add_value_callback(
+			m_callback_guard.wrap([this](const std::string& value) { on_humidity(value); }));
+	}
+}
+
+void hal::pipeline::EnvironmentCompensation::stop()
+{
+	std::lock_guard<std::mutex> guard(m_subscription_mutex);
+
+	// The sensors only queue the removal, the guard makes sure the callbacks do not run anymore
+	m_callback_guard.close();
+	if (m_temperature_handle != nullptr)
+	{
+		m_temperature_sensor->remove_value_callback(m_temperature_handle);
+		m_temperature_handle = nullptr;
+	}
+	if (m_humidity_handle != nullptr)
+	{
+		m_humidity_sensor->remove_value_callback(m_humidity_handle);
+		m_humidity_handle = nullptr;
+	}
+}
+
+uint32_t hal::pipeline::EnvironmentCompensation::get_update_count()
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	return m_update_count;
+}
+
+void hal::pipeline::EnvironmentCompensation::on_temperature(const std::string& value)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_temperature = Helper::string_to_double(value);
+	m_has_temperature = true;
+	update_if_needed();
+}
+
+void hal::pipeline::EnvironmentCompensation::on_humidity(const std::string& value)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_humidity = Helper::string_to_double(value);
+	m_has_humidity = true;
+	update_if_needed();
+}
+
+void hal::pipeline::EnvironmentCompensation::update_if_needed()
+{
+	if (!m_has_temperature || !m_has_humidity)
+	{
+		return;
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	if (m_has_written)
+	{
+		const auto outside_band = std::fabs(m_temperature - m_written_temperature) >= m_temperature_band
+			|| std::fabs(m_humidity - m_written_humidity) >= m_humidity_band;
+		if (!outside_band || now - m_last_update < m_min_update_interval)
+		{
+			return;
+		}
+	}
+
+	// The environment data setting expects both values scaled by 100. Negative temperatures can not be
+	// represented and are clamped to 0, the upper limits are the range of the environment data register.
+	const auto temperature = static_cast<uint16_t>(std::min(std::lround(std::max(m_temperature, 0.0) * 100),
+																			  static_cast<long>(sensors::i2c::ccs811::ENV_TEMPERATURE_MAX)));
+	const auto humidity = static_cast<uint16_t>(std::min(std::lround(std::max(m_humidity, 0.0) * 100),
+																		  static_cast<long>(sensors::i2c::ccs811::ENV_HUMIDITY_MAX)));
+	try
+	{
+		m_air_quality_sensor->configure(SensorSetting::ENVIRONMENT_DATA,
+												std::to_string(temperature).append(",").append(std::to_string(humidity)));
+	}
+	catch (exception::HALException& ex)
+	{
+		// Must not break the temperature or humidity sensor that executes this callback. The next sample retries.
+		std::cerr << "EnvironmentCompensation [update_if_needed] Could not write environment data:\n" << ex.to_string() << std::endl;
+		return;
+	}
+
+	m_written_temperature = m_temperature;
+	m_written_humidity = m_humidity;
+	m_last_update = now;
+	m_has_written = true;
+	m_update_count++;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "CallbackGuard.h"
+#include "../Sensor.h"
+#include "../structs/CallbackHandle.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hal
+{
+	namespace pipeline
+	{
+		/*! Default change of the temperature (in degree Celsius) that causes a new compensation update. */
+		static constexpr double DEFAULT_TEMPERATURE_BAND = 0.5;
+
+		/*! Default change of the relative humidity (in percent) that causes a new compensation update. */
+		static constexpr double DEFAULT_HUMIDITY_BAND = 2.0;
+
+		/*! Default minimum time between two compensation updates (10 minutes). */
+		static constexpr uint32_t DEFAULT_MIN_UPDATE_INTERVAL_IN_S = 600;
+
+		//! Pipeline stage that feeds temperature and humidity into the environment data of an air quality sensor.
+		/*!
+		* This class subscribes to a temperature and a humidity sensor (e.g. the BME280) and forwards their
+		* values to the ENVIRONMENT_DATA setting of an air quality sensor (e.g. the CCS811), which uses them
+		* to compensate its eCO2 and TVOC calculation. An update is only written if one of the values left
+		* the hysteresis band around the last written value and the minimum update interval elapsed. This
+		* keeps the number of writes down to a few per hour instead of one per sample.
+		* The stage is opt-in: compensation only happens while an instance is started.
+		*/
+		class EnvironmentCompensation
+		{
+		public:
+			EnvironmentCompensation() = delete;
+			EnvironmentCompensation(const EnvironmentCompensation&) = delete;
+			EnvironmentCompensation(EnvironmentCompensation&&) = delete;
+			EnvironmentCompensation& operator=(const EnvironmentCompensation&) = delete;
+			EnvironmentCompensation& operator=(EnvironmentCompensation&&) = delete;
+
+			//! Creates a new compensation stage.
+			/*!
+			* Creates a new compensation stage. The sensors are not owned by the stage and have to outlive it.
+			* \param[in] temperature_sensor: A sensor of type TEMPERATURE that delivers values in degree Celsius.
+			* \param[in] humidity_sensor: A sensor of type AIR_HUMIDITY that delivers values in percent.
+			* \param[in] air_quality_sensor: The sensor (CO2 or TVOC) whose ENVIRONMENT_DATA setting is updated.
+			* \param[in] temperature_band: The temperature change (in degree Celsius) that causes a new update.
+			* \param[in] humidity_band: The humidity change (in percent) that causes a new update.
+			* \param[in] min_update_interval_s: The minimum time between two updates in seconds.
+			* \throws HALException if one of the sensors is null or does not support the needed type/setting.
+			*/
+			EnvironmentCompensation(
+				Sensor* temperature_sensor,
+				Sensor* humidity_sensor,
+				Sensor* air_quality_sensor,
+				double temperature_band = DEFAULT_TEMPERATURE_BAND,
+				double humidity_band = DEFAULT_HUMIDITY_BAND,
+				uint32_t min_update_interval_s = DEFAULT_MIN_UPDATE_INTERVAL_IN_S);
+
+			~EnvironmentCompensation();
+
+			//! Starts the compensation.
+			/*!
+			* Registers the callbacks at the temperature and humidity sensor. The first update is written
+			* as soon as both values were received.
+			*/
+			void start();
+
+			//! Stops the compensation.
+			/*!
+			* Removes the callbacks from the temperature and humidity sensor. Waits for a callback that is
+			* running, afterwards none is executed anymore. The environment data that was written last stays
+			* active on the air quality sensor.
+			*/
+			void stop();
+
+			//! Returns the number of updates written to the air quality sensor.
+			/*!
+			* Returns the number of updates written to the air quality sensor.
+			* \returns the number of written updates.
+			*/
+			uint32_t get_update_count();
+
+		protected:
+			/*!
+			* Callback for new temperature values.
+			* \param[in] value: The new temperature in degree Celsius.
+			*/
+			void on_temperature(const std::string& value);
+
+			/*!
+			* Callback for new humidity values.
+			* \param[in] value: The new relative humidity in percent.
+			*/
+			void on_humidity(const std::string& value);
+
+			/*!
+			* Writes the latest values to the air quality sensor if they left the hysteresis band and the
+			* minimum update interval elapsed. If writing fails the error is logged and the next sample
+			* retries the update. The mutex has to be locked by the caller.
+			*/
+			void update_if_needed();
+
+			Sensor* m_temperature_sensor;
+			Sensor* m_humidity_sensor;
+			Sensor* m_air_quality_sensor;
+			double m_temperature_band;
+			double m_humidity_band;
+			std::chrono::seconds m_min_update_interval;
+
+			std::mutex m_subscription_mutex{};
+			CallbackGuard m_callback_guard{};
+			std::shared_ptr<CallbackHandle> m_temperature_handle{};
+			std::shared_ptr<CallbackHandle> m_humidity_handle{};
+
+			std::mutex m_mutex{};
+			bool m_has_temperature = false;
+			bool m_has_humidity = false;
+			bool m_has_written = false;
+			double m_temperature = 0;
+			double m_humidity = 0;
+			double m_written_temperature = 0;
+			double m_written_humidity = 0;
+			uint32_t m_update_count = 0;
+			std::chrono::steady_clock::time_point m_last_update{};
+		};
+	}
+}
@@ -0,0 +1,245 @@
+#include "OccupancyAggregator.h"
+
+#include "../exceptions/HALException.h"
+#include "../utils/EventScheduler.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace hal::utils;
+
+hal::pipeline::OccupancyAggregator::OccupancyAggregator(Sensor* sensor, const uint32_t hold_off_time_in_ms)
+	: m_sensor(sensor),
+		m_hold_off_time_in_ms(hold_off_time_in_ms)
+{
+}
+
+hal::pipeline::OccupancyAggregator::~OccupancyAggregator()
+{
+	stop();
+
+	uint32_t hold_off_handle;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		hold_off_handle = m_hold_off_handle;
+		m_hold_off_handle = 0;
+		m_hold_off_id++;
+	}
+	if (hold_off_handle != 0)
+	{
+		EventScheduler::instance().remove(hold_off_handle);
+	}
+}
+
+void hal::pipeline::OccupancyAggregator::start()
+{
+	if (m_sensor == nullptr)
+	{
+		throw exception::HALException("OccupancyAggregator", "start", "Sensor pointer is null.");
+	}
+
+	// m_mutex is taken by on_value on the sensor thread, which holds the sensor lock, so it is not held here
+	std::lock_guard<std::mutex> guard(m_subscription_mutex);
+	if (m_sensor_handle == nullptr)
+	{
+		m_sensor_handle = m_sensor->add_value_callback(m_callback_guard.wrap([this](const std::string& value) { on_value(value); }));
+	}
+}
+
+void hal::pipeline::OccupancyAggregator::stop()
+{
+	std::lock_guard<std::mutex> guard(m_subscription_mutex);
+	m_callback_guard.close();
+	if (m_sensor_handle != nullptr)
+	{
+		m_sensor->remove_value_callback(m_sensor_handle);
+		m_sensor_handle = nullptr;
+	}
+}
+
+void hal::pipeline::OccupancyAggregator::push(const bool motion, const std::chrono::system_clock::time_point timestamp)
+{
+	uint32_t stale_handle = 0;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (motion == m_motion)
+		{
+			return;
+		}
+
+		m_motion = motion;
+		if (motion)
+		{
+			if (!m_is_open)
+			{
+				m_is_open = true;
+				m_interval = OccupancyInterval{timestamp, timestamp, 0};
+			}
+			m_interval.event_count++;
+
+			// Invalidates a running hold-off time. The timer is removed below without the lock.
+			m_hold_off_id++;
+			stale_handle = m_hold_off_handle;
+			m_hold_off_handle = 0;
+		}
+		else
+		{
+			if (!m_is_open)
+			{
+				return;
+			}
+			m_interval.end = timestamp;
+
+			const auto hold_off_id = ++m_hold_off_id;
+			stale_handle = m_hold_off_handle;
+			try
+			{
+				m_hold_off_handle = EventScheduler::instance().add_timer(m_hold_off_time_in_ms, false,
+																							[this, hold_off_id]() { on_hold_off_timer(hold_off_id); });
+			}
+			catch (exception::HALException& ex)
+			{
+				// Must not break the sensor that executes this callback. The interval is completed by the next flush.
+				m_hold_off_handle = 0;
+				std::cerr << "OccupancyAggregator [push] Could not start hold-off timer:\n" << ex.to_string() << std::endl;
+			}
+		}
+	}
+
+	if (stale_handle != 0)
+	{
+		EventScheduler::instance().remove(stale_handle);
+	}
+}
+
+void hal::pipeline::OccupancyAggregator::push(const sensors::digital::am312::MotionEvent& event)
+{
+	// The kernel timestamps edges with CLOCK_MONOTONIC which is the clock of steady_clock on Linux.
+	const auto now_steady = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	const auto age = std::chrono::nanoseconds(static_cast<uint64_t>(now_steady) > event.timestamp_ns
+															? static_cast<uint64_t>(now_steady) - event.timestamp_ns : 0);
+	push(event.motion, std::chrono::system_clock::now() - std::chrono::duration_cast<std::chrono::system_clock::duration>(age));
+}
+
+void hal::pipeline::OccupancyAggregator::flush()
+{
+	OccupancyInterval interval;
+	bool completed;
+	uint32_t stale_handle;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (m_motion)
+		{
+			m_interval.end = std::chrono::system_clock::now();
+			m_motion = false;
+		}
+		m_hold_off_id++;
+		stale_handle = m_hold_off_handle;
+		m_hold_off_handle = 0;
+		completed = complete_interval(interval);
+	}
+
+	if (stale_handle != 0)
+	{
+		EventScheduler::instance().remove(stale_handle);
+	}
+	if (completed)
+	{
+		publish(interval);
+	}
+}
+
+uint32_t hal::pipeline::OccupancyAggregator::add_interval_callback(const std::function<void(const OccupancyInterval&)>& on_interval)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_callbacks[m_next_handle] = on_interval;
+	return m_next_handle++;
+}
+
+void hal::pipeline::OccupancyAggregator::remove_interval_callback(const uint32_t handle)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_callbacks.erase(handle);
+}
+
+void hal::pipeline::OccupancyAggregator::set_hold_off_time(const uint32_t hold_off_time_in_ms) noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_hold_off_time_in_ms = hold_off_time_in_ms;
+}
+
+uint32_t hal::pipeline::OccupancyAggregator::get_hold_off_time() const noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	return m_hold_off_time_in_ms;
+}
+
+bool hal::pipeline::OccupancyAggregator::is_occupied() const noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	return m_is_open;
+}
+
+void hal::pipeline::OccupancyAggregator::on_value(const std::string& value)
+{
+	if (value != "0" && value != "1")
+	{
+		// Must not break the sensor that executes this callback
+		std::cerr << "OccupancyAggregator [on_value] Dropped invalid motion value '" << value << "'." << std::endl;
+		return;
+	}
+	push(value == "1", std::chrono::system_clock::now());
+}
+
+void hal::pipeline::OccupancyAggregator::on_hold_off_timer(const uint64_t hold_off_id)
+{
+	OccupancyInterval interval;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (hold_off_id != m_hold_off_id || m_motion)
+		{
+			return;
+		}
+
+		m_hold_off_handle = 0; // One-shot timer, removed by the scheduler after this callback
+		if (!complete_interval(interval))
+		{
+			return;
+		}
+	}
+	publish(interval);
+}
+
+bool hal::pipeline::OccupancyAggregator::complete_interval(OccupancyInterval& interval)
+{
+	if (!m_is_open)
+	{
+		return false;
+	}
+
+	interval = m_interval;
+	m_interval = OccupancyInterval{};
+	m_is_open = false;
+	return true;
+}
+
+void hal::pipeline::OccupancyAggregator::publish(const OccupancyInterval& interval)
+{
+	// Subscribers may add or remove callbacks, so they are executed without the lock
+	std::vector<std::function<void(const OccupancyInterval&)>> callbacks;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		for (const auto& callback : m_callbacks)
+		{
+			callbacks.push_back(callback.second);
+		}
+	}
+
+	for (const auto& callback : callbacks)
+	{
+		if (callback != nullptr)
+		{
+			callback(interval);
+		}
+	}
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "CallbackGuard.h"
+#include "../Sensor.h"
+#include "../sensors/digital/AM312Definitions.h"
+#include "../structs/CallbackHandle.h"
+#include "../structs/OccupancyInterval.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hal
+{
+	namespace pipeline
+	{
+		static constexpr uint32_t DEFAULT_OCCUPANCY_HOLD_OFF_TIME_IN_MS = 300000;
+		// Five minutes without motion end an occupancy interval
+
+		//! Pipeline stage that turns motion state changes into occupancy intervals.
+		/*!
+		* This class collects the state changes of a motion sensor (e.g. the AM312) and merges all motions that follow
+		* each other within the hold-off time into one occupancy interval. An interval is delivered to the subscribers
+		* as soon as the hold-off time after its last motion expired, so consumers store one compact record per
+		* occupancy instead of every 0/1 sample. The hold-off timer runs on the \sa { HAL::Utils::EventScheduler } thread.
+		*/
+		class OccupancyAggregator
+		{
+		public:
+			OccupancyAggregator(const OccupancyAggregator&) = delete;
+			OccupancyAggregator(OccupancyAggregator&&) = delete;
+			OccupancyAggregator& operator=(const OccupancyAggregator&) = delete;
+			OccupancyAggregator& operator=(OccupancyAggregator&&) = delete;
+
+			//! Creates a new occupancy aggregator.
+			/*!
+			* Creates a new occupancy aggregator. The sensor is not owned by the aggregator and has to outlive it.
+			* \param[in] sensor: The motion sensor whose values ("1" motion, "0" no motion) are aggregated. May be null if
+			* the state changes are passed to <push>"()" directly (e.g. from \sa { AM312::set_event_callback() }).
+			* \param[in] hold_off_time_in_ms: The time without motion that ends an interval.
+			*/
+			explicit OccupancyAggregator(Sensor* sensor = nullptr, uint32_t hold_off_time_in_ms = DEFAULT_OCCUPANCY_HOLD_OFF_TIME_IN_MS);
+
+			/*!
+			* Destructor. Stops aggregating and drops an interval that is still open.
+			*/
+			~OccupancyAggregator();
+
+			//! Starts aggregating the values of the sensor.
+			/*!
+			* Registers the callback at the sensor. The values are timestamped when they arrive.
+			* \throws HALException if no sensor was passed to the constructor.
+			*/
+			void start();
+
+			//! Stops aggregating the values of the sensor.
+			/*!
+			* Removes the callback from the sensor and waits for a callback that is running. An open interval stays
+			* open until <flush>"()" is called or a state change is pushed.
+			*/
+			void stop();
+
+			//! Adds a state change of the motion sensor.
+			/*!
+			* Adds a state change of the motion sensor. Repeated states are ignored.
+			* \param[in] motion: True if a motion started, false if it ended.
+			* \param[in] timestamp: The time of the state change.
+			*/
+			void push(bool motion, std::chrono::system_clock::time_point timestamp);
+
+			//! Adds a state change reported by an AM312.
+			/*!
+			* Adds a state change reported by an AM312. The kernel timestamp of the edge is converted to the system clock.
+			* \param[in] event: The state change and its monotonic timestamp.
+			*/
+			void push(const sensors::digital::am312::MotionEvent& event);
+
+			//! Completes the open interval.
+			/*!
+			* Completes the open interval without waiting for the hold-off time and delivers it to the subscribers.
+			* If a motion is still going on the interval ends now.
+			*/
+			void flush();
+
+			//! Adds a subscriber for the completed intervals.
+			/*!
+			* Adds a subscriber for the completed intervals.
+			* \param[in] on_interval: Function that is called with each completed interval. Executed on the
+			* \sa { HAL::Utils::EventScheduler } thread or the thread that called <flush>"()".
+			* \returns the handle to remove the subscriber again.
+			*/
+			uint32_t add_interval_callback(const std::function<void(const OccupancyInterval&)>& on_interval);
+
+			//! Removes a subscriber.
+			/*!
+			* Removes a subscriber.
+			* \param[in] handle: The handle returned by <add_interval_callback>"()".
+			*/
+			void remove_interval_callback(uint32_t handle);
+
+			//! Changes the hold-off time.
+			/*!
+			* Changes the hold-off time. Applies to the next end of a motion.
+			* \param[in] hold_off_time_in_ms: The time without motion that ends an interval.
+			*/
+			void set_hold_off_time(uint32_t hold_off_time_in_ms) noexcept;
+
+			//! Returns the hold-off time.
+			/*!
+			* Returns the hold-off time.
+			* \returns the time without motion that ends an interval in milliseconds.
+			*/
+			uint32_t get_hold_off_time() const noexcept;
+
+			//! Checks whether an interval is open.
+			/*!
+			* Checks whether an interval is open.
+			* \returns True if a motion was detected within the hold-off time, false otherwise.
+			*/
+			bool is_occupied() const noexcept;
+
+		protected:
+			/*!
+			* Callback for new sensor values.
+			* \param[in] value: The new sensor value.
+			*/
+			void on_value(const std::string& value);
+
+			/*!
+			* Handler that is executed if the hold-off time after the end of a motion expired.
+			* \param[in] hold_off_id: The end of motion the timer was created for.
+			*/
+			void on_hold_off_timer(uint64_t hold_off_id);
+
+			/*!
+			* Closes the open interval. The mutex has to be locked by the caller.
+			* \param[out] interval: The completed interval.
+			* \returns True if an interval was open, false otherwise.
+			*/
+			bool complete_interval(OccupancyInterval& interval);
+
+			/*!
+			* Delivers a completed interval to the subscribers. The mutex must not be locked by the caller.
+			* \param[in] interval: The completed interval.
+			*/
+			void publish(const OccupancyInterval& interval);
+
+			Sensor* m_sensor;
+			uint32_t m_hold_off_time_in_ms;
+
+			std::mutex m_subscription_mutex{};
+			CallbackGuard m_callback_guard{};
+			std::shared_ptr<CallbackHandle> m_sensor_handle{};
+
+			mutable std::mutex m_mutex{};
+			std::map<uint32_t, std::function<void(const OccupancyInterval&)>> m_callbacks{};
+			uint32_t m_next_handle = 1;
+
+			OccupancyInterval m_interval{};
+			bool m_is_open{};
+			bool m_motion{};
+			uint64_t m_hold_off_id{};
+			uint32_t m_hold_off_handle{};
+		};
+	}
+}
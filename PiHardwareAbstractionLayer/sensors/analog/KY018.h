@@ -1,10 +1,16 @@
 #pragma once
 
+#include <map>
+#include <memory>
 #include <mutex>
 #include <cmath>
 
+#include "KY018Definitions.h"
+#include "KY018LuxTable.h"
 #include "../../enums/SensorSetting.h"
 #include "../../interfaces/ISensor.h"
+#include "../i2c/ADS1115Constants.h"
+#include "../i2c/ADS1115SharedConverter.h"
 #include "../../utils/EnumConverter.h"
 #include "../../utils/Helper.h"
 
@@ -34,31 +40,38 @@ namespace hal
 
 					/*!
 					* Tells the hardware to perform a new measurement. The result will be sent with a callback function.
-					* If no callback is registered the measurement cannot be obtained.
+					* If no callback is registered the measurement cannot be obtained. LIGHT values are sent in lux.
 					* \param[in] type: The type of measurement that has to do be done.
 					* \throws HALException if triggering a light measurement fails.
 					* \throws HALException if the sensor type is invalid.
 					*/
 					void trigger_measurement(const SensorType type) override
 					{
-						for (auto i = m_callbacks[type].begin(); i != m_callbacks[type].end(); ++i)
+						if (type != SensorType::LIGHT)
 						{
-							if (type == SensorType::LIGHT)
-							{
-								try
-								{
-									(*i)->callback(std::to_string(get_resistance()));
-								}
-								catch (exception::HALException& ex)
-								{
-									throw exception::HALException("KY018", "trigger_measurement",
-																			std::string("Could not trigger light measurement:\n").append(ex.to_string()));
-								}
-							}
-							else
-							{
-								throw exception::HALException("KY018", "trigger_measurement", "Invalid sensor type.");
-							}
+							throw exception::HALException("KY018", "trigger_measurement", "Invalid sensor type.");
+						}
+
+						const auto callbacks = get_value_callbacks(type);
+						if (callbacks.empty())
+						{
+							return;
+						}
+
+						// One reading for all callbacks
+						std::string lux;
+						try
+						{
+							lux = std::to_string(get_lux());
+						}
+						catch (exception::HALException& ex)
+						{
+							throw exception::HALException("KY018", "trigger_measurement",
+																	std::string("Could not trigger light measurement:\n").append(ex.to_string()));
+						}
+						for (const auto& callback : callbacks)
+						{
+							callback->callback(lux);
 						}
 					}
 
@@ -71,47 +84,35 @@ namespace hal
 					* done easily on each sensor.
 					* If changing OVERSAMPLING setting: Configuration has to contain three uint8_t values in the order temperature, pressure and humidity.
 					* If changing FILTER setting: Configuration has to contain one uint8_t value.
+					* If changing GAIN_AMPLIFIER setting: "GAIN_AUTO" enables auto ranging, a fixed gain disables it.
 					* \throws HALException if configuring the devices AD-converter fails.
 					*/
 					void configure(const SensorSetting setting, const std::string& configuration) override
 					{
 						try
 						{
-							if (setting == SensorSetting::COMPARATOR_LATCHING)
-							{
-								m_converter->set_comparator_latching_setting(EnumConverter::string_to_alert_latching(configuration));
-							}
-							else if (setting == SensorSetting::COMPARATOR_MODE)
-							{
-								m_converter->set_comparator_mode_setting(EnumConverter::string_to_comparator_mode(configuration));
-							}
-							else if (setting == SensorSetting::COMPARATOR_QUEUE)
+							// Multiplexer and gain belong to this sensor and are sent with each conversion. All other
+							// settings are shared with the other sensors of the converter.
+							std::lock_guard<std::mutex> guard(m_mutex);
+							if (setting == SensorSetting::GAIN_AMPLIFIER)
 							{
-								m_converter->set_comparator_queue_setting(EnumConverter::string_to_alert_queueing(configuration));
-							}
-							else if (setting == SensorSetting::DATA_RATE)
-							{
-								m_converter->set_data_rate_setting(EnumConverter::string_to_data_rate(configuration));
-							}
-							else if (setting == SensorSetting::GAIN_AMPLIFIER)
-							{
-								m_converter->set_gain_amplifier_setting(EnumConverter::string_to_gain_amplifier(configuration));
-							}
-							else if (setting == SensorSetting::THRESHOLD)
-							{
-								if (Helper::string_contains_separator(configuration))
+								if (configuration == sensors::i2c::ads1115::AUTO_RANGE_GAIN_SETTING)
 								{
-									std::vector<uint16_t> thresholds;
-									Helper::string_to_array(thresholds, configuration);
-									if (thresholds.size() == 2)
-									{
-										m_converter->set_thresholds(thresholds[0], thresholds[1]);
-									}
+									enable_auto_range(true);
+								}
+								else
+								{
+									m_auto_range = false;
+									m_sensor_gain = EnumConverter::string_to_gain_amplifier(configuration);
 								}
 							}
 							else if (setting == SensorSetting::MULTIPLEXER)
 							{
-								m_converter->set_multiplexer_setting(EnumConverter::string_to_multiplexer(configuration));
+								m_sensor_multiplexer_mode = EnumConverter::string_to_multiplexer(configuration);
+							}
+							else
+							{
+								m_converter->configure(setting, configuration);
 							}
 						}
 						catch (exception::HALException& ex)
@@ -132,6 +133,17 @@ namespace hal
 					{
 						try
 						{
+							std::lock_guard<std::mutex> guard(m_mutex);
+							if (setting == SensorSetting::GAIN_AMPLIFIER)
+							{
+								return m_auto_range
+									? std::string(sensors::i2c::ads1115::AUTO_RANGE_GAIN_SETTING)
+									: EnumConverter::enum_to_string(m_sensor_gain);
+							}
+							if (setting == SensorSetting::MULTIPLEXER)
+							{
+								return EnumConverter::enum_to_string(m_sensor_multiplexer_mode);
+							}
 							return m_converter->get_configuration(setting);
 						}
 						catch (exception::HALException& ex)
@@ -153,7 +165,7 @@ namespace hal
 
 					//! Closes a device connection and performs some cleanup.
 					/*!
-					*  Closes a device connection and performs some cleanup.
+					*  Closes a device connection and performs some cleanup. The converter is only closed if no other sensor uses it.
 					* \throws HALException if the connection to the devices AD-converter could not be closed.
 					*/
 					void close() override
@@ -172,7 +184,8 @@ namespace hal
 					//! Opens a device connection and performs basic setup.
 					/*!
 					* Opens a device connection and performs basic setup.
-					* \param[in] converter: The analog-digital converter used to access the sensor.
+					* \param[in] converter: The analog-digital converter used to access the sensor. Shared with the other
+					* sensors that are connected to it, e.g. \sa { HAL::Sensors::I2C::ADS1115::SharedConverter::for_address }.
 					* \param[in] sensor_multiplexer_mode: The multiplexer setting of the sensor/ad-converter.
 					* \param[in] sensor_gain: The gain amplification setting of the sensor/ad-converter.
 					* \throws HALException if the converter is not yet initialized and could not be setup.
@@ -182,26 +195,33 @@ namespace hal
 						m_converter = converter;
 						m_sensor_multiplexer_mode = sensor_multiplexer_mode;
 						m_sensor_gain = sensor_gain;
+						m_predicted_gain = sensor_gain;
+						m_last_gain = sensor_gain;
 
-						// If the ADS1115 device is not yet fully setup, initialize it
-						uint8_t try_count = 0;
-						m_mutex.lock();
-						while (!m_converter->is_initialized())
+						// Attach to the converter. The first sensor opens the device.
+						for (uint8_t try_count = 1; ; try_count++)
 						{
-							m_converter->init();
-							try_count++;
-							if (try_count == 5)
+							try
 							{
-								m_mutex.unlock();
-								throw exception::HALException("KY018", "init", "Could not initialize analog digital converter (ADS1115).");
+								m_converter->init();
+								return;
+							}
+							catch (exception::HALException& ex)
+							{
+								if (try_count == 5)
+								{
+									throw exception::HALException("KY018", "init",
+																			std::string("Could not initialize analog digital converter (ADS1115):\n").append(
+																				ex.to_string()));
+								}
 							}
 						}
-						m_mutex.unlock();
 					}
 
 					//! Reads the current voltage value via the ad converter and returns it.
 					/*!
-					* Reads the current voltage value via the ad converter and returns it.
+					* Reads the current voltage value via the ad converter and returns it. The converter is
+					* switched to the channel of this sensor and the result is read after the conversion finished.
 					* \returns the current voltage of the sensor.
 					* \throws HALException if getting the current converted value fails.
 					*/
@@ -209,15 +229,11 @@ namespace hal
 					{
 						try
 						{
-							m_mutex.lock(); // Lock the shared ADS1115 pointer to avoid conflicts (we need to change multiplexer and gain)
-							m_converter->set_multiplexer_setting(m_sensor_multiplexer_mode); // Set multiplexer
-							m_converter->set_gain_amplifier_setting(m_sensor_gain); // Set gain amplifier
-							m_converter->start_single_conversion(); // Trigger new conversion
-							auto voltage = m_converter->get_converted_data(); // Receive the new voltage data from the ADS1115
-							m_mutex.unlock(); // Unlock ADS1115 pointer
+							std::lock_guard<std::mutex> guard(m_mutex);
+							const auto voltage = read_sample().voltage;
 
 							// Clamp voltage
-							return std::fmaxl(std::fminl(m_max_voltage, voltage), m_min_voltage);
+							return std::fmax(std::fmin(m_calibration.supply_voltage, voltage), m_min_voltage);
 						}
 						catch (exception::HALException& ex)
 						{
@@ -238,7 +254,8 @@ namespace hal
 						try
 						{
 							const auto voltage = get_voltage();
-							return 10000 * voltage / (m_max_voltage - voltage);
+							std::lock_guard<std::mutex> guard(m_mutex);
+							return LuxTable::compute_resistance(m_calibration, voltage);
 						}
 						catch (exception::HALException& ex)
 						{
@@ -248,14 +265,144 @@ namespace hal
 						}
 					}
 
+					//! Reads the current illuminance via the ad converter and returns it.
+					/*!
+					* Reads the current illuminance via the ad converter and returns it. The conversion result is
+					* mapped to lux with the lookup table of the gain that was used. The table is built by the first
+					* reading with a gain.
+					* \returns the current illuminance in lux.
+					* \throws HALException if getting the current converted value fails.
+					*/
+					double get_lux()
+					{
+						try
+						{
+							std::lock_guard<std::mutex> guard(m_mutex);
+							const auto sample = read_sample();
+							return get_lux_table(sample.gain_amplifier).lookup(sample.raw_value);
+						}
+						catch (exception::HALException& ex)
+						{
+							throw exception::HALException("KY018", "get_lux",
+																	std::string("Could not get a light value from the devices AD-converter:\n").append(
+																		ex.to_string()));
+						}
+					}
+
+					//! Replaces the calibration of the sensor.
+					/*!
+					* Replaces the calibration of the sensor. The lookup tables are built again with the next readings.
+					* \param[in] calibration: Divider resistor, supply voltage and curve of the photo resistor.
+					* \throws HALException if the calibration contains non positive values.
+					*/
+					void set_calibration(const Calibration& calibration)
+					{
+						if (calibration.divider_resistance <= 0 || calibration.supply_voltage <= 0 || calibration.r10 <= 0
+							|| calibration.gamma <= 0)
+						{
+							throw exception::HALException("KY018", "set_calibration", "Calibration values have to be positive.");
+						}
+
+						std::lock_guard<std::mutex> guard(m_mutex);
+						m_calibration = calibration;
+						m_lux_tables.clear();
+					}
+
+					//! Enables or disables choosing the gain of each conversion automatically.
+					/*!
+					* Enables or disables choosing the gain of each conversion automatically. If enabled the gain with the
+					* highest resolution that does not saturate is predicted from the previous sample. Only if the
+					* prediction fails the voltage is converted a second time.
+					* \param[in] enabled: True to choose the gain automatically, false to use the gain passed to <init>"()" or
+					* set with the GAIN_AMPLIFIER setting.
+					*/
+					void set_auto_range(const bool enabled) noexcept
+					{
+						std::lock_guard<std::mutex> guard(m_mutex);
+						enable_auto_range(enabled);
+					}
+
+					//! Returns the gain of the last conversion.
+					/*!
+					* Returns the gain of the last conversion.
+					* \returns the gain that was used for the last voltage or resistance value.
+					*/
+					Gain get_last_gain() const noexcept
+					{
+						std::lock_guard<std::mutex> guard(m_mutex);
+						return m_last_gain;
+					}
+
 				private:
+					//! Enables or disables choosing the gain automatically.
+					/*!
+					* Enables or disables choosing the gain automatically. The first prediction after enabling starts
+					* from the configured gain. The mutex has to be locked by the caller.
+					* \param[in] enabled: True to choose the gain automatically, false to use the configured gain.
+					*/
+					void enable_auto_range(const bool enabled) noexcept
+					{
+						if (enabled && !m_auto_range)
+						{
+							m_predicted_gain = m_sensor_gain;
+						}
+						m_auto_range = enabled;
+					}
+
+					//! Converts the channel of this sensor.
+					/*!
+					* Converts the channel of this sensor and predicts the gain of the next conversion if auto ranging
+					* is enabled. The mutex has to be locked by the caller.
+					* \returns the converted sample.
+					* \throws HALException if the conversion failed.
+					*/
+					auto read_sample()
+					{
+						// The converter serializes the conversions of all sensors that are connected to it
+						if (m_auto_range)
+						{
+							const auto sample = m_converter->read_auto_ranged_conversion(m_sensor_multiplexer_mode, m_predicted_gain);
+							m_predicted_gain = Converter::predict_gain(sample.voltage); // Gain of the next conversion
+							m_last_gain = sample.gain_amplifier;
+							return sample;
+						}
+
+						const auto sample = m_converter->read_sample(m_sensor_multiplexer_mode, m_sensor_gain);
+						m_last_gain = sample.gain_amplifier;
+						return sample;
+					}
+
+					//! Returns the lookup table of the given gain.
+					/*!
+					* Returns the lookup table of the given gain. Builds it if it does not exist yet. The mutex has to be locked by the caller.
+					* \param[in] gain: The gain of the conversion.
+					* \returns the lookup table.
+					*/
+					const LuxTable& get_lux_table(const Gain gain)
+					{
+						auto table = m_lux_tables.find(gain);
+						if (table == m_lux_tables.end())
+						{
+							table = m_lux_tables.emplace(gain, std::make_unique<LuxTable>(
+								m_calibration, Converter::get_full_scale_in_mv(gain) / 1000.0)).first;
+						}
+						return *table->second;
+					}
+
 					std::shared_ptr<Converter> m_converter;
 					Multiplexer m_sensor_multiplexer_mode;
 					Gain m_sensor_gain;
-					double m_max_voltage = 5.0;
+					Gain m_predicted_gain;
+					Gain m_last_gain;
+					bool m_auto_range = false;
+					Calibration m_calibration{};
+					std::map<Gain, std::unique_ptr<LuxTable>> m_lux_tables{};
 					double m_min_voltage = 0.0;
-					std::mutex m_mutex;
+					mutable std::mutex m_mutex;
 				};
+
+				//! KY-018 connected to one input of an ADS1115 that is shared with other analog sensors.
+				using KY018OnADS1115 = KY018<i2c::ads1115::SharedConverter, i2c::ads1115::Multiplexer, i2c::ads1115::GainAmplifier>;
 			}
 		}
 	}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+
+namespace hal
+{
+	namespace sensors
+	{
+		namespace analog
+		{
+			namespace ky018
+			{
+				// Calibration defaults (KY-018 module with a GL5528 photo resistor)
+				static constexpr double DEFAULT_DIVIDER_RESISTANCE_IN_OHM = 10000.0;
+				// Fixed resistor between supply and signal pin. The photo resistor connects the signal pin to ground
+				static constexpr double DEFAULT_SUPPLY_VOLTAGE = 5.0;
+				static constexpr double DEFAULT_R10_IN_OHM = 15000.0;
+				// Resistance of the photo resistor at 10 lux
+				static constexpr double DEFAULT_GAMMA = 0.7;
+				// Slope of the resistance over the illuminance in log-log scale
+
+				// Lookup table
+				static constexpr uint32_t LUX_TABLE_SIZE = 32768;
+				// One entry per non negative code of a 16 bit conversion result
+				static constexpr double MAX_LUX_VALUE = 100000.0;
+				// Direct sunlight. Used for voltages at or below 0 V where the model has no finite value
+			}
+		}
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "KY018Constants.h"
+
+namespace hal
+{
+	namespace sensors
+	{
+		namespace analog
+		{
+			namespace ky018
+			{
+				struct Calibration
+				{
+					double divider_resistance = DEFAULT_DIVIDER_RESISTANCE_IN_OHM; // Fixed resistor of the voltage divider in ohm
+					double supply_voltage = DEFAULT_SUPPLY_VOLTAGE; // Voltage at the supply pin of the module
+					double r10 = DEFAULT_R10_IN_OHM; // Resistance of the photo resistor at 10 lux in ohm
+					double gamma = DEFAULT_GAMMA; // log10(R10 / R100) of the photo resistor
+				};
+			}
+		}
+	}
+}
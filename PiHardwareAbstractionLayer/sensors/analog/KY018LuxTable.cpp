@@ -0,0 +1,45 @@
+#include "KY018LuxTable.h"
+
+#include "../../exceptions/HALException.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+hal::sensors::analog::ky018::LuxTable::LuxTable(const Calibration& calibration, const double full_scale_voltage)
+{
+	if (calibration.divider_resistance <= 0 || calibration.supply_voltage <= 0 || calibration.r10 <= 0
+		|| calibration.gamma <= 0 || full_scale_voltage <= 0)
+	{
+		throw exception::HALException("LuxTable", "LuxTable", "Calibration values and full scale voltage have to be positive.");
+	}
+
+	m_lux.resize(LUX_TABLE_SIZE);
+	const auto volts_per_code = full_scale_voltage / LUX_TABLE_SIZE;
+	for (uint32_t code = 0; code < LUX_TABLE_SIZE; code++)
+	{
+		m_lux[code] = static_cast<float>(compute_lux(calibration, code * volts_per_code));
+	}
+}
+
+double hal::sensors::analog::ky018::LuxTable::compute_resistance(const Calibration& calibration, const double voltage) noexcept
+{
+	if (voltage >= calibration.supply_voltage)
+	{
+		return std::numeric_limits<double>::infinity();
+	}
+	return calibration.divider_resistance * voltage / (calibration.supply_voltage - voltage);
+}
+
+double hal::sensors::analog::ky018::LuxTable::compute_lux(const Calibration& calibration, const double voltage) noexcept
+{
+	const auto resistance = compute_resistance(calibration, voltage);
+	if (resistance <= 0)
+	{
+		return MAX_LUX_VALUE;
+	}
+
+	// R = R10 * (lux / 10)^-gamma
+	const auto lux = 10.0 * std::pow(calibration.r10 / resistance, 1.0 / calibration.gamma);
+	return std::min(lux, MAX_LUX_VALUE);
+}
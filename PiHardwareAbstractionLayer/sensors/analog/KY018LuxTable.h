@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "KY018Definitions.h"
+
+namespace hal
+{
+	namespace sensors
+	{
+		namespace analog
+		{
+			namespace ky018
+			{
+				//! Lookup table that maps conversion results of a KY-018 directly to lux.
+				/*!
+				* This class evaluates the calibration model (voltage divider and gamma curve of the photo resistor) once
+				* for each non negative code of a 16 bit conversion result with the given full scale range. Afterwards a
+				* reading only needs one table lookup instead of a division and a pow() per sample. A table takes 128 KiB.
+				*/
+				class LuxTable
+				{
+				public:
+					LuxTable() = delete;
+
+					//! Builds the table.
+					/*!
+					* Builds the table.
+					* \param[in] calibration: The calibration of the sensor.
+					* \param[in] full_scale_voltage: The voltage that corresponds to the largest conversion result (gain of the converter).
+					* \throws HALException if the calibration contains non positive values.
+					*/
+					LuxTable(const Calibration& calibration, double full_scale_voltage);
+
+					//! Returns the illuminance of a conversion result.
+					/*!
+					* Returns the illuminance of a conversion result.
+					* \param[in] raw_value: The value of the conversion register. Negative values are treated as 0.
+					* \returns the illuminance in lux.
+					*/
+					double lookup(const int16_t raw_value) const noexcept
+					{
+						return m_lux[raw_value < 0 ? 0 : static_cast<uint16_t>(raw_value)];
+					}
+
+					//! Computes the resistance of the photo resistor.
+					/*!
+					* Computes the resistance of the photo resistor from the voltage at the signal pin.
+					* \param[in] calibration: The calibration of the sensor.
+					* \param[in] voltage: The voltage at the signal pin.
+					* \returns the resistance in ohm. Infinity if the voltage reached the supply voltage.
+					*/
+					static double compute_resistance(const Calibration& calibration, double voltage) noexcept;
+
+					//! Computes the illuminance from the voltage at the signal pin.
+					/*!
+					* Computes the illuminance from the voltage at the signal pin. Used to build the table.
+					* \param[in] calibration: The calibration of the sensor.
+					* \param[in] voltage: The voltage at the signal pin.
+					* \returns the illuminance in lux, limited to MAX_LUX_VALUE.
+					*/
+					static double compute_lux(const Calibration& calibration, double voltage) noexcept;
+
+				protected:
+					std::vector<float> m_lux{};
+				};
+			}
+		}
+	}
+}
@@ -1,60 +1,305 @@
 #include "AM312.h"
-#include <wiringPi.h>
 #include "../../exceptions/HALException.h"
+#include "../../structs/GPIOEvent.h"
+#include "../../utils/EventScheduler.h"
+#include "../../utils/GPIOFactory.h"
+#include "../../utils/Helper.h"
+
+#include <iostream>
+
+hal::sensors::digital::am312::AM312::~AM312()
+{
+	try
+	{
+		close();
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "AM312 [~AM312] Could not close the sensor:\n" << ex.to_string() << std::endl;
+	}
+}
 
 void hal::sensors::digital::am312::AM312::trigger_measurement(const SensorType type)
 {
-	for (auto i = m_callbacks[type].begin(); i != m_callbacks[type].end(); ++i)
+	if (type != SensorType::MOTION)
 	{
-		switch (type)
-		{
-		case SensorType::MOTION:
-			try
-			{
-				(*i)->callback(std::to_string(digitalRead(m_pin)));
-			}
-			catch (exception::HALException& ex)
-			{
-				throw exception::HALException("AM312", "trigger_measurement",
-														std::string("Could not trigger motion measurement:\n").append(ex.to_string()));
-			}
-			break;
-		default:
-			throw exception::HALException("AM312", "trigger_measurement", "Invalid sensor type.");
-		}
+		throw exception::HALException("AM312", "trigger_measurement", "Invalid sensor type.");
 	}
+	// Intentionally empty since state changes are published by the edge handlers.
 }
 
 void hal::sensors::digital::am312::AM312::configure(const SensorSetting setting, const std::string& configuration)
 {
-	// Intentionally empty since this sensor cannot be configured.
+	if (setting != SensorSetting::DEBOUNCE_TIME && setting != SensorSetting::RETRIGGER_TIME)
+	{
+		throw exception::HALException("AM312", "configure", "The given setting type is not supported by this device.");
+	}
+
+	int time_in_ms;
+	try
+	{
+		time_in_ms = utils::Helper::string_to_int(configuration);
+	}
+	catch (std::exception&)
+	{
+		throw exception::HALException("AM312", "configure",
+												std::string("Invalid time (").append(configuration).append(")."));
+	}
+	if (time_in_ms < 0 || static_cast<uint32_t>(time_in_ms) > MAX_EDGE_TIME_IN_MS)
+	{
+		throw exception::HALException("AM312", "configure",
+												std::string("The time has to be between 0 and ").append(std::to_string(MAX_EDGE_TIME_IN_MS)).append(" ms."));
+	}
+
+	// Applies to the next edge. A pending retrigger timer keeps its time.
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (setting == SensorSetting::DEBOUNCE_TIME)
+	{
+		m_debounce_time_in_ms = static_cast<uint32_t>(time_in_ms);
+	}
+	else
+	{
+		m_retrigger_time_in_ms = static_cast<uint32_t>(time_in_ms);
+	}
 }
 
-std::string hal::sensors::digital::am312::AM312::get_configuration(SensorSetting setting)
+std::string hal::sensors::digital::am312::AM312::get_configuration(const SensorSetting setting)
 {
-	// Intentionally empty since this sensor cannot be configured.
-	return "";
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (setting == SensorSetting::DEBOUNCE_TIME)
+	{
+		return std::to_string(m_debounce_time_in_ms);
+	}
+	if (setting == SensorSetting::RETRIGGER_TIME)
+	{
+		return std::to_string(m_retrigger_time_in_ms);
+	}
+	throw exception::HALException("AM312", "get_configuration", "The given setting type is not supported by this device.");
 }
 
 std::vector<hal::SensorSetting> hal::sensors::digital::am312::AM312::available_configurations() noexcept
 {
-	// Intentionally empty since this sensor cannot be configured.
-	return std::vector<SensorSetting>();
+	return { SensorSetting::DEBOUNCE_TIME, SensorSetting::RETRIGGER_TIME };
 }
 
 void hal::sensors::digital::am312::AM312::close()
 {
-	// Intentionally empty since this sensor cannot be closed. Just stop listening to it.
+	// Handlers that wait for the lock return as soon as they see the flag.
+	m_is_running = false;
+
+	uint32_t watch_handle;
+	uint32_t debounce_handle;
+	uint32_t retrigger_handle;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		watch_handle = m_watch_handle;
+		debounce_handle = m_debounce_handle;
+		retrigger_handle = m_retrigger_handle;
+		m_watch_handle = 0;
+		m_debounce_handle = 0;
+		m_retrigger_handle = 0;
+		m_release_pending = false;
+	}
+
+	for (const auto handle : { watch_handle, debounce_handle, retrigger_handle })
+	{
+		if (handle != 0)
+		{
+			utils::EventScheduler::instance().remove(handle);
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_line != nullptr)
+	{
+		m_line->close();
+	}
 }
 
 void hal::sensors::digital::am312::AM312::init(const uint8_t pin)
 {
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_is_running)
+	{
+		return;
+	}
+
 	m_pin = pin;
+	try
+	{
+		if (m_line == nullptr)
+		{
+			m_line = utils::GPIOFactory::open_line(m_pin, false, GPIOEdge::BOTH, "am312");
+		}
+
+		m_motion = m_line->get_value() != 0;
+		m_release_pending = false;
+		m_last_edge_ns = 0;
+		m_is_running = true;
+		m_watch_handle = utils::EventScheduler::instance().watch_fd(m_line->get_event_fd(), [this]() { on_edge(); });
+	}
+	catch (exception::HALException& ex)
+	{
+		m_is_running = false;
+		throw exception::HALException("AM312", "init", std::string("Could not watch the output pin:\n").append(ex.to_string()));
+	}
+}
+
+void hal::sensors::digital::am312::AM312::set_line(const std::shared_ptr<interfaces::IGPIOLine>& line) noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_line = line;
+}
+
+void hal::sensors::digital::am312::AM312::set_event_callback(const std::function<void(const MotionEvent&)>& callback) noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_event_callback = callback;
+}
+
+bool hal::sensors::digital::am312::AM312::is_motion_detected() const noexcept
+{
+	return m_motion;
+}
+
+void hal::sensors::digital::am312::AM312::on_edge()
+{
+	// Always consume the event, otherwise the scheduler executes this handler again.
+	GPIOEvent event{};
+	const auto has_event = m_line->read_event(event);
+
+	MotionEvent motion_event{};
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (!has_event || !m_is_running || (event.edge != GPIOEdge::RISING && event.edge != GPIOEdge::FALLING))
+		{
+			return;
+		}
+
+		const auto debounce_ns = m_debounce_time_in_ms * NANOSECONDS_PER_MILLISECOND;
+		if (m_last_edge_ns != 0 && event.timestamp_ns >= m_last_edge_ns && event.timestamp_ns - m_last_edge_ns < debounce_ns)
+		{
+			// Bounce: The final level is checked as soon as the pin settled.
+			m_bounce_timestamp_ns = event.timestamp_ns;
+			if (m_debounce_handle == 0)
+			{
+				m_debounce_handle = utils::EventScheduler::instance().add_timer(m_debounce_time_in_ms, false, [this]() { on_debounce_timer(); });
+			}
+			return;
+		}
+
+		m_last_edge_ns = event.timestamp_ns;
+		if (!update_state(event.edge == GPIOEdge::RISING, event.timestamp_ns, motion_event))
+		{
+			return;
+		}
+	}
+	publish(motion_event);
+}
+
+void hal::sensors::digital::am312::AM312::on_debounce_timer()
+{
+	MotionEvent motion_event{};
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_debounce_handle = 0; // One-shot timer, removed by the scheduler after this callback
+		if (!m_is_running)
+		{
+			return;
+		}
+
+		bool high;
+		try
+		{
+			high = m_line->get_value() != 0;
+		}
+		catch (exception::HALException& ex)
+		{
+			throw exception::HALException("AM312", "on_debounce_timer",
+													std::string("Could not read the output pin:\n").append(ex.to_string()));
+		}
+
+		if (!update_state(high, m_bounce_timestamp_ns, motion_event))
+		{
+			return;
+		}
+	}
+	publish(motion_event);
+}
+
+void hal::sensors::digital::am312::AM312::on_retrigger_timer()
+{
+	MotionEvent motion_event{};
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_retrigger_handle = 0; // One-shot timer, removed by the scheduler after this callback
+		if (!m_is_running || !m_release_pending)
+		{
+			return;
+		}
+
+		m_release_pending = false;
+		m_motion = false;
+		motion_event = MotionEvent{false, m_release_timestamp_ns};
+	}
+	publish(motion_event);
+}
 
-	if (wiringPiSetup() != OK)
+bool hal::sensors::digital::am312::AM312::update_state(const bool high, const uint64_t timestamp_ns, MotionEvent& event)
+{
+	if (high)
 	{
-		throw exception::HALException("AM312", "init", "Could not initialize wiringPi.");
+		if (m_release_pending)
+		{
+			// Retriggered: The motion continues. Removing the timer on the scheduler thread does not block.
+			m_release_pending = false;
+			utils::EventScheduler::instance().remove(m_retrigger_handle);
+			m_retrigger_handle = 0;
+			return false;
+		}
+		if (m_motion)
+		{
+			return false;
+		}
+
+		m_motion = true;
+		event = MotionEvent{true, timestamp_ns};
+		return true;
 	}
 
-	pinMode(m_pin, INPUT);
+	if (!m_motion || m_release_pending)
+	{
+		return false;
+	}
+	if (m_retrigger_time_in_ms == 0)
+	{
+		m_motion = false;
+		event = MotionEvent{false, timestamp_ns};
+		return true;
+	}
+
+	m_release_pending = true;
+	m_release_timestamp_ns = timestamp_ns;
+	m_retrigger_handle = utils::EventScheduler::instance().add_timer(m_retrigger_time_in_ms, false, [this]() { on_retrigger_timer(); });
+	return false;
+}
+
+void hal::sensors::digital::am312::AM312::publish(const MotionEvent& event)
+{
+	std::function<void(const MotionEvent&)> event_callback;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		event_callback = m_event_callback;
+	}
+
+	if (event_callback)
+	{
+		event_callback(event);
+	}
+
+	const auto value = std::to_string(event.motion ? 1 : 0);
+	for (auto& callback : get_value_callbacks(SensorType::MOTION))
+	{
+		callback->callback(value);
+	}
 }
@@ -1,8 +1,15 @@
 #pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "AM312Constants.h"
+#include "AM312Definitions.h"
 #include "../../enums/SensorSetting.h"
+#include "../../interfaces/IGPIOLine.h"
 #include "../../interfaces/ISensor.h"
 
 namespace hal
@@ -13,13 +20,14 @@ namespace hal
 		{
 			namespace am312
 			{
-				static constexpr int8_t OK = 0;
-				static constexpr int8_t COMMUNICATION_FAIL = -4;
-
 				//! Class that communicates via GPIO with the AM312 sensor to detect motions.
 				/*!
-				* Class that communicates via GPIO with the AM312 sensor to detect motions. If a motion is detected,
-				* a callback function is called.
+				* Class that communicates via GPIO with the AM312 sensor to detect motions. The output pin of the sensor
+				* is watched for rising and falling edges on the \sa { HAL::Utils::EventScheduler } thread, so no motion
+				* is missed between two measurements. Edges within the debounce time of the last accepted edge are ignored
+				* and the line level is checked again afterwards. The end of a motion is reported after the output stayed
+				* LOW for the retrigger time, a new motion within this time continues the current one. The callbacks
+				* are only executed if the motion state changed.
 				*/
 				class AM312 final : public interfaces::ISensor
 				{
@@ -31,10 +39,14 @@ namespace hal
 					AM312() = default;
 
 					/*!
-					* Tells the hardware to perform a new measurement. The result will be sent with a callback function.
-					* If no callback is registered the measurement cannot be obtained.
+					* Destructor. Stops watching the output pin.
+					*/
+					~AM312();
+
+					/*!
+					* Does nothing for MOTION measurements since the state changes are reported as soon as the output pin
+					* changes. The callbacks receive "1" if a motion started and "0" if it ended.
 					* \param[in] type: The type of measurement that has to do be done.
-					* \throws HALException if triggering a motion measurement fails.
 					* \throws HALException if the sensor type is invalid.
 					*/
 					void trigger_measurement(SensorType type) override;
@@ -46,17 +58,19 @@ namespace hal
 					* \param[in] configuration: The new value to set for the desired setting. The value has to be converted
 					* to string because each sensor needs its own data format and this way the specific conversion can be
 					* done easily on each sensor.
-					* If changing OVERSAMPLING setting: Configuration has to contain three uint8_t values in the order temperature, pressure and humidity.
-					* If changing FILTER setting: Configuration has to contain one uint8_t value.
+					* If changing DEBOUNCE_TIME setting: Configuration has to contain the debounce time in milliseconds.
+					* If changing RETRIGGER_TIME setting: Configuration has to contain the retrigger time in milliseconds.
+					* \throws HALException if the setting is not supported or the configuration is invalid.
 					*/
 					void configure(SensorSetting setting, const std::string& configuration) override;
 
 					/*!
 					* Returns one specific setting of a sensor.
-					* \param[in] setting: The type of setting to return. For this sensor only OVERSAMPLING and FILTER settings can be returned.
+					* \param[in] setting: The type of setting to return. For this sensor only DEBOUNCE_TIME and RETRIGGER_TIME settings can be returned.
 					* \returns the current value of the given setting as string.
+					* \throws HALException if the setting is not supported.
 					*/
-					std::string get_configuration(SensorSetting setting = SensorSetting::BASELINE) override;
+					std::string get_configuration(SensorSetting setting = SensorSetting::DEBOUNCE_TIME) override;
 
 					/*!
 					* Returns a vector of \sa { HAL::Enums::SensorSetting } that are supported by this sensor.
@@ -66,22 +80,97 @@ namespace hal
 
 					//! Closes a device connection and performs some cleanup.
 					/*!
-					*  Closes a device connection and performs some cleanup.
-					* \throws HALException if the device connection could not be closed.
+					* Stops watching the output pin and releases it. Blocks until a running handler returned.
 					*/
 					void close() override;
 
 					//! Opens a device connection and performs basic setup.
 					/*!
-					* Tries to open the device at the given GPIO pin in INPUT mode.
-					* It also starts the internal sensor loop that continuously reads the sensor data.
+					* Requests the given GPIO pin with edge detection on both edges and starts watching it.
+					* The current level of the pin becomes the initial motion state without executing the callbacks.
 					* \param[in] pin: The GPIO pin to use. Use WiringPi simplified pin numbering (http://wiringpi.com/pins/).
-					* \throws HALException if WiringPi could not be initialized.
+					* \throws HALException if the pin could not be requested or watched.
 					*/
 					void init(uint8_t pin);
 
+					//! Replaces the line that is used to detect the edges of the output pin.
+					/*!
+					* Replaces the line that is used to detect the edges of the output pin. By default the pin
+					* that was passed to <init>"()" is requested via \sa { HAL::Utils::GPIOFactory }. Any other
+					* \sa { HAL::Interfaces::IGPIOLine } (e.g. a \sa { HAL::Utils::FakeGPIOLine } in tests) can be used instead.
+					* Has to be called before <init>"()".
+					* \param[in] line: The line to watch. Has to be requested with detection of both edges.
+					*/
+					void set_line(const std::shared_ptr<interfaces::IGPIOLine>& line) noexcept;
+
+					//! Sets a function that receives every change of the motion state.
+					/*!
+					* Sets a function that receives every change of the motion state together with the kernel timestamp
+					* of the edge that caused it. The function is executed on the \sa { HAL::Utils::EventScheduler } thread
+					* before the value callbacks.
+					* \param[in] callback: The function to execute or nullptr to remove it.
+					*/
+					void set_event_callback(const std::function<void(const MotionEvent&)>& callback) noexcept;
+
+					//! Returns the current motion state.
+					/*!
+					* Returns the current (debounced) motion state.
+					* \returns True if a motion is detected, false otherwise.
+					*/
+					bool is_motion_detected() const noexcept;
+
 				private:
+					//! Handler that is executed if the output pin reported an edge.
+					/*!
+					* Handler that is executed if the output pin reported an edge. Consumes the edge event and updates the state.
+					*/
+					void on_edge();
+
+					//! Handler that is executed if the debounce time after a bounce expired.
+					/*!
+					* Handler that is executed if the debounce time after a bounce expired. Reads the level of the
+					* output pin and updates the state if a change was hidden by the bounce.
+					*/
+					void on_debounce_timer();
+
+					//! Handler that is executed if the output pin stayed LOW for the retrigger time.
+					/*!
+					* Handler that is executed if the output pin stayed LOW for the retrigger time. Reports the end of the motion.
+					*/
+					void on_retrigger_timer();
+
+					//! Updates the state with a new level of the output pin.
+					/*!
+					* Updates the state with a new level of the output pin. The mutex has to be locked by the caller.
+					* \param[in] high: True if the output pin is HIGH, false otherwise.
+					* \param[in] timestamp_ns: The timestamp of the level change.
+					* \param[out] event: The state change to publish.
+					* \returns True if the state changed and the event has to be published, false otherwise.
+					*/
+					bool update_state(bool high, uint64_t timestamp_ns, MotionEvent& event);
+
+					//! Executes the event callback and the value callbacks.
+					/*!
+					* Executes the event callback and the value callbacks. The mutex must not be locked by the caller.
+					* \param[in] event: The state change to publish.
+					*/
+					void publish(const MotionEvent& event);
+
 					uint8_t m_pin{};
+					std::shared_ptr<interfaces::IGPIOLine> m_line{};
+					std::function<void(const MotionEvent&)> m_event_callback{};
+					mutable std::mutex m_mutex{};
+					std::atomic_bool m_is_running = ATOMIC_VAR_INIT(false);
+					std::atomic_bool m_motion = ATOMIC_VAR_INIT(false);
+					bool m_release_pending{};
+					uint64_t m_release_timestamp_ns{};
+					uint64_t m_last_edge_ns{};
+					uint64_t m_bounce_timestamp_ns{};
+					uint32_t m_debounce_time_in_ms = DEFAULT_DEBOUNCE_TIME_IN_MS;
+					uint32_t m_retrigger_time_in_ms = DEFAULT_RETRIGGER_TIME_IN_MS;
+					uint32_t m_watch_handle{};
+					uint32_t m_debounce_handle{};
+					uint32_t m_retrigger_handle{};
 				};
 			}
 		}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+namespace hal
+{
+	namespace sensors
+	{
+		namespace digital
+		{
+			namespace am312
+			{
+				// Return codes
+				static constexpr int8_t OK = 0;
+				static constexpr int8_t COMMUNICATION_FAIL = -4;
+
+				// Edge handling
+				static constexpr uint32_t DEFAULT_DEBOUNCE_TIME_IN_MS = 20;
+				// Edges that follow an accepted edge within this time are treated as bounces
+				static constexpr uint32_t DEFAULT_RETRIGGER_TIME_IN_MS = 0;
+				// Time the output has to stay LOW until the end of a motion is reported
+				static constexpr uint32_t MAX_EDGE_TIME_IN_MS = 60000;
+				// Upper limit of the debounce and retrigger time
+				static constexpr uint64_t NANOSECONDS_PER_MILLISECOND = 1000000;
+			}
+		}
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+
+namespace hal
+{
+	namespace sensors
+	{
+		namespace digital
+		{
+			namespace am312
+			{
+				struct MotionEvent
+				{
+					bool motion; // True if a motion started, false if it ended
+					uint64_t timestamp_ns; // Kernel timestamp of the edge that caused the state change
+				};
+			}
+		}
+	}
+}
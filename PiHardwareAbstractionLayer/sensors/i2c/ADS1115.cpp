@@ -1,11 +1,18 @@
 #include "ADS1115.h"
 #include "../../exceptions/I2CException.h"
 #include "../../utils/BitManipulation.h"
+#include "../../utils/EventScheduler.h"
 #include "../../utils/Helper.h"
 #include "../../utils/I2CManager.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <cmath>
 #include <cstdio>
+#include <iostream>
+#include <thread>
+#include <poll.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <cstring>
@@ -15,25 +22,39 @@
 
 void hal::sensors::i2c::ads1115::ADS1115::trigger_measurement(const SensorType type)
 {
-	for (auto i = m_callbacks[type].begin(); i != m_callbacks[type].end(); ++i)
+	measure(type).or_raise();
+}
+
+hal::utils::Result<void> hal::sensors::i2c::ads1115::ADS1115::measure(const SensorType type)
+{
+	if (m_event_mode)
 	{
-		if (type == SensorType::CONVERTER)
-		{
-			try
-			{
-				(*i)->callback(std::to_string(get_converted_data()));
-			}
-			catch (exception::HALException& ex)
-			{
-				throw exception::HALException("ADS1115", "trigger_measurement",
-														std::string("Could not trigger conversion:\n").append(ex.to_string()));
-			}
-		}
-		else
-		{
-			throw exception::HALException("ADS1115", "trigger_measurement", "Invalid sensor type.");
-		}
+		return {}; // Values are delivered by the ALERT/RDY handler
+	}
+	if (type != SensorType::CONVERTER)
+	{
+		return utils::Error{ErrorCode::INVALID_ARGUMENT, 0, m_dev_id, 0, "ADS1115", "trigger_measurement"};
 	}
+
+	const auto callbacks = get_value_callbacks(type);
+	if (callbacks.empty())
+	{
+		return {};
+	}
+
+	const auto voltage = read_converted_data();
+	if (!voltage)
+	{
+		return voltage.error().with_context("ADS1115", "trigger_measurement", m_dev_id);
+	}
+
+	const auto value = std::to_string(voltage.value());
+	TraceScope trace("ads1115.dispatch", "driver", m_dev_id);
+	for (const auto& callback : callbacks)
+	{
+		callback->callback(value);
+	}
+	return {};
 }
 
 void hal::sensors::i2c::ads1115::ADS1115::configure(const SensorSetting setting, const std::string& configuration)
@@ -248,6 +269,7 @@ std::vector<hal::SensorSetting> hal::sensors::i2c::ads1115::ADS1115::available_c
 
 void hal::sensors::i2c::ads1115::ADS1115::close()
 {
+	stop_event_mode();
 	try
 	{
 		I2CManager::close_device(m_file_handle);
@@ -271,6 +293,8 @@ void hal::sensors::i2c::ads1115::ADS1115::init(const uint8_t device_reg)
 		throw exception::HALException("ADS1115", "init",
 												std::string("Could not establish connection with device:\n").append(ex.to_string()));
 	}
+	m_conversion_wait = &MetricsRegistry::instance().histogram("ads1115.conversion_wait_ns", m_dev_id);
+	m_conversion_timeouts = &MetricsRegistry::instance().counter("ads1115.conversion_timeouts", m_dev_id);
 }
 
 bool hal::sensors::i2c::ads1115::ADS1115::is_initialized() const noexcept
@@ -281,6 +305,8 @@ bool hal::sensors::i2c::ads1115::ADS1115::is_initialized() const noexcept
 void hal::sensors::i2c::ads1115::ADS1115::soft_reset()
 {
 	uint8_t data[1] = {RESET_CMD};
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	m_registers.invalidate();
 	if (write_operation(m_file_handle, RESET_REG, data, 1) != OK)
 	{
 		throw exception::I2CException("ADS1115", "soft_reset", m_dev_id, RESET_REG, "Could not write soft reset command to device.");
@@ -297,12 +323,12 @@ int8_t hal::sensors::i2c::ads1115::ADS1115::start_single_conversion()
 												"Could not read first byte of current device settings.");
 	}
 
-	if (static_cast<uint8_t>(BitManipulation::is_bit_set(current_settings[0], 0)) == static_cast<uint8_t>(OperationMode::CONTINUOUS))
+	if (OperationModeField::decode<OperationMode>(current_settings[OperationModeField::BYTE]) == OperationMode::CONTINUOUS)
 	{
 		return WARNING;
 	}
 
-	BitManipulation::set_bit(current_settings[0], 7, true); // Set OS bit (7th) to true
+	OperationalStatusFlag::set(current_settings[OperationalStatusFlag::BYTE], true); // Starts the conversion
 	if (write_operation(m_file_handle, CONFIG_REG, current_settings) != OK)
 	{
 		throw exception::I2CException("ADS1115", "start_single_conversion", m_dev_id, CONFIG_REG,
@@ -322,15 +348,7 @@ bool hal::sensors::i2c::ads1115::ADS1115::is_converting()
 												"Could not read first byte of current device settings.");
 	}
 
-	try
-	{
-		return BitManipulation::is_bit_set(current_settings[0], 7);
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("ADS1115", "is_converting",
-												std::string("Could not check whether a certain bit of a byte is set:\n").append(ex.to_string()));
-	}
+	return !OperationalStatusFlag::is_set(current_settings[OperationalStatusFlag::BYTE]); // OS bit is 0 while a conversion is performed
 }
 
 hal::sensors::i2c::ads1115::Multiplexer hal::sensors::i2c::ads1115::ADS1115::get_multiplexer_setting()
@@ -447,252 +465,748 @@ hal::sensors::i2c::ads1115::Configuration hal::sensors::i2c::ads1115::ADS1115::g
 
 void hal::sensors::i2c::ads1115::ADS1115::set_multiplexer_setting(Multiplexer new_multiplexer_setting)
 {
-	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
-	// Reading only the first byte is enough since all necessary information is located there.
-	if (read_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	try
 	{
-		throw exception::I2CException("ADS1115", "set_multiplexer_setting", m_dev_id, CONFIG_REG, "Could not read current device settings.");
+		load_settings();
+		m_registers.set<MultiplexerField>(new_multiplexer_setting);
+		m_registers.apply(m_file_handle);
 	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::I2CException("ADS1115", "set_multiplexer_setting", m_dev_id, CONFIG_REG,
+												std::string("Could not write new device settings:\n").append(ex.to_string()));
+	}
+}
 
+void hal::sensors::i2c::ads1115::ADS1115::set_gain_amplifier_setting(GainAmplifier new_gain_amplifier_setting)
+{
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
 	try
 	{
-		BitManipulation::set_bits(raw_settings[0], static_cast<uint8_t>(new_multiplexer_setting), MULTIPLEXER_MASK);
+		load_settings();
+		m_registers.set<GainAmplifierField>(new_gain_amplifier_setting);
+		m_registers.apply(m_file_handle);
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::HALException("ADS1115", "set_multiplexer_setting",
-												std::string("Could not set multiplexer bits in config byte:\n").append(ex.to_string()));
+		throw exception::I2CException("ADS1115", "set_gain_amplifier_setting", m_dev_id, CONFIG_REG,
+												std::string("Could not write new device settings:\n").append(ex.to_string()));
 	}
+}
 
-	if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+void hal::sensors::i2c::ads1115::ADS1115::set_operation_mode_setting(OperationMode new_operation_mode_setting)
+{
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	try
 	{
-		throw exception::I2CException("ADS1115", "set_multiplexer_setting", m_dev_id, CONFIG_REG, "Could not write new device settings.");
+		load_settings();
+		m_registers.set<OperationModeField>(new_operation_mode_setting);
+		m_registers.apply(m_file_handle);
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::I2CException("ADS1115", "set_operation_mode_setting", m_dev_id, CONFIG_REG,
+												std::string("Could not write new device settings:\n").append(ex.to_string()));
 	}
 }
 
-void hal::sensors::i2c::ads1115::ADS1115::set_gain_amplifier_setting(GainAmplifier new_gain_amplifier_setting)
+void hal::sensors::i2c::ads1115::ADS1115::set_data_rate_setting(DataRate new_data_rate_setting)
 {
-	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
-	// Reading only the first byte is enough since all necessary information is located there.
-	if (read_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	try
 	{
-		throw exception::I2CException("ADS1115", "set_gain_amplifier_setting", m_dev_id, CONFIG_REG,
-												"Could not read current device settings.");
+		load_settings();
+		m_registers.set<DataRateField>(new_data_rate_setting);
+		m_registers.apply(m_file_handle);
 	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::I2CException("ADS1115", "set_data_rate_setting", m_dev_id, CONFIG_REG,
+												std::string("Could not write new device settings:\n").append(ex.to_string()));
+	}
+}
 
+void hal::sensors::i2c::ads1115::ADS1115::set_comparator_mode_setting(ComparatorMode new_comparator_mode_setting)
+{
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
 	try
 	{
-		BitManipulation::set_bits(raw_settings[0], static_cast<uint8_t>(new_gain_amplifier_setting), GAIN_AMPLIFIER_MASK);
+		load_settings();
+		m_registers.set<ComparatorModeField>(new_comparator_mode_setting);
+		m_registers.apply(m_file_handle);
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::HALException("ADS1115", "set_gain_amplifier_setting",
-												std::string("Could not set gain amplifier bits in config byte:\n").append(ex.to_string()));
+		throw exception::I2CException("ADS1115", "set_comparator_mode_setting", m_dev_id, CONFIG_REG,
+												std::string("Could not write new device settings:\n").append(ex.to_string()));
 	}
+}
 
-	if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+void hal::sensors::i2c::ads1115::ADS1115::set_comparator_polarity_setting(AlertPolarity new_comparator_polarity_setting)
+{
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	try
 	{
-		throw exception::I2CException("ADS1115", "set_gain_amplifier_setting", m_dev_id, CONFIG_REG, "Could not write new device settings.");
+		load_settings();
+		m_registers.set<ComparatorPolarityField>(new_comparator_polarity_setting);
+		m_registers.apply(m_file_handle);
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::I2CException("ADS1115", "set_comparator_polarity_setting", m_dev_id, CONFIG_REG,
+												std::string("Could not write new device settings:\n").append(ex.to_string()));
 	}
 }
 
-void hal::sensors::i2c::ads1115::ADS1115::set_operation_mode_setting(OperationMode new_operation_mode_setting)
+void hal::sensors::i2c::ads1115::ADS1115::set_comparator_latching_setting(AlertLatching new_comparator_latching_setting)
 {
-	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
-	// Reading only the first byte is enough since all necessary information is located there.
-	if (read_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	try
 	{
-		throw exception::I2CException("ADS1115", "set_operation_mode_setting", m_dev_id, CONFIG_REG,
-												"Could not read current device settings.");
+		load_settings();
+		m_registers.set<ComparatorLatchingField>(new_comparator_latching_setting);
+		m_registers.apply(m_file_handle);
 	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::I2CException("ADS1115", "set_comparator_latching_setting", m_dev_id, CONFIG_REG,
+												std::string("Could not write new device settings:\n").append(ex.to_string()));
+	}
+}
 
+void hal::sensors::i2c::ads1115::ADS1115::set_comparator_queue_setting(AlertQueueing new_comparator_queue_setting)
+{
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
 	try
 	{
-		BitManipulation::set_bits(raw_settings[0], static_cast<uint8_t>(new_operation_mode_setting), OPERATION_MODE_MASK);
+		load_settings();
+		m_registers.set<ComparatorQueueingField>(new_comparator_queue_setting);
+		m_registers.apply(m_file_handle);
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::HALException("ADS1115", "set_operation_mode_setting",
-												std::string("Could not set operation mode bits in config byte:\n").append(ex.to_string()));
+		throw exception::I2CException("ADS1115", "set_comparator_queue_setting", m_dev_id, CONFIG_REG,
+												std::string("Could not write new device settings:\n").append(ex.to_string()));
 	}
+}
 
-	if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+void hal::sensors::i2c::ads1115::ADS1115::set_settings(Configuration new_settings)
+{
+	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
+	MultiplexerField::set(raw_settings[MultiplexerField::BYTE], new_settings.multiplexer);
+	GainAmplifierField::set(raw_settings[GainAmplifierField::BYTE], new_settings.gain_amplifier);
+	OperationModeField::set(raw_settings[OperationModeField::BYTE], new_settings.operation_mode);
+	DataRateField::set(raw_settings[DataRateField::BYTE], new_settings.data_rate);
+	ComparatorModeField::set(raw_settings[ComparatorModeField::BYTE], new_settings.comparator_mode);
+	ComparatorPolarityField::set(raw_settings[ComparatorPolarityField::BYTE], new_settings.alert_polarity);
+	ComparatorLatchingField::set(raw_settings[ComparatorLatchingField::BYTE], new_settings.alert_latching);
+	ComparatorQueueingField::set(raw_settings[ComparatorQueueingField::BYTE], new_settings.alert_queueing);
+
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	m_registers.set_register(CONFIG_REG, raw_settings);
+	try
+	{
+		m_registers.apply(m_file_handle);
+	}
+	catch (exception::HALException& ex)
 	{
-		throw exception::I2CException("ADS1115", "set_operation_mode_setting", m_dev_id, CONFIG_REG, "Could not write new device settings.");
+		throw exception::I2CException("ADS1115", "set_settings", m_dev_id, CONFIG_REG,
+												std::string("Could not write new device settings:\n").append(ex.to_string()));
 	}
 }
 
-void hal::sensors::i2c::ads1115::ADS1115::set_data_rate_setting(DataRate new_data_rate_setting)
+void hal::sensors::i2c::ads1115::ADS1115::restore_default_settings()
 {
-	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
-	if (read_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+	uint8_t default_settings[REG_READ_LEN] = {DEFAULT_SETTINGS_BYTE_1, DEFAULT_SETTINGS_BYTE_2};
+	if (write_operation(m_file_handle, CONFIG_REG, default_settings) != OK)
 	{
-		throw exception::I2CException("ADS1115", "set_data_rate_setting", m_dev_id, CONFIG_REG, "Could not read current device settings.");
+		throw exception::I2CException("ADS1115", "restore_default_settings", m_dev_id, CONFIG_REG,
+												"Could not write default device settings.");
 	}
+}
 
-	try
+double hal::sensors::i2c::ads1115::ADS1115::get_converted_data()
+{
+	return read_converted_data().value_or_raise();
+}
+
+hal::utils::Result<double> hal::sensors::i2c::ads1115::ADS1115::read_converted_data() noexcept
+{
+	uint8_t raw_converted[REG_READ_LEN] = {0, 0};
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+
+	// The gain is taken from the register map, the configuration is only read if it is not known yet
+	const auto loaded = try_load_settings();
+	if (!loaded)
 	{
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_data_rate_setting), DATA_RATE_MASK);
+		return loaded.error().with_context("ADS1115", "get_converted_data", m_dev_id);
 	}
-	catch (exception::HALException& ex)
+
+	const auto read = I2CManager::try_read_from_device(m_file_handle, CONVERSION_REG, raw_converted, REG_READ_LEN);
+	if (!read)
 	{
-		throw exception::HALException("ADS1115", "set_data_rate_setting",
-												std::string("Could not set data rate bits in config byte:\n").append(ex.to_string()));
+		return read.error().with_context("ADS1115", "get_converted_data", m_dev_id);
 	}
+	return raw_to_voltage(static_cast<int16_t>(BitManipulation::combine_bytes(raw_converted[0], raw_converted[1])),
+								 m_registers.get<GainAmplifierField, GainAmplifier>());
+}
+
+void hal::sensors::i2c::ads1115::ADS1115::start_conversion(const ChannelConfig& channel, const bool use_ready_pin)
+{
+	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
+	encode_conversion(channel, OperationMode::SINGLE_SHOT, use_ready_pin, raw_settings);
 
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
 	if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
 	{
-		throw exception::I2CException("ADS1115", "set_data_rate_setting", m_dev_id, CONFIG_REG, "Could not write new device settings.");
+		throw exception::I2CException("ADS1115", "start_conversion", m_dev_id, CONFIG_REG, "Could not write conversion settings.");
 	}
 }
 
-void hal::sensors::i2c::ads1115::ADS1115::set_comparator_mode_setting(ComparatorMode new_comparator_mode_setting)
+int16_t hal::sensors::i2c::ads1115::ADS1115::read_conversion_raw()
 {
-	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
-	if (read_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+	uint8_t raw_converted[REG_READ_LEN] = {0, 0};
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	if (read_operation(m_file_handle, CONVERSION_REG, raw_converted) != OK)
 	{
-		throw exception::I2CException("ADS1115", "set_comparator_mode_setting", m_dev_id, CONFIG_REG,
-												"Could not read current device settings.");
+		throw exception::I2CException("ADS1115", "read_conversion_raw", m_dev_id, CONVERSION_REG, "Could not read converted data.");
 	}
+	return static_cast<int16_t>(BitManipulation::combine_bytes(raw_converted[0], raw_converted[1]));
+}
 
+double hal::sensors::i2c::ads1115::ADS1115::read_single_conversion(const Multiplexer multiplexer, const GainAmplifier gain_amplifier,
+																						 const DataRate data_rate)
+{
 	try
 	{
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_comparator_mode_setting), COMPARATOR_MODE_MASK);
+		return raw_to_voltage(convert_raw(ChannelConfig{multiplexer, gain_amplifier, data_rate}), gain_amplifier);
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::HALException("ADS1115", "set_comparator_mode_setting",
-												std::string("Could not set comparator mode bits in config byte:\n").append(ex.to_string()));
-	}
-
-	if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
-	{
-		throw exception::I2CException("ADS1115", "set_comparator_mode_setting", m_dev_id, CONFIG_REG, "Could not write new device settings.");
+		throw exception::HALException("ADS1115", "read_single_conversion",
+												std::string("Could not convert channel:\n").append(ex.to_string()));
 	}
 }
 
-void hal::sensors::i2c::ads1115::ADS1115::set_comparator_polarity_setting(AlertPolarity new_comparator_polarity_setting)
+hal::sensors::i2c::ads1115::ChannelSample hal::sensors::i2c::ads1115::ADS1115::read_sample(const ChannelConfig& channel)
 {
-	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
-	if (read_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+	if (channel.auto_range)
 	{
-		throw exception::I2CException("ADS1115", "set_comparator_polarity_setting", m_dev_id, CONFIG_REG,
-												"Could not read current device settings.");
+		return read_auto_ranged_conversion(channel.multiplexer, channel.gain_amplifier, channel.data_rate);
 	}
 
 	try
 	{
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_comparator_polarity_setting), COMPARATOR_POLARITY_MASK);
+		const auto raw_value = convert_raw(channel);
+		const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+		return ChannelSample{
+			raw_value, raw_to_voltage(raw_value, channel.gain_amplifier), channel.gain_amplifier, 1, static_cast<uint64_t>(timestamp)
+		};
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::HALException("ADS1115", "set_comparator_polarity_setting",
-												std::string("Could not set pin polarity bits in config byte:\n").append(ex.to_string()));
+		throw exception::HALException("ADS1115", "read_sample", std::string("Could not convert channel:\n").append(ex.to_string()));
 	}
+}
 
-	if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+hal::sensors::i2c::ads1115::ChannelSample hal::sensors::i2c::ads1115::ADS1115::read_auto_ranged_conversion(
+	const Multiplexer multiplexer, const GainAmplifier predicted_gain, const DataRate data_rate)
+{
+	ChannelConfig channel{multiplexer, predicted_gain, data_rate, true};
+
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	try
 	{
-		throw exception::I2CException("ADS1115", "set_comparator_polarity_setting", m_dev_id, CONFIG_REG,
-												"Could not write new device settings.");
+		auto raw_value = convert_raw(channel);
+		if (is_saturated(raw_value) && channel.gain_amplifier != GainAmplifier::GAIN_6144_mV)
+		{
+			// The signal rose faster than predicted -> one more conversion with the widest range
+			channel.gain_amplifier = GainAmplifier::GAIN_6144_mV;
+			raw_value = convert_raw(channel);
+		}
+
+		const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+		return ChannelSample{
+			raw_value, raw_to_voltage(raw_value, channel.gain_amplifier), channel.gain_amplifier, 1, static_cast<uint64_t>(timestamp)
+		};
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("ADS1115", "read_auto_ranged_conversion",
+												std::string("Could not convert channel:\n").append(ex.to_string()));
 	}
 }
 
-void hal::sensors::i2c::ads1115::ADS1115::set_comparator_latching_setting(AlertLatching new_comparator_latching_setting)
+hal::sensors::i2c::ads1115::GainAmplifier hal::sensors::i2c::ads1115::ADS1115::predict_gain(const double voltage) noexcept
 {
-	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
-	if (read_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+	static constexpr GainAmplifier GAINS_BY_RESOLUTION[] = {
+		GainAmplifier::GAIN_256_mV, GainAmplifier::GAIN_512_mV, GainAmplifier::GAIN_1024_mV,
+		GainAmplifier::GAIN_2048_mV, GainAmplifier::GAIN_4096_mV
+	};
+
+	const auto required_mv = std::fabs(voltage) * 1000.0 * (1.0 + AUTO_RANGE_HEADROOM);
+	for (const auto gain : GAINS_BY_RESOLUTION)
 	{
-		throw exception::I2CException("ADS1115", "set_comparator_latching_setting", m_dev_id, CONFIG_REG,
-												"Could not read current device settings.");
+		if (get_full_scale_in_mv(gain) >= required_mv)
+		{
+			return gain;
+		}
 	}
+	return GainAmplifier::GAIN_6144_mV;
+}
 
-	try
+bool hal::sensors::i2c::ads1115::ADS1115::is_saturated(const int16_t raw_value) noexcept
+{
+	return raw_value >= RAW_MAX_VALUE || raw_value <= RAW_MIN_VALUE;
+}
+
+int16_t hal::sensors::i2c::ads1115::ADS1115::convert_raw(const ChannelConfig& channel)
+{
+	// Nobody else may change the channel until the result was read.
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	start_conversion(channel);
+	const auto start = std::chrono::steady_clock::now();
+	std::this_thread::sleep_for(std::chrono::microseconds(get_conversion_time_in_us(channel.data_rate)));
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CONVERSION_TIMEOUT_IN_MS);
+	while (is_converting())
 	{
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_comparator_latching_setting), COMPARATOR_LATCHING_MASK);
+		if (std::chrono::steady_clock::now() >= deadline)
+		{
+			if (m_conversion_timeouts != nullptr)
+			{
+				m_conversion_timeouts->add();
+			}
+			throw exception::HALException("ADS1115", "convert_raw", "The conversion did not finish in time.");
+		}
+		std::this_thread::sleep_for(std::chrono::microseconds(CONVERSION_POLL_INTERVAL_IN_US));
 	}
-	catch (exception::HALException& ex)
+	if (m_conversion_wait != nullptr)
 	{
-		throw exception::HALException("ADS1115", "set_comparator_latching_setting",
-												std::string("Could not set comparator latching bits in config byte:\n").append(ex.to_string()));
+		m_conversion_wait->record_since(start);
 	}
+	Tracer::record("ads1115.conversion_wait", "driver", m_dev_id, start, std::chrono::steady_clock::now());
+	return read_conversion_raw();
+}
 
-	if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+void hal::sensors::i2c::ads1115::ADS1115::enable_conversion_ready_pin()
+{
+	uint8_t high_threshold[REG_READ_LEN] = {READY_HIGH_THRES_BYTE_1, READY_HIGH_THRES_BYTE_2};
+	uint8_t low_threshold[REG_READ_LEN] = {READY_LOW_THRES_BYTE_1, READY_LOW_THRES_BYTE_2};
+
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	if (write_operation(m_file_handle, HIGH_THRESHOLD_REG, high_threshold) != OK)
 	{
-		throw exception::I2CException("ADS1115", "set_comparator_latching_setting", m_dev_id, CONFIG_REG,
-												"Could not write new device settings.");
+		throw exception::I2CException("ADS1115", "enable_conversion_ready_pin", m_dev_id, HIGH_THRESHOLD_REG,
+												"Could not write upper threshold.");
+	}
+	if (write_operation(m_file_handle, LOW_THRESHOLD_REG, low_threshold) != OK)
+	{
+		throw exception::I2CException("ADS1115", "enable_conversion_ready_pin", m_dev_id, LOW_THRESHOLD_REG,
+												"Could not write lower threshold.");
 	}
 }
 
-void hal::sensors::i2c::ads1115::ADS1115::set_comparator_queue_setting(AlertQueueing new_comparator_queue_setting)
+hal::sensors::i2c::ads1115::BurstResult hal::sensors::i2c::ads1115::ADS1115::capture_burst(
+	const ChannelConfig& channel, const std::shared_ptr<interfaces::IGPIOLine>& ready_line, int16_t* buffer, const size_t capacity,
+	const uint64_t sample_count, const uint32_t duration_in_ms)
 {
-	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
-	if (read_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+	if (ready_line == nullptr || buffer == nullptr || capacity == 0)
 	{
-		throw exception::I2CException("ADS1115", "set_comparator_queue_setting", m_dev_id, CONFIG_REG,
-												"Could not read current device settings.");
+		throw exception::HALException("ADS1115", "capture_burst", "The ready line and a buffer with a capacity above 0 are required.");
+	}
+	if (sample_count == 0 && duration_in_ms == 0)
+	{
+		throw exception::HALException("ADS1115", "capture_burst", "Either a sample count or a duration is required.");
 	}
 
+	BurstResult result{0, 0, 0, 0, 0, 0, channel.gain_amplifier};
+	const auto period_ns = NANOSECONDS_PER_SECOND / get_samples_per_second(channel.data_rate);
+	const auto edge_timeout_ms = static_cast<int>((get_conversion_time_in_us(channel.data_rate) + 999) / 1000 + CONVERSION_TIMEOUT_IN_MS);
+
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	uint8_t previous_settings[REG_READ_LEN] = {0, 0};
+	uint8_t previous_high_threshold[REG_READ_LEN] = {0, 0};
+	uint8_t previous_low_threshold[REG_READ_LEN] = {0, 0};
+	if (read_operation(m_file_handle, CONFIG_REG, previous_settings) != OK
+		|| read_operation(m_file_handle, HIGH_THRESHOLD_REG, previous_high_threshold) != OK
+		|| read_operation(m_file_handle, LOW_THRESHOLD_REG, previous_low_threshold) != OK)
+	{
+		throw exception::I2CException("ADS1115", "capture_burst", m_dev_id, CONFIG_REG, "Could not read current settings.");
+	}
+	// Writing the OS bit back would start a single conversion
+	previous_settings[0] = static_cast<uint8_t>(previous_settings[0] & ~(1 << STATUS_BIT));
+	const auto restore_settings = [&]()
+	{
+		write_operation(m_file_handle, CONFIG_REG, previous_settings);
+		write_operation(m_file_handle, HIGH_THRESHOLD_REG, previous_high_threshold);
+		write_operation(m_file_handle, LOW_THRESHOLD_REG, previous_low_threshold);
+	};
+
+	uint64_t last_edge_ns = 0;
 	try
 	{
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_comparator_queue_setting), COMPARATOR_QUEUEING_MASK);
+		enable_conversion_ready_pin();
+
+		uint8_t raw_settings[REG_READ_LEN] = {0, 0};
+		encode_conversion(channel, OperationMode::CONTINUOUS, true, raw_settings);
+
+		// Drop edges of earlier conversions
+		GPIOEvent event{};
+		pollfd poll_fd{ready_line->get_event_fd(), POLLIN, 0};
+		while (poll(&poll_fd, 1, 0) > 0 && ready_line->read_event(event))
+		{
+		}
+
+		if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+		{
+			throw exception::I2CException("ADS1115", "capture_burst", m_dev_id, CONFIG_REG, "Could not start continuous conversions.");
+		}
+
+		// The register pointer stays on the conversion register, so each sample only needs a single read request.
+		const auto conversion_reg = CONVERSION_REG;
+		if (I2CManager::write_raw(m_file_handle, &conversion_reg, 1) != 1)
+		{
+			throw exception::I2CException("ADS1115", "capture_burst", m_dev_id, CONVERSION_REG,
+													std::string("Could not switch to conversion register. Error: ").append(strerror(errno)));
+		}
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(duration_in_ms);
+		while ((sample_count == 0 || result.total_samples < sample_count)
+			&& (duration_in_ms == 0 || std::chrono::steady_clock::now() < deadline))
+		{
+			const auto ready = poll(&poll_fd, 1, edge_timeout_ms);
+			if (ready < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (ready <= 0)
+			{
+				throw exception::HALException("ADS1115", "capture_burst", "The conversion ready signal did not arrive in time.");
+			}
+			if (!ready_line->read_event(event) || event.edge != GPIOEdge::FALLING)
+			{
+				continue;
+			}
+
+			uint8_t raw_converted[REG_READ_LEN] = {0, 0};
+			if (I2CManager::read_raw(m_file_handle, raw_converted, REG_READ_LEN) != REG_READ_LEN)
+			{
+				throw exception::I2CException("ADS1115", "capture_burst", m_dev_id, CONVERSION_REG,
+														std::string("Could not read converted data. Error: ").append(strerror(errno)));
+			}
+
+			if (result.total_samples == 0)
+			{
+				result.start_timestamp_ns = event.timestamp_ns;
+			}
+			else if ((event.timestamp_ns - last_edge_ns) * 2 > period_ns * 3)
+			{
+				// More than one and a half periods since the last edge -> conversions were overwritten before they were read
+				result.missed_conversions += static_cast<uint32_t>((event.timestamp_ns - last_edge_ns + period_ns / 2) / period_ns - 1);
+			}
+			last_edge_ns = event.timestamp_ns;
+
+			buffer[result.total_samples % capacity] = static_cast<int16_t>(BitManipulation::combine_bytes(raw_converted[0], raw_converted[1]));
+			result.total_samples++;
+		}
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::HALException("ADS1115", "set_comparator_queue_setting",
-												std::string("Could not set comparator queue bits in config byte:\n").append(ex.to_string()));
+		try
+		{
+			restore_settings();
+		}
+		catch (exception::HALException&)
+		{
+			// Report the original error
+		}
+		throw exception::HALException("ADS1115", "capture_burst", std::string("Could not capture burst:\n").append(ex.to_string()));
+	}
+
+	// Stop the continuous conversions
+	restore_settings();
+
+	result.end_timestamp_ns = last_edge_ns;
+	result.sample_count = static_cast<size_t>(std::min<uint64_t>(result.total_samples, capacity));
+	result.first_index = result.total_samples > capacity ? static_cast<size_t>(result.total_samples % capacity) : 0;
+	return result;
+}
+
+void hal::sensors::i2c::ads1115::ADS1115::raw_to_voltages(const int16_t* raw_values, const size_t count,
+																			 const GainAmplifier gain_amplifier, double* voltages) noexcept
+{
+	// Compute the size of one LSB once instead of per sample
+	const auto volts_per_lsb = get_full_scale_in_mv(gain_amplifier) / 32768.0 / 1000.0;
+	for (size_t i = 0; i < count; i++)
+	{
+		voltages[i] = raw_values[i] * volts_per_lsb;
+	}
+}
+
+void hal::sensors::i2c::ads1115::ADS1115::burst_to_voltages(const int16_t* buffer, const size_t capacity, const BurstResult& result,
+																				double* voltages) noexcept
+{
+	// Oldest samples from first_index to the end of the buffer, then the wrapped ones from the start
+	const auto tail_count = std::min(result.sample_count, capacity - result.first_index);
+	raw_to_voltages(buffer + result.first_index, tail_count, result.gain_amplifier, voltages);
+	raw_to_voltages(buffer, result.sample_count - tail_count, result.gain_amplifier, voltages + tail_count);
+}
+
+void hal::sensors::i2c::ads1115::ADS1115::start_event_mode(const ChannelConfig& channel, const double lower_voltage,
+																				const double upper_voltage,
+																				const std::shared_ptr<interfaces::IGPIOLine>& alert_line,
+																				const AlertQueueing queue)
+{
+	if (alert_line == nullptr)
+	{
+		throw exception::HALException("ADS1115", "start_event_mode", "The alert line is required.");
+	}
+	if (queue == AlertQueueing::DISABLED)
+	{
+		throw exception::HALException("ADS1115", "start_event_mode", "The comparator queue must not be disabled.");
 	}
 
+	const auto lower_threshold = voltage_to_raw(lower_voltage, channel.gain_amplifier);
+	const auto upper_threshold = voltage_to_raw(upper_voltage, channel.gain_amplifier);
+	if (lower_threshold >= upper_threshold)
+	{
+		throw exception::HALException("ADS1115", "start_event_mode", "The lower voltage has to be below the upper voltage.");
+	}
+
+	stop_event_mode();
+
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	uint8_t raw_high_threshold[REG_READ_LEN] = {
+		static_cast<uint8_t>(static_cast<uint16_t>(upper_threshold) >> 8), static_cast<uint8_t>(upper_threshold & 0xFF)
+	};
+	uint8_t raw_low_threshold[REG_READ_LEN] = {
+		static_cast<uint8_t>(static_cast<uint16_t>(lower_threshold) >> 8), static_cast<uint8_t>(lower_threshold & 0xFF)
+	};
+
+	// Byte 1: MUX[2:0] | PGA[2:0] | MODE (continuous)
+	// Byte 2: DR[2:0] | COMP_MODE (window) | COMP_POL (active low) | COMP_LAT (not latching) | COMP_QUE[1:0]
+	uint8_t raw_settings[REG_READ_LEN] = {
+		static_cast<uint8_t>(static_cast<uint8_t>(channel.multiplexer) << MULTIPLEXER_BIT_1
+			| static_cast<uint8_t>(channel.gain_amplifier) << GAIN_AMPLIFIER_BIT_1
+			| static_cast<uint8_t>(OperationMode::CONTINUOUS) << OPERATION_MODE_BIT),
+		static_cast<uint8_t>(static_cast<uint8_t>(channel.data_rate) << DATA_RATE_BIT_1
+			| static_cast<uint8_t>(ComparatorMode::WINDOW) << COMPARATOR_MODE_BIT
+			| static_cast<uint8_t>(queue) << COMPARATOR_QUEUE_BIT_1)
+	};
+
+	if (write_operation(m_file_handle, HIGH_THRESHOLD_REG, raw_high_threshold) != OK
+		|| write_operation(m_file_handle, LOW_THRESHOLD_REG, raw_low_threshold) != OK)
+	{
+		throw exception::I2CException("ADS1115", "start_event_mode", m_dev_id, HIGH_THRESHOLD_REG, "Could not write window thresholds.");
+	}
 	if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
 	{
-		throw exception::I2CException("ADS1115", "set_comparator_queue_setting", m_dev_id, CONFIG_REG,
-												"Could not write new device settings.");
+		throw exception::I2CException("ADS1115", "start_event_mode", m_dev_id, CONFIG_REG, "Could not start window comparator.");
+	}
+
+	m_alert_line = alert_line;
+	m_event_channel = channel;
+	m_outside_window = false;
+	m_event_mode = true;
+	try
+	{
+		m_alert_watch_handle = EventScheduler::instance().watch_fd(m_alert_line->get_event_fd(), [this]() { on_alert_edge(); });
+		m_alert_watchdog_handle = EventScheduler::instance().add_timer(ALERT_WATCHDOG_PERIOD_IN_MS, true,
+																							[this]() { on_alert_watchdog(); });
+	}
+	catch (exception::HALException& ex)
+	{
+		stop_event_mode();
+		throw exception::HALException("ADS1115", "start_event_mode",
+												std::string("Could not watch the alert line:\n").append(ex.to_string()));
 	}
 }
 
-void hal::sensors::i2c::ads1115::ADS1115::set_settings(Configuration new_settings)
+void hal::sensors::i2c::ads1115::ADS1115::stop_event_mode() noexcept
 {
-	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
+	if (!m_event_mode.exchange(false))
+	{
+		return;
+	}
+
+	// The handlers lock m_mutex, so it must not be held while waiting for them.
+	if (m_alert_watch_handle != 0)
+	{
+		EventScheduler::instance().remove(m_alert_watch_handle);
+		m_alert_watch_handle = 0;
+	}
+	if (m_alert_watchdog_handle != 0)
+	{
+		EventScheduler::instance().remove(m_alert_watchdog_handle);
+		m_alert_watchdog_handle = 0;
+	}
+
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
 	try
 	{
-		BitManipulation::set_bits(raw_settings[0], static_cast<uint8_t>(new_settings.multiplexer), MULTIPLEXER_MASK);
-		BitManipulation::set_bits(raw_settings[0], static_cast<uint8_t>(new_settings.gain_amplifier), GAIN_AMPLIFIER_MASK);
-		BitManipulation::set_bits(raw_settings[0], static_cast<uint8_t>(new_settings.operation_mode), OPERATION_MODE_MASK);
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_settings.data_rate), DATA_RATE_MASK);
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_settings.comparator_mode), COMPARATOR_MODE_MASK);
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_settings.alert_polarity), COMPARATOR_POLARITY_MASK);
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_settings.alert_latching), COMPARATOR_LATCHING_MASK);
-		BitManipulation::set_bits(raw_settings[1], static_cast<uint8_t>(new_settings.alert_queueing), COMPARATOR_QUEUEING_MASK);
+		// Stop the continuous conversions and disable the comparator
+		uint8_t raw_settings[REG_READ_LEN] = {0, 0};
+		encode_conversion(m_event_channel, OperationMode::SINGLE_SHOT, false, raw_settings);
+		raw_settings[0] = static_cast<uint8_t>(raw_settings[0] & ~(1 << STATUS_BIT));
+		write_operation(m_file_handle, CONFIG_REG, raw_settings);
+		restore_default_thresholds();
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::HALException("ADS1115", "set_settings",
-												std::string("Could not set setting bits in config byte:\n").append(ex.to_string()));
+		std::cerr << "ADS1115 [stop_event_mode] Could not disable the window comparator:\n" << ex.to_string() << std::endl;
 	}
+}
 
-	if (write_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+bool hal::sensors::i2c::ads1115::ADS1115::is_event_mode_active() const noexcept
+{
+	return m_event_mode;
+}
+
+int16_t hal::sensors::i2c::ads1115::ADS1115::voltage_to_raw(const double voltage, const GainAmplifier gain_amplifier) noexcept
+{
+	const auto raw_value = std::lround(voltage * 1000.0 * 32768.0 / get_full_scale_in_mv(gain_amplifier));
+	return static_cast<int16_t>(std::max<long>(RAW_MIN_VALUE, std::min<long>(RAW_MAX_VALUE, raw_value)));
+}
+
+void hal::sensors::i2c::ads1115::ADS1115::on_alert_edge()
+{
+	// Always consume the event, otherwise the scheduler executes this handler again.
+	GPIOEvent event{};
+	if (!m_alert_line->read_event(event))
+	{
+		return;
+	}
+
+	if (event.edge == GPIOEdge::RISING)
+	{
+		m_outside_window = false; // Back inside of the window
+	}
+	else if (event.edge == GPIOEdge::FALLING && !m_outside_window)
 	{
-		throw exception::I2CException("ADS1115", "set_settings", m_dev_id, CONFIG_REG, "Could not write new device settings.");
+		publish_window_exit();
 	}
 }
 
-void hal::sensors::i2c::ads1115::ADS1115::restore_default_settings()
+void hal::sensors::i2c::ads1115::ADS1115::on_alert_watchdog()
 {
-	uint8_t default_settings[REG_READ_LEN] = {DEFAULT_SETTINGS_BYTE_1, DEFAULT_SETTINGS_BYTE_2};
-	if (write_operation(m_file_handle, CONFIG_REG, default_settings) != OK)
+	// ALERT/RDY stays LOW as long as the signal is outside of the window
+	const auto outside = m_alert_line->get_value() == 0;
+	if (!outside)
 	{
-		throw exception::I2CException("ADS1115", "restore_default_settings", m_dev_id, CONFIG_REG,
-												"Could not write default device settings.");
+		m_outside_window = false;
+	}
+	else if (!m_outside_window)
+	{
+		publish_window_exit();
 	}
 }
 
-double hal::sensors::i2c::ads1115::ADS1115::get_converted_data()
+void hal::sensors::i2c::ads1115::ADS1115::publish_window_exit()
 {
-	uint8_t raw_converted[REG_READ_LEN] = {0, 0};
-	if (read_operation(m_file_handle, CONVERSION_REG, raw_converted) != OK)
+	m_outside_window = true;
+
+	double voltage;
 	{
-		throw exception::I2CException("ADS1115", "get_converted_data", m_dev_id, CONVERSION_REG, "Could not read converted data.");
+		std::lock_guard<std::recursive_mutex> guard(m_mutex);
+		if (!m_event_mode)
+		{
+			return;
+		}
+		try
+		{
+			voltage = raw_to_voltage(read_conversion_raw(), m_event_channel.gain_amplifier);
+		}
+		catch (exception::HALException& ex)
+		{
+			throw exception::HALException("ADS1115", "publish_window_exit",
+													std::string("Could not read the value outside of the window:\n").append(ex.to_string()));
+		}
 	}
-	return convert_to_voltage(BitManipulation::combine_bytes(raw_converted[0], raw_converted[1]));
+
+	const auto value = std::to_string(voltage);
+	for (const auto& handle : get_value_callbacks(SensorType::CONVERTER))
+	{
+		if (handle->callback != nullptr)
+		{
+			handle->callback(value);
+		}
+	}
+}
+
+double hal::sensors::i2c::ads1115::ADS1115::raw_to_voltage(const int16_t raw_value, const GainAmplifier gain_amplifier) noexcept
+{
+	// One LSB is the full scale range divided by 2^15
+	return raw_value * get_full_scale_in_mv(gain_amplifier) / 32768.0 / 1000.0;
+}
+
+uint32_t hal::sensors::i2c::ads1115::ADS1115::get_conversion_time_in_us(const DataRate data_rate) noexcept
+{
+	// The internal oscillator may run up to 10% slow
+	return 1100000 / get_samples_per_second(data_rate) + CONVERSION_MARGIN_IN_US;
+}
+
+uint16_t hal::sensors::i2c::ads1115::ADS1115::get_samples_per_second(const DataRate data_rate) noexcept
+{
+	switch (data_rate)
+	{
+	case DataRate::RATE_8_SPS:
+		return 8;
+	case DataRate::RATE_16_SPS:
+		return 16;
+	case DataRate::RATE_32_SPS:
+		return 32;
+	case DataRate::RATE_64_SPS:
+		return 64;
+	case DataRate::RATE_250_SPS:
+		return 250;
+	case DataRate::RATE_475_SPS:
+		return 475;
+	case DataRate::RATE_860_SPS:
+		return 860;
+	case DataRate::RATE_128_SPS:
+	default:
+		return 128;
+	}
+}
+
+double hal::sensors::i2c::ads1115::ADS1115::get_full_scale_in_mv(const GainAmplifier gain_amplifier) noexcept
+{
+	switch (gain_amplifier)
+	{
+	case GainAmplifier::GAIN_6144_mV:
+		return 6144.0;
+	case GainAmplifier::GAIN_4096_mV:
+		return 4096.0;
+	case GainAmplifier::GAIN_1024_mV:
+		return 1024.0;
+	case GainAmplifier::GAIN_512_mV:
+		return 512.0;
+	case GainAmplifier::GAIN_256_mV:
+		return 256.0;
+	case GainAmplifier::GAIN_2048_mV:
+	default:
+		return 2048.0;
+	}
+}
+
+void hal::sensors::i2c::ads1115::ADS1115::encode_conversion(const ChannelConfig& channel, const OperationMode operation_mode,
+																				const bool use_ready_pin, uint8_t raw_settings[REG_READ_LEN]) noexcept
+{
+	// Byte 1: OS (start) | MUX[2:0] | PGA[2:0] | MODE
+	const auto start = operation_mode == OperationMode::SINGLE_SHOT ? 1 : 0;
+	raw_settings[0] = static_cast<uint8_t>(start << STATUS_BIT
+		| static_cast<uint8_t>(channel.multiplexer) << MULTIPLEXER_BIT_1
+		| static_cast<uint8_t>(channel.gain_amplifier) << GAIN_AMPLIFIER_BIT_1
+		| static_cast<uint8_t>(operation_mode) << OPERATION_MODE_BIT);
+
+	// Byte 2: DR[2:0] | COMP_MODE | COMP_POL (active low) | COMP_LAT | COMP_QUE[1:0]
+	const auto queue = use_ready_pin ? AlertQueueing::ASSERT_1_CONVERSION : AlertQueueing::DISABLED;
+	raw_settings[1] = static_cast<uint8_t>(static_cast<uint8_t>(channel.data_rate) << DATA_RATE_BIT_1
+		| static_cast<uint8_t>(queue) << COMPARATOR_QUEUE_BIT_1);
 }
 
 uint16_t hal::sensors::i2c::ads1115::ADS1115::get_upper_threshold()
@@ -735,9 +1249,17 @@ void hal::sensors::i2c::ads1115::ADS1115::set_upper_threshold(const uint16_t upp
 {
 	uint8_t divided_threshold[REG_READ_LEN] = {0, 0};
 	BitManipulation::split_bytes(upper_threshold, divided_threshold[0], divided_threshold[1]);
-	if (write_operation(m_file_handle, HIGH_THRESHOLD_REG, divided_threshold) != OK)
+
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	m_registers.set_register(HIGH_THRESHOLD_REG, divided_threshold);
+	try
+	{
+		m_registers.apply(m_file_handle);
+	}
+	catch (exception::HALException& ex)
 	{
-		throw exception::I2CException("ADS1115", "set_upper_threshold", m_dev_id, CONVERSION_REG, "Could not write upper threshold.");
+		throw exception::I2CException("ADS1115", "set_upper_threshold", m_dev_id, HIGH_THRESHOLD_REG,
+												std::string("Could not write upper threshold:\n").append(ex.to_string()));
 	}
 }
 
@@ -745,9 +1267,17 @@ void hal::sensors::i2c::ads1115::ADS1115::set_lower_threshold(const uint16_t low
 {
 	uint8_t divided_threshold[REG_READ_LEN] = {0, 0};
 	BitManipulation::split_bytes(lower_threshold, divided_threshold[0], divided_threshold[1]);
-	if (write_operation(m_file_handle, LOW_THRESHOLD_REG, divided_threshold) != OK)
+
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	m_registers.set_register(LOW_THRESHOLD_REG, divided_threshold);
+	try
+	{
+		m_registers.apply(m_file_handle);
+	}
+	catch (exception::HALException& ex)
 	{
-		throw exception::I2CException("ADS1115", "set_lower_threshold", m_dev_id, CONVERSION_REG, "Could not write lower threshold.");
+		throw exception::I2CException("ADS1115", "set_lower_threshold", m_dev_id, LOW_THRESHOLD_REG,
+												std::string("Could not write lower threshold:\n").append(ex.to_string()));
 	}
 }
 
@@ -799,194 +1329,129 @@ void hal::sensors::i2c::ads1115::ADS1115::restore_default_thresholds()
 	}
 }
 
-hal::sensors::i2c::ads1115::Multiplexer hal::sensors::i2c::ads1115::ADS1115::parse_multiplexer_value(const uint8_t raw_data)
+hal::sensors::i2c::ads1115::Multiplexer hal::sensors::i2c::ads1115::ADS1115::parse_multiplexer_value(const uint8_t raw_data) noexcept
 {
-	try
-	{
-		switch (BitManipulation::value_of_bits(raw_data, MULTIPLEXER_BIT_1, MULTIPLEXER_BIT_3))
-		{
-		case 0:
-			return Multiplexer::POSITIVE_0_AND_NEGATIVE_1;
-		case 1:
-			return Multiplexer::POSITIVE_0_AND_NEGATIVE_3;
-		case 2:
-			return Multiplexer::POSITIVE_1_AND_NEGATIVE_3;
-		case 3:
-			return Multiplexer::POSITIVE_2_AND_NEGATIVE_3;
-		case 4:
-			return Multiplexer::POSITIVE_0_AND_NEGATIVE_GND;
-		case 5:
-			return Multiplexer::POSITIVE_1_AND_NEGATIVE_GND;
-		case 6:
-			return Multiplexer::POSITIVE_2_AND_NEGATIVE_GND;
-		case 7:
-			return Multiplexer::POSITIVE_3_AND_NEGATIVE_GND;
-		default:
-			return Multiplexer::POSITIVE_0_AND_NEGATIVE_1;
-		}
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("ADS1115", "parse_multiplexer_value",
-												std::string("Could not read value of multiplexer bits in config byte:\n").append(ex.to_string()));
+	switch (MultiplexerField::decode(raw_data))
+	{
+	case 0:
+		return Multiplexer::POSITIVE_0_AND_NEGATIVE_1;
+	case 1:
+		return Multiplexer::POSITIVE_0_AND_NEGATIVE_3;
+	case 2:
+		return Multiplexer::POSITIVE_1_AND_NEGATIVE_3;
+	case 3:
+		return Multiplexer::POSITIVE_2_AND_NEGATIVE_3;
+	case 4:
+		return Multiplexer::POSITIVE_0_AND_NEGATIVE_GND;
+	case 5:
+		return Multiplexer::POSITIVE_1_AND_NEGATIVE_GND;
+	case 6:
+		return Multiplexer::POSITIVE_2_AND_NEGATIVE_GND;
+	case 7:
+		return Multiplexer::POSITIVE_3_AND_NEGATIVE_GND;
+	default:
+		return Multiplexer::POSITIVE_0_AND_NEGATIVE_1;
 	}
 }
 
-hal::sensors::i2c::ads1115::GainAmplifier hal::sensors::i2c::ads1115::ADS1115::parse_gain_amplifier_value(const uint8_t raw_data)
+hal::sensors::i2c::ads1115::GainAmplifier hal::sensors::i2c::ads1115::ADS1115::parse_gain_amplifier_value(const uint8_t raw_data) noexcept
 {
-	try
-	{
-		switch (BitManipulation::value_of_bits(raw_data, GAIN_AMPLIFIER_BIT_1, GAIN_AMPLIFIER_BIT_3))
-		{
-		case 0:
-			return GainAmplifier::GAIN_6144_mV;
-		case 1:
-			return GainAmplifier::GAIN_4096_mV;
-		case 2:
-			return GainAmplifier::GAIN_2048_mV;
-		case 3:
-			return GainAmplifier::GAIN_1024_mV;
-		case 4:
-			return GainAmplifier::GAIN_512_mV;
-		case 5:
-		case 6:
-		case 7:
-			return GainAmplifier::GAIN_256_mV;
-		default:
-			return GainAmplifier::GAIN_2048_mV;
-		}
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("ADS1115", "parse_gain_amplifier_value",
-												std::string("Could not read value of gain amplifier bits in config byte:\n").append(ex.to_string()));
+	switch (GainAmplifierField::decode(raw_data))
+	{
+	case 0:
+		return GainAmplifier::GAIN_6144_mV;
+	case 1:
+		return GainAmplifier::GAIN_4096_mV;
+	case 2:
+		return GainAmplifier::GAIN_2048_mV;
+	case 3:
+		return GainAmplifier::GAIN_1024_mV;
+	case 4:
+		return GainAmplifier::GAIN_512_mV;
+	case 5:
+	case 6:
+	case 7:
+		return GainAmplifier::GAIN_256_mV;
+	default:
+		return GainAmplifier::GAIN_2048_mV;
 	}
 }
 
-hal::sensors::i2c::ads1115::OperationMode hal::sensors::i2c::ads1115::ADS1115::parse_operation_mode_value(const uint8_t raw_data)
+hal::sensors::i2c::ads1115::OperationMode hal::sensors::i2c::ads1115::ADS1115::parse_operation_mode_value(const uint8_t raw_data) noexcept
 {
-	try
+	if (OperationModeField::is_set(raw_data))
 	{
-		if (BitManipulation::is_bit_set(raw_data, OPERATION_MODE_BIT))
-		{
-			return OperationMode::SINGLE_SHOT;
-		}
-		return OperationMode::CONTINUOUS;
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("ADS1115", "parse_operation_mode_value",
-												std::string("Could not read value of operation mode bits in config byte:\n").append(ex.to_string()));
+		return OperationMode::SINGLE_SHOT;
 	}
+	return OperationMode::CONTINUOUS;
 }
 
-hal::sensors::i2c::ads1115::DataRate hal::sensors::i2c::ads1115::ADS1115::parse_data_rate_value(const uint8_t raw_data)
+hal::sensors::i2c::ads1115::DataRate hal::sensors::i2c::ads1115::ADS1115::parse_data_rate_value(const uint8_t raw_data) noexcept
 {
-	try
-	{
-		switch (BitManipulation::value_of_bits(raw_data, GAIN_AMPLIFIER_BIT_1, GAIN_AMPLIFIER_BIT_3))
-		{
-		case 0:
-			return DataRate::RATE_8_SPS;
-		case 1:
-			return DataRate::RATE_16_SPS;
-		case 2:
-			return DataRate::RATE_32_SPS;
-		case 3:
-			return DataRate::RATE_64_SPS;
-		case 4:
-			return DataRate::RATE_128_SPS;
-		case 5:
-			return DataRate::RATE_250_SPS;
-		case 6:
-			return DataRate::RATE_475_SPS;
-		case 7:
-			return DataRate::RATE_860_SPS;
-		default:
-			return DataRate::RATE_128_SPS;
-		}
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("ADS1115", "parse_data_rate_value",
-												std::string("Could not read value of data rate bits in config byte:\n").append(ex.to_string()));
+	switch (DataRateField::decode(raw_data))
+	{
+	case 0:
+		return DataRate::RATE_8_SPS;
+	case 1:
+		return DataRate::RATE_16_SPS;
+	case 2:
+		return DataRate::RATE_32_SPS;
+	case 3:
+		return DataRate::RATE_64_SPS;
+	case 4:
+		return DataRate::RATE_128_SPS;
+	case 5:
+		return DataRate::RATE_250_SPS;
+	case 6:
+		return DataRate::RATE_475_SPS;
+	case 7:
+		return DataRate::RATE_860_SPS;
+	default:
+		return DataRate::RATE_128_SPS;
 	}
 }
 
-hal::sensors::i2c::ads1115::ComparatorMode hal::sensors::i2c::ads1115::ADS1115::parse_comparator_mode_value(const uint8_t raw_data)
+hal::sensors::i2c::ads1115::ComparatorMode hal::sensors::i2c::ads1115::ADS1115::parse_comparator_mode_value(const uint8_t raw_data) noexcept
 {
-	try
-	{
-		if (BitManipulation::is_bit_set(raw_data, COMPARATOR_MODE_BIT))
-		{
-			return ComparatorMode::WINDOW;
-		}
-		return ComparatorMode::HYSTERESIS;
-	}
-	catch (exception::HALException& ex)
+	if (ComparatorModeField::is_set(raw_data))
 	{
-		throw exception::HALException("ADS1115", "parse_comparator_mode_value",
-												std::string("Could not read value of comparator mode bits in config byte:\n").append(ex.to_string()));
+		return ComparatorMode::WINDOW;
 	}
+	return ComparatorMode::HYSTERESIS;
 }
 
-hal::sensors::i2c::ads1115::AlertPolarity hal::sensors::i2c::ads1115::ADS1115::parse_comparator_polarity_value(const uint8_t raw_data)
+hal::sensors::i2c::ads1115::AlertPolarity hal::sensors::i2c::ads1115::ADS1115::parse_comparator_polarity_value(const uint8_t raw_data) noexcept
 {
-	try
+	if (ComparatorPolarityField::is_set(raw_data))
 	{
-		if (BitManipulation::is_bit_set(raw_data, COMPARATOR_POL_BIT))
-		{
-			return AlertPolarity::ACTIVE_HIGH;
-		}
-		return AlertPolarity::ACTIVE_LOW;
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("ADS1115", "parse_comparator_polarity_value",
-												std::string("Could not read value of pin polarity bits in config byte:\n").append(ex.to_string()));
+		return AlertPolarity::ACTIVE_HIGH;
 	}
+	return AlertPolarity::ACTIVE_LOW;
 }
 
-hal::sensors::i2c::ads1115::AlertLatching hal::sensors::i2c::ads1115::ADS1115::parse_comparator_latching_value(const uint8_t raw_data)
+hal::sensors::i2c::ads1115::AlertLatching hal::sensors::i2c::ads1115::ADS1115::parse_comparator_latching_value(const uint8_t raw_data) noexcept
 {
-	try
-	{
-		if (BitManipulation::is_bit_set(raw_data, COMPARATOR_LAT_BIT))
-		{
-			return AlertLatching::ACTIVE;
-		}
-		return AlertLatching::DISABLED;
-	}
-	catch (exception::HALException& ex)
+	if (ComparatorLatchingField::is_set(raw_data))
 	{
-		throw exception::HALException("ADS1115", "parse_comparator_latching_value",
-												std::string("Could not read value of comparator latching bits in config byte:\n").append(
-													ex.to_string()));
+		return AlertLatching::ACTIVE;
 	}
+	return AlertLatching::DISABLED;
 }
 
-hal::sensors::i2c::ads1115::AlertQueueing hal::sensors::i2c::ads1115::ADS1115::parse_comparator_queueing_value(const uint8_t raw_data)
+hal::sensors::i2c::ads1115::AlertQueueing hal::sensors::i2c::ads1115::ADS1115::parse_comparator_queueing_value(const uint8_t raw_data) noexcept
 {
-	try
-	{
-		switch (BitManipulation::value_of_bits(raw_data, COMPARATOR_QUEUE_BIT_1, COMPARATOR_QUEUE_BIT_2))
-		{
-		case 0:
-			return AlertQueueing::ASSERT_1_CONVERSION;
-		case 1:
-			return AlertQueueing::ASSERT_2_CONVERSIONS;
-		case 2:
-			return AlertQueueing::ASSERT_4_CONVERSIONS;
-		case 3:
-			return AlertQueueing::DISABLED;
-		default:
-			return AlertQueueing::DISABLED;
-		}
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("ADS1115", "parse_comparator_queueing_value",
-												std::string("Could not read value of comparator queue bits in config byte:\n").append(ex.to_string()));
+	switch (ComparatorQueueingField::decode(raw_data))
+	{
+	case 0:
+		return AlertQueueing::ASSERT_1_CONVERSION;
+	case 1:
+		return AlertQueueing::ASSERT_2_CONVERSIONS;
+	case 2:
+		return AlertQueueing::ASSERT_4_CONVERSIONS;
+	case 3:
+		return AlertQueueing::DISABLED;
+	default:
+		return AlertQueueing::DISABLED;
 	}
 }
 
@@ -994,33 +1459,7 @@ double hal::sensors::i2c::ads1115::ADS1115::convert_to_voltage(const uint16_t ra
 {
 	try
 	{
-		const auto gain = get_gain_amplifier_setting();
-		double bit_factor;
-		switch (gain)
-		{
-		case GainAmplifier::GAIN_6144_mV:
-			bit_factor = 6144.0 / 32767.0;
-			break;
-		case GainAmplifier::GAIN_4096_mV:
-			bit_factor = 4096.0 / 32767.0;
-			break;
-		case GainAmplifier::GAIN_2048_mV:
-			bit_factor = 2048.0 / 32767.0;
-			break;
-		case GainAmplifier::GAIN_1024_mV:
-			bit_factor = 1024.0 / 32767.0;
-			break;
-		case GainAmplifier::GAIN_512_mV:
-			bit_factor = 512.0 / 32767.0;
-			break;
-		case GainAmplifier::GAIN_256_mV:
-			bit_factor = 256.0 / 32767.0;
-			break;
-		default:
-			bit_factor = 1.0;
-			break;
-		}
-		return (raw_data * bit_factor) / 1000.0;
+		return raw_to_voltage(static_cast<int16_t>(raw_data), get_gain_amplifier_setting());
 	}
 	catch (exception::HALException& ex)
 	{
@@ -1040,7 +1479,7 @@ int8_t hal::sensors::i2c::ads1115::ADS1115::write_operation(int handle, uint8_t
 	write_buffer[0] = address;
 	write_buffer[1] = buffer[0];
 	write_buffer[2] = buffer[1];
-	if (write(handle, write_buffer, length + 1) != length + 1)
+	if (I2CManager::write_raw(handle, write_buffer, length + 1) != length + 1)
 	{
 		std::stringstream stream1;
 		stream1 << std::hex << buffer[0];
@@ -1051,6 +1490,7 @@ int8_t hal::sensors::i2c::ads1115::ADS1115::write_operation(int handle, uint8_t
 												str() + ". Error: " + strerror(errno));
 	}
 
+	remember_register(address, buffer, length);
 	return OK;
 }
 
@@ -1061,7 +1501,7 @@ int8_t hal::sensors::i2c::ads1115::ADS1115::read_operation(int handle, uint8_t a
 		return -1;
 	}
 
-	if (write(handle, &address, 1) != 1)
+	if (I2CManager::write_raw(handle, &address, 1) != 1)
 	{
 		std::stringstream address_stream;
 		address_stream << std::hex << address;
@@ -1069,7 +1509,7 @@ int8_t hal::sensors::i2c::ads1115::ADS1115::read_operation(int handle, uint8_t a
 												"Could not switch to register with address 0x" + address_stream.str() + ". Error: " + strerror(errno));
 	}
 
-	if (read(handle, buffer, length) != length)
+	if (I2CManager::read_raw(handle, buffer, length) != length)
 	{
 		std::stringstream address_stream;
 		address_stream << std::hex << address;
@@ -1079,5 +1519,56 @@ int8_t hal::sensors::i2c::ads1115::ADS1115::read_operation(int handle, uint8_t a
 																												strerror(errno)));
 	}
 
+	remember_register(address, buffer, length);
 	return OK;
 }
+
+void hal::sensors::i2c::ads1115::ADS1115::load_settings()
+{
+	if (m_registers.is_valid(CONFIG_REG))
+	{
+		return;
+	}
+
+	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
+	if (read_operation(m_file_handle, CONFIG_REG, raw_settings) != OK)
+	{
+		throw exception::I2CException("ADS1115", "load_settings", m_dev_id, CONFIG_REG, "Could not read current device settings.");
+	}
+}
+
+hal::utils::Result<void> hal::sensors::i2c::ads1115::ADS1115::try_load_settings() noexcept
+{
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	if (m_registers.is_valid(CONFIG_REG))
+	{
+		return {};
+	}
+
+	uint8_t raw_settings[REG_READ_LEN] = {0, 0};
+	const auto read = I2CManager::try_read_from_device(m_file_handle, CONFIG_REG, raw_settings, REG_READ_LEN);
+	if (!read)
+	{
+		return read.error().with_context("ADS1115", "load_settings", m_dev_id);
+	}
+	remember_register(CONFIG_REG, raw_settings, REG_READ_LEN);
+	return {};
+}
+
+void hal::sensors::i2c::ads1115::ADS1115::remember_register(const uint8_t address, const uint8_t* buffer, const uint16_t length) noexcept
+{
+	if (length != REG_READ_LEN || address < CONFIG_REG || address > HIGH_THRESHOLD_REG)
+	{
+		return;
+	}
+
+	uint8_t content[REG_READ_LEN] = {buffer[0], buffer[1]};
+	if (address == CONFIG_REG)
+	{
+		// OS starts a single conversion when written and reports a finished conversion when read, it is no setting
+		OperationalStatusFlag::set(content[OperationalStatusFlag::BYTE], false);
+	}
+
+	std::lock_guard<std::recursive_mutex> guard(m_mutex);
+	m_registers.store(address, content);
+}
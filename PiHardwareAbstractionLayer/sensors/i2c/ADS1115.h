@@ -1,12 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include "ADS1115Definitions.h"
 #include "ADS1115Constants.h"
 #include "../../enums/SensorSetting.h"
+#include "../../interfaces/IGPIOLine.h"
 #include "../../interfaces/ISensor.h"
 #include "../../utils/EnumConverter.h"
+#include "../../utils/Metrics.h"
+#include "../../utils/Tracer.h"
+#include "../../utils/RegisterMap.h"
 
 using namespace hal::utils;
 
@@ -35,11 +41,20 @@ namespace hal
 					* Tells the hardware to perform a new measurement. The result will be sent with a callback function.
 					* If no callback is registered the measurement cannot be obtained.
 					* \param[in] type: The type of measurement that has to do be done.
+					* Does nothing in event mode since values are only published if the signal leaves the window.
 					* \throws HALException if triggering a conversion fails.
 					* \throws HALException if the sensor type is invalid.
 					*/
 					void trigger_measurement(SensorType type) override;
 
+					/*!
+					* Reads the last conversion and sends it to all registered callbacks. Bus failures are returned
+					* instead of thrown. Does nothing in event mode.
+					* \param[in] type: The type of measurement that has to do be done.
+					* \returns the result of the measurement. INVALID_ARGUMENT if the sensor type is invalid.
+					*/
+					utils::Result<void> measure(SensorType type) override;
+
 					/*!
 					* Changes one specific setting of a sensor.
 					* \param[in] setting: The type of setting to change. Use \sa { ISensor::available_configurations}
@@ -128,12 +143,222 @@ namespace hal
 					*/
 					int8_t start_single_conversion();
 
+					//! Starts a single conversion of the given channel.
+					/*!
+					* Starts a single conversion of the given channel. Multiplexer, gain, data rate and the start bit
+					* are written with one i2c request. The result can be read with <read_conversion_raw>"()" after
+					* <get_conversion_time_in_us>"()" or as soon as the ALERT/RDY pin signals the end of the conversion.
+					* \param[in] channel: The multiplexer, gain and data rate to use.
+					* \param[in] use_ready_pin: True to signal the end of the conversion on the ALERT/RDY pin. Requires
+					* <enable_conversion_ready_pin>"()" to be called once before. False disables the comparator.
+					* \throws I2CException if writing the device settings fails.
+					*/
+					void start_conversion(const ChannelConfig& channel, bool use_ready_pin = false);
+
+					//! Reads the conversion register.
+					/*!
+					* Reads the conversion register.
+					* \returns the raw (signed) value of the last conversion.
+					* \throws I2CException if reading converted data from the device fails.
+					*/
+					int16_t read_conversion_raw();
+
+					//! Converts the given channel and returns the result.
+					/*!
+					* Starts a single conversion of the given channel, waits until the conversion has finished and
+					* returns the result. Unlike changing the settings and calling <start_single_conversion>"()"
+					* and <get_converted_data>"()" the result always belongs to the requested channel.
+					* \param[in] multiplexer: The inputs to convert.
+					* \param[in] gain_amplifier: The gain to use.
+					* \param[in] data_rate: The data rate to use. Determines the conversion time.
+					* \returns the converted voltage.
+					* \throws I2CException if writing the device settings or reading the converted data fails.
+					* \throws HALException if the conversion did not finish in time.
+					*/
+					double read_single_conversion(Multiplexer multiplexer, GainAmplifier gain_amplifier,
+															DataRate data_rate = DataRate::RATE_128_SPS);
+
+					//! Converts the given channel and returns the raw value together with the voltage.
+					/*!
+					* Converts the given channel and returns the raw value together with the voltage. Channels with
+					* auto_range set are converted like <read_auto_ranged_conversion>"()".
+					* \param[in] channel: The multiplexer, gain and data rate to use.
+					* \returns the converted sample including the gain that was used.
+					* \throws I2CException if writing the device settings or reading the converted data fails.
+					* \throws HALException if a conversion did not finish in time.
+					*/
+					ChannelSample read_sample(const ChannelConfig& channel);
+
+					//! Converts the given channel with a predicted gain and returns the result.
+					/*!
+					* Converts the given channel with a predicted gain and returns the result. The gain should be
+					* predicted from the previous sample with <predict_gain>"()". Only if the result saturates the
+					* channel is converted once more with the widest range.
+					* \param[in] multiplexer: The inputs to convert.
+					* \param[in] predicted_gain: The gain to try first.
+					* \param[in] data_rate: The data rate to use. Determines the conversion time.
+					* \returns the converted sample including the gain that was used.
+					* \throws I2CException if writing the device settings or reading the converted data fails.
+					* \throws HALException if a conversion did not finish in time.
+					*/
+					ChannelSample read_auto_ranged_conversion(Multiplexer multiplexer, GainAmplifier predicted_gain,
+																			DataRate data_rate = DataRate::RATE_128_SPS);
+
+					//! Returns the gain with the highest resolution that does not saturate at the given voltage.
+					/*!
+					* Returns the gain with the highest resolution that does not saturate at the given voltage.
+					* Keeps some headroom so small changes of the signal do not saturate the next conversion.
+					* \param[in] voltage: The voltage of the previous sample.
+					* \returns the gain to use for the next conversion.
+					*/
+					static GainAmplifier predict_gain(double voltage) noexcept;
+
+					//! Checks whether a conversion result is at the limit of the full scale range.
+					/*!
+					* Checks whether a conversion result is at the limit of the full scale range.
+					* \param[in] raw_value: The value of the conversion register.
+					* \returns True if the input exceeded the full scale range of the gain, false otherwise.
+					*/
+					static bool is_saturated(int16_t raw_value) noexcept;
+
+					//! Turns the ALERT/RDY pin into a conversion ready signal.
+					/*!
+					* Turns the ALERT/RDY pin into a conversion ready signal by setting the MSB of the high threshold
+					* to 1 and the MSB of the low threshold to 0. The pin is asserted (active low) at the end of each
+					* conversion that was started with <start_conversion>"()" and use_ready_pin set to true.
+					* \throws I2CException if writing the thresholds fails.
+					*/
+					void enable_conversion_ready_pin();
+
+					//! Captures a burst of conversions of one channel at the full data rate.
+					/*!
+					* Captures a burst of conversions of one channel at the full data rate. The device is switched into
+					* continuous mode and each conversion is read as soon as the ALERT/RDY pin signals it. The register
+					* pointer stays on the conversion register, so reading a sample takes one i2c request. The raw values
+					* are written into the given ring buffer, which is overwritten from the start if the burst is longer
+					* than the buffer. Scale the values afterwards with <raw_to_voltages>"()" or <burst_to_voltages>"()".
+					* Config and threshold registers are restored after the burst. Blocks the calling thread and the
+					* converter until the burst has finished.
+					* \param[in] channel: The multiplexer, gain and data rate to use.
+					* \param[in] ready_line: Line connected to the ALERT/RDY pin. Has to be requested with falling edge
+					* detection and must not be watched by somebody else during the burst.
+					* \param[out] buffer: The ring buffer for the raw values.
+					* \param[in] capacity: The number of values the buffer can hold.
+					* \param[in] sample_count: The number of conversions to read. 0 to only stop after the duration.
+					* \param[in] duration_in_ms: The maximum duration of the burst. 0 to only stop after sample_count conversions.
+					* \returns the position of the samples in the buffer and the timing of the burst.
+					* \throws HALException if the line or buffer is null, the capacity is 0 or the burst has no end.
+					* \throws HALException if the conversion ready signal did not arrive in time.
+					* \throws I2CException if configuring the device or reading a sample fails.
+					*/
+					BurstResult capture_burst(const ChannelConfig& channel, const std::shared_ptr<interfaces::IGPIOLine>& ready_line,
+													  int16_t* buffer, size_t capacity, uint64_t sample_count, uint32_t duration_in_ms = 0);
+
+					//! Converts a block of raw conversion values into voltages.
+					/*!
+					* Converts a block of raw conversion values into voltages. Does not access the device.
+					* \param[in] raw_values: The values of the conversion register.
+					* \param[in] count: The number of values.
+					* \param[in] gain_amplifier: The gain that was used for the conversions.
+					* \param[out] voltages: Buffer for count voltages.
+					*/
+					static void raw_to_voltages(const int16_t* raw_values, size_t count, GainAmplifier gain_amplifier,
+														 double* voltages) noexcept;
+
+					//! Converts the samples of a burst into voltages in the order they were captured.
+					/*!
+					* Converts the samples of a burst into voltages in the order they were captured. Unrolls the ring buffer
+					* if the burst wrapped around. Does not access the device.
+					* \param[in] buffer: The ring buffer that was passed to <capture_burst>"()".
+					* \param[in] capacity: The number of values the buffer can hold.
+					* \param[in] result: The result of <capture_burst>"()".
+					* \param[out] voltages: Buffer for result.sample_count voltages.
+					*/
+					static void burst_to_voltages(const int16_t* buffer, size_t capacity, const BurstResult& result,
+															double* voltages) noexcept;
+
+					//! Publishes values only if the signal leaves a voltage window.
+					/*!
+					* Publishes values only if the signal leaves a voltage window. The device converts the channel
+					* continuously and compares each result with the window in hardware (window comparator, not latching).
+					* The ALERT/RDY pin falls as soon as the signal is outside of the window and rises once it is back
+					* inside. Only the falling edge reads the conversion register and invokes the CONVERTER callbacks,
+					* so there is no bus traffic while the signal stays inside (or outside) of the window. A previously
+					* started event mode is stopped first.
+					* \param[in] channel: The multiplexer, gain and data rate to use.
+					* \param[in] lower_voltage: The lower bound of the window.
+					* \param[in] upper_voltage: The upper bound of the window.
+					* \param[in] alert_line: Line connected to the ALERT/RDY pin. Has to be requested with detection of both edges.
+					* \param[in] queue: The number of conversions outside of the window until the pin is asserted.
+					* \throws HALException if the line is null, the queue is disabled or the window is empty.
+					* \throws HALException if the line could not be watched.
+					* \throws I2CException if writing the thresholds or the config register fails.
+					*/
+					void start_event_mode(const ChannelConfig& channel, double lower_voltage, double upper_voltage,
+												 const std::shared_ptr<interfaces::IGPIOLine>& alert_line,
+												 AlertQueueing queue = AlertQueueing::ASSERT_1_CONVERSION);
+
+					//! Stops publishing values on window exits.
+					/*!
+					* Stops publishing values on window exits. Blocks until a running handler returned. The device is
+					* switched back to single shot mode and the default thresholds are restored.
+					*/
+					void stop_event_mode() noexcept;
+
+					//! Checks whether the event mode is active.
+					/*!
+					* Checks whether the event mode is active.
+					* \returns True if values are published on window exits, false otherwise.
+					*/
+					bool is_event_mode_active() const noexcept;
+
+					//! Converts a voltage into the raw value of the conversion or threshold registers.
+					/*!
+					* Converts a voltage into the raw value of the conversion or threshold registers. Does not access the device.
+					* \param[in] voltage: The voltage to convert.
+					* \param[in] gain_amplifier: The gain of the conversion.
+					* \returns the raw value. Clamped to the full scale range of the gain.
+					*/
+					static int16_t voltage_to_raw(double voltage, GainAmplifier gain_amplifier) noexcept;
+
+					//! Converts a raw conversion value into voltage.
+					/*!
+					* Converts a raw conversion value into voltage. Does not access the device.
+					* \param[in] raw_value: The value of the conversion register.
+					* \param[in] gain_amplifier: The gain that was used for the conversion.
+					* \returns the voltage.
+					*/
+					static double raw_to_voltage(int16_t raw_value, GainAmplifier gain_amplifier) noexcept;
+
+					//! Returns the maximum time a conversion with the given data rate takes.
+					/*!
+					* Returns the maximum time a conversion with the given data rate takes.
+					* \param[in] data_rate: The data rate of the conversion.
+					* \returns the conversion time in microseconds including a safety margin.
+					*/
+					static uint32_t get_conversion_time_in_us(DataRate data_rate) noexcept;
+
+					//! Returns the number of conversions per second of the given data rate.
+					/*!
+					* Returns the number of conversions per second of the given data rate.
+					* \param[in] data_rate: The data rate.
+					* \returns the conversions per second.
+					*/
+					static uint16_t get_samples_per_second(DataRate data_rate) noexcept;
+
+					//! Returns the full scale range of the given gain.
+					/*!
+					* Returns the full scale range of the given gain.
+					* \param[in] gain_amplifier: The gain.
+					* \returns the full scale range in millivolts.
+					*/
+					static double get_full_scale_in_mv(GainAmplifier gain_amplifier) noexcept;
+
 					//! Checks whether the device is currently converting an analog value.
 					/*!
 					* Checks whether the device is currently converting an analog value.
 					* \returns true if the device is currently converting, false otherwise.
 					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if checking whether the convert bit of the config byte is set fails.
 					*/
 					bool is_converting();
 
@@ -211,90 +436,88 @@ namespace hal
 
 					//! Sets a new multiplexer setting.
 					/*!
-					* Sets a new multiplexer setting.
+					* Sets a new multiplexer setting. Nothing is written if the setting did not change and the device
+					* settings are only read before the first change.
 					* \param[in] new_multiplexer_setting: The new multiplexer setting.
 					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if setting multiplexer bits in config byte fails.
 					* \throws I2CException if writing the device settings fails.
 					*/
 					void set_multiplexer_setting(Multiplexer new_multiplexer_setting);
 
 					//! Sets a new gain amplifier setting.
 					/*!
-					* Sets a new gain amplifier setting.
+					* Sets a new gain amplifier setting. Nothing is written if the setting did not change and the device
+					* settings are only read before the first change.
 					* \param[in] new_gain_amplifier_setting: The new gain amplifier setting.
 					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if setting gain amplifier bits in config byte fails.
 					* \throws I2CException if writing the device settings fails.
 					*/
 					void set_gain_amplifier_setting(GainAmplifier new_gain_amplifier_setting);
 
 					//! Sets a new operation mode setting.
 					/*!
-					* Sets a new operation mode setting.
+					* Sets a new operation mode setting. Nothing is written if the setting did not change and the device
+					* settings are only read before the first change.
 					* \param[in] new_operation_mode_setting: The new operation mode setting.
 					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if setting operation mode bits in config byte fails.
 					* \throws I2CException if writing the device settings fails.
 					*/
 					void set_operation_mode_setting(OperationMode new_operation_mode_setting);
 
 					//! Sets a new data rate setting.
 					/*!
-					* Sets a new data rate setting.
+					* Sets a new data rate setting. Nothing is written if the setting did not change and the device
+					* settings are only read before the first change.
 					* \param[in] new_data_rate_setting: The new data rate setting.
 					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if setting data rate bits in config byte fails.
 					* \throws I2CException if writing the device settings fails.
 					*/
 					void set_data_rate_setting(DataRate new_data_rate_setting);
 
 					//! Sets a new comparator mode setting.
 					/*!
-					* Sets a new comparator mode setting.
+					* Sets a new comparator mode setting. Nothing is written if the setting did not change and the device
+					* settings are only read before the first change.
 					* \param[in] new_comparator_mode_setting: The new comparator mode setting.
 					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if setting comparator mode bits in config byte fails.
 					* \throws I2CException if writing the device settings fails.
 					*/
 					void set_comparator_mode_setting(ComparatorMode new_comparator_mode_setting);
 
 					//! Sets a new comparator polarity setting.
 					/*!
-					* Sets a new comparator polarity setting.
+					* Sets a new comparator polarity setting. Nothing is written if the setting did not change and the device
+					* settings are only read before the first change.
 					* \param[in] new_comparator_polarity_setting: The new comparator polarity setting.
 					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if setting pin polarity bits in config byte fails.
 					* \throws I2CException if writing the device settings fails.
 					*/
 					void set_comparator_polarity_setting(AlertPolarity new_comparator_polarity_setting);
 
 					//! Sets a new comparator latching setting.
 					/*!
-					* Sets a new comparator latching setting.
+					* Sets a new comparator latching setting. Nothing is written if the setting did not change and the device
+					* settings are only read before the first change.
 					* \param[in] new_comparator_latching_setting: The new comparator latching setting.
 					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if setting comparator latching bits in config byte fails.
 					* \throws I2CException if writing the device settings fails.
 					*/
 					void set_comparator_latching_setting(AlertLatching new_comparator_latching_setting);
 
 					//! Sets a new comparator queue setting.
 					/*!
-					* Sets a new comparator queue setting.
+					* Sets a new comparator queue setting. Nothing is written if the setting did not change and the device
+					* settings are only read before the first change.
 					* \param[in] new_comparator_queue_setting: The new comparator queue setting.
 					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if setting comparator queue bits in config byte fails.
 					* \throws I2CException if writing the device settings fails.
 					*/
 					void set_comparator_queue_setting(AlertQueueing new_comparator_queue_setting);
 
 					//! Sets all settings at once.
 					/*!
-					* Sets all settings at once.
+					* Sets all settings at once. Nothing is written if the settings did not change.
 					* \param[in] new_settings: The new settings.
-					* \throws I2CException if reading the device settings fails.
-					* \throws HALException if changing setting bits in config byte fails.
 					* \throws I2CException if writing the device settings fails.
 					*/
 					void set_settings(struct Configuration new_settings);
@@ -314,6 +537,13 @@ namespace hal
 					*/
 					double get_converted_data();
 
+					//! Returns the last converted data without throwing.
+					/*!
+					* Like <get_converted_data>"()", but reports failures with the returned result instead of an exception.
+					* \returns The converted data or the error of the failed read.
+					*/
+					utils::Result<double> read_converted_data() noexcept;
+
 					//! Returns the upper (high) threshold.
 					/*!
 					* Returns the upper (high) threshold.
@@ -341,7 +571,7 @@ namespace hal
 
 					//! Sets the upper (high) threshold.
 					/*!
-					* Sets the upper (high) threshold.
+					* Sets the upper (high) threshold. Nothing is written if the threshold did not change.
 					* \param[in] upper_threshold: The upper (high) threshold.
 					* \throws I2CException if writing the upper threshold fails.
 					*/
@@ -349,7 +579,7 @@ namespace hal
 
 					//! Sets the lower (low) threshold.
 					/*!
-					* Sets the lower (low) threshold.
+					* Sets the lower (low) threshold. Nothing is written if the threshold did not change.
 					* \param[in] lower_threshold: The lower (low) threshold.
 					* \throws I2CException if writing the lower threshold fails.
 					*/
@@ -391,72 +621,64 @@ namespace hal
 					*  Extracts the multiplexer bits from the given byte and parses them into the resulting enum.
 					* \param[in] raw_data: A setting byte that was read from the device.
 					* \returns The parsed multiplexer value as Multiplexer enum.
-					* \throws HALException if reading the multiplexer bits fails.
 					*/
-					static Multiplexer parse_multiplexer_value(uint8_t raw_data);
+					static Multiplexer parse_multiplexer_value(uint8_t raw_data) noexcept;
 
 					//! Extracts the gain amplifier bits from the given byte and parses them into the resulting enum.
 					/*!
 					*  Extracts the gain amplifier bits from the given byte and parses them into the resulting enum.
 					* \param[in] raw_data: A setting byte that was read from the device.
 					* \returns The parsed gain amplifier value as GainAmplifier enum.
-					* \throws HALException if reading the gain amplifier bits fails.
 					*/
-					static GainAmplifier parse_gain_amplifier_value(uint8_t raw_data);
+					static GainAmplifier parse_gain_amplifier_value(uint8_t raw_data) noexcept;
 
 					//! Extracts the operation mode bit from the given byte and parses it into the resulting enum.
 					/*!
 					*  Extracts the operation mode bit from the given byte and parses it into the resulting enum.
 					* \param[in] raw_data: A setting byte that was read from the device.
 					* \returns The parsed operation mode value as OperationMode enum.
-					* \throws HALException if reading the operation mode bits fails.
 					*/
-					static OperationMode parse_operation_mode_value(uint8_t raw_data);
+					static OperationMode parse_operation_mode_value(uint8_t raw_data) noexcept;
 
 					//! Extracts the data rate bits from the given byte and parses them into the resulting enum.
 					/*!
 					*  Extracts the data rate bits from the given byte and parses them into the resulting enum.
 					* \param[in] raw_data: A setting byte that was read from the device.
 					* \returns The parsed data rate value as DataRate enum.
-					* \throws HALException if reading the data rate bits fails.
 					*/
-					static DataRate parse_data_rate_value(uint8_t raw_data);
+					static DataRate parse_data_rate_value(uint8_t raw_data) noexcept;
 
 					//! Extracts the comparator mode bit from the given byte and parses it into the resulting enum.
 					/*!
 					*  Extracts the comparator mode bit from the given byte and parses it into the resulting enum.
 					* \param[in] raw_data: A setting byte that was read from the device.
 					* \returns The parsed comparator mode value as ComparatorMode enum.
-					* \throws HALException if reading the comparator mode bits fails.
 					*/
-					static ComparatorMode parse_comparator_mode_value(uint8_t raw_data);
+					static ComparatorMode parse_comparator_mode_value(uint8_t raw_data) noexcept;
 
 					//! Extracts the comparator polarity bit from the given byte and parses it into the resulting enum.
 					/*!
 					*  Extracts the comparator polarity bit from the given byte and parses it into the resulting enum.
 					* \param[in] raw_data: A setting byte that was read from the device.
 					* \returns The parsed comparator polarity value as AlertPolarity enum.
-					* \throws HALException if reading the pin polarity bits fails.
 					*/
-					static AlertPolarity parse_comparator_polarity_value(uint8_t raw_data);
+					static AlertPolarity parse_comparator_polarity_value(uint8_t raw_data) noexcept;
 
 					//! Extracts the comparator latching bit from the given byte and parses it into the resulting enum.
 					/*!
 					*  Extracts the comparator latching bit from the given byte and parses it into the resulting enum.
 					* \param[in] raw_data: A setting byte that was read from the device.
 					* \returns The parsed comparator latching value as AlertLatching enum.
-					* \throws HALException if reading the comparator latching bits fails.
 					*/
-					static AlertLatching parse_comparator_latching_value(uint8_t raw_data);
+					static AlertLatching parse_comparator_latching_value(uint8_t raw_data) noexcept;
 
 					//! Extracts the comparator queuing bits from the given byte and parses them into the resulting enum.
 					/*!
 					*  Extracts the comparator queuing bits from the given byte and parses them into the resulting enum.
 					* \param[in] raw_data: A setting byte that was read from the device.
 					* \returns The parsed comparator queuing value as AlertQueueing enum.
-					* \throws HALException if reading the comparator queue bits fails.
 					*/
-					static AlertQueueing parse_comparator_queueing_value(uint8_t raw_data);
+					static AlertQueueing parse_comparator_queueing_value(uint8_t raw_data) noexcept;
 
 					//! Converts the bit value read via i2c based on the current gain amplifier to voltage.
 					/*!
@@ -492,9 +714,91 @@ namespace hal
 					*/
 					int8_t read_operation(int handle, uint8_t address, uint8_t* buffer, uint16_t length = 2);
 
+					//! Reads the configuration register if its content is not known yet.
+					/*!
+					*  Reads the configuration register into the register map if its content is not known yet, e.g. after
+					*  <init>"()" or <soft_reset>"()".
+					* \throws I2CException if reading the device settings fails.
+					*/
+					void load_settings();
+
+					//! Reads the configuration register if its content is not known yet, without throwing.
+					/*!
+					*  Like <load_settings>"()", but reports failures with the returned result. Used on the acquisition path.
+					* \returns the result of the read.
+					*/
+					utils::Result<void> try_load_settings() noexcept;
+
+					//! Updates the register map after a transfer that bypassed it.
+					/*!
+					*  Updates the register map after a transfer that bypassed it. Only the configuration and threshold
+					*  registers are kept in the map, the OS bit of the configuration is not kept.
+					* \param[in] address: The register address.
+					* \param[in] buffer: The transferred register content.
+					* \param[in] length: The number of transferred bytes.
+					*/
+					void remember_register(uint8_t address, const uint8_t* buffer, uint16_t length) noexcept;
+
+					//! Builds the two config register bytes for a conversion.
+					/*!
+					* Builds the two config register bytes for a conversion. The start bit is only set in single shot mode.
+					* \param[in] channel: The multiplexer, gain and data rate to use.
+					* \param[in] operation_mode: Single shot or continuous conversions.
+					* \param[in] use_ready_pin: True to assert the ALERT/RDY pin after each conversion, false to disable the comparator.
+					* \param[out] raw_settings: The config register bytes.
+					*/
+					static void encode_conversion(const ChannelConfig& channel, OperationMode operation_mode, bool use_ready_pin,
+															uint8_t raw_settings[REG_READ_LEN]) noexcept;
+
+					//! Converts the given channel and returns the raw result.
+					/*!
+					* Starts a single conversion of the given channel, waits until the conversion has finished and
+					* returns the raw result. The wait is recorded in the "ads1115.conversion_wait_ns" metric (and
+					* traced as "ads1115.conversion_wait"), a conversion that did not finish in time in
+					* "ads1115.conversion_timeouts".
+					* \param[in] channel: The multiplexer, gain and data rate to use.
+					* \returns the raw value of the conversion register.
+					* \throws I2CException if writing the device settings or reading the converted data fails.
+					* \throws HALException if the conversion did not finish in time.
+					*/
+					int16_t convert_raw(const ChannelConfig& channel);
+
+					//! Handler that is executed if the ALERT/RDY pin reported an edge in event mode.
+					/*!
+					* Handler that is executed if the ALERT/RDY pin reported an edge in event mode. Consumes the edge
+					* event and publishes the current value if the signal left the window.
+					* \throws HALException if reading the conversion register fails.
+					*/
+					void on_alert_edge();
+
+					//! Handler that is executed periodically while the event mode is active.
+					/*!
+					* Handler that is executed periodically while the event mode is active. Compares the level of the
+					* ALERT/RDY pin with the last known window state in case an edge got lost. Does not access the bus.
+					* \throws HALException if reading the conversion register fails.
+					*/
+					void on_alert_watchdog();
+
+					//! Reads the conversion register and invokes the CONVERTER callbacks.
+					/*!
+					* Reads the conversion register and invokes the CONVERTER callbacks with the voltage.
+					* \throws HALException if reading the conversion register fails.
+					*/
+					void publish_window_exit();
+
 					int m_file_handle{};
 					uint8_t m_dev_id{};
 					uint8_t m_chip_id{};
+					std::recursive_mutex m_mutex{};
+					RegisterMap m_registers{CONFIG_REG, HIGH_THRESHOLD_REG - CONFIG_REG + 1, RegisterAccess::SINGLE_REGISTER, REG_READ_LEN};
+					std::shared_ptr<interfaces::IGPIOLine> m_alert_line{};
+					std::atomic_bool m_event_mode = ATOMIC_VAR_INIT(false);
+					ChannelConfig m_event_channel{};
+					bool m_outside_window{};
+					uint32_t m_alert_watch_handle{};
+					uint32_t m_alert_watchdog_handle{};
+					Histogram* m_conversion_wait{};
+					Counter* m_conversion_timeouts{};
 				};
 			}
 		}
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstdint>
+#include "../../utils/RegisterField.h"
 
 namespace hal
 {
@@ -53,6 +55,22 @@ namespace hal
 				static constexpr uint8_t COMPARATOR_LATCHING_MASK = 0x04;
 				static constexpr uint8_t COMPARATOR_QUEUEING_MASK = 0x03;
 
+				// Config register fields (byte 0 is the MSB, byte 1 the LSB of the transferred register)
+				using OperationalStatusFlag = utils::Flag<CONFIG_REG, STATUS_BIT, 0>;
+				using MultiplexerField = utils::Field<CONFIG_REG, MULTIPLEXER_BIT_1, 3, 0>;
+				using GainAmplifierField = utils::Field<CONFIG_REG, GAIN_AMPLIFIER_BIT_1, 3, 0>;
+				using OperationModeField = utils::Field<CONFIG_REG, OPERATION_MODE_BIT, 1, 0>;
+				using DataRateField = utils::Field<CONFIG_REG, DATA_RATE_BIT_1, 3, 1>;
+				using ComparatorModeField = utils::Field<CONFIG_REG, COMPARATOR_MODE_BIT, 1, 1>;
+				using ComparatorPolarityField = utils::Field<CONFIG_REG, COMPARATOR_POL_BIT, 1, 1>;
+				using ComparatorLatchingField = utils::Field<CONFIG_REG, COMPARATOR_LAT_BIT, 1, 1>;
+				using ComparatorQueueingField = utils::Field<CONFIG_REG, COMPARATOR_QUEUE_BIT_1, 2, 1>;
+				static_assert(MultiplexerField::MASK == MULTIPLEXER_MASK && GainAmplifierField::MASK == GAIN_AMPLIFIER_MASK &&
+					OperationModeField::MASK == OPERATION_MODE_MASK && DataRateField::MASK == DATA_RATE_MASK &&
+					ComparatorModeField::MASK == COMPARATOR_MODE_MASK && ComparatorPolarityField::MASK == COMPARATOR_POLARITY_MASK &&
+					ComparatorLatchingField::MASK == COMPARATOR_LATCHING_MASK && ComparatorQueueingField::MASK == COMPARATOR_QUEUEING_MASK,
+					"The register fields do not match the bit masks.");
+
 				// Default values
 				static constexpr uint8_t DEFAULT_SETTINGS_BYTE_1 = 0x85;
 				static constexpr uint8_t DEFAULT_SETTINGS_BYTE_2 = 0x83;
@@ -60,6 +78,31 @@ namespace hal
 				static constexpr uint8_t DEFAULT_LOW_THRES_BYTE_2 = 0x00;
 				static constexpr uint8_t DEFAULT_HIGH_THRES_BYTE_1 = 0x7F;
 				static constexpr uint8_t DEFAULT_HIGH_THRES_BYTE_2 = 0xFF;
+
+				// Conversion ready pin (ALERT/RDY). Setting the MSB of the high threshold to 1 and of the low threshold
+				// to 0 turns the comparator into a conversion ready signal.
+				static constexpr uint8_t READY_HIGH_THRES_BYTE_1 = 0x80;
+				static constexpr uint8_t READY_HIGH_THRES_BYTE_2 = 0x00;
+				static constexpr uint8_t READY_LOW_THRES_BYTE_1 = 0x00;
+				static constexpr uint8_t READY_LOW_THRES_BYTE_2 = 0x00;
+
+				// Auto range
+				static constexpr int16_t RAW_MAX_VALUE = 32767;
+				static constexpr int16_t RAW_MIN_VALUE = -32768;
+				static constexpr double AUTO_RANGE_HEADROOM = 0.1;
+				// Share of the full scale range that is kept free so small changes of the signal do not saturate the predicted gain
+				static constexpr auto AUTO_RANGE_GAIN_SETTING = "GAIN_AUTO";
+
+				// Time constants
+				static constexpr uint32_t CONVERSION_MARGIN_IN_US = 100;
+				// Added to the nominal conversion time since the internal oscillator may run up to 10% slow
+				static constexpr uint32_t CONVERSION_POLL_INTERVAL_IN_US = 100;
+				// Time between two reads of the OS bit while waiting for a conversion
+				static constexpr uint32_t CONVERSION_TIMEOUT_IN_MS = 10;
+				// Additional time after the expected end of a conversion until it is considered as failed
+				static constexpr uint64_t NANOSECONDS_PER_SECOND = 1000000000;
+				static constexpr uint32_t ALERT_WATCHDOG_PERIOD_IN_MS = 1000;
+				// Period of the level check of the ALERT/RDY pin in event mode. Catches lost edges
 			}
 		}
 	}
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 
 namespace hal
 {
@@ -85,6 +87,34 @@ namespace hal
 					AlertLatching alert_latching = AlertLatching::DISABLED;
 					AlertQueueing alert_queueing = AlertQueueing::DISABLED;
 				};
+
+				struct ChannelConfig
+				{
+					Multiplexer multiplexer = Multiplexer::POSITIVE_0_AND_NEGATIVE_GND;
+					GainAmplifier gain_amplifier = GainAmplifier::GAIN_4096_mV;
+					DataRate data_rate = DataRate::RATE_128_SPS;
+					bool auto_range = false; // Predict the gain from the previous sample. gain_amplifier is only the first guess
+				};
+
+				struct ChannelSample
+				{
+					int16_t raw_value; // Value of the conversion register
+					double voltage; // Raw value scaled with the gain of the conversion
+					GainAmplifier gain_amplifier; // The gain that was used for the conversion
+					uint64_t sample_count; // Number of conversions of this channel since the scan was started
+					uint64_t timestamp_ns; // Time the conversion was read (steady clock)
+				};
+
+				struct BurstResult
+				{
+					size_t sample_count; // Number of samples in the buffer (at most its capacity)
+					size_t first_index; // Buffer index of the oldest sample. Not 0 if the buffer wrapped around
+					uint64_t total_samples; // Number of conversions read during the burst
+					uint32_t missed_conversions; // Conversions that were skipped because a sample was read too late
+					uint64_t start_timestamp_ns; // Time of the first conversion ready edge
+					uint64_t end_timestamp_ns; // Time of the last conversion ready edge
+					GainAmplifier gain_amplifier; // The gain that was used for the conversions
+				};
 			}
 		}
 	}
@@ -0,0 +1,258 @@
+#include "ADS1115ScanEngine.h"
+#include "ADS1115Constants.h"
+
+#include "../../exceptions/HALException.h"
+#include "../../structs/GPIOEvent.h"
+#include "../../utils/EventScheduler.h"
+
+#include <chrono>
+#include <iostream>
+
+hal::sensors::i2c::ads1115::ScanEngine::ScanEngine(std::shared_ptr<ADS1115> converter, std::shared_ptr<interfaces::IGPIOLine> ready_line)
+	: m_converter(std::move(converter)),
+	  m_ready_line(std::move(ready_line))
+{
+	if (m_converter == nullptr)
+	{
+		throw exception::HALException("ScanEngine", "ScanEngine", "The converter must not be null.");
+	}
+}
+
+hal::sensors::i2c::ads1115::ScanEngine::~ScanEngine()
+{
+	stop();
+}
+
+size_t hal::sensors::i2c::ads1115::ScanEngine::add_channel(const ChannelConfig& channel)
+{
+	std::lock_guard<std::mutex> guard(m_scan_mutex);
+	if (m_is_running)
+	{
+		throw exception::HALException("ScanEngine", "add_channel", "Channels cannot be added while the engine is running.");
+	}
+
+	std::lock_guard<std::mutex> samples_guard(m_samples_mutex);
+	m_channels.push_back(channel);
+	m_samples.push_back(ChannelSample{0, 0.0, channel.gain_amplifier, 0, 0});
+	return m_channels.size() - 1;
+}
+
+void hal::sensors::i2c::ads1115::ScanEngine::start()
+{
+	std::lock_guard<std::mutex> guard(m_scan_mutex);
+	if (m_is_running)
+	{
+		return;
+	}
+	if (m_channels.empty())
+	{
+		throw exception::HALException("ScanEngine", "start", "No channel was added.");
+	}
+
+	try
+	{
+		if (m_ready_line != nullptr)
+		{
+			m_converter->enable_conversion_ready_pin();
+			m_ready_watch_handle = utils::EventScheduler::instance().watch_fd(m_ready_line->get_event_fd(), [this]() { on_ready_edge(); });
+		}
+		m_is_running = true;
+		m_current_channel = 0;
+		start_next_conversion();
+	}
+	catch (exception::HALException& ex)
+	{
+		m_is_running = false;
+		utils::EventScheduler::instance().remove(m_ready_watch_handle);
+		utils::EventScheduler::instance().remove(m_timer_handle);
+		m_ready_watch_handle = 0;
+		m_timer_handle = 0;
+		throw exception::HALException("ScanEngine", "start", std::string("Could not start scanning:\n").append(ex.to_string()));
+	}
+}
+
+void hal::sensors::i2c::ads1115::ScanEngine::stop() noexcept
+{
+	// Handlers that wait for the lock return as soon as they see the flag.
+	m_is_running = false;
+
+	uint32_t watch_handle;
+	uint32_t timer_handle;
+	{
+		std::lock_guard<std::mutex> guard(m_scan_mutex);
+		watch_handle = m_ready_watch_handle;
+		timer_handle = m_timer_handle;
+		m_ready_watch_handle = 0;
+		m_timer_handle = 0;
+		m_awaiting_result = false;
+	}
+
+	if (watch_handle != 0)
+	{
+		utils::EventScheduler::instance().remove(watch_handle);
+	}
+	if (timer_handle != 0)
+	{
+		utils::EventScheduler::instance().remove(timer_handle);
+	}
+}
+
+bool hal::sensors::i2c::ads1115::ScanEngine::is_running() const noexcept
+{
+	return m_is_running;
+}
+
+size_t hal::sensors::i2c::ads1115::ScanEngine::get_channel_count() const noexcept
+{
+	std::lock_guard<std::mutex> guard(m_samples_mutex);
+	return m_samples.size();
+}
+
+bool hal::sensors::i2c::ads1115::ScanEngine::get_latest_sample(const size_t slot, ChannelSample& sample) const
+{
+	std::lock_guard<std::mutex> guard(m_samples_mutex);
+	if (slot >= m_samples.size())
+	{
+		throw exception::HALException("ScanEngine", "get_latest_sample",
+												std::string("Invalid slot (").append(std::to_string(slot)).append(")."));
+	}
+
+	sample = m_samples[slot];
+	return sample.sample_count != 0;
+}
+
+void hal::sensors::i2c::ads1115::ScanEngine::start_next_conversion()
+{
+	const auto& channel = m_channels[m_current_channel];
+	m_converter->start_conversion(channel, m_ready_line != nullptr);
+	m_awaiting_result = true;
+
+	// With the ALERT/RDY pin the timer only catches missed edges.
+	auto delay_ms = (ADS1115::get_conversion_time_in_us(channel.data_rate) + 999) / 1000;
+	if (m_ready_line != nullptr)
+	{
+		delay_ms += CONVERSION_TIMEOUT_IN_MS;
+	}
+
+	const auto conversion_id = ++m_conversion_id;
+	m_timer_handle = utils::EventScheduler::instance().add_timer(delay_ms, false,
+																					 [this, conversion_id]() { on_conversion_timer(conversion_id); });
+}
+
+void hal::sensors::i2c::ads1115::ScanEngine::on_ready_edge()
+{
+	// Always consume the event, otherwise the scheduler executes this handler again.
+	GPIOEvent event{};
+	const auto has_event = m_ready_line->read_event(event);
+
+	std::lock_guard<std::mutex> guard(m_scan_mutex);
+	if (!has_event || !m_is_running || !m_awaiting_result || event.edge != GPIOEdge::FALLING)
+	{
+		return;
+	}
+
+	// The fallback timer is not needed anymore. Removing it on the scheduler thread does not block.
+	utils::EventScheduler::instance().remove(m_timer_handle);
+	m_timer_handle = 0;
+	finish_conversion();
+}
+
+void hal::sensors::i2c::ads1115::ScanEngine::on_conversion_timer(const uint64_t conversion_id)
+{
+	std::lock_guard<std::mutex> guard(m_scan_mutex);
+	if (!m_is_running || conversion_id != m_conversion_id)
+	{
+		return;
+	}
+
+	m_timer_handle = 0; // One-shot timer, removed by the scheduler after this callback
+	if (!m_awaiting_result) // The previous conversion failed -> retry
+	{
+		try
+		{
+			start_next_conversion();
+		}
+		catch (exception::HALException& ex)
+		{
+			m_timer_handle = utils::EventScheduler::instance().add_timer(CONVERSION_TIMEOUT_IN_MS, false,
+																							 [this, conversion_id]() { on_conversion_timer(conversion_id); });
+			throw exception::HALException("ScanEngine", "on_conversion_timer",
+													std::string("Could not restart the conversion. Retrying:\n").append(ex.to_string()));
+		}
+		return;
+	}
+
+	bool converting;
+	try
+	{
+		converting = m_converter->is_converting();
+	}
+	catch (exception::HALException& ex)
+	{
+		m_awaiting_result = false;
+		m_timer_handle = utils::EventScheduler::instance().add_timer(CONVERSION_TIMEOUT_IN_MS, false,
+																						 [this, conversion_id]() { on_conversion_timer(conversion_id); });
+		throw exception::HALException("ScanEngine", "on_conversion_timer",
+												std::string("Could not check conversion state. Retrying:\n").append(ex.to_string()));
+	}
+
+	if (converting)
+	{
+		m_timer_handle = utils::EventScheduler::instance().add_timer(1, false,
+																						 [this, conversion_id]() { on_conversion_timer(conversion_id); });
+		return;
+	}
+	finish_conversion();
+}
+
+void hal::sensors::i2c::ads1115::ScanEngine::finish_conversion()
+{
+	m_awaiting_result = false;
+	auto& channel = m_channels[m_current_channel];
+	try
+	{
+		const auto raw_value = m_converter->read_conversion_raw();
+		if (channel.auto_range && ADS1115::is_saturated(raw_value) && channel.gain_amplifier != GainAmplifier::GAIN_6144_mV)
+		{
+			// The prediction was too optimistic. Convert the same channel again with the widest range.
+			channel.gain_amplifier = GainAmplifier::GAIN_6144_mV;
+			start_next_conversion();
+			return;
+		}
+
+		const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+
+		std::lock_guard<std::mutex> guard(m_samples_mutex);
+		auto& sample = m_samples[m_current_channel];
+		sample.raw_value = raw_value;
+		sample.voltage = ADS1115::raw_to_voltage(raw_value, channel.gain_amplifier);
+		sample.gain_amplifier = channel.gain_amplifier;
+		sample.sample_count++;
+		sample.timestamp_ns = static_cast<uint64_t>(timestamp);
+
+		if (channel.auto_range)
+		{
+			channel.gain_amplifier = ADS1115::predict_gain(sample.voltage);
+		}
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "ScanEngine [finish_conversion] Could not read conversion result or restart the channel:\n" << ex.to_string() << std::endl;
+	}
+
+	m_current_channel = (m_current_channel + 1) % m_channels.size();
+	try
+	{
+		start_next_conversion();
+	}
+	catch (exception::HALException& ex)
+	{
+		// Retry the channel later instead of stalling the scan.
+		const auto conversion_id = m_conversion_id;
+		m_timer_handle = utils::EventScheduler::instance().add_timer(CONVERSION_TIMEOUT_IN_MS, false,
+																						 [this, conversion_id]() { on_conversion_timer(conversion_id); });
+		throw exception::HALException("ScanEngine", "finish_conversion",
+												std::string("Could not start next conversion. Retrying:\n").append(ex.to_string()));
+	}
+}
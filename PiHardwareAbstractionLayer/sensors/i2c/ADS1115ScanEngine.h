@@ -0,0 +1,149 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ADS1115.h"
+#include "ADS1115Definitions.h"
+#include "../../interfaces/IGPIOLine.h"
+
+namespace hal
+{
+	namespace sensors
+	{
+		namespace i2c
+		{
+			namespace ads1115
+			{
+				//! Class that converts a list of ADS1115 channels round robin.
+				/*!
+				* This class converts a list of channels (multiplexer, gain and data rate) one after another and stores
+				* the latest result of each channel in its own slot. The next conversion is started as soon as the
+				* previous one has finished, which is detected either by the falling edge of the ALERT/RDY pin or by
+				* polling the OS bit of the config register. All work is done on the \sa { HAL::Utils::EventScheduler } thread.
+				* While scanning the engine owns the converter: Nobody else should start conversions.
+				*/
+				class ScanEngine
+				{
+				public:
+					ScanEngine() = delete;
+					ScanEngine(const ScanEngine&) = delete;
+					ScanEngine(ScanEngine&&) = delete;
+					ScanEngine& operator=(const ScanEngine&) = delete;
+					ScanEngine& operator=(ScanEngine&&) = delete;
+
+					/*!
+					* Constructor.
+					* \param[in] converter: The initialized converter to scan.
+					* \param[in] ready_line: Optional line connected to the ALERT/RDY pin. Has to be requested with
+					* falling edge detection. The OS bit is polled if no line is given.
+					* \throws HALException if the converter is null.
+					*/
+					explicit ScanEngine(std::shared_ptr<ADS1115> converter, std::shared_ptr<interfaces::IGPIOLine> ready_line = nullptr);
+
+					/*!
+					* Destructor. Stops scanning.
+					*/
+					~ScanEngine();
+
+					//! Adds a channel to the scan list.
+					/*!
+					* Adds a channel to the scan list. The same inputs may be added multiple times (e.g. with different gains).
+					* Channels with auto_range set start with their gain and afterwards use the gain predicted from their
+					* previous sample. A saturated result is converted once more with the widest range before the scan continues.
+					* \param[in] channel: The multiplexer, gain and data rate of the channel.
+					* \returns the slot of the channel.
+					* \throws HALException if the engine is running.
+					*/
+					size_t add_channel(const ChannelConfig& channel);
+
+					//! Starts converting the channels.
+					/*!
+					* Starts converting the channels.
+					* \throws HALException if no channel was added.
+					* \throws HALException if the conversion ready pin could not be configured or watched.
+					* \throws HALException if the first conversion could not be started.
+					*/
+					void start();
+
+					//! Stops converting the channels.
+					/*!
+					* Stops converting the channels. Blocks until a running handler returned. The latest samples stay available.
+					*/
+					void stop() noexcept;
+
+					//! Checks whether the engine is running.
+					/*!
+					* Checks whether the engine is running.
+					* \returns True if the channels are converted, false otherwise.
+					*/
+					bool is_running() const noexcept;
+
+					//! Returns the number of channels.
+					/*!
+					* Returns the number of channels.
+					* \returns the number of channels.
+					*/
+					size_t get_channel_count() const noexcept;
+
+					//! Returns the latest sample of a channel.
+					/*!
+					* Returns the latest sample of a channel.
+					* \param[in] slot: The slot returned by <add_channel>"()".
+					* \param[out] sample: The latest sample of the channel.
+					* \returns True if the channel was converted at least once, false otherwise.
+					* \throws HALException if the slot is invalid.
+					*/
+					bool get_latest_sample(size_t slot, ChannelSample& sample) const;
+
+				protected:
+					//! Starts the conversion of the current channel.
+					/*!
+					* Starts the conversion of the current channel and schedules the timer that checks for its end.
+					* \throws HALException if starting the conversion or creating the timer fails.
+					*/
+					void start_next_conversion();
+
+					//! Handler that is executed if the ALERT/RDY pin reported an edge.
+					/*!
+					* Handler that is executed if the ALERT/RDY pin reported an edge. Consumes the edge event and
+					* reads the result on a falling edge.
+					* \throws HALException if reading the result or starting the next conversion fails.
+					*/
+					void on_ready_edge();
+
+					//! Handler that is executed if the conversion time of the current channel expired.
+					/*!
+					* Handler that is executed if the conversion time of the current channel expired. Checks the OS bit and
+					* reads the result or checks again shortly. Also catches missed edges of the ALERT/RDY pin.
+					* \param[in] conversion_id: The conversion the timer was created for.
+					* \throws HALException if reading the result or starting the next conversion fails.
+					*/
+					void on_conversion_timer(uint64_t conversion_id);
+
+					//! Reads the result of the current channel and starts the conversion of the next one.
+					/*!
+					* Reads the result of the current channel, stores it in the channel slot and starts the conversion of the next one.
+					* \throws HALException if reading the result or starting the next conversion fails.
+					*/
+					void finish_conversion();
+
+					std::shared_ptr<ADS1115> m_converter{};
+					std::shared_ptr<interfaces::IGPIOLine> m_ready_line{};
+					std::vector<ChannelConfig> m_channels{};
+					std::vector<ChannelSample> m_samples{};
+					mutable std::mutex m_samples_mutex{};
+					std::mutex m_scan_mutex{};
+					std::atomic_bool m_is_running = ATOMIC_VAR_INIT(false);
+					size_t m_current_channel{};
+					uint64_t m_conversion_id{};
+					bool m_awaiting_result{};
+					uint32_t m_ready_watch_handle{};
+					uint32_t m_timer_handle{};
+				};
+			}
+		}
+	}
+}
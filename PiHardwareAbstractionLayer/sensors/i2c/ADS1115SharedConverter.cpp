@@ -0,0 +1,289 @@
+#include "ADS1115SharedConverter.h"
+
+#include "../../exceptions/HALException.h"
+#include "../../utils/EnumConverter.h"
+
+#include <exception>
+
+using namespace hal::utils;
+
+hal::sensors::i2c::ads1115::SharedConverter::SharedConverter(const uint8_t address)
+	: m_address(address)
+{
+}
+
+hal::sensors::i2c::ads1115::SharedConverter::~SharedConverter()
+{
+	try
+	{
+		if (m_converter.is_initialized())
+		{
+			m_converter.close();
+		}
+	}
+	catch (exception::HALException&)
+	{
+		// Nothing left to do with the device
+	}
+}
+
+std::shared_ptr<hal::sensors::i2c::ads1115::SharedConverter> hal::sensors::i2c::ads1115::SharedConverter::for_address(
+	const uint8_t address)
+{
+	// The owner lives as long as at least one sensor holds it
+	static std::mutex registry_mutex;
+	static std::map<uint8_t, std::weak_ptr<SharedConverter>> registry;
+
+	std::lock_guard<std::mutex> guard(registry_mutex);
+	auto owner = registry[address].lock();
+	if (owner == nullptr)
+	{
+		owner = std::make_shared<SharedConverter>(address);
+		registry[address] = owner;
+	}
+	return owner;
+}
+
+hal::sensors::i2c::ads1115::Multiplexer hal::sensors::i2c::ads1115::SharedConverter::single_ended_input(const uint8_t input)
+{
+	switch (input)
+	{
+	case 0:
+		return Multiplexer::POSITIVE_0_AND_NEGATIVE_GND;
+	case 1:
+		return Multiplexer::POSITIVE_1_AND_NEGATIVE_GND;
+	case 2:
+		return Multiplexer::POSITIVE_2_AND_NEGATIVE_GND;
+	case 3:
+		return Multiplexer::POSITIVE_3_AND_NEGATIVE_GND;
+	default:
+		throw exception::HALException("SharedConverter", "single_ended_input",
+												std::string("The converter has no input ").append(std::to_string(input)).append("."));
+	}
+}
+
+void hal::sensors::i2c::ads1115::SharedConverter::init()
+{
+	std::lock_guard<std::mutex> guard(m_device_mutex);
+	if (!m_converter.is_initialized())
+	{
+		try
+		{
+			m_converter.init(m_address);
+		}
+		catch (exception::HALException& ex)
+		{
+			throw exception::HALException("SharedConverter", "init", std::string("Could not open converter:\n").append(ex.to_string()));
+		}
+	}
+	m_sensor_count++;
+}
+
+bool hal::sensors::i2c::ads1115::SharedConverter::is_initialized() const noexcept
+{
+	return m_sensor_count > 0 && m_converter.is_initialized();
+}
+
+void hal::sensors::i2c::ads1115::SharedConverter::close()
+{
+	std::lock_guard<std::mutex> guard(m_device_mutex);
+	if (m_sensor_count == 0 || --m_sensor_count > 0)
+	{
+		return;
+	}
+
+	try
+	{
+		m_converter.close();
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("SharedConverter", "close", std::string("Could not close converter:\n").append(ex.to_string()));
+	}
+}
+
+double hal::sensors::i2c::ads1115::SharedConverter::read_single_conversion(const Multiplexer multiplexer,
+																								  const GainAmplifier gain_amplifier)
+{
+	return request(ChannelConfig{multiplexer, gain_amplifier, DataRate::RATE_128_SPS, false}).voltage;
+}
+
+hal::sensors::i2c::ads1115::ChannelSample hal::sensors::i2c::ads1115::SharedConverter::read_sample(const Multiplexer multiplexer,
+																															  const GainAmplifier gain_amplifier)
+{
+	return request(ChannelConfig{multiplexer, gain_amplifier, DataRate::RATE_128_SPS, false});
+}
+
+hal::sensors::i2c::ads1115::ChannelSample hal::sensors::i2c::ads1115::SharedConverter::read_auto_ranged_conversion(
+	const Multiplexer multiplexer, const GainAmplifier predicted_gain)
+{
+	return request(ChannelConfig{multiplexer, predicted_gain, DataRate::RATE_128_SPS, true});
+}
+
+hal::sensors::i2c::ads1115::GainAmplifier hal::sensors::i2c::ads1115::SharedConverter::predict_gain(const double voltage) noexcept
+{
+	return ADS1115::predict_gain(voltage);
+}
+
+double hal::sensors::i2c::ads1115::SharedConverter::get_full_scale_in_mv(const GainAmplifier gain_amplifier) noexcept
+{
+	return ADS1115::get_full_scale_in_mv(gain_amplifier);
+}
+
+void hal::sensors::i2c::ads1115::SharedConverter::configure(const SensorSetting setting, const std::string& configuration)
+{
+	std::lock_guard<std::mutex> guard(m_device_mutex);
+	try
+	{
+		if (setting == SensorSetting::DATA_RATE)
+		{
+			const auto data_rate = EnumConverter::string_to_data_rate(configuration);
+			m_converter.configure(setting, configuration);
+			m_data_rate = data_rate;
+			return;
+		}
+		m_converter.configure(setting, configuration);
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("SharedConverter", "configure", std::string("Could not change setting:\n").append(ex.to_string()));
+	}
+}
+
+std::string hal::sensors::i2c::ads1115::SharedConverter::get_configuration(const SensorSetting setting)
+{
+	std::lock_guard<std::mutex> guard(m_device_mutex);
+	try
+	{
+		if (setting == SensorSetting::DATA_RATE)
+		{
+			return EnumConverter::enum_to_string(m_data_rate);
+		}
+		return m_converter.get_configuration(setting);
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("SharedConverter", "get_configuration", std::string("Could not read setting:\n").append(ex.to_string()));
+	}
+}
+
+std::vector<hal::SensorSetting> hal::sensors::i2c::ads1115::SharedConverter::available_configurations() noexcept
+{
+	return m_converter.available_configurations();
+}
+
+void hal::sensors::i2c::ads1115::SharedConverter::get_statistics(uint64_t& scan_count, uint64_t& conversion_count) noexcept
+{
+	std::lock_guard<std::mutex> guard(m_queue_mutex);
+	scan_count = m_scan_count;
+	conversion_count = m_conversion_count;
+}
+
+hal::sensors::i2c::ads1115::ChannelSample hal::sensors::i2c::ads1115::SharedConverter::request(const ChannelConfig& channel)
+{
+	auto pending = std::make_shared<PendingRequest>();
+	pending->channel = channel;
+	auto result = pending->result.get_future();
+
+	bool execute_scan;
+	{
+		std::lock_guard<std::mutex> guard(m_queue_mutex);
+		m_pending.push_back(pending);
+		execute_scan = !m_is_scanning;
+		m_is_scanning = true;
+	}
+
+	if (execute_scan)
+	{
+		run_scans();
+	}
+
+	try
+	{
+		return result.get();
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("SharedConverter", "request", std::string("Could not convert channel:\n").append(ex.to_string()));
+	}
+}
+
+void hal::sensors::i2c::ads1115::SharedConverter::run_scans() noexcept
+{
+	while (true)
+	{
+		// Everything that was queued while the previous scan ran is converted in the next one
+		std::vector<std::shared_ptr<PendingRequest>> scan;
+		{
+			std::lock_guard<std::mutex> guard(m_queue_mutex);
+			if (m_pending.empty())
+			{
+				m_is_scanning = false;
+				return;
+			}
+			scan.swap(m_pending);
+			m_scan_count++;
+		}
+
+		std::lock_guard<std::mutex> guard(m_device_mutex);
+		// The requests carry no data rate, every conversion of the scan uses the current one of the converter
+		for (const auto& pending : scan)
+		{
+			pending->channel.data_rate = m_data_rate;
+		}
+		std::vector<bool> done(scan.size(), false);
+		for (size_t i = 0; i < scan.size(); i++)
+		{
+			if (done[i])
+			{
+				continue;
+			}
+
+			const auto& channel = scan[i]->channel;
+			ChannelSample sample{};
+			std::exception_ptr error{};
+			try
+			{
+				sample = convert(channel);
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+
+			// Requests for the same channel share the conversion
+			for (size_t j = i; j < scan.size(); j++)
+			{
+				const auto& other = scan[j]->channel;
+				if (done[j] || other.multiplexer != channel.multiplexer || other.gain_amplifier != channel.gain_amplifier
+					|| other.data_rate != channel.data_rate || other.auto_range != channel.auto_range)
+				{
+					continue;
+				}
+				if (error != nullptr)
+				{
+					scan[j]->result.set_exception(error);
+				}
+				else
+				{
+					scan[j]->result.set_value(sample);
+				}
+				done[j] = true;
+			}
+		}
+	}
+}
+
+hal::sensors::i2c::ads1115::ChannelSample hal::sensors::i2c::ads1115::SharedConverter::convert(const ChannelConfig& channel)
+{
+	{
+		std::lock_guard<std::mutex> guard(m_queue_mutex);
+		m_conversion_count++;
+	}
+
+	if (!m_converter.is_initialized())
+	{
+		throw exception::HALException("SharedConverter", "convert", "The converter is not initialized.");
+	}
+	return m_converter.read_sample(channel);
+}
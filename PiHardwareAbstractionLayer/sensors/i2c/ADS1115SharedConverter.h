@@ -0,0 +1,218 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ADS1115.h"
+#include "ADS1115Constants.h"
+#include "ADS1115Definitions.h"
+#include "../../enums/SensorSetting.h"
+
+namespace hal
+{
+	namespace sensors
+	{
+		namespace i2c
+		{
+			namespace ads1115
+			{
+				//! Owner of one ADS1115 that is shared by several analog sensors.
+				/*!
+				* This class owns the ADS1115 at one i2c address and serializes the conversions of all analog sensors that
+				* are connected to its inputs. Each sensor requests a conversion of its own channel. The first waiting sensor
+				* converts all requests that are pending at that time back to back (one scan) and hands out the results, so
+				* no sensor can switch the multiplexer while another one waits for its conversion. Requests for the same
+				* channel and gain share one conversion. Use <for_address>"()" to get the owner of an address.
+				*/
+				class SharedConverter
+				{
+				public:
+					SharedConverter() = delete;
+					SharedConverter(const SharedConverter&) = delete;
+					SharedConverter(SharedConverter&&) = delete;
+					SharedConverter& operator=(const SharedConverter&) = delete;
+					SharedConverter& operator=(SharedConverter&&) = delete;
+
+					/*!
+					* Constructor. Does not access the device. Prefer <for_address>"()".
+					* \param[in] address: The i2c address of the converter.
+					*/
+					explicit SharedConverter(uint8_t address);
+
+					/*!
+					* Destructor. Closes the device.
+					*/
+					~SharedConverter();
+
+					//! Returns the owner of the converter with the given address.
+					/*!
+					* Returns the owner of the converter with the given address. Creates it if no sensor uses the address yet.
+					* \param[in] address: The i2c address of the converter.
+					* \returns the owner of the converter.
+					*/
+					static std::shared_ptr<SharedConverter> for_address(uint8_t address = CONVERTER_ADDR_IS_GND_I2C_REG);
+
+					//! Returns the single ended multiplexer setting of an input.
+					/*!
+					* Returns the multiplexer setting that converts the given input against ground.
+					* \param[in] input: The input of the converter (0 to 3).
+					* \returns the multiplexer setting.
+					* \throws HALException if the input does not exist.
+					*/
+					static Multiplexer single_ended_input(uint8_t input);
+
+					//! Attaches a sensor to the converter.
+					/*!
+					* Attaches a sensor to the converter. The device is opened by the first sensor.
+					* \throws HALException if the device could not be opened.
+					*/
+					void init();
+
+					//! Checks whether the device is open.
+					/*!
+					* Checks whether the device is open.
+					* \returns True if at least one sensor is attached and the device is open, false otherwise.
+					*/
+					bool is_initialized() const noexcept;
+
+					//! Detaches a sensor from the converter.
+					/*!
+					* Detaches a sensor from the converter. The device is closed after the last sensor detached.
+					* \throws HALException if the device could not be closed.
+					*/
+					void close();
+
+					//! Converts the given channel and returns the result.
+					/*!
+					* Converts the given channel with the data rate of the converter and returns the result. Blocks until
+					* the scan that contains the request has finished.
+					* \param[in] multiplexer: The inputs to convert.
+					* \param[in] gain_amplifier: The gain to use.
+					* \returns the converted voltage.
+					* \throws HALException if the conversion failed.
+					*/
+					double read_single_conversion(Multiplexer multiplexer, GainAmplifier gain_amplifier);
+
+					//! Converts the given channel and returns the raw value together with the voltage.
+					/*!
+					* Converts the given channel with the data rate of the converter and returns the raw value together with the voltage.
+					* \param[in] multiplexer: The inputs to convert.
+					* \param[in] gain_amplifier: The gain to use.
+					* \returns the converted sample.
+					* \throws HALException if the conversion failed.
+					*/
+					ChannelSample read_sample(Multiplexer multiplexer, GainAmplifier gain_amplifier);
+
+					//! Converts the given channel with a predicted gain and returns the result.
+					/*!
+					* Converts the given channel with a predicted gain and returns the result. \sa { ADS1115::read_auto_ranged_conversion }
+					* \param[in] multiplexer: The inputs to convert.
+					* \param[in] predicted_gain: The gain to try first.
+					* \returns the converted sample including the gain that was used.
+					* \throws HALException if the conversion failed.
+					*/
+					ChannelSample read_auto_ranged_conversion(Multiplexer multiplexer, GainAmplifier predicted_gain);
+
+					//! Returns the gain with the highest resolution that does not saturate at the given voltage.
+					/*!
+					* Returns the gain with the highest resolution that does not saturate at the given voltage. \sa { ADS1115::predict_gain }
+					* \param[in] voltage: The voltage of the previous sample.
+					* \returns the gain to use for the next conversion.
+					*/
+					static GainAmplifier predict_gain(double voltage) noexcept;
+
+					//! Returns the full scale range of the given gain.
+					/*!
+					* Returns the full scale range of the given gain. \sa { ADS1115::get_full_scale_in_mv }
+					* \param[in] gain_amplifier: The gain.
+					* \returns the full scale range in millivolts.
+					*/
+					static double get_full_scale_in_mv(GainAmplifier gain_amplifier) noexcept;
+
+					//! Changes a setting of the converter.
+					/*!
+					* Changes a setting of the converter. The setting applies to all attached sensors. DATA_RATE sets the data
+					* rate of the scans. Multiplexer and gain are sent with each request and are not changed by this function.
+					* \param[in] setting: The setting to change.
+					* \param[in] configuration: The new value.
+					* \throws HALException if changing the setting fails.
+					*/
+					void configure(SensorSetting setting, const std::string& configuration);
+
+					//! Returns a setting of the converter.
+					/*!
+					* Returns a setting of the converter.
+					* \param[in] setting: The setting to return.
+					* \returns the current value of the setting as string.
+					* \throws HALException if reading the setting fails.
+					*/
+					std::string get_configuration(SensorSetting setting);
+
+					//! Returns the settings of the converter that can be changed.
+					/*!
+					* Returns the settings of the converter that can be changed.
+					* \returns the settings.
+					*/
+					std::vector<SensorSetting> available_configurations() noexcept;
+
+					//! Returns the number of scans and conversions that were executed.
+					/*!
+					* Returns the number of scans and conversions that were executed. Less conversions than requests means
+					* that requests shared a conversion.
+					* \param[out] scan_count: The number of scans.
+					* \param[out] conversion_count: The number of conversions.
+					*/
+					void get_statistics(uint64_t& scan_count, uint64_t& conversion_count) noexcept;
+
+				protected:
+					//! A conversion that waits for the next scan.
+					struct PendingRequest
+					{
+						ChannelConfig channel;
+						std::promise<ChannelSample> result;
+					};
+
+					//! Queues a conversion and waits for its result.
+					/*!
+					* Queues a conversion and waits for its result. If no scan is running the calling thread executes it.
+					* \param[in] channel: The channel to convert.
+					* \returns the result of the conversion.
+					* \throws HALException if the conversion failed.
+					*/
+					ChannelSample request(const ChannelConfig& channel);
+
+					//! Converts all pending requests until none is left.
+					/*!
+					* Converts all pending requests until none is left. Exceptions are handed to the waiting requests.
+					*/
+					void run_scans() noexcept;
+
+					//! Converts one channel.
+					/*!
+					* Converts one channel.
+					* \param[in] channel: The channel to convert.
+					* \returns the result of the conversion.
+					* \throws HALException if the conversion failed.
+					*/
+					ChannelSample convert(const ChannelConfig& channel);
+
+					ADS1115 m_converter{};
+					uint8_t m_address;
+					DataRate m_data_rate = DataRate::RATE_128_SPS; // Guarded by m_device_mutex
+					std::atomic<uint32_t> m_sensor_count{0};
+					std::mutex m_device_mutex{};
+					std::mutex m_queue_mutex{};
+					std::vector<std::shared_ptr<PendingRequest>> m_pending{};
+					bool m_is_scanning = false;
+					uint64_t m_scan_count = 0;
+					uint64_t m_conversion_count = 0;
+				};
+			}
+		}
+	}
+}
@@ -4,53 +4,46 @@
 #include "../../utils/BitManipulation.h"
 #include "../../utils/Helper.h"
 #include "../../utils/I2CManager.h"
+#include <chrono>
 #include <unistd.h>
 
 void hal::sensors::i2c::bme280::BME280::trigger_measurement(const SensorType type)
 {
-	double val;
-	for (auto i = m_callbacks[type].begin(); i != m_callbacks[type].end(); ++i)
+	measure(type).or_raise();
+}
+
+hal::utils::Result<void> hal::sensors::i2c::bme280::BME280::measure(const SensorType type)
+{
+	if (type != SensorType::TEMPERATURE && type != SensorType::AIR_PRESSURE && type != SensorType::AIR_HUMIDITY)
 	{
-		switch (type)
-		{
-		case SensorType::TEMPERATURE:
-			try
-			{
-				val = get_temperature_data();
-			}
-			catch (exception::HALException& ex)
-			{
-				throw exception::HALException("BME280", "trigger_measurement",
-														std::string("Could not trigger temperature measurement:\n").append(ex.to_string()));
-			}
-			break;
-		case SensorType::AIR_PRESSURE:
-			try
-			{
-				val = get_pressure_data();
-			}
-			catch (exception::HALException& ex)
-			{
-				throw exception::HALException("BME280", "trigger_measurement",
-														std::string("Could not trigger air pressure measurement:\n").append(ex.to_string()));
-			}
-			break;
-		case SensorType::AIR_HUMIDITY:
-			try
-			{
-				val = get_humidity_data();
-			}
-			catch (exception::HALException& ex)
-			{
-				throw exception::HALException("BME280", "trigger_measurement",
-														std::string("Could not trigger air humidity measurement:\n").append(ex.to_string()));
-			}
-			break;
-		default:
-			throw exception::HALException("BME280", "trigger_measurement", "Invalid sensor type.");
-		}
-		(*i)->callback(std::to_string(val));
+		return utils::Error{ErrorCode::INVALID_ARGUMENT, 0, m_dev_id, 0, "BME280", "trigger_measurement"};
+	}
+
+	const auto callbacks = get_value_callbacks(type);
+	if (callbacks.empty())
+	{
+		return {};
+	}
+
+	// One forced measurement delivers all three values, so every callback gets the same one
+	double temperature, pressure, humidity;
+	const auto result = read_all_data(temperature, pressure, humidity);
+	if (!result)
+	{
+		return result.error().with_context("BME280", "trigger_measurement", m_dev_id);
+	}
+
+	const auto value = std::to_string(type == SensorType::TEMPERATURE
+													 ? temperature
+													 : type == SensorType::AIR_PRESSURE
+													 ? pressure
+													 : humidity);
+	TraceScope trace("bme280.dispatch", "driver", m_dev_id);
+	for (const auto& callback : callbacks)
+	{
+		callback->callback(value);
 	}
+	return {};
 }
 
 void hal::sensors::i2c::bme280::BME280::configure(const SensorSetting setting, const std::string& configuration)
@@ -151,6 +144,7 @@ uint8_t hal::sensors::i2c::bme280::BME280::init(const uint8_t device_reg)
 	{
 		throw exception::HALException("BME280", "init", std::string("Could not establish connection with device:\n").append(ex.to_string()));
 	}
+	m_conversion_wait = &MetricsRegistry::instance().histogram("bme280.conversion_wait_ns", device_reg);
 
 	uint8_t try_count = 5;
 	while (try_count)
@@ -181,49 +175,22 @@ void hal::sensors::i2c::bme280::BME280::set_pressure_and_temperature_oversamplin
 	const uint8_t desired_settings,
 	const SettingsData settings) const
 {
-	const auto reg_REG = MEASUREMENT_OVERSAMPLING_REG;
-	uint8_t reg_data[1];
-
-	try
+	if (desired_settings & PRESSURE_SETTING_SELECTION)
 	{
-		I2CManager::read_from_device(m_file_handle, reg_REG, reg_data, 1);
+		m_registers.set<PressureOversamplingField>(settings.pressure_oversampling);
 	}
-	catch (exception::HALException& ex)
+	if (desired_settings & TEMPERATURE_SETTING_SELECTION)
 	{
-		throw exception::I2CException("BME280", "set_pressure_and_temperature_oversampling", m_dev_id, reg_REG,
-												std::string("Could not read pressure and temperature oversampling setting from device:\n").append(
-													ex.to_string()));
+		m_registers.set<TemperatureOversamplingField>(settings.temperature_oversampling);
 	}
 
 	try
 	{
-		if (desired_settings & PRESSURE_SETTING_SELECTION)
-		{
-			BitManipulation::set_bits(reg_data[0],
-									  BitManipulation::multiply_by_2_power_n(settings.pressure_oversampling, BitManipulation::mask_out(PRESSURE_POS, PRESSURE_MASK), uint8_t()),
-									  PRESSURE_MASK);
-		}
-		if (desired_settings & TEMPERATURE_SETTING_SELECTION)
-		{
-			BitManipulation::set_bits(reg_data[0],
-									  BitManipulation::multiply_by_2_power_n(settings.temperature_oversampling, BitManipulation::mask_out(TEMPERATURE_POS, TEMPERATURE_MASK), uint8_t()),
-									  TEMPERATURE_MASK);
-		}
+		write_settings();
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::HALException("BME280", "set_pressure_and_temperature_oversampling",
-												std::string("Could not set pressure/temperature bits:\n").append(ex.to_string()));
-	}
-
-	/* Write the oversampling settings in the register */
-	try
-	{
-		I2CManager::write_to_device(m_file_handle, reg_REG, std::move(reg_data), 1);
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::I2CException("BME280", "set_pressure_and_temperature_oversampling", m_dev_id, reg_REG,
+		throw exception::I2CException("BME280", "set_pressure_and_temperature_oversampling", m_dev_id, MEASUREMENT_OVERSAMPLING_REG,
 												std::string("Could not write pressure and temperature oversampling settings to device:\n").append(
 													ex.to_string()));
 	}
@@ -231,119 +198,66 @@ void hal::sensors::i2c::bme280::BME280::set_pressure_and_temperature_oversamplin
 
 void hal::sensors::i2c::bme280::BME280::set_humidity_oversampling(const SettingsData settings) const
 {
-	/* Humidity related changes will be only effective after a
-	 * write operation to ctrl_meas register
-	 */
-	auto reg_REG = HUMIDITY_OVERSAMPLING_REG;
-	uint8_t ctrl_hum[1] = {static_cast<uint8_t>(settings.humidity_oversampling & HUMIDITY_MASK)};
+	m_registers.set<HumidityOversamplingField>(settings.humidity_oversampling);
 	try
 	{
-		I2CManager::write_to_device(m_file_handle, reg_REG, ctrl_hum, 1);
+		write_settings();
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::I2CException("BME280", "set_humidity_oversampling", m_dev_id, reg_REG,
+		throw exception::I2CException("BME280", "set_humidity_oversampling", m_dev_id, HUMIDITY_OVERSAMPLING_REG,
 												std::string("Could not write humidity setting to device:\n").append(ex.to_string()));
 	}
-
-	reg_REG = MEASUREMENT_OVERSAMPLING_REG;
-	uint8_t ctrl_meas[1];
-	try
-	{
-		I2CManager::read_from_device(m_file_handle, reg_REG, ctrl_meas, 1);
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::I2CException("BME280", "set_humidity_oversampling", m_dev_id, reg_REG,
-												std::string("Could not read settings from device:\n").append(ex.to_string()));
-	}
-
-	try
-	{
-		I2CManager::write_to_device(m_file_handle, reg_REG, ctrl_meas, 1);
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::I2CException("BME280", "set_humidity_oversampling", m_dev_id, reg_REG,
-												std::string("Could not write settings to device (to force the new oversampling take effect):\n").append(
-													ex.to_string()));
-	}
 }
 
 void hal::sensors::i2c::bme280::BME280::set_filter_and_standby_settings(const uint8_t desired_settings, const SettingsData settings) const
 {
-	const auto reg_REG = CONFIG_REG;
-	uint8_t reg_data[1];
-
-	try
+	if (desired_settings & FILTER_SETTING_SELECTION)
 	{
-		I2CManager::read_from_device(m_file_handle, reg_REG, reg_data, 1);
+		m_registers.set<FilterField>(settings.filter);
 	}
-	catch (exception::HALException& ex)
+	if (desired_settings & STANDBY_SETTING_SELECTION)
 	{
-		throw exception::I2CException("BME280", "set_filter_and_standby_settings", m_dev_id, reg_REG,
-												std::string("Could not read filter and standby settings from device:\n").append(ex.to_string()));
+		m_registers.set<StandbyField>(settings.standby_time);
 	}
 
 	try
 	{
-		if (desired_settings & FILTER_SETTING_SELECTION)
-		{
-			BitManipulation::set_bits(reg_data[0],
-									  BitManipulation::multiply_by_2_power_n(settings.filter, BitManipulation::mask_out(FILTER_POS, FILTER_MASK), uint8_t()),
-									  FILTER_MASK);
-		}
-		if (desired_settings & STANDBY_SETTING_SELECTION)
-		{
-			BitManipulation::set_bits(reg_data[0],
-									  BitManipulation::multiply_by_2_power_n(settings.standby_time, BitManipulation::mask_out(STANDBY_POS, STANDBY_MASK), uint8_t()),
-									  STANDBY_MASK);
-		}
+		write_settings();
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::HALException("BME280", "set_filter_and_standby_settings",
-												std::string("Could not set filter/standby bits:\n").append(ex.to_string()));
+		throw exception::I2CException("BME280", "set_filter_and_standby_settings", m_dev_id, CONFIG_REG,
+												std::string("Could not write filter and standby settings to device:\n").append(ex.to_string()));
 	}
+}
 
-	try
-	{
-		I2CManager::write_to_device(m_file_handle, reg_REG, reg_data, 1);
-	}
-	catch (exception::HALException& ex)
+void hal::sensors::i2c::bme280::BME280::set_sensor_mode(const OperationMode mode) const
+{
+	const auto result = try_set_sensor_mode(mode);
+	if (!result)
 	{
-		throw exception::I2CException("BME280", "set_filter_and_standby_settings", m_dev_id, reg_REG,
-												std::string("Could not write filter and standby settings to device:\n").append(ex.to_string()));
+		throw exception::I2CException("BME280", "set_sensor_mode", m_dev_id, MODE_REG,
+												std::string("Could not write new sensor mode:\n").append(result.error().to_string()));
 	}
 }
 
-void hal::sensors::i2c::bme280::BME280::set_sensor_mode(OperationMode mode) const
+hal::utils::Result<void> hal::sensors::i2c::bme280::BME280::try_set_sensor_mode(const OperationMode mode) const noexcept
 {
-	if (mode != get_sensor_mode())
+	m_registers.set<SensorModeField>(mode);
+	const auto result = try_write_settings();
+	if (!result)
 	{
-		uint8_t reg_data[1];
-
-		try
-		{
-			I2CManager::read_from_device(m_file_handle, MODE_REG, reg_data, 1);
-		}
-		catch (exception::HALException& ex)
-		{
-			throw exception::I2CException("BME280", "set_sensor_mode", m_dev_id, MODE_REG,
-													std::string("Could not read settings from device:\n").append(ex.to_string()));
-		}
+		return result;
+	}
 
-		BitManipulation::set_bits(reg_data[0], BitManipulation::mask_out(static_cast<uint8_t>(mode), SENSOR_MODE_MASK), SENSOR_MODE_MASK);
-		try
-		{
-			I2CManager::write_to_device(m_file_handle, MODE_REG, reg_data, 1);
-		}
-		catch (exception::HALException& ex)
-		{
-			throw exception::I2CException("BME280", "set_sensor_mode", m_dev_id, MODE_REG,
-													std::string("Could not write new sensor mode:\n").append(ex.to_string()));
-		}
+	if (mode == OperationMode::FORCED)
+	{
+		// The device goes back to sleep after the measurement, so the next FORCED mode is a change again
+		const auto ctrl_meas = SensorModeField::encode(*m_registers.get_register(MODE_REG), OperationMode::SLEEP);
+		m_registers.store(MODE_REG, &ctrl_meas);
 	}
+	return {};
 }
 
 hal::sensors::i2c::bme280::OperationMode hal::sensors::i2c::bme280::BME280::get_sensor_mode() const
@@ -360,9 +274,9 @@ hal::sensors::i2c::bme280::OperationMode hal::sensors::i2c::bme280::BME280::get_
 												std::string("Could not read device mode:\n").append(ex.to_string()));
 	}
 
-	result[0] = BitManipulation::mask_out(result[0], SENSOR_MODE_MASK);
-	if (result[0] == 0) return OperationMode::SLEEP;
-	if (result[0] == 1 || result[0] == 2) return OperationMode::FORCED;
+	const auto mode = SensorModeField::decode(result[0]);
+	if (mode == 0) return OperationMode::SLEEP;
+	if (mode == 1 || mode == 2) return OperationMode::FORCED;
 	return OperationMode::NORMAL;
 }
 
@@ -379,76 +293,27 @@ void hal::sensors::i2c::bme280::BME280::set_settings(
 	m_device.settings.filter = static_cast<uint8_t>(filter);
 	m_device.settings.standby_time = static_cast<uint8_t>(standby);
 
-	const auto settings_sel = BitManipulation::combine(PRESSURE_SETTING_SELECTION,
-																		BitManipulation::combine(TEMPERATURE_SETTING_SELECTION,
-																										BitManipulation::combine(HUMIDITY_SETTING_SELECTION,
-																																		BitManipulation::combine(
-																																			FILTER_SETTING_SELECTION,
-																																			STANDBY_SETTING_SELECTION))));
+	m_registers.set<HumidityOversamplingField>(humidity);
+	m_registers.set<PressureOversamplingField>(pressure);
+	m_registers.set<TemperatureOversamplingField>(temperature);
+	m_registers.set<FilterField>(filter);
+	m_registers.set<StandbyField>(standby);
 
-	OperationMode sensor_mode;
-	try
-	{
-		sensor_mode = get_sensor_mode();
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("BME280", "set_settings",
-												std::string("Could not read sensor mode:\n").append(ex.to_string()));
-	}
-	std::shared_ptr<SettingsData> settings;
-	try
-	{
-		settings = get_settings();
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("BME280", "set_settings",
-												std::string("Could not read sensor settings:\n").append(ex.to_string()));
-	}
-
-	// Sleep mode and reset
-	if (sensor_mode != OperationMode::SLEEP)
-	{
-		try
-		{
-			soft_reset();
-			reload_device_settings(*settings.get());
-		}
-		catch (exception::HALException& ex)
-		{
-			throw exception::HALException("BME280", "set_settings",
-													std::string("Could not perform soft reset on device:\n").append(ex.to_string()));
-		}
-	}
+	// Writes to the config register may be ignored in normal mode. ctrl_meas precedes config in the transaction,
+	// so the device is asleep when the filter and standby settings arrive.
+	m_registers.set<SensorModeField>(OperationMode::SLEEP);
 
-	// Apply new settings
 	try
 	{
-		if (are_settings_changed(OVERSAMPLING_SETTINGS, settings_sel))
-		{
-			if (BitManipulation::mask_out(settings_sel, HUMIDITY_SETTING_SELECTION))
-			{
-				set_humidity_oversampling(m_device.settings);
-			}
-			if (BitManipulation::mask_out(settings_sel, BitManipulation::combine(PRESSURE_SETTING_SELECTION, TEMPERATURE_SETTING_SELECTION)))
-			{
-				set_pressure_and_temperature_oversampling(settings_sel, m_device.settings);
-			}
-
-			m_device.wait_time = calculate_wait_time();
-		}
-
-		if (are_settings_changed(FILTER_STANDBY_SETTINGS, settings_sel))
-		{
-			set_filter_and_standby_settings(settings_sel, m_device.settings);
-		}
+		write_settings();
 	}
 	catch (exception::HALException& ex)
 	{
 		throw exception::HALException("BME280", "set_settings",
 												std::string("Could not apply new settings to the device:\n").append(ex.to_string()));
 	}
+
+	m_device.wait_time = calculate_wait_time();
 }
 
 std::shared_ptr<hal::sensors::i2c::bme280::SettingsData> hal::sensors::i2c::bme280::BME280::get_settings() const
@@ -495,12 +360,23 @@ void hal::sensors::i2c::bme280::BME280::soft_reset() const
 													std::string("Could not read device status:\n").append(ex.to_string()));
 		}
 	}
-	while (try_run-- && BitManipulation::mask_out(status_reg[0], STATUS_DURING_UPDATE));
+	while (try_run-- && UpdatingFlag::is_set(status_reg[0]));
 
-	if (status_reg[0] & STATUS_DURING_UPDATE)
+	if (UpdatingFlag::is_set(status_reg[0]))
 	{
 		throw exception::I2CException("BME280", "soft_reset", m_dev_id, STATUS_REG, "NVM copy failed.");
 	}
+
+	// The reset restored the default settings
+	try
+	{
+		m_registers.load(m_file_handle);
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::I2CException("BME280", "soft_reset", m_dev_id, HUMIDITY_OVERSAMPLING_REG,
+												std::string("Could not read settings data from device:\n").append(ex.to_string()));
+	}
 }
 
 double hal::sensors::i2c::bme280::BME280::get_temperature_data()
@@ -586,32 +462,31 @@ double hal::sensors::i2c::bme280::BME280::get_humidity_data() const
 
 void hal::sensors::i2c::bme280::BME280::get_all_data(double& temperature, double& pressure, double& humidity)
 {
-	try
-	{
-		set_sensor_mode(OperationMode::FORCED);
-		sleep_until_ready();
-	}
-	catch (exception::HALException& ex)
+	read_all_data(temperature, pressure, humidity).or_raise();
+}
+
+hal::utils::Result<void> hal::sensors::i2c::bme280::BME280::read_all_data(double& temperature, double& pressure, double& humidity) noexcept
+{
+	const auto forced = try_set_sensor_mode(OperationMode::FORCED);
+	if (!forced)
 	{
-		throw exception::HALException("BME280", "get_all_data",
-												std::string("Could not set device mode to FORCED:\n").append(ex.to_string()));
+		return forced.error().with_context("BME280", "get_all_data", m_dev_id);
 	}
+	sleep_until_ready();
 
 	uint8_t reg_data[ALL_DATA_LENGTH] = {0};
-	try
+	const auto read = I2CManager::try_read_from_device(m_file_handle, DATA_REG, reg_data, ALL_DATA_LENGTH);
+	if (!read)
 	{
-		I2CManager::read_from_device(m_file_handle, DATA_REG, reg_data, ALL_DATA_LENGTH);
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::I2CException("BME280", "get_all_data", m_dev_id, DATA_REG,
-												std::string("Could not read raw data:\n").append(ex.to_string()));
+		return read.error().with_context("BME280", "get_all_data", m_dev_id);
 	}
 
+	TraceScope trace("bme280.compensate", "driver", m_dev_id);
 	const auto raw = parse_raw_data(reg_data);
 	temperature = compensate_temperature(m_device.calibration_data, raw->temperature);
 	pressure = compensate_pressure(m_device.calibration_data, raw->pressure);
 	humidity = compensate_humidity(m_device.calibration_data, raw->humidity);
+	return {};
 }
 
 hal::sensors::i2c::bme280::CalibrationData hal::sensors::i2c::bme280::BME280::get_calibration_data() const
@@ -677,7 +552,7 @@ hal::sensors::i2c::bme280::CalibrationData hal::sensors::i2c::bme280::BME280::ge
 	return calibration;
 }
 
-std::shared_ptr<hal::sensors::i2c::bme280::RawData> hal::sensors::i2c::bme280::BME280::parse_raw_data(uint8_t* read_data) const noexcept
+std::shared_ptr<hal::sensors::i2c::bme280::RawData> hal::sensors::i2c::bme280::BME280::parse_raw_data(uint8_t* read_data) noexcept
 {
 	auto raw_data = std::make_shared<RawData>();
 
@@ -700,21 +575,14 @@ std::shared_ptr<hal::sensors::i2c::bme280::RawData> hal::sensors::i2c::bme280::B
 
 std::shared_ptr<hal::sensors::i2c::bme280::SettingsData> hal::sensors::i2c::bme280::BME280::parse_settings(uint8_t* read_data) const
 {
-	try
-	{
-		auto settings = std::make_shared<SettingsData>();
-		settings->humidity_oversampling = BitManipulation::mask_out(read_data[0], HUMIDITY_MASK);
-		settings->pressure_oversampling = BitManipulation::value_of_bits(read_data[2], PRESSURE_POS, 4);
-		settings->temperature_oversampling = BitManipulation::value_of_bits(read_data[2], TEMPERATURE_POS, 7);
-		settings->filter = BitManipulation::value_of_bits(read_data[3], FILTER_POS, 4);
-		settings->standby_time = BitManipulation::value_of_bits(read_data[3], STANDBY_POS, 7);
-		return settings;
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("BME280", "parse_settings",
-												std::string("Could not read value of certain bits from byte:\n").append(ex.to_string()));
-	}
+	// The buffer starts at the humidity oversampling register
+	auto settings = std::make_shared<SettingsData>();
+	settings->humidity_oversampling = HumidityOversamplingField::decode(read_data[HumidityOversamplingField::REGISTER - HUMIDITY_OVERSAMPLING_REG]);
+	settings->pressure_oversampling = PressureOversamplingField::decode(read_data[PressureOversamplingField::REGISTER - HUMIDITY_OVERSAMPLING_REG]);
+	settings->temperature_oversampling = TemperatureOversamplingField::decode(read_data[TemperatureOversamplingField::REGISTER - HUMIDITY_OVERSAMPLING_REG]);
+	settings->filter = FilterField::decode(read_data[FilterField::REGISTER - HUMIDITY_OVERSAMPLING_REG]);
+	settings->standby_time = StandbyField::decode(read_data[StandbyField::REGISTER - HUMIDITY_OVERSAMPLING_REG]);
+	return settings;
 }
 
 void hal::sensors::i2c::bme280::BME280::get_all_raw_data(uint8_t all_data[COMPLETE_FILE_LENGTH]) const
@@ -808,50 +676,40 @@ double hal::sensors::i2c::bme280::BME280::compensate_humidity(const CalibrationD
 	return humidity;
 }
 
-double hal::sensors::i2c::bme280::BME280::calculate_wait_time() const
+double hal::sensors::i2c::bme280::BME280::calculate_wait_time() const noexcept
 {
-	try
-	{
-		auto settings = get_settings();
-		return 1.25 + (2.3 * m_device.settings.temperature_oversampling) + ((2.3 * m_device.settings.pressure_oversampling) + 0.575) + ((2.3 *
-			m_device.settings.humidity_oversampling) + 0.575);
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("BME280", "calculate_wait_time",
-												std::string("Could not read settings from the device:\n").append(ex.to_string()));
-	}
+	return 1.25 + (2.3 * m_device.settings.temperature_oversampling) + ((2.3 * m_device.settings.pressure_oversampling) + 0.575) + ((2.3 *
+		m_device.settings.humidity_oversampling) + 0.575);
 }
 
 void hal::sensors::i2c::bme280::BME280::sleep_until_ready() const noexcept
 {
+	const auto start = std::chrono::steady_clock::now();
 	usleep(static_cast<__useconds_t>(m_device.wait_time * 1000));
+	if (m_conversion_wait != nullptr)
+	{
+		m_conversion_wait->record_since(start);
+	}
+	Tracer::record("bme280.conversion_wait", "driver", m_dev_id, start, std::chrono::steady_clock::now());
 }
 
-void hal::sensors::i2c::bme280::BME280::reload_device_settings(const SettingsData settings) const
+void hal::sensors::i2c::bme280::BME280::write_settings() const
 {
-	try
-	{
-		set_humidity_oversampling(settings);
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("BME280", "reload_device_settings",
-												std::string("Could not reset humidity oversampling setting back to default:\n").append(
-													ex.to_string()));
-	}
-	try
+	try_write_settings().or_raise();
+}
+
+hal::utils::Result<void> hal::sensors::i2c::bme280::BME280::try_write_settings() const noexcept
+{
+	// Humidity related changes will be only effective after a write operation to the ctrl_meas register
+	if (m_registers.is_dirty(HUMIDITY_OVERSAMPLING_REG))
 	{
-		set_filter_and_standby_settings(ALL_SETTING_SELECTION, settings);
+		m_registers.touch(MEASUREMENT_OVERSAMPLING_REG);
 	}
-	catch (exception::HALException& ex)
+
+	const auto result = m_registers.try_apply(m_file_handle);
+	if (!result)
 	{
-		throw exception::HALException("BME280", "reload_device_settings",
-												std::string("Could not reset filter and standby settings back to default:\n").append(ex.to_string()));
+		return result.error();
 	}
-}
-
-bool hal::sensors::i2c::bme280::BME280::are_settings_changed(const uint8_t old_settings, const uint8_t desired_settings) noexcept
-{
-	return BitManipulation::mask_out(old_settings, desired_settings) != 0;
+	return {};
 }
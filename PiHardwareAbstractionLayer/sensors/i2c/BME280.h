@@ -7,6 +7,9 @@
 #include "../../enums/SensorSetting.h"
 #include "../../interfaces/ISensor.h"
 #include "../../utils/Constants.h"
+#include "../../utils/Metrics.h"
+#include "../../utils/Tracer.h"
+#include "../../utils/RegisterMap.h"
 
 using namespace hal::utils;
 
@@ -35,13 +38,19 @@ namespace hal
 					* Tells the hardware to perform a new measurement. The result will be sent with a callback function.
 					* If no callback is registered the measurement cannot be obtained.
 					* \param[in] type: The type of measurement that has to do be done.
-					* \throws HALException if triggering a temperature measurement fails.
-					* \throws HALException if triggering an air pressure measurement fails.
-					* \throws HALException if triggering an air humidity measurement fails.
 					* \throws HALException if the sensor type is invalid.
+					* \throws I2CException if communicating with the device fails.
 					*/
 					void trigger_measurement(SensorType type) override;
 
+					/*!
+					* Performs one forced measurement and sends the value of the given type to all registered callbacks.
+					* Bus failures are returned instead of thrown.
+					* \param[in] type: The type of measurement that has to do be done.
+					* \returns the result of the measurement. INVALID_ARGUMENT if the sensor type is invalid.
+					*/
+					utils::Result<void> measure(SensorType type) override;
+
 					/*!
 					* Changes one specific setting of a sensor.
 					* \param[in] setting: The type of setting to change. Use \sa { ISensor::available_configurations}
@@ -90,24 +99,21 @@ namespace hal
 
 					//! Writes temperature and pressure oversampling settings to the device.
 					/*!
-					* Writes temperature and pressure oversampling settings to the device.
+					* Writes temperature and pressure oversampling settings to the device. Nothing is written if the settings
+					* did not change.
 					* \param desired_settings: selector that defines which oversampling setting should be set
 					* (only temperature, only pressure or both).
 					* \param[in] settings: A settings object containing the new oversampling settings.
-					* \throws I2CException if reading the current oversampling data from the device fails.
-					* \throws HALException if manipulating the temperature/pressure bits fails.
 					* \throws I2CException if writing the new oversampling data to the device fails.
 					*/
 					void set_pressure_and_temperature_oversampling(uint8_t desired_settings, SettingsData settings) const;
 
 					//! Writes humidity oversampling settings to the device.
 					/*!
-					* Writes humidity oversampling settings to the device.
+					* Writes humidity oversampling settings to the device. The ctrl_meas register is rewritten in the same
+					* transaction to make the new setting take effect.
 					* \param[in] settings: A settings object containing the new oversampling settings.
 					* \throws I2CException if writing the new oversampling data to the device fails.
-					* \throws I2CException if reading the current settings data from the device fails.
-					* \throws I2CException if writing settings data to the device fails. This is needed to enforce the new
-					* humidity oversampling setting take effect.
 					*/
 					void set_humidity_oversampling(SettingsData settings) const;
 
@@ -116,8 +122,6 @@ namespace hal
 					* Writes filter and standby settings to the device.
 					* \param[in] desired_settings: selector that defines which setting should be set
 					* \param[in] settings: A settings object containing the new settings.
-					* \throws I2CException if reading the current settings data from the device fails.
-					* \throws HALException if manipulating the filter/standby bits fails.
 					* \throws I2CException if writing the new settings data to the device fails.
 					*/
 					void set_filter_and_standby_settings(uint8_t desired_settings, struct SettingsData settings) const;
@@ -128,7 +132,6 @@ namespace hal
 					* by setting it to FORCED mode. After this measurement the sensor automatically goes back
 					* to sleep mode. If NORMAL mode is used the device continuously delivers sensor data.
 					* \param[in] mode: The mode to set (SLEEP, FORCED, NORMAL).
-					* \throws I2CException if reading the current settings data from the device fails.
 					* \throws I2CException if writing the new settings data to the device fails.
 					*/
 					void set_sensor_mode(OperationMode mode) const;
@@ -145,15 +148,13 @@ namespace hal
 
 					//! Writes the given settings to the device.
 					/*!
-					* Writes the given settings to the device.
+					* Writes the given settings to the device and puts it to sleep. Only the changed registers are written,
+					* all of them with one transaction.
 					* \param[in] temperature: the new temperature oversampling setting.
 					* \param[in] pressure: the new pressure oversampling setting.
 					* \param[in] humidity: the new humidity oversampling setting.
 					* \param[in] filter: the new filter setting.
 					* \param[in] standby: the new standby setting.
-					* \throws HALException if reading the current operation mode from the device fails.
-					* \throws HALException if reading the current settings from the device fails.
-					* \throws HALException if performing a soft reset fails.
 					* \throws HALException if applying new settings fails.
 					*/
 					void set_settings(
@@ -173,10 +174,11 @@ namespace hal
 
 					//! Performs a soft reset on the device.
 					/*!
-					* Performs a soft reset on the device.
+					* Performs a soft reset on the device and reads the restored settings.
 					* \throws I2CException if writing the soft reset command to the device fails.
 					* \throws I2CException if reading the device status fails.
 					* \throws I2CException if copying NVM fails.
+					* \throws I2CException if reading the settings fails.
 					*/
 					void soft_reset() const;
 
@@ -226,15 +228,15 @@ namespace hal
 					*/
 					void get_all_data(double& temperature, double& pressure, double& humidity);
 
-				protected:
-					//! Reads the calibration constants for compensation of the three sensor values from the device.
+					//! Measures all three sensor values at once without throwing.
 					/*!
-					*  Reads the calibration constants for compensation of the three sensor values from the device.
-					* \returns The calibration values.
-					* \throws I2CException if reading temperature and pressure calibration data from the device fails.
-					* \throws I2CException if reading humidity calibration data from the device fails.
+					* Like <get_all_data>"()", but reports failures with the returned result instead of an exception.
+					* \param[out] temperature: The measured temperature.
+					* \param[out] pressure: The measured air pressure.
+					* \param[out] humidity: The measured air humidity.
+					* \returns the result of the measurement.
 					*/
-					CalibrationData get_calibration_data() const;
+					utils::Result<void> read_all_data(double& temperature, double& pressure, double& humidity) noexcept;
 
 					//! Transforms the raw sensor value buffer into a struct.
 					/*!
@@ -242,25 +244,7 @@ namespace hal
 					* \param[in] read_data: The buffer with the raw sensor values.
 					* \returns The resulting raw data struct.
 					*/
-					std::shared_ptr<struct RawData> parse_raw_data(uint8_t* read_data) const noexcept;
-
-					//! Transforms the sensor settings buffer into a struct.
-					/*!
-					*  Transforms the sensor settings buffer into a struct.
-					* \param[in] read_data: The buffer with the settings values.
-					* \returns The resulting settings struct.
-					* \throws HALException if reading the value of certain bits from byte fails.
-					*/
-					std::shared_ptr<struct SettingsData> parse_settings(uint8_t* read_data) const;
-
-					//! Simply reads all content from the device at once.
-					/*!
-					*  Simply reads all content from the device at once. The function should only be used for
-					*  debug purposes.
-					* \param[out] all_data: A buffer to store the content.
-					* \throws I2CException if reading raw data from the device fails.
-					*/
-					void get_all_raw_data(uint8_t all_data[COMPLETE_FILE_LENGTH]) const;
+					static std::shared_ptr<struct RawData> parse_raw_data(uint8_t* read_data) noexcept;
 
 					//! Calculates the compensated temperature by using temperature calibration constants and a raw value.
 					/*!
@@ -295,42 +279,82 @@ namespace hal
 					*/
 					static double compensate_humidity(struct CalibrationData calibration, int32_t raw_humidity) noexcept;
 
+				protected:
+					//! Reads the calibration constants for compensation of the three sensor values from the device.
+					/*!
+					*  Reads the calibration constants for compensation of the three sensor values from the device.
+					* \returns The calibration values.
+					* \throws I2CException if reading temperature and pressure calibration data from the device fails.
+					* \throws I2CException if reading humidity calibration data from the device fails.
+					*/
+					CalibrationData get_calibration_data() const;
+
+					//! Transforms the sensor settings buffer into a struct.
+					/*!
+					*  Transforms the sensor settings buffer into a struct.
+					* \param[in] read_data: The buffer with the settings values.
+					* \returns The resulting settings struct.
+					*/
+					std::shared_ptr<struct SettingsData> parse_settings(uint8_t* read_data) const;
+
+					//! Simply reads all content from the device at once.
+					/*!
+					*  Simply reads all content from the device at once. The function should only be used for
+					*  debug purposes.
+					* \param[out] all_data: A buffer to store the content.
+					* \throws I2CException if reading raw data from the device fails.
+					*/
+					void get_all_raw_data(uint8_t all_data[COMPLETE_FILE_LENGTH]) const;
+
 					//! Calculates the time needed for one complete measurement.
 					/*!
 					*  Depending on the filter and oversampling settings a measurement takes some time to finish.
 					*  This time can be calculated with the formula that can be found here
 					*  https://usermanual.wiki/Pdf/BstBme280Ds00110.1570003573 in appendix B, 9.1 (page 51, [01.27.2020]).
 					* \returns The calculated time in milliseconds.
-					* \throws HALException if reading device settings fails.
 					*/
-					double calculate_wait_time() const;
+					double calculate_wait_time() const noexcept;
 
 					//! Pauses the current process until a measurement finishes.
 					/*!
-					*  Pauses the current process until a measurement finishes.
+					*  Pauses the current process until a measurement finishes. The actual pause is recorded in the
+					*  "bme280.conversion_wait_ns" metric and traced as "bme280.conversion_wait".
 					*/
 					void sleep_until_ready() const noexcept;
 
-					//! Rewrites the given settings to the device.
+					//! Writes the changed settings registers to the device.
+					/*!
+					*  Writes the changed ctrl_hum, ctrl_meas and config registers to the device with one transaction.
+					*  A changed humidity oversampling only takes effect after a write to ctrl_meas, so ctrl_meas is
+					*  written as well in that case.
+					* \throws HALException if the device is not open.
+					* \throws I2CException if writing the registers fails.
+					*/
+					void write_settings() const;
+
+					//! Writes the changed settings registers to the device without throwing.
 					/*!
-					*  Rewrites the given settings to the device.
-					* \param[in] settings: The settings to reload.
+					*  Like <write_settings>"()", but reports failures with the returned result instead of an exception.
+					* \returns the result of the write.
 					*/
-					void reload_device_settings(SettingsData settings) const;
+					utils::Result<void> try_write_settings() const noexcept;
 
-					//! Compares old and new settings and decides whether the device settings have to be changed.
+					//! Changes the device mode without throwing.
 					/*!
-					*  Compares old and new settings and decides whether the device settings have to be changed.
-					* \param[in] old_settings: The old/current settings.
-					* \param[in] desired_settings: The new/desired settings.
-					* \returns true if both settings equal, false otherwise.
+					*  Like <set_sensor_mode>"()", but reports failures with the returned result instead of an exception.
+					* \param[in] mode: The new device mode.
+					* \returns the result of the write.
 					*/
-					static bool are_settings_changed(uint8_t old_settings, uint8_t desired_settings) noexcept;
+					utils::Result<void> try_set_sensor_mode(OperationMode mode) const noexcept;
 
 					Device m_device{};
+					mutable RegisterMap m_registers{
+						HUMIDITY_OVERSAMPLING_REG, CONFIG_REG - HUMIDITY_OVERSAMPLING_REG + 1, RegisterAccess::ADDRESS_DATA_PAIRS
+					};
 					int m_file_handle{};
 					uint8_t m_dev_id{};
 					uint8_t m_chip_id{};
+					Histogram* m_conversion_wait{};
 				};
 			}
 		}
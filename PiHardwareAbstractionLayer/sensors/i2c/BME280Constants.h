@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../utils/RegisterField.h"
+
 namespace hal
 {
 	namespace sensors
@@ -75,6 +77,18 @@ namespace hal
 				static constexpr uint8_t STANDBY_MASK = 0xE0;
 				static constexpr uint8_t STANDBY_POS = 0x05;
 
+				// Register fields
+				using SensorModeField = utils::Field<MODE_REG, SENSOR_MODE_POS, 2>;
+				using HumidityOversamplingField = utils::Field<HUMIDITY_OVERSAMPLING_REG, HUMIDITY_POS, 3>;
+				using PressureOversamplingField = utils::Field<MEASUREMENT_OVERSAMPLING_REG, PRESSURE_POS, 3>;
+				using TemperatureOversamplingField = utils::Field<MEASUREMENT_OVERSAMPLING_REG, TEMPERATURE_POS, 3>;
+				using FilterField = utils::Field<CONFIG_REG, FILTER_POS, 3>;
+				using StandbyField = utils::Field<CONFIG_REG, STANDBY_POS, 3>;
+				using UpdatingFlag = utils::Flag<STATUS_REG, 0>;
+				static_assert(SensorModeField::MASK == SENSOR_MODE_MASK && HumidityOversamplingField::MASK == HUMIDITY_MASK &&
+					PressureOversamplingField::MASK == PRESSURE_MASK && TemperatureOversamplingField::MASK == TEMPERATURE_MASK &&
+					FilterField::MASK == FILTER_MASK && StandbyField::MASK == STANDBY_MASK, "The register fields do not match the bit masks.");
+
 				// Lengths
 				static constexpr uint8_t COMPLETE_FILE_LENGTH = 118;
 				static constexpr uint8_t ALL_DATA_LENGTH = 8;
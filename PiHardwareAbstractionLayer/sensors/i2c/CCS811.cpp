@@ -3,45 +3,53 @@
 #include "../../utils/Constants.h"
 #include "../../utils/BitManipulation.h"
 #include "../../utils/Helper.h"
+#include "../../utils/EventScheduler.h"
+#include "../../utils/GPIOFactory.h"
 #include "../../structs/CallbackHandle.h"
 #include "../../exceptions/GPIOException.h"
 #include "../../exceptions/I2CException.h"
 
+#include <ctime>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <thread>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 void hal::sensors::i2c::ccs811::CCS811::trigger_measurement(const SensorType type)
 {
-	uint16_t val = 0;
-	for (auto i = m_callbacks[type].begin(); i != m_callbacks[type].end(); ++i)
+	if (type != SensorType::CO2 && type != SensorType::TVOC)
 	{
-		switch (type)
+		throw exception::HALException("CCS811", "trigger_measurement", "Invalid sensor type.");
+	}
+
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	if (m_use_interrupt_mode)
+	{
+		return; // New samples are delivered by the nINT handler
+	}
+
+	// eCO2 and TVOC sensors share this device. Whichever of them triggers first reads the new
+	// sample and publishes both values. Afterwards DATA_READY is cleared until the next sample.
+	ResultData results{};
+	try
+	{
+		if (read_result_data(results) != OK)
 		{
-		case SensorType::CO2:
-			try
-			{
-				get_eCO2_data(val);
-			}
-			catch (exception::HALException& ex)
-			{
-				throw exception::HALException("CCS811", "trigger_measurement",
-														std::string("Could not trigger eCO2 measurement:\n").append(ex.to_string()));
-			}
-			break;
-		case SensorType::TVOC:
-			try
-			{
-				get_TVOC_data(val);
-			}
-			catch (exception::HALException& ex)
-			{
-				throw exception::HALException("CCS811", "trigger_measurement",
-														std::string("Could not trigger TVOC measurement:\n").append(ex.to_string()));
-			}
-			break;
-		default:
-			throw exception::HALException("CCS811", "trigger_measurement", "Invalid sensor type.");
+			return;
 		}
-		(*i)->callback(std::to_string(val));
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("CCS811", "trigger_measurement",
+												std::string("Could not read result data:\n").append(ex.to_string()));
+	}
+
+	if (DataReadyFlag::is_set(results.status))
+	{
+		publish_results(results);
 	}
 }
 
@@ -49,7 +57,7 @@ void hal::sensors::i2c::ccs811::CCS811::configure(const SensorSetting setting, c
 {
 	if (setting == SensorSetting::BASELINE)
 	{
-		std::vector<uint8_t> baselines = {0, 0};
+		std::vector<uint8_t> baselines;
 
 		if (Helper::string_contains_separator(configuration))
 		{
@@ -57,6 +65,7 @@ void hal::sensors::i2c::ccs811::CCS811::configure(const SensorSetting setting, c
 		}
 		else
 		{
+			baselines = {0, 0};
 			BitManipulation::split_bytes(Helper::string_to_uint16_t(configuration), baselines[0], baselines[1]);
 		}
 
@@ -94,7 +103,7 @@ void hal::sensors::i2c::ccs811::CCS811::configure(const SensorSetting setting, c
 	}
 	else if (setting == SensorSetting::ENVIRONMENT_DATA)
 	{
-		std::vector<uint16_t> env = {0, 0};
+		std::vector<uint16_t> env;
 		Helper::string_to_array(env, configuration);
 		if (env.size() == 2)
 		{
@@ -138,6 +147,28 @@ std::vector<hal::SensorSetting> hal::sensors::i2c::ccs811::CCS811::available_con
 
 void hal::sensors::i2c::ccs811::CCS811::close()
 {
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	try
+	{
+		save_baseline_snapshot(); // Keep the latest baseline for the next start
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "CCS811 [close] Could not save baseline snapshot:\n" << ex.to_string() << std::endl;
+	}
+	m_auto_mode_selection = false;
+	cancel_pending_mode_switch();
+	stop_baseline_snapshots();
+	stop_interrupt_handling();
+	if (m_int_line != nullptr)
+	{
+		m_int_line->close();
+	}
+	if (m_wake_line != nullptr)
+	{
+		m_wake_line->close();
+	}
+
 	try
 	{
 		I2CManager::close_device(m_file_handle);
@@ -159,14 +190,17 @@ uint8_t hal::sensors::i2c::ccs811::CCS811::init(
 	m_wake_gpio_pin = wake_gpio_pin_nr;
 	m_dev_id = device_reg;
 
-	if (wiringPiSetup() != OK)
+	// The nINT pin is requested as soon as interrupt mode is activated.
+	try
 	{
-		throw exception::GPIOException("CCS811", "init", -1, "Could not initialize wiringPi.");
+		m_wake_line = GPIOFactory::open_line(m_wake_gpio_pin, true, GPIOEdge::NONE, "ccs811-nwake");
 	}
-
-	pinMode(m_int_gpio_pin_nr, INPUT);
-	pinMode(m_wake_gpio_pin, OUTPUT);
-	unwake_device();
+	catch (exception::HALException& ex)
+	{
+		throw exception::GPIOException("CCS811", "init", static_cast<uint8_t>(m_wake_gpio_pin),
+												 std::string("Could not request nWAKE pin:\n").append(ex.to_string()));
+	}
+	toggle_power_safe_mode(use_power_safe_mode);
 
 	try
 	{
@@ -177,28 +211,100 @@ uint8_t hal::sensors::i2c::ccs811::CCS811::init(
 		throw exception::HALException("CCS811", "init", std::string("Could not establish connection with device:\n").append(ex.to_string()));
 	}
 
+	std::shared_ptr<DeviceInfo> info;
 	try
 	{
-		return get_device_information()->device_id;
+		info = get_device_information();
 	}
 	catch (exception::HALException& ex)
 	{
 		throw exception::HALException("CCS811", "init", std::string("Could not read device id:\n").append(ex.to_string()));
 	}
+
+	// The snapshots are restored as soon as the application runs in the corresponding mode.
+	m_hardware_id = info->hardware_id;
+	load_baseline_snapshots();
+	return info->device_id;
+}
+
+void hal::sensors::i2c::ccs811::CCS811::enable_baseline_store(const std::string& directory, const std::string& device_identifier,
+																				  const uint32_t max_age_in_s)
+{
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	m_baseline_store = std::make_unique<BaselineStore>(directory, max_age_in_s);
+	m_baseline_device_identifier = device_identifier;
+	if (m_hardware_id != 0)
+	{
+		load_baseline_snapshots();
+	}
+}
+
+int8_t hal::sensors::i2c::ccs811::CCS811::save_baseline_snapshot()
+{
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	if (m_baseline_store == nullptr || m_current_mode == OperationMode::SLEEP)
+	{
+		return WARNING;
+	}
+
+	// A baseline of a sensor that is still warming up would distort later measurements.
+	const auto running_time = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - m_mode_entered).count();
+	if (running_time < BASELINE_WARM_UP_TIME_IN_S)
+	{
+		return WARNING;
+	}
+
+	BaselineSnapshot snapshot{};
+	try
+	{
+		if (get_current_baseline(snapshot.baseline) != OK)
+		{
+			return WRONG_MODE_WARNING;
+		}
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("CCS811", "save_baseline_snapshot",
+												std::string("Could not read current baseline:\n").append(ex.to_string()));
+	}
+	snapshot.mode = m_current_mode;
+	snapshot.operating_time_in_s = m_mode_operating_time_s + static_cast<uint64_t>(running_time);
+	snapshot.saved_at = static_cast<int64_t>(time(nullptr));
+
+	try
+	{
+		m_baseline_store->save(BaselineStore::make_key(m_hardware_id, m_dev_id, m_current_mode, m_baseline_device_identifier), snapshot);
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("CCS811", "save_baseline_snapshot",
+												std::string("Could not store baseline snapshot:\n").append(ex.to_string()));
+	}
+	m_baseline_snapshots[m_current_mode] = snapshot;
+	return OK;
 }
 
 void hal::sensors::i2c::ccs811::CCS811::toggle_power_safe_mode(const bool use_power_safe_mode) noexcept
 {
+	std::lock_guard<std::mutex> guard(m_wake_mutex);
 	m_use_power_safe_mode = use_power_safe_mode;
 
 	if (!m_use_power_safe_mode) // Deactivate power safe mode
 	{
-		wake_device(); // Just put the pin to low and leave it. This way the processor is always running
+		// Just put the pin to low and leave it. This way the processor is always running
+		set_wake_pin(0);
+		usleep(AWAKE_TIME_IN_US);
+	}
+	else if (m_wake_depth == 0) // Activate power safe mode -> sleep until the next session
+	{
+		set_wake_pin(1);
+		usleep(DWAKE_TIME_IN_US);
 	}
 }
 
 int8_t hal::sensors::i2c::ccs811::CCS811::start()
 {
+	const WakeSession wake_session(*this); // Status, verification and start share one wake window
 	const auto status = get_status_information();
 	if (status->current_state == State::BOOT)
 	{
@@ -219,13 +325,11 @@ int8_t hal::sensors::i2c::ccs811::CCS811::start()
 		uint8_t start_byte = 0xF4;
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::write_to_device(m_file_handle, APP_START_BOOT_REG, &start_byte, 0);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "start", m_dev_id, APP_START_BOOT_REG,
 													std::string("Could not start device:\n").append(ex.to_string()));
 		}
@@ -264,82 +368,38 @@ std::shared_ptr<hal::sensors::i2c::ccs811::Status> hal::sensors::i2c::ccs811::CC
 	uint8_t raw_status;
 	try
 	{
-		if (m_use_power_safe_mode) wake_device();
+		const WakeSession wake_session(*this);
 		I2CManager::read_from_device(m_file_handle, STATUS_REG, &raw_status, STATUS_LEN);
-		if (m_use_power_safe_mode) unwake_device();
 	}
 	catch (exception::HALException& ex)
 	{
-		if (m_use_power_safe_mode) unwake_device();
 		throw exception::I2CException("CCS811", "get_status_information", m_dev_id, STATUS_REG,
 												std::string("Could not read status information from the device:\n").append(ex.to_string()));
 	}
 
-	auto status = std::make_shared<Status>();
 	// Check error bit
-	if (BitManipulation::is_bit_set(raw_status, 0))
-	{
-		status->has_error = true;
-		const auto error_code = read_error();
-
-		if (BitManipulation::is_bit_set(error_code, 0)) // WRITE_REG_INVALID
-		{
-			status->error_message.push_back("CCS881 [get_status_information] Error WRITE_REG_INVALID: The CCS811 received an IC write"
-				"request addressed to this station but with invalid register address ID.");
-		}
-		if (BitManipulation::is_bit_set(error_code, 1)) // READ_REG_INVALID
-		{
-			status->error_message.push_back("CCS881 [get_status_information] Error READ_REG_INVALID: "
-				"The CCS811 received an IC read request to a mailbox ID that is invalid");
-		}
-		if (BitManipulation::is_bit_set(error_code, 2)) // MEASUREMODE_INVALID
-		{
-			status->error_message.push_back("CCS881 [get_status_information] Error MEASUREMODE_INVALID: "
-				"The CCS811 received an IC request to write an unsupported mode to	MEAS_MODE");
-		}
-		if (BitManipulation::is_bit_set(error_code, 3)) // MAX_RESISTANCE
-		{
-			status->error_message.push_back("CCS881 [get_status_information] Error: MAX_RESISTANCE: "
-				"The sensor resistance measurement has reached or exceeded the maximum range");
-		}
-		if (BitManipulation::is_bit_set(error_code, 4)) // HEATER_FAULT
-		{
-			status->error_message.push_back("CCS881 [get_status_information] Error: HEATER_FAULT: "
-				"The Heater current in the CCS811 is not in range");
-		}
-		if (BitManipulation::is_bit_set(error_code, 5)) // HEATER_SUPPLY_ERROR
-		{
-			status->error_message.push_back("CCS881 [get_status_information] Error: HEATER_SUPPLY_ERROR: "
-				"The Heater voltage is not being applied correctly");
-		}
-	}
-
-	status->raw_status_info = raw_status;
-	status->data_ready = BitManipulation::is_bit_set(raw_status, 3);
-	status->firmware_loaded = BitManipulation::is_bit_set(raw_status, 4);
-	status->current_state = BitManipulation::is_bit_set(raw_status, 7) ? State::READY : State::BOOT;
+	const auto error_code = ErrorFlag::is_set(raw_status) ? read_error() : static_cast<uint8_t>(0);
+	auto status = std::make_shared<Status>();
+	parse_status(raw_status, error_code, *status);
 	return status;
 }
 
 std::shared_ptr<struct hal::sensors::i2c::ccs811::DeviceInfo> hal::sensors::i2c::ccs811::CCS811::get_device_information() const
 {
 	uint8_t hw_id;
-	if (m_use_power_safe_mode) wake_device();
+	const WakeSession wake_session(*this);
 	try
 	{
 		I2CManager::read_from_device(m_file_handle, HARDWARE_ID_REG, &hw_id, HARDWARE_ID_LEN);
 	}
 	catch (exception::HALException& ex)
 	{
-		if (m_use_power_safe_mode) unwake_device();
 		throw exception::I2CException("CCS811", "get_device_information", m_dev_id, HARDWARE_ID_REG,
 												std::string("Could not read hardware chip id from the device:\n").append(ex.to_string()));
 	}
 
 	if (hw_id != HARDWARE_ID_VALUE)
 	{
-		if (m_use_power_safe_mode) unwake_device();
-
 		char wrong_id[70];
 		sprintf(wrong_id, "Wrong hardware id. Awaited 0x81 but got 0x%x from the device", hw_id);
 		throw exception::I2CException("CCS811", "get_device_information", m_dev_id, HARDWARE_ID_REG, wrong_id);
@@ -352,7 +412,6 @@ std::shared_ptr<struct hal::sensors::i2c::ccs811::DeviceInfo> hal::sensors::i2c:
 	}
 	catch (exception::HALException& ex)
 	{
-		if (m_use_power_safe_mode) unwake_device();
 		throw exception::I2CException("CCS811", "get_device_information", m_dev_id, HARDWARE_VERSION_REG,
 												std::string("Could not read hardware version from the device:\n").append(ex.to_string()));
 	}
@@ -364,7 +423,6 @@ std::shared_ptr<struct hal::sensors::i2c::ccs811::DeviceInfo> hal::sensors::i2c:
 	}
 	catch (exception::HALException& ex)
 	{
-		if (m_use_power_safe_mode) unwake_device();
 		throw exception::I2CException("CCS811", "get_device_information", m_dev_id, FIRMWARE_VERSION_REG,
 												std::string("Could not read firmware version from the device:\n").append(ex.to_string()));
 	}
@@ -376,54 +434,23 @@ std::shared_ptr<struct hal::sensors::i2c::ccs811::DeviceInfo> hal::sensors::i2c:
 	}
 	catch (exception::HALException& ex)
 	{
-		if (m_use_power_safe_mode) unwake_device();
 		throw exception::I2CException("CCS811", "get_device_information", m_dev_id, APPLICATION_VERSION_REG,
 												std::string("Could not read application version from the device:\n").append(ex.to_string()));
 	}
-	if (m_use_power_safe_mode) unwake_device();
 
-	try
-	{
-		auto info = std::make_shared<DeviceInfo>();
-		info->device_id = m_dev_id;
-		info->hardware_id = hw_id;
-		info->hardware_version = std::to_string(static_cast<int>(BitManipulation::value_of_bits(hw_version_raw, 4, 7))).append(".").append(
-			std::to_string(
-				static_cast<int>(
-					BitManipulation
-					::
-					value_of_bits(
-						hw_version_raw,
-						0, 3))));
-		info->firmware_version = std::to_string(static_cast<int>(BitManipulation::value_of_bits(fw_version_raw[0], 4, 7))).append(".").append(
-			std::to_string(
-				static_cast<
-					int>(
-					BitManipulation
-					::
-					value_of_bits(
-						fw_version_raw
-						[0], 0,
-						3)))
-			.append(".").
-			append(
-				std::
-				to_string(
-					static_cast
-					<int>(
-						fw_version_raw
-						[1]))));
-		info->application_version = std::to_string(static_cast<int>(BitManipulation::value_of_bits(app_version_raw[0], 4, 7)))
-											.append(".").append(
-												std::to_string(static_cast<int>(BitManipulation::value_of_bits(app_version_raw[0], 0, 3)))
-												.append(".").append(std::to_string(static_cast<int>(app_version_raw[1]))));
-		return info;
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::I2CException("CCS811", "get_device_information", m_dev_id, APPLICATION_VERSION_REG,
-												std::string("Could not read value of certain bits from byte:\n").append(ex.to_string()));
-	}
+	auto info = std::make_shared<DeviceInfo>();
+	info->device_id = m_dev_id;
+	info->hardware_id = hw_id;
+	info->hardware_version = std::to_string(static_cast<int>(HardwareVersionMajorField::decode(hw_version_raw))).append(".").append(
+		std::to_string(static_cast<int>(HardwareVersionMinorField::decode(hw_version_raw))));
+	info->firmware_version = std::to_string(static_cast<int>(FirmwareVersionMajorField::decode(fw_version_raw[0]))).append(".").append(
+		std::to_string(static_cast<int>(FirmwareVersionMinorField::decode(fw_version_raw[0])))
+		.append(".").append(std::to_string(static_cast<int>(fw_version_raw[1]))));
+	info->application_version = std::to_string(static_cast<int>(ApplicationVersionMajorField::decode(app_version_raw[0])))
+										.append(".").append(
+											std::to_string(static_cast<int>(ApplicationVersionMinorField::decode(app_version_raw[0])))
+											.append(".").append(std::to_string(static_cast<int>(app_version_raw[1]))));
+	return info;
 }
 
 int8_t hal::sensors::i2c::ccs811::CCS811::get_operation_mode_information(std::shared_ptr<struct ModeInfo>& mode) const
@@ -444,28 +471,17 @@ int8_t hal::sensors::i2c::ccs811::CCS811::get_operation_mode_information(std::sh
 		uint8_t raw_mode;
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::read_from_device(m_file_handle, MODE_REG, &raw_mode, MODE_LEN);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "get_operation_mode_information", m_dev_id, MODE_REG,
 													std::string("Could not read mode information from the device:\n").append(ex.to_string()));
 		}
 
 		mode->raw_mode_info = raw_mode;
-		uint8_t mode_value;
-		try
-		{
-			mode_value = BitManipulation::value_of_bits(raw_mode, 4, 6);
-		}
-		catch (exception::HALException& ex)
-		{
-			throw exception::HALException("CCS811", "get_operation_mode_information",
-													std::string("Could not read value of certain bits from byte:\n").append(ex.to_string()));
-		}
+		const auto mode_value = DriveModeField::decode(raw_mode);
 
 		switch (mode_value)
 		{
@@ -490,16 +506,8 @@ int8_t hal::sensors::i2c::ccs811::CCS811::get_operation_mode_information(std::sh
 													.append(std::to_string(mode_value)).append("."));
 		}
 
-		try
-		{
-			mode->interrupt_generation = BitManipulation::is_bit_set(raw_mode, 3);
-			mode->use_threshold = BitManipulation::is_bit_set(raw_mode, 2);
-		}
-		catch (exception::HALException& ex)
-		{
-			throw exception::HALException("CCS811", "get_operation_mode_information",
-													std::string("Could not check interrupt and/or threshold bit:\n").append(ex.to_string()));
-		}
+		mode->interrupt_generation = InterruptFlag::is_set(raw_mode);
+		mode->use_threshold = ThresholdFlag::is_set(raw_mode);
 		return OK;
 	}
 	return WRONG_MODE_WARNING;
@@ -507,6 +515,9 @@ int8_t hal::sensors::i2c::ccs811::CCS811::get_operation_mode_information(std::sh
 
 int8_t hal::sensors::i2c::ccs811::CCS811::set_operation_mode(OperationMode mode, bool interrupt_mode, bool use_thresholds)
 {
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	const WakeSession wake_session(*this); // Status, mode, baseline and the new mode share one wake window
+	cancel_pending_mode_switch(); // The latest request wins
 	int8_t device_mode;
 	try
 	{
@@ -532,11 +543,11 @@ int8_t hal::sensors::i2c::ccs811::CCS811::set_operation_mode(OperationMode mode,
 		}
 
 		// If interrupt generation is currently on, should stay on and private fields for this purpose or uninitialized / set false.
-		if (current_mode->interrupt_generation && interrupt_mode && !m_use_interrupt_mode && m_interrupt_thread == nullptr)
+		if (current_mode->interrupt_generation && interrupt_mode && !m_use_interrupt_mode && m_int_watch_handle == 0)
 		{
-			// The device is in interrupt mode but our thread is not running...
+			// The device is in interrupt mode but nobody watches the nINT pin...
 			// Could be caused through a software restart which did not power off the device.
-			start_interrupt_thread();
+			start_interrupt_handling();
 		}
 
 		if (current_mode->current_mode == mode && current_mode->interrupt_generation == interrupt_mode && current_mode->use_threshold ==
@@ -544,12 +555,21 @@ int8_t hal::sensors::i2c::ccs811::CCS811::set_operation_mode(OperationMode mode,
 		{
 			// Nothing changes -> abort
 			m_current_mode = mode;
+			if (m_baseline_timer_handle == 0)
+			{
+				// The device kept running (e.g. software restart). Its baseline is newer than any snapshot.
+				begin_baseline_tracking(false);
+			}
 			return WARNING;
 		}
 
 		auto new_mode = SLEEP;
+		const auto requested_mode = mode;
+		const auto requested_interrupt_mode = interrupt_mode;
+		const auto requested_use_thresholds = use_thresholds;
 		// Switch to a slower mode -> wait 10 minutes in idle mode first.
-		if (current_mode->current_mode > mode && mode != OperationMode::SLEEP)
+		const auto slower_switch = current_mode->current_mode > mode && mode != OperationMode::SLEEP;
+		if (slower_switch)
 		{
 			// new_mode = SLEEP;
 			mode = OperationMode::SLEEP;
@@ -578,75 +598,55 @@ int8_t hal::sensors::i2c::ccs811::CCS811::set_operation_mode(OperationMode mode,
 			}
 		}
 
-		// Write mode.
-		try
-		{
-			BitManipulation::set_bits(current_mode->raw_mode_info, new_mode, MODE_MASK);
-		}
-		catch (exception::HALException& ex)
-		{
-			throw exception::HALException("CCS811", "set_operation_mode",
-													std::string("Could not write new mode to mode byte:\n").append(ex.to_string()));
-		}
-
-		// Write interrupt mode.
-		try
-		{
-			BitManipulation::set_bit(current_mode->raw_mode_info, 3, interrupt_mode);
-		}
-		catch (exception::HALException& ex)
-		{
-			throw exception::HALException("CCS811", "set_operation_mode",
-													std::string("Could not set interrupt mode to false in mode byte:\n").append(ex.to_string()));
-		}
+		// Write mode, interrupt mode and threshold mode. The mode constants are register contents.
+		DriveModeField::set(current_mode->raw_mode_info, DriveModeField::decode(new_mode));
+		InterruptFlag::set(current_mode->raw_mode_info, interrupt_mode);
+		ThresholdFlag::set(current_mode->raw_mode_info, use_thresholds);
 
-		// Write threshold mode.
+		// Save the baseline of the mode that is left.
 		try
 		{
-			BitManipulation::set_bit(current_mode->raw_mode_info, 2, use_thresholds);
+			save_baseline_snapshot();
 		}
 		catch (exception::HALException& ex)
 		{
-			throw exception::HALException("CCS811", "set_operation_mode",
-													std::string("Could not set threshold mode to false in mode byte:\n").append(ex.to_string()));
+			std::cerr << "CCS811 [set_operation_mode] Could not save baseline snapshot:\n" << ex.to_string() << std::endl;
 		}
 
 		// Write new mode information to device.
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::write_to_device(m_file_handle, MODE_REG, &current_mode->raw_mode_info, 1);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "set_operation_mode", m_dev_id, MODE_REG,
 													std::string("Could not write new operation mode '").append(std::to_string(static_cast<int>(mode)))
 																														.append("' to device:\n").append(
 																															ex.to_string()));
 		}
 
+		const auto previous_mode = m_current_mode;
 		m_current_mode = mode;
+		begin_baseline_tracking(true);
 		// Switch to a slower mode -> wait 10 minutes in idle mode first.
-		if (current_mode->current_mode > mode && mode != OperationMode::SLEEP)
+		if (slower_switch)
 		{
-			if (m_use_interrupt_mode && m_interrupt_thread != nullptr)
-			{
-				stop_interrupt_thread();
-			}
+			stop_interrupt_handling();
+			schedule_pending_mode_switch(previous_mode, requested_mode, requested_interrupt_mode, requested_use_thresholds);
 			return MODE_SWITCH_WARNING;
 		}
 
 		// Switch to a faster mode or SLEEP mode -> can be instantly switched.
-		// Start / Stop interrupt threads
+		// Start / Stop watching the nINT pin
 		if (interrupt_mode && mode != OperationMode::SLEEP)
 		{
-			start_interrupt_thread();
+			start_interrupt_handling();
 		}
 		else
 		{
-			stop_interrupt_thread();
+			stop_interrupt_handling();
 		}
 		return OK;
 	}
@@ -671,13 +671,11 @@ int8_t hal::sensors::i2c::ccs811::CCS811::get_eCO2_data(uint16_t& eCO2) const
 		uint8_t raw_results[2] = {0, 0};
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::read_from_device(m_file_handle, RESULT_DATA_REG, raw_results, ECO2_LEN);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "get_eCO2_data", m_dev_id, RESULT_DATA_REG,
 													std::string("Could not read eCO2 data from the device:\n").append(ex.to_string()));
 		}
@@ -707,13 +705,11 @@ int8_t hal::sensors::i2c::ccs811::CCS811::get_TVOC_data(uint16_t& TVOC) const
 		uint8_t raw_results[4] = {0, 0, 0, 0};
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::read_from_device(m_file_handle, RESULT_DATA_REG, raw_results, TVOC_LEN);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "get_TVOC_data", m_dev_id, RESULT_DATA_REG,
 													std::string("Could not read TVOC data from the device:\n").append(ex.to_string()));
 		}
@@ -771,41 +767,28 @@ int8_t hal::sensors::i2c::ccs811::CCS811::get_all_result_data(std::shared_ptr<Re
 
 	if (device_mode == OK)
 	{
-		uint8_t raw_results[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-		try
-		{
-			if (m_use_power_safe_mode) wake_device();
-			I2CManager::read_from_device(m_file_handle, RESULT_DATA_REG, raw_results, RAW_DATA_LEN);
-			if (m_use_power_safe_mode) unwake_device();
-		}
-		catch (exception::HALException& ex)
-		{
-			if (m_use_power_safe_mode) unwake_device();
-			throw exception::I2CException("CCS811", "get_all_result_data", m_dev_id, RESULT_DATA_REG,
-													std::string("Could not read all result data from the device:\n").append(ex.to_string()));
-		}
-
-		result->eco2_value = BitManipulation::combine_bytes(raw_results[0], raw_results[1]);
-		result->tvoc_value = BitManipulation::combine_bytes(raw_results[2], raw_results[3]);
-		result->status = raw_results[4];
-		result->error_id = raw_results[5];
 		try
 		{
-			result->raw_data.voltage = BitManipulation::combine_bytes(BitManipulation::value_of_bits(raw_results[6], 0, 1), raw_results[7]);
-			result->raw_data.current = BitManipulation::value_of_bits(raw_results[6], 2, 7);
+			read_result_data(*result);
 		}
 		catch (exception::HALException& ex)
 		{
 			throw exception::HALException("CCS811", "get_all_result_data",
-													std::string("Could not read value of certain bits from byte:\n").append(ex.to_string()));
+													std::string("Could not read all result data from the device:\n").append(ex.to_string()));
 		}
 		return OK;
 	}
 	return WRONG_MODE_WARNING;
 }
 
-int8_t hal::sensors::i2c::ccs811::CCS811::set_environment_data(uint16_t temperature, const uint16_t humidity) const
+int8_t hal::sensors::i2c::ccs811::CCS811::set_environment_data(const uint16_t temperature, const uint16_t humidity) const
 {
+	if (temperature > ENV_TEMPERATURE_MAX || humidity > ENV_HUMIDITY_MAX)
+	{
+		throw exception::HALException("CCS811", "set_environment_data",
+												"The environment data exceeds the range of the register (max 102.99 degree Celsius and 100%).");
+	}
+
 	int8_t device_mode;
 	try
 	{
@@ -819,43 +802,24 @@ int8_t hal::sensors::i2c::ccs811::CCS811::set_environment_data(uint16_t temperat
 
 	if (device_mode == OK)
 	{
-		// Rounds humidity and temperature in 0.5 steps:
-		// 35.1 -> 35.0
-		// 35.3 -> 35.5
-		// 35.7 -> 35.5
-		// 35.8 -> 36.0
-		uint8_t environment_data[4] = {0, 0, 0, 0};
-		const auto hum_fraction = static_cast<uint8_t>(static_cast<uint8_t>(humidity % 100) / static_cast<uint8_t>(10));
-		environment_data[0] = (hum_fraction > 7)
-										? static_cast<uint8_t>((humidity / static_cast<uint8_t>(100 + 1)) << 1)
-										: static_cast<uint8_t>(static_cast<uint8_t>(humidity / 100) << 1);
-		// Rounds integral part up if fraction is greater 0.7
-		if (hum_fraction > 2 && hum_fraction < 8)
-		{
-			environment_data[1] = 1; // Sets fractional part to 0.5 if it is in the range [0.2, 0.7]
-		}
-
-		temperature = static_cast<uint16_t>(temperature + static_cast<uint16_t>(2500));
+		// Both values are transmitted as unsigned 16 bit values with a resolution of 1/512
+		// (7 bit integer part and 9 bit fraction).
 		// The sensor needs an offset of 25C (2500 = 25 * 100) to be applied to the actual temperature.
-		const auto temp_fraction = static_cast<uint8_t>((temperature % 100) / static_cast<uint8_t>(10));
-		environment_data[2] = (temp_fraction > 7)
-										? static_cast<uint8_t>((temperature / static_cast<uint8_t>(100 + 1)) << 1)
-										: static_cast<uint8_t>(static_cast<uint8_t>(temperature / 100) << 1);
-		// Rounds integral part up if fraction is greater 0.7
-		if (temp_fraction > 2 && temp_fraction < 8)
-		{
-			environment_data[3] = 1; // Sets fractional part to 0.5 if it is in the range [0.2, 0.7]
-		}
+		const auto raw_humidity = static_cast<uint16_t>((static_cast<uint32_t>(humidity) * ENV_DATA_RESOLUTION + 50) / 100);
+		const auto raw_temperature = static_cast<uint16_t>(
+			(static_cast<uint32_t>(temperature + TEMPERATURE_BASELINE * 100) * ENV_DATA_RESOLUTION + 50) / 100);
+		uint8_t environment_data[4] = {
+			static_cast<uint8_t>(raw_humidity >> 8), static_cast<uint8_t>(raw_humidity & 0xFF),
+			static_cast<uint8_t>(raw_temperature >> 8), static_cast<uint8_t>(raw_temperature & 0xFF)
+		};
 
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::write_to_device(m_file_handle, ENV_DATA_REG, environment_data, ENV_HUM_DATA_LEN + ENV_TEMP_DATA_LEN);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "set_environment_data", m_dev_id, ENV_DATA_REG,
 													std::string("Could not write environment data to the device:\n").append(ex.to_string()));
 		}
@@ -882,13 +846,11 @@ int8_t hal::sensors::i2c::ccs811::CCS811::get_NTC_data(std::shared_ptr<NTC>& NTC
 		uint8_t ntc_results[4] = {0, 0, 0, 0};
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::read_from_device(m_file_handle, NTC_REG, ntc_results, NTC_LEN);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "get_NTC_data", m_dev_id, NTC_REG,
 													std::string("Could not read NTC data from the device:\n").append(ex.to_string()));
 		}
@@ -920,14 +882,12 @@ int8_t hal::sensors::i2c::ccs811::CCS811::set_thresholds(std::shared_ptr<Thresho
 		const auto data = reinterpret_cast<uint8_t*>(&thresholds->low_medium_threshold);
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::write_to_device(m_file_handle, THRESHOLDS_REG, data,
 												THRESHOLDS_LOW_MEDIUM_LEN + THRESHOLDS_MEDIUM_HIGH_LEN + THRESHOLDS_HYSTERESIS_LEN);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "set_thresholds", m_dev_id, THRESHOLDS_REG,
 													std::string("Could not write thresholds to the device:\n").append(ex.to_string()));
 		}
@@ -954,13 +914,11 @@ int8_t hal::sensors::i2c::ccs811::CCS811::get_current_baseline(uint8_t baseline[
 	{
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::read_from_device(m_file_handle, BASELINE_REG, baseline, BASELINE_LEN);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "get_current_baseline", m_dev_id, BASELINE_REG,
 													std::string("Could not read baseline data from the device:\n").append(ex.to_string()));
 		}
@@ -987,13 +945,11 @@ int8_t hal::sensors::i2c::ccs811::CCS811::set_baseline(uint8_t baseline[BASELINE
 	{
 		try
 		{
-			if (m_use_power_safe_mode) wake_device();
+			const WakeSession wake_session(*this);
 			I2CManager::write_to_device(m_file_handle, BASELINE_REG, baseline, BASELINE_LEN);
-			if (m_use_power_safe_mode) unwake_device();
 		}
 		catch (exception::HALException& ex)
 		{
-			if (m_use_power_safe_mode) unwake_device();
 			throw exception::I2CException("CCS811", "set_baseline", m_dev_id, BASELINE_REG,
 													std::string("Could not write baseline data to the device:\n").append(ex.to_string()));
 		}
@@ -1003,8 +959,96 @@ int8_t hal::sensors::i2c::ccs811::CCS811::set_baseline(uint8_t baseline[BASELINE
 	return WRONG_MODE_WARNING;
 }
 
+int8_t hal::sensors::i2c::ccs811::CCS811::update_firmware(const std::string& firmware_path,
+																			 const std::function<void(const FirmwareProgress&)>& progress_callback)
+{
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+
+	// Map the image instead of copying it. The mapping stays valid after closing the file.
+	const auto fd = open(firmware_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		throw exception::HALException("CCS811", "update_firmware",
+												std::string("Could not open firmware file '").append(firmware_path).append("': ").append(strerror(errno)));
+	}
+	struct stat file_info{};
+	if (fstat(fd, &file_info) < 0)
+	{
+		const auto error = errno;
+		::close(fd);
+		throw exception::HALException("CCS811", "update_firmware",
+												std::string("Could not read size of firmware file '").append(firmware_path).append("': ").append(strerror(error)));
+	}
+	const auto byte_count = static_cast<uint64_t>(file_info.st_size);
+	if (byte_count == 0 || byte_count % APP_DATA_BOOT_LEN != 0 || byte_count > UINT32_MAX)
+	{
+		::close(fd);
+		throw exception::HALException("CCS811", "update_firmware",
+												std::string("The firmware file has an invalid size (").append(std::to_string(byte_count)).append(
+													" bytes). It has to be a multiple of 8 bytes."));
+	}
+	const auto mapping = mmap(nullptr, byte_count, PROT_READ, MAP_PRIVATE, fd, 0);
+	const auto error = errno;
+	::close(fd);
+	if (mapping == MAP_FAILED)
+	{
+		throw exception::HALException("CCS811", "update_firmware",
+												std::string("Could not map firmware file '").append(firmware_path).append("': ").append(strerror(error)));
+	}
+	madvise(mapping, byte_count, MADV_SEQUENTIAL); // Only a hint for read ahead. Failing is not critical
+
+	auto firmware_valid = false;
+	try
+	{
+		// Nothing may access the device while it is in BOOT mode
+		try
+		{
+			save_baseline_snapshot();
+		}
+		catch (exception::HALException& ex)
+		{
+			std::cerr << "CCS811 [update_firmware] Could not save baseline snapshot:\n" << ex.to_string() << std::endl;
+		}
+		cancel_pending_mode_switch();
+		stop_baseline_snapshots();
+		stop_interrupt_handling();
+
+		// Keep the device awake for the whole update instead of waking it for every block and status read
+		const WakeSession wake_session(*this);
+		if (check_device_mode() == OK) // Application is running -> reset to BOOT mode
+		{
+			uint8_t reset_sequence[] = {RESET_1, RESET_2, RESET_3, RESET_4};
+			I2CManager::write_to_device(m_file_handle, RESET_REG, reset_sequence, RESET_LEN * 4);
+			m_current_mode = OperationMode::SLEEP;
+			std::this_thread::sleep_for(std::chrono::milliseconds(FIRMWARE_RESET_TIME_IN_MS));
+			if (check_device_mode() != 1)
+			{
+				throw exception::HALException("CCS811", "update_firmware", "The device did not restart in BOOT mode.");
+			}
+		}
+
+		delete_current_firmware();
+		write_firmware_blocks(static_cast<const uint8_t*>(mapping), static_cast<uint32_t>(byte_count), progress_callback);
+		verify_firmware(firmware_valid);
+	}
+	catch (exception::HALException& ex)
+	{
+		munmap(mapping, byte_count);
+		throw exception::HALException("CCS811", "update_firmware",
+												std::string("Could not update firmware:\n").append(ex.to_string()));
+	}
+	munmap(mapping, byte_count);
+
+	if (!firmware_valid)
+	{
+		throw exception::HALException("CCS811", "update_firmware", "The device reported that the new firmware is not valid.");
+	}
+	return OK;
+}
+
 int8_t hal::sensors::i2c::ccs811::CCS811::delete_current_firmware() const
 {
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
 	int8_t device_mode;
 	try
 	{
@@ -1018,14 +1062,34 @@ int8_t hal::sensors::i2c::ccs811::CCS811::delete_current_firmware() const
 
 	if (device_mode == 1) // Device is in BOOT mode
 	{
-		// ToDo: Implement
+		uint8_t erase_sequence[APP_ERASE_BOOT_LEN] = {ERASE_1, ERASE_2, ERASE_3, ERASE_4};
+		try
+		{
+			const WakeSession wake_session(*this);
+			I2CManager::write_to_device(m_file_handle, APP_ERASE_BOOT_REG, erase_sequence, APP_ERASE_BOOT_LEN);
+			poll_boot_status(STATUS_APP_ERASE_MASK, FIRMWARE_ERASE_TIMEOUT_IN_MS);
+		}
+		catch (exception::HALException& ex)
+		{
+			throw exception::I2CException("CCS811", "delete_current_firmware", m_dev_id, APP_ERASE_BOOT_REG,
+													std::string("Could not erase the firmware:\n").append(ex.to_string()));
+		}
 		return OK;
 	}
 	return WRONG_MODE_WARNING;
 }
 
-int8_t hal::sensors::i2c::ccs811::CCS811::write_new_firmware(std::shared_ptr<uint8_t[]> new_firmware, uint16_t byte_count) const
+int8_t hal::sensors::i2c::ccs811::CCS811::write_new_firmware(std::shared_ptr<uint8_t[]> new_firmware, const uint16_t byte_count,
+																				 const std::function<void(const FirmwareProgress&)>& progress_callback) const
 {
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	if (new_firmware == nullptr || byte_count == 0 || byte_count % APP_DATA_BOOT_LEN != 0)
+	{
+		throw exception::HALException("CCS811", "write_new_firmware",
+												std::string("The firmware has an invalid size (").append(std::to_string(byte_count)).append(
+													" bytes). It has to be a multiple of 8 bytes."));
+	}
+
 	int8_t device_mode;
 	try
 	{
@@ -1039,7 +1103,15 @@ int8_t hal::sensors::i2c::ccs811::CCS811::write_new_firmware(std::shared_ptr<uin
 
 	if (device_mode == 1) // Device is in BOOT mode
 	{
-		// ToDo: Implement
+		try
+		{
+			write_firmware_blocks(new_firmware.get(), byte_count, progress_callback);
+		}
+		catch (exception::HALException& ex)
+		{
+			throw exception::HALException("CCS811", "write_new_firmware",
+													std::string("Could not write the firmware:\n").append(ex.to_string()));
+		}
 		return OK;
 	}
 	return WRONG_MODE_WARNING;
@@ -1047,6 +1119,7 @@ int8_t hal::sensors::i2c::ccs811::CCS811::write_new_firmware(std::shared_ptr<uin
 
 int8_t hal::sensors::i2c::ccs811::CCS811::verify_firmware(bool& firmware_valid) const
 {
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
 	int8_t device_mode;
 	try
 	{
@@ -1060,12 +1133,110 @@ int8_t hal::sensors::i2c::ccs811::CCS811::verify_firmware(bool& firmware_valid)
 
 	if (device_mode == 1) // Device is in BOOT mode
 	{
-		// ToDo: Implement
+		uint8_t verify_byte = APP_VERIFY_BOOT_REG;
+		try
+		{
+			const WakeSession wake_session(*this);
+			I2CManager::write_to_device(m_file_handle, APP_VERIFY_BOOT_REG, &verify_byte, 0);
+			const auto status = poll_boot_status(STATUS_APP_VERIFY_MASK, FIRMWARE_VERIFY_TIMEOUT_IN_MS);
+			firmware_valid = (status & STATUS_APP_VALID_MASK) != 0;
+		}
+		catch (exception::HALException& ex)
+		{
+			throw exception::I2CException("CCS811", "verify_firmware", m_dev_id, APP_VERIFY_BOOT_REG,
+													std::string("Could not verify the firmware:\n").append(ex.to_string()));
+		}
 		return OK;
 	}
 	return WRONG_MODE_WARNING;
 }
 
+void hal::sensors::i2c::ccs811::CCS811::write_firmware_blocks(const uint8_t* firmware, const uint32_t byte_count,
+																				  const std::function<void(const FirmwareProgress&)>& progress_callback) const
+{
+	const auto started = std::chrono::steady_clock::now();
+	const auto report = [&](const uint32_t bytes_written)
+	{
+		if (progress_callback == nullptr)
+		{
+			return;
+		}
+		const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+		progress_callback(FirmwareProgress{bytes_written, byte_count, elapsed > 0 ? bytes_written / elapsed : 0});
+	};
+
+	const WakeSession wake_session(*this);
+	for (uint32_t offset = 0; offset < byte_count; offset += APP_DATA_BOOT_LEN)
+	{
+		try
+		{
+			I2CManager::write_to_device(m_file_handle, APP_DATA_BOOT_REG, firmware + offset, APP_DATA_BOOT_LEN);
+
+			// Nothing in the status register tells when the block is programmed, so the write time is waited
+			// for in any case. The status is only read to stop at the first error.
+			std::this_thread::sleep_for(std::chrono::milliseconds(FIRMWARE_BLOCK_WRITE_TIME_IN_MS));
+			poll_boot_status(0, FIRMWARE_WRITE_TIMEOUT_IN_MS);
+		}
+		catch (exception::HALException& ex)
+		{
+			throw exception::I2CException("CCS811", "write_firmware_blocks", m_dev_id, APP_DATA_BOOT_REG,
+													std::string("Could not write firmware block at offset ").append(std::to_string(offset)).append(
+														":\n").append(ex.to_string()));
+		}
+
+		const auto bytes_written = offset + APP_DATA_BOOT_LEN;
+		if (bytes_written % FIRMWARE_PROGRESS_INTERVAL_IN_BYTES == 0 || bytes_written == byte_count)
+		{
+			report(bytes_written);
+		}
+	}
+}
+
+uint8_t hal::sensors::i2c::ccs811::CCS811::poll_boot_status(const uint8_t mask, const uint32_t timeout_in_ms) const
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_in_ms);
+	while (true)
+	{
+		uint8_t status = 0;
+		auto readable = true;
+		try
+		{
+			I2CManager::read_from_device(m_file_handle, STATUS_BOOT_REG, &status, STATUS_BOOT_LEN);
+		}
+		catch (exception::HALException&)
+		{
+			readable = false; // The device does not respond while it accesses its flash
+		}
+
+		if (readable)
+		{
+			if ((status & STATUS_ERROR_MASK) != 0)
+			{
+				Status parsed{};
+				parse_status(status, read_error(), parsed);
+				std::string message("The device reported an error:");
+				for (const auto& error : parsed.error_message)
+				{
+					message.append("\n").append(error);
+				}
+				throw exception::HALException("CCS811", "poll_boot_status", message);
+			}
+			if ((status & mask) == mask)
+			{
+				return status;
+			}
+		}
+
+		if (std::chrono::steady_clock::now() >= deadline)
+		{
+			throw exception::HALException("CCS811", "poll_boot_status",
+													std::string("Timed out after ").append(std::to_string(timeout_in_ms)).append(
+														"ms while waiting for the status register."));
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(FIRMWARE_POLL_INTERVAL_IN_MS));
+	}
+}
+
 int8_t hal::sensors::i2c::ccs811::CCS811::check_device_mode() const
 {
 	try
@@ -1089,117 +1260,541 @@ uint8_t hal::sensors::i2c::ccs811::CCS811::read_error() const
 	uint8_t error_code[ERROR_LEN] = {0};
 	try
 	{
-		if (m_use_power_safe_mode) wake_device();
+		const WakeSession wake_session(*this);
 		I2CManager::read_from_device(m_file_handle, ERROR_REG, error_code, ERROR_LEN);
-		if (m_use_power_safe_mode) unwake_device();
 	}
 	catch (exception::HALException& ex)
 	{
-		if (m_use_power_safe_mode) unwake_device();
 		throw exception::I2CException("CCS811", "read_error", m_dev_id, ERROR_REG,
 												std::string("Could not read error data from the device:\n").append(ex.to_string()));
 	}
 	return error_code[0];
 }
 
+int8_t hal::sensors::i2c::ccs811::CCS811::enable_automatic_mode_selection(const bool interrupt_mode, const bool use_thresholds)
+{
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	m_auto_interrupt_mode = interrupt_mode;
+	m_auto_use_thresholds = use_thresholds;
+	m_auto_mode_selection = true;
+	try
+	{
+		return apply_subscriber_mode();
+	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("CCS811", "enable_automatic_mode_selection",
+												std::string("Could not apply operation mode:\n").append(ex.to_string()));
+	}
+}
+
+void hal::sensors::i2c::ccs811::CCS811::disable_automatic_mode_selection() noexcept
+{
+	m_auto_mode_selection = false;
+}
+
+hal::sensors::i2c::ccs811::OperationMode hal::sensors::i2c::ccs811::CCS811::select_mode_for_subscribers() noexcept
+{
+	// Only the fastest subscriber matters. Subscribers without interval accept any data rate.
+	uint32_t fastest_interval_in_ms = 0;
+	for (const auto type : {SensorType::CO2, SensorType::TVOC})
+	{
+		for (const auto& handle : get_value_callbacks(type))
+		{
+			if (handle->interval_in_ms != 0 && (fastest_interval_in_ms == 0 || handle->interval_in_ms < fastest_interval_in_ms))
+			{
+				fastest_interval_in_ms = handle->interval_in_ms;
+			}
+		}
+	}
+
+	// The slowest mode that still delivers a new sample within the interval of the fastest subscriber.
+	if (fastest_interval_in_ms == 0 || fastest_interval_in_ms >= 60000)
+	{
+		return OperationMode::PULSE_60_S;
+	}
+	if (fastest_interval_in_ms >= 10000)
+	{
+		return OperationMode::PULSE_10_S;
+	}
+	if (fastest_interval_in_ms >= 1000)
+	{
+		return OperationMode::CONSTANT_POWER_1_S;
+	}
+	return OperationMode::CONSTANT_POWER_250_MS;
+}
+
+int8_t hal::sensors::i2c::ccs811::CCS811::apply_subscriber_mode()
+{
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	if (!m_auto_mode_selection)
+	{
+		return WARNING;
+	}
+
+	const auto mode = select_mode_for_subscribers();
+	if (m_mode_switch_timer_handle != 0)
+	{
+		// The device idles before switching to a slower mode. Only a faster mode needs to be applied right away.
+		if (mode < m_mode_before_switch)
+		{
+			m_pending_mode = mode;
+			return MODE_SWITCH_WARNING;
+		}
+	}
+	else if (mode == m_current_mode)
+	{
+		return WARNING;
+	}
+	return set_operation_mode(mode, m_auto_interrupt_mode, m_auto_use_thresholds);
+}
+
+void hal::sensors::i2c::ccs811::CCS811::on_callbacks_changed() noexcept
+{
+	if (!m_auto_mode_selection)
+	{
+		return;
+	}
+
+	try
+	{
+		apply_subscriber_mode();
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "CCS811 [on_callbacks_changed] Could not apply operation mode:\n" << ex.to_string() << std::endl;
+	}
+}
+
+void hal::sensors::i2c::ccs811::CCS811::schedule_pending_mode_switch(const OperationMode previous_mode, const OperationMode mode,
+																							const bool interrupt_mode, const bool use_thresholds)
+{
+	m_mode_before_switch = previous_mode;
+	m_pending_mode = mode;
+	m_pending_interrupt_mode = interrupt_mode;
+	m_pending_use_thresholds = use_thresholds;
+	m_mode_switch_pending = true;
+	m_mode_switch_timer_handle = EventScheduler::instance().add_timer(MODE_SWITCH_IDLE_TIME_IN_S * 1000, false,
+																							[this]() { on_pending_mode_switch(); });
+}
+
+void hal::sensors::i2c::ccs811::CCS811::cancel_pending_mode_switch() noexcept
+{
+	m_mode_switch_pending = false;
+	if (m_mode_switch_timer_handle != 0)
+	{
+		EventScheduler::instance().remove(m_mode_switch_timer_handle);
+		m_mode_switch_timer_handle = 0;
+	}
+}
+
+void hal::sensors::i2c::ccs811::CCS811::on_pending_mode_switch()
+{
+	// The thread that cancels the switch holds the lock and waits for this callback to return.
+	std::unique_lock<std::recursive_timed_mutex> lock(m_mutex, std::defer_lock);
+	while (!lock.try_lock_for(std::chrono::milliseconds(INTERRUPT_LOCK_RETRY_IN_MS)))
+	{
+		if (!m_mode_switch_pending)
+		{
+			return;
+		}
+	}
+	if (!m_mode_switch_pending)
+	{
+		return;
+	}
+
+	m_mode_switch_timer_handle = 0; // One-shot timer, removed by the scheduler after this callback
+	m_mode_switch_pending = false;
+	set_operation_mode(m_pending_mode, m_pending_interrupt_mode, m_pending_use_thresholds);
+}
+
 void hal::sensors::i2c::ccs811::CCS811::wake_device() const noexcept
 {
-	digitalWrite(m_wake_gpio_pin, LOW);
-	usleep(AWAKE_TIME_IN_US);
+	std::lock_guard<std::mutex> guard(m_wake_mutex);
+	if (m_wake_depth++ == 0 && m_use_power_safe_mode)
+	{
+		set_wake_pin(0);
+		usleep(AWAKE_TIME_IN_US);
+	}
 }
 
 void hal::sensors::i2c::ccs811::CCS811::unwake_device() const noexcept
 {
-	digitalWrite(m_wake_gpio_pin, HIGH);
-	usleep(DWAKE_TIME_IN_US);
+	std::lock_guard<std::mutex> guard(m_wake_mutex);
+	if (m_wake_depth == 0)
+	{
+		return;
+	}
+	if (--m_wake_depth == 0 && m_use_power_safe_mode)
+	{
+		set_wake_pin(1);
+		usleep(DWAKE_TIME_IN_US);
+	}
+}
+
+void hal::sensors::i2c::ccs811::CCS811::set_wake_pin(const int value) const noexcept
+{
+	if (m_wake_line == nullptr)
+	{
+		return;
+	}
+
+	try
+	{
+		m_wake_line->set_value(value);
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "CCS811 [set_wake_pin] Could not write nWAKE pin:\n" << ex.to_string() << std::endl;
+	}
+}
+
+hal::sensors::i2c::ccs811::CCS811::WakeSession::WakeSession(const CCS811& device) noexcept
+	: m_device(device)
+{
+	m_device.wake_device();
+}
+
+hal::sensors::i2c::ccs811::CCS811::WakeSession::~WakeSession() noexcept
+{
+	m_device.unwake_device();
 }
 
-void hal::sensors::i2c::ccs811::CCS811::start_interrupt_thread() noexcept
+void hal::sensors::i2c::ccs811::CCS811::set_interrupt_line(const std::shared_ptr<interfaces::IGPIOLine>& line)
 {
-	if (m_interrupt_thread == nullptr)
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	const auto was_active = m_int_watch_handle != 0;
+	stop_interrupt_handling();
+	m_int_line = line;
+	if (was_active)
 	{
-		m_use_interrupt_mode = true;
-		m_interrupt_thread = new std::thread(&CCS811::interrupt_mode_loop, this);
+		start_interrupt_handling();
 	}
 }
 
-void hal::sensors::i2c::ccs811::CCS811::stop_interrupt_thread() noexcept
+void hal::sensors::i2c::ccs811::CCS811::start_interrupt_handling()
 {
-	if (m_interrupt_thread != nullptr)
+	std::lock_guard<std::recursive_timed_mutex> guard(m_mutex);
+	if (m_int_line == nullptr)
+	{
+		m_int_line = GPIOFactory::open_line(m_int_gpio_pin_nr, false, GPIOEdge::FALLING, "ccs811-nint");
+	}
+
+	// The watchdog (re)starts with the period of the current mode. A running watchdog waits for the lock
+	// held by this thread until interrupt mode is cleared, so it is cleared before the watchdog is removed.
+	if (m_int_watchdog_handle != 0)
 	{
 		m_use_interrupt_mode = false;
-		m_interrupt_thread->join();
+		EventScheduler::instance().remove(m_int_watchdog_handle);
+		m_int_watchdog_handle = 0;
+	}
+
+	m_use_interrupt_mode = true;
+	if (m_int_watch_handle == 0)
+	{
+		m_int_watch_handle = EventScheduler::instance().watch_fd(m_int_line->get_event_fd(), [this]() { on_data_ready_edge(); });
+	}
+	m_int_watchdog_handle = EventScheduler::instance().add_timer(INTERRUPT_WATCHDOG_PERIODS * get_mode_period_in_ms(), true,
+																					[this]() { on_interrupt_watchdog(); });
+}
+
+void hal::sensors::i2c::ccs811::CCS811::stop_interrupt_handling() noexcept
+{
+	m_use_interrupt_mode = false;
+	if (m_int_watch_handle != 0)
+	{
+		EventScheduler::instance().remove(m_int_watch_handle);
+		m_int_watch_handle = 0;
+	}
+	if (m_int_watchdog_handle != 0)
+	{
+		EventScheduler::instance().remove(m_int_watchdog_handle);
+		m_int_watchdog_handle = 0;
+	}
+}
+
+void hal::sensors::i2c::ccs811::CCS811::on_data_ready_edge()
+{
+	GPIOEvent event;
+	if (!m_int_line->read_event(event) || event.edge != GPIOEdge::FALLING)
+	{
+		return;
 	}
+	service_data_ready();
 }
 
-void hal::sensors::i2c::ccs811::CCS811::wait_for_data_flag() const noexcept
+void hal::sensors::i2c::ccs811::CCS811::on_interrupt_watchdog()
 {
-	auto data_available = false;
-	while (!data_available && m_use_interrupt_mode)
+	// nINT stays LOW until the result data was read. If reading failed or an edge got lost no new
+	// edge will be generated, therefore the level is checked from time to time.
+	if (m_int_line->get_value() == 0)
 	{
-		mode_dependent_sleep();
-		if (digitalRead(m_int_gpio_pin_nr) == LOW)
+		service_data_ready();
+	}
+}
+
+void hal::sensors::i2c::ccs811::CCS811::service_data_ready()
+{
+	// The thread that stops interrupt handling holds the lock and waits for this callback to return.
+	std::unique_lock<std::recursive_timed_mutex> lock(m_mutex, std::defer_lock);
+	while (!lock.try_lock_for(std::chrono::milliseconds(INTERRUPT_LOCK_RETRY_IN_MS)))
+	{
+		if (!m_use_interrupt_mode)
+		{
+			return;
+		}
+	}
+	if (!m_use_interrupt_mode)
+	{
+		return;
+	}
+
+	// Read data
+	const WakeSession wake_session(*this);
+	ResultData results{};
+	try
+	{
+		if (read_result_data(results) != OK)
 		{
-			data_available = true;
+			return;
 		}
 	}
+	catch (exception::HALException& ex)
+	{
+		throw exception::HALException("CCS811", "service_data_ready",
+												std::string("Could not read result data:\n").append(ex.to_string()));
+	}
+	publish_results(results);
 }
 
-void hal::sensors::i2c::ccs811::CCS811::interrupt_mode_loop()
+int8_t hal::sensors::i2c::ccs811::CCS811::read_result_data(ResultData& result) const
 {
-	while (m_use_interrupt_mode)
+	uint8_t raw_results[RAW_DATA_LEN] = {0, 0, 0, 0, 0, 0, 0, 0};
+	try
+	{
+		const WakeSession wake_session(*this);
+		I2CManager::read_from_device(m_file_handle, RESULT_DATA_REG, raw_results, RAW_DATA_LEN);
+	}
+	catch (exception::HALException& ex)
 	{
-		if (m_int_check_thread == nullptr)
+		throw exception::I2CException("CCS811", "read_result_data", m_dev_id, RESULT_DATA_REG,
+												std::string("Could not read all result data from the device:\n").append(ex.to_string()));
+	}
+
+	result.eco2_value = BitManipulation::combine_bytes(raw_results[0], raw_results[1]);
+	result.tvoc_value = BitManipulation::combine_bytes(raw_results[2], raw_results[3]);
+	result.status = raw_results[4];
+	result.error_id = raw_results[5];
+	result.raw_data.voltage = BitManipulation::combine_bytes(RawVoltageHighField::decode(raw_results[RawVoltageHighField::BYTE]), raw_results[7]);
+	result.raw_data.current = RawCurrentField::decode(raw_results[RawCurrentField::BYTE]);
+
+	// The status byte is part of the result data. If the application is not running the values are invalid.
+	return FirmwareModeFlag::is_set(result.status) ? OK : WRONG_MODE_WARNING;
+}
+
+void hal::sensors::i2c::ccs811::CCS811::publish_results(const ResultData& results)
+{
+	if (ErrorFlag::is_set(results.status))
+	{
+		Status status{};
+		parse_status(results.status, results.error_id, status);
+		std::string message("The device reported an error. No values were published:");
+		for (const auto& error : status.error_message)
 		{
-			m_int_check_thread = new std::thread(&CCS811::wait_for_data_flag, this);
+			message.append("\n").append(error);
 		}
-		m_int_check_thread->join();
-		m_int_check_thread = nullptr;
+		throw exception::HALException("CCS811", "publish_results", message);
+	}
 
-		// Read data
-		auto results = std::make_shared<ResultData>();
-		try
+	const auto eco2 = std::to_string(results.eco2_value);
+	for (const auto& handle : get_value_callbacks(SensorType::CO2))
+	{
+		if (handle->callback != nullptr)
 		{
-			get_all_result_data(results);
+			handle->callback(eco2);
 		}
-		catch (exception::HALException& ex)
+	}
+
+	const auto tvoc = std::to_string(results.tvoc_value);
+	for (const auto& handle : get_value_callbacks(SensorType::TVOC))
+	{
+		if (handle->callback != nullptr)
 		{
-			throw exception::HALException("CCS811", "interrupt_mode_loop",
-													std::string("Could not read result data:\n").append(ex.to_string()));
+			handle->callback(tvoc);
 		}
+	}
+}
 
-		// Execute callbacks with new values
-		for (auto miter = m_callbacks.begin(); miter != m_callbacks.end(); ++miter)
+void hal::sensors::i2c::ccs811::CCS811::parse_status(const uint8_t raw_status, const uint8_t error_code, Status& status)
+{
+	status.has_error = ErrorFlag::is_set(raw_status);
+	if (status.has_error)
+	{
+		if (WriteRegisterInvalidFlag::is_set(error_code)) // WRITE_REG_INVALID
 		{
-			for (auto v_iterator = miter->second.begin(); v_iterator != miter->second.end(); ++v_iterator)
-			{
-				if ((*v_iterator)->callback != nullptr)
-				{
-					(*v_iterator)->callback(std::to_string(results->eco2_value));
-				}
-			}
+			status.error_message.push_back("CCS881 [get_status_information] Error WRITE_REG_INVALID: The CCS811 received an IC write"
+				"request addressed to this station but with invalid register address ID.");
+		}
+		if (ReadRegisterInvalidFlag::is_set(error_code)) // READ_REG_INVALID
+		{
+			status.error_message.push_back("CCS881 [get_status_information] Error READ_REG_INVALID: "
+				"The CCS811 received an IC read request to a mailbox ID that is invalid");
+		}
+		if (MeasureModeInvalidFlag::is_set(error_code)) // MEASUREMODE_INVALID
+		{
+			status.error_message.push_back("CCS881 [get_status_information] Error MEASUREMODE_INVALID: "
+				"The CCS811 received an IC request to write an unsupported mode to	MEAS_MODE");
+		}
+		if (MaxResistanceFlag::is_set(error_code)) // MAX_RESISTANCE
+		{
+			status.error_message.push_back("CCS881 [get_status_information] Error: MAX_RESISTANCE: "
+				"The sensor resistance measurement has reached or exceeded the maximum range");
+		}
+		if (HeaterFaultFlag::is_set(error_code)) // HEATER_FAULT
+		{
+			status.error_message.push_back("CCS881 [get_status_information] Error: HEATER_FAULT: "
+				"The Heater current in the CCS811 is not in range");
+		}
+		if (HeaterSupplyFlag::is_set(error_code)) // HEATER_SUPPLY_ERROR
+		{
+			status.error_message.push_back("CCS881 [get_status_information] Error: HEATER_SUPPLY_ERROR: "
+				"The Heater voltage is not being applied correctly");
 		}
 	}
+
+	status.raw_status_info = raw_status;
+	status.data_ready = DataReadyFlag::is_set(raw_status);
+	status.firmware_loaded = AppValidFlag::is_set(raw_status);
+	status.current_state = FirmwareModeFlag::is_set(raw_status) ? State::READY : State::BOOT;
 }
 
-void hal::sensors::i2c::ccs811::CCS811::mode_dependent_sleep() const noexcept
+uint32_t hal::sensors::i2c::ccs811::CCS811::get_mode_period_in_ms() const noexcept
 {
 	switch (m_current_mode)
 	{
 	case OperationMode::PULSE_10_S:
-		sleep(10);
-		return;
+		return 10000;
 	case OperationMode::PULSE_60_S:
-		sleep(60);
-		return;
+		return 60000;
 	case OperationMode::CONSTANT_POWER_1_S:
-		sleep(1);
-		return;
+		return 1000;
 	case OperationMode::CONSTANT_POWER_250_MS:
-		usleep(250000);
-		return;
+		return 250;
 	case OperationMode::SLEEP:
 	default:
+		return 60000;
+	}
+}
+
+void hal::sensors::i2c::ccs811::CCS811::load_baseline_snapshots() noexcept
+{
+	m_baseline_snapshots.clear();
+	if (m_baseline_store == nullptr)
+	{
+		return;
+	}
+
+	for (const auto mode : {OperationMode::PULSE_60_S, OperationMode::PULSE_10_S, OperationMode::CONSTANT_POWER_1_S,
+									OperationMode::CONSTANT_POWER_250_MS})
+	{
+		BaselineSnapshot snapshot{};
+		if (m_baseline_store->load(BaselineStore::make_key(m_hardware_id, m_dev_id, mode, m_baseline_device_identifier), snapshot) && snapshot.mode == mode)
+		{
+			m_baseline_snapshots[mode] = snapshot;
+		}
+	}
+}
+
+void hal::sensors::i2c::ccs811::CCS811::begin_baseline_tracking(const bool restore)
+{
+	stop_baseline_snapshots();
+	m_mode_entered = std::chrono::steady_clock::now();
+	m_mode_operating_time_s = 0;
+	if (m_baseline_store == nullptr || m_current_mode == OperationMode::SLEEP)
+	{
+		return;
+	}
+
+	const auto snapshot = m_baseline_snapshots.find(m_current_mode);
+	if (snapshot != m_baseline_snapshots.end())
+	{
+		m_mode_operating_time_s = snapshot->second.operating_time_in_s;
+		if (restore)
+		{
+			try
+			{
+				set_baseline(snapshot->second.baseline);
+			}
+			catch (exception::HALException& ex)
+			{
+				throw exception::HALException("CCS811", "begin_baseline_tracking",
+														std::string("Could not restore baseline snapshot:\n").append(ex.to_string()));
+			}
+		}
+	}
+
+	m_baseline_tracking = true;
+	schedule_baseline_snapshot();
+}
+
+void hal::sensors::i2c::ccs811::CCS811::schedule_baseline_snapshot()
+{
+	// The first snapshot of a mode is taken right after the warm up. Afterwards the interval follows
+	// the data sheet: every 36h during the first 500h of operation, every 6 days afterwards.
+	uint32_t delay_s;
+	if (m_baseline_snapshots.find(m_current_mode) == m_baseline_snapshots.end())
+	{
+		delay_s = BASELINE_WARM_UP_TIME_IN_S;
+	}
+	else if (m_mode_operating_time_s + std::chrono::duration_cast<std::chrono::seconds>(
+		std::chrono::steady_clock::now() - m_mode_entered).count() < BASELINE_THRESHOLD_IN_S)
+	{
+		delay_s = BASELINE_EARLY_SAVE_TIME_IN_S;
+	}
+	else
+	{
+		delay_s = BASELINE_LATE_SAVE_TIME_IN_S;
+	}
+
+	m_baseline_timer_handle = EventScheduler::instance().add_timer(delay_s * 1000, false, [this]() { on_baseline_snapshot(); });
+}
+
+void hal::sensors::i2c::ccs811::CCS811::stop_baseline_snapshots() noexcept
+{
+	m_baseline_tracking = false;
+	if (m_baseline_timer_handle != 0)
+	{
+		EventScheduler::instance().remove(m_baseline_timer_handle);
+		m_baseline_timer_handle = 0;
+	}
+}
+
+void hal::sensors::i2c::ccs811::CCS811::on_baseline_snapshot()
+{
+	// The thread that stops the snapshots holds the lock and waits for this callback to return.
+	std::unique_lock<std::recursive_timed_mutex> lock(m_mutex, std::defer_lock);
+	while (!lock.try_lock_for(std::chrono::milliseconds(INTERRUPT_LOCK_RETRY_IN_MS)))
+	{
+		if (!m_baseline_tracking)
+		{
+			return;
+		}
+	}
+	if (!m_baseline_tracking)
+	{
 		return;
 	}
+
+	m_baseline_timer_handle = 0; // One-shot timer, removed by the scheduler after this callback
+	try
+	{
+		save_baseline_snapshot();
+	}
+	catch (exception::HALException&)
+	{
+		schedule_baseline_snapshot();
+		throw;
+	}
+	schedule_baseline_snapshot();
 }
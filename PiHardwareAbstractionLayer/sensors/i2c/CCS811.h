@@ -1,14 +1,19 @@
 #pragma once
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
-#include <wiringPi.h>
-#include <thread>
 #include <vector>
 
+#include "CCS811BaselineStore.h"
 #include "CCS811Constants.h"
 #include "CCS811Definitions.h"
 #include "../../enums/SensorSetting.h"
+#include "../../interfaces/IGPIOLine.h"
 #include "../../interfaces/ISensor.h"
 #include "../../utils/I2CManager.h"
 
@@ -37,9 +42,12 @@ namespace hal
 					/*!
 					* Tells the hardware to perform a new measurement. The result will be sent with a callback function.
 					* If no callback is registered the measurement cannot be obtained.
+					* eCO2 and TVOC are read together with one access to the result register. If a new sample is
+					* available it is published to the eCO2 and the TVOC callbacks, regardless of the given type.
+					* In interrupt mode this method does nothing since new samples are published by the nINT handler.
 					* \param[in] type: The type of measurement that has to do be done.
-					* \throws HALException if triggering a eCO2 measurement fails.
-					* \throws HALException if triggering a TVOC measurement fails.
+					* \throws HALException if reading the result data fails.
+					* \throws HALException if the device reported an error.
 					* \throws HALException if the sensor type is invalid.
 					*/
 					void trigger_measurement(SensorType type) override;
@@ -90,9 +98,10 @@ namespace hal
 					* \param[in] use_power_safe_mode: Whether the devices processor should be put to sleep mode between i2c requests or not.
 					* \param[in] wake_gpio_pin_nr: The GPIO pin number of the nWAKE pin that is used to put the device to sleep and wake it up.
 					* \param[in] int_gpio_pin_nr: The GPIO pin number of the INT pin that is used to notify if new data is available.
+					* The pin is requested via \sa { HAL::Utils::GPIOFactory } as soon as interrupt mode is activated.
 					* \param[in] device_reg: The address of the device to open.
 					* \returns the id of the connected device.
-					* \throws GPIOException if initializing wiringPi fails.
+					* \throws GPIOException if the nWAKE pin could not be requested.
 					* \throws HALException if opening a connection to the device fails (e.g. the device was not found).
 					* \throws I2CException if reading the hardware id fails.
 					* \throws I2CException if the device id is not 0x81 (e.g. a wrong device is connected).
@@ -162,21 +171,77 @@ namespace hal
 
 					//! Sets the operation mode of this device.
 					/*!
-					*  Sets the operation mode of this device.
+					*  Sets the operation mode of this device. Switching to a slower mode puts the device to idle first
+					*  and applies the new mode after 10 minutes (returns MODE_SWITCH_WARNING in this case).
 					* \param[in] mode: The new operation mode of the device.
 					* \param[in] interrupt_mode: True if interrupt mode should be used.
 					* \param[in] use_thresholds: True if thresholds should be used.
 					* \returns 0 if setting the device mode was successful, a warning value otherwise.
 					* \throws HALException if reading the current device operation mode fails.
 					* \throws HALException if the operation mode that was read from the device is invalid.
-					* \throws HALException if setting the mode bits fails.
-					* \throws HALException if getting/setting the interrupt mode bit fails.
-					* \throws HALException if getting/setting the threshold mode bit fails.
 					* \throws I2CException if writing the new operation mode fails.
+					* \throws GPIOException if the nINT pin could not be requested in interrupt mode.
 					*/
 					int8_t set_operation_mode(OperationMode mode, bool interrupt_mode, bool use_thresholds);
+
+					//! Lets the registered callbacks decide about the operation mode.
+					/*!
+					* Lets the registered callbacks decide about the operation mode. The slowest mode whose sample period
+					* does not exceed the interval of the fastest eCO2 or TVOC callback is selected (PULSE_60_S if there
+					* is none). The mode is updated every time a callback is added or removed. Switching to a slower mode
+					* takes 10 minutes since the device has to idle first.
+					* \param[in] interrupt_mode: True if interrupt mode should be used.
+					* \param[in] use_thresholds: True if thresholds should be used.
+					* \returns 0 if the selected mode was set, a warning value otherwise (see <set_operation_mode>"()").
+					* \throws HALException if setting the selected operation mode fails.
+					*/
+					int8_t enable_automatic_mode_selection(bool interrupt_mode, bool use_thresholds);
+
+					//! Stops updating the operation mode if callbacks are added or removed.
+					/*!
+					* Stops updating the operation mode if callbacks are added or removed. The current mode is kept.
+					*/
+					void disable_automatic_mode_selection() noexcept;
 					// Todo implement wait time correctly
 
+					//! Replaces the line that is used to detect the falling edge of the nINT pin.
+					/*!
+					* Replaces the line that is used to detect the falling edge of the nINT pin. By default the pin
+					* that was passed to <init>"()" is requested via \sa { HAL::Utils::GPIOFactory }. Any other
+					* \sa { HAL::Interfaces::IGPIOLine } (e.g. a \sa { HAL::Utils::FakeGPIOLine } in tests) can be used instead.
+					* \param[in] line: The line to watch. Has to be requested with falling edge detection.
+					* \throws HALException if the line could not be watched.
+					*/
+					void set_interrupt_line(const std::shared_ptr<interfaces::IGPIOLine>& line);
+
+					//! Persists the baseline of each operation mode and restores it after a restart.
+					/*!
+					* Persists the baseline of each operation mode and restores it after a restart. The snapshots
+					* are loaded by <init>"()" and written back to the device as soon as the corresponding operation
+					* mode is entered. New snapshots are taken after the warm up time, every 36 hours during the
+					* first 500 hours of operation and every 6 days afterwards as well as on mode changes and <close>"()".
+					* Snapshots older than the maximum age are not restored, the sensor runs its normal burn-in instead.
+					* Should be called before <init>"()".
+					* The hardware id of all CCS811 is the same, so the device identifier is the only way to tell two
+					* sensors at the same address apart. Without it a replaced sensor restores the baseline of the old one
+					* until that snapshot exceeds the maximum age.
+					* \param[in] directory: The directory that stores the snapshot files. Created if it does not exist.
+					* \param[in] device_identifier: Identifier of the physical sensor (e.g. a label or serial number). May be empty.
+					* \param[in] max_age_in_s: The maximum age of a snapshot that is restored.
+					*/
+					void enable_baseline_store(const std::string& directory = DEFAULT_BASELINE_STORE_PATH,
+														const std::string& device_identifier = "",
+														uint32_t max_age_in_s = BASELINE_MAX_AGE_IN_S);
+
+					//! Stores the current baseline of the active operation mode.
+					/*!
+					* Stores the current baseline of the active operation mode. Nothing is stored if no store
+					* is enabled, the device sleeps or the warm up time of the mode has not passed yet.
+					* \returns 0 if the snapshot was stored, a warning otherwise.
+					* \throws HALException if reading the baseline or writing the snapshot fails.
+					*/
+					int8_t save_baseline_snapshot();
+
 					//! Returns the current eCO2 value.
 					/*!
 					* Returns the current eCO2 value.
@@ -215,7 +280,6 @@ namespace hal
 					* \returns 0 if getting the result data was successful, a warning if the device is still in BOOT mode.
 					* \throws HALException if reading the current device operation mode fails.
 					* \throws I2CException if reading the result data from the device fails.
-					* \throws HALException if reading the value of certain bits from byte fails.
 					*/
 					int8_t get_all_result_data(std::shared_ptr<ResultData>& result) const;
 
@@ -224,12 +288,13 @@ namespace hal
 					* Sets the current temperature and humidity in order to improve the calculation of
 					* the eCO2 and TVOC values.
 					* \param[in] temperature: The current temperature in Degree Celsius. The value is assumed to
-					* be 2 orders of magnitude greater than the usual value (e.g. 25.3C will be 2530). At the
-					* moment the CCS811 only supports 0.5 and 0 as fractions. Therefore all values will be rounded.
+					* be 2 orders of magnitude greater than the usual value (e.g. 25.3C will be 2530). The device
+					* stores the value with a resolution of 1/512C.
 					* \param[in] humidity: The current humidity in percent. The value is assumed to be 2 orders of
-					* magnitude greater than the usual value (e.g. 37.45% will be 3745). At the moment the CCS811
-					* only supports 0.5 and 0 as fractions. Therefore all values will be rounded.
+					* magnitude greater than the usual value (e.g. 37.45% will be 3745). The device stores the value
+					* with a resolution of 1/512%.
 					* \returns 0 if setting the environment data was successful, a warning if the device is still in BOOT mode.
+					* \throws HALException if a value exceeds the register (\sa { ENV_TEMPERATURE_MAX }, \sa { ENV_HUMIDITY_MAX }).
 					* \throws HALException if reading the current device operation mode fails.
 					* \throws I2CException if writing the environment data to the device fails.
 					*/
@@ -293,48 +358,74 @@ namespace hal
 					*/
 					int8_t set_baseline(uint8_t baseline[BASELINE_LEN]) const;
 
+					//! Replaces the firmware of the device with the firmware image stored in the given file.
+					/*!
+					* Replaces the firmware of the device with the firmware image stored in the given file. The file is
+					* memory mapped and streamed to the device block by block, so it never has to be copied into memory.
+					* If the application is running the device is reset to BOOT mode first. Afterwards the old firmware is
+					* erased, the new one is written and verified. Each step waits for the status register instead of
+					* using fixed delays.
+					* The device stays in BOOT mode. Call <start>"()" and <set_operation_mode>"()" afterwards.
+					*
+					* WARNING: There will be no backup of the old firmware version.
+					*
+					* \param[in] firmware_path: The path of the firmware image (*.bin). Its size has to be a multiple of 8 bytes.
+					* \param[in] progress_callback: Optional function that receives the written bytes and the throughput.
+					* \returns 0 if the new firmware was written and verified successfully.
+					* \throws HALException if the firmware file could not be mapped or has an invalid size.
+					* \throws HALException if resetting, erasing, writing or verifying fails or the new firmware is invalid.
+					*/
+					int8_t update_firmware(const std::string& firmware_path,
+												  const std::function<void(const FirmwareProgress&)>& progress_callback = nullptr);
+
 					//! WARNING: Deletes the firmware of the device.
 					/*!
-					* This operation might take some time and can only be performed in BOOT state. Read the status
-					* register to check if the operation has finished.
+					* This operation can only be performed in BOOT state. Blocks until the status register
+					* reports that the application was erased.
 					*
 					* WARNING: Deletes the firmware of the device. The device can not be used anymore to measure
 					*          eCO2 and TVOC values after deleting the firmware.
 					*          You have to copy a new firmware to the device in order to restore its functionality.
 					* WARNING: This class does not store any fall-back firmware version in case you deleted the one
 					*          on the sensor!
-					* \returns 0 if deleting the firmware was successful, a negative error value otherwise.
+					* \returns 0 if deleting the firmware was successful, a warning if the device is not in BOOT mode.
 					* \throws HALException if reading the current device operation mode fails.
+					* \throws HALException if erasing the firmware fails or times out.
 					*/
 					int8_t delete_current_firmware() const;
 
 					//! Writes new a firmware version to the device.
 					/*!
-					* This operation might take some time and can only be performed in BOOT state. Read the status
-					* register to check if the operation has finished.
+					* This operation might take some time and can only be performed in BOOT state. The next block
+					* is written as soon as the status register can be read again after the previous one.
 					*
 					* WARNING: There will be no backup of the old firmware version.
 					* WARNING: Please delete the old firmware by calling "delete_current_firmware()" first.
 					* WARNING: The device might not work as expected after changing the firmware version.
 					*
 					* \param[in] new_firmware: The new firmware to write to the device.
-					* \param[in] byte_count: The size of the new firmware. Since only 9 bytes can be written at once
-					* this value is used to cut the firmware in 9-byte parts.
-					* \returns 0 if writing the new firmware to the device was successful, a negative error value otherwise.
+					* \param[in] byte_count: The size of the new firmware. Since only 8 bytes can be written at once
+					* this value is used to cut the firmware in 8-byte parts and has to be a multiple of 8.
+					* \param[in] progress_callback: Optional function that receives the written bytes and the throughput.
+					* \returns 0 if writing the new firmware to the device was successful, a warning if the device is not in BOOT mode.
 					* \throws HALException if reading the current device operation mode fails.
+					* \throws HALException if the byte count is invalid.
+					* \throws HALException if writing a block fails or the device reported an error.
 					*/
-					int8_t write_new_firmware(std::shared_ptr<uint8_t[]> new_firmware, uint16_t byte_count) const;
+					int8_t write_new_firmware(std::shared_ptr<uint8_t[]> new_firmware, uint16_t byte_count,
+													  const std::function<void(const FirmwareProgress&)>& progress_callback = nullptr) const;
 
 					//! Verifies the currently installed firmware.
 					/*!
 					* Verifies the currently installed firmware. This only has to be done after installing
 					* a new firmware since the result will be stored directly on the device. The verification
-					* can only be done in BOOT state and might take some time to complete. Read the status
-					* register to check if the operation has finished.
+					* can only be done in BOOT state and blocks until the status register reports that the
+					* verification has finished.
 					*
 					* \param[out] firmware_valid: True if the firmware is valid, false otherwise.
-					* \returns 0 if verifying the firmware was successful, a negative error value otherwise.
+					* \returns 0 if verifying the firmware was successful, a warning if the device is not in BOOT mode.
 					* \throws HALException if reading the current device operation mode fails.
+					* \throws HALException if the verification fails or times out.
 					*/
 					int8_t verify_firmware(bool& firmware_valid) const;
 
@@ -348,6 +439,58 @@ namespace hal
 					*/
 					int8_t check_device_mode() const;
 
+					//! Reads eCO2, TVOC, status, error id and raw data with one i2c read.
+					/*!
+					* Reads eCO2, TVOC, status, error id and raw data with one i2c read. Unlike
+					* <get_all_result_data>"()" the device mode is taken from the returned status byte
+					* instead of reading the status register first.
+					* \param[out] result: The current result data.
+					* \returns 0 if the application is running, a warning if the device is still in BOOT mode.
+					* \throws I2CException if reading the result data from the device fails.
+					*/
+					int8_t read_result_data(ResultData& result) const;
+
+					//! Executes the eCO2 callbacks with the eCO2 value and the TVOC callbacks with the TVOC value.
+					/*!
+					* Executes the eCO2 callbacks with the eCO2 value and the TVOC callbacks with the TVOC value.
+					* \param[in] results: The result data to publish.
+					* \throws HALException if the status of the result data contains an error.
+					*/
+					void publish_results(const ResultData& results);
+
+					//! Converts a raw status byte and error code into a Status struct.
+					/*!
+					* Converts a raw status byte and error code into a Status struct.
+					* \param[in] raw_status: The value of the status register.
+					* \param[in] error_code: The value of the error register. Only used if the error bit of the status is set.
+					* \param[out] status: The parsed status information.
+					*/
+					static void parse_status(uint8_t raw_status, uint8_t error_code, Status& status);
+
+					//! Streams firmware blocks to the device.
+					/*!
+					* Streams firmware blocks to the device. After each block the bootloader gets the block write time
+					* (\sa { FIRMWARE_BLOCK_WRITE_TIME_IN_MS }) before the status register is checked for errors.
+					* \param[in] firmware: The firmware image.
+					* \param[in] byte_count: The size of the image. Has to be a multiple of 8.
+					* \param[in] progress_callback: Optional function that receives the written bytes and the throughput.
+					* \throws HALException if writing a block fails or the device reported an error.
+					*/
+					void write_firmware_blocks(const uint8_t* firmware, uint32_t byte_count,
+														const std::function<void(const FirmwareProgress&)>& progress_callback) const;
+
+					//! Polls the status register until all bits of the given mask are set.
+					/*!
+					* Polls the status register until all bits of the given mask are set. Failed reads are
+					* retried because the device may not respond while it accesses its flash.
+					* \param[in] mask: The status bits to wait for. 0 returns as soon as the status could be read, which
+					* only checks for errors.
+					* \param[in] timeout_in_ms: The maximum time to wait.
+					* \returns the raw status.
+					* \throws HALException if the error bit is set or the timeout expired.
+					*/
+					uint8_t poll_boot_status(uint8_t mask, uint32_t timeout_in_ms) const;
+
 					//! Tries to read an error code from the device register.
 					/*!
 					* Tries to read an error code from the device register.
@@ -356,75 +499,226 @@ namespace hal
 					*/
 					uint8_t read_error() const;
 
+					//! Keeps the device processor awake while it exists.
+					/*!
+					* Keeps the device processor awake while it exists. Sessions can be nested: Only the outermost
+					* session toggles the nWAKE pin, so consecutive register operations share one wake window
+					* instead of paying the wake up and sleep delays for every i2c request.
+					* Has no effect if the power safe mode is deactivated.
+					*/
+					class WakeSession
+					{
+					public:
+						/*!
+						* Constructor. Wakes the device if no other session is active.
+						* \param[in] device: The device to keep awake.
+						*/
+						explicit WakeSession(const CCS811& device) noexcept;
+
+						/*!
+						* Destructor. Puts the device to sleep if this was the last active session.
+						*/
+						~WakeSession() noexcept;
+
+						WakeSession(const WakeSession&) = delete;
+						WakeSession& operator=(const WakeSession&) = delete;
+
+					private:
+						const CCS811& m_device;
+					};
+
 					//! Sets the nWAKE pin to low which wakes the device processor up.
 					/*!
-					* Sets the nWAKE pin to low which wakes the device processor up. By waking the
-					* device before every i2c request its power consumption can be drastically reduced
-					* compared to the nWAKE pin being always low.
+					* Sets the nWAKE pin to low which wakes the device processor up if no wake session is active.
+					* By waking the device before i2c requests its power consumption can be drastically reduced
+					* compared to the nWAKE pin being always low. Use a \sa { WakeSession } instead of calling this directly.
 					*/
 					void wake_device() const noexcept;
 
 					//! Sets the nWAKE pin to high which puts the device processor to sleep mode.
 					/*!
-					* Sets the nWAKE pin to high which puts the device processor to sleep mode. By
-					* setting the device to sleep mode after every i2c request its power consumption
+					* Sets the nWAKE pin to high which puts the device processor to sleep mode if the last active
+					* wake session ended. By setting the device to sleep mode after i2c requests its power consumption
 					* can be drastically reduced compared to the nWAKE pin being always low.
 					*/
 					void unwake_device() const noexcept;
 
-					//! Starts a new thread that executes the <wait_for_data_flag>"() method.
+					//! Writes the nWAKE pin.
+					/*!
+					* Writes the nWAKE pin. Errors are logged since waking the device must not throw.
+					* \param[in] value: 0 to wake the device up, 1 to let it sleep.
+					*/
+					void set_wake_pin(int value) const noexcept;
+
+					//! Starts watching the nINT pin.
 					/*!
-					* Starts a new thread that executes the <wait_for_data_flag>"() method.
+					* Starts watching the nINT pin. The falling edge of the pin is detected by the kernel and
+					* serviced by the shared \sa { HAL::Utils::EventScheduler } thread, which reads the new
+					* result data and executes the callbacks. Additionally a watchdog timer checks the pin level
+					* in case an edge was missed. Calling this method again restarts the watchdog with the
+					* period of the current operation mode.
 					* Measure mode has to be set to interrupt to activate this kind of notification
 					* and data access.
+					* \throws GPIOException if the nINT pin could not be requested.
+					* \throws HALException if the pin could not be watched.
 					*/
-					void start_interrupt_thread() noexcept;
+					void start_interrupt_handling();
 
-					//! Stops the interrupt mode thread if it is running.
+					//! Stops watching the nINT pin.
 					/*!
-					* Stops the interrupt mode thread if it is running.
+					* Stops watching the nINT pin. Blocks until a running interrupt handler returned.
 					*/
-					void stop_interrupt_thread() noexcept;
+					void stop_interrupt_handling() noexcept;
 
-					//! Function that continuously checks the state of the nINT GPIO pin.
+					//! Handler that is executed if the nINT pin reported an edge.
 					/*!
-					* Function that continuously checks the state of the nINT GPIO pin. If the pin goes
-					* LOW it means that new data is available on the sensor. As a result <new_data_ready>"()"
-					* will be called and this method finishes. This method should be executed inside a thread.
-					* Measure mode has to be set to interrupt to activate this kind of notification and data
-					* access.
+					* Handler that is executed if the nINT pin reported an edge. Consumes the edge event and
+					* reads the new data on a falling edge.
+					* \throws HALException if reading result data failed.
 					*/
-					void wait_for_data_flag() const noexcept;
+					void on_data_ready_edge();
 
-					//! Thread function that controls the inner interrupt check thread.
+					//! Handler that is executed periodically while interrupt mode is active.
 					/*!
-					* The function checks if the int check thread finished. If this is the case, it reads
-					* data from the sensor and restarts the thread.
+					* Handler that is executed periodically while interrupt mode is active. nINT stays LOW until
+					* the result data was read, so no new edge is generated if a read failed. In this case the
+					* data is read by this handler.
+					* \throws GPIOException if reading the pin level failed.
 					* \throws HALException if reading result data failed.
 					*/
-					void interrupt_mode_loop();
+					void on_interrupt_watchdog();
 
-					//! Puts the calling thread to sleep mode by calling sleep().
+					//! Reads the new result data and executes the callbacks with the new values.
 					/*!
-					* Puts the calling thread to sleep mode by calling sleep(). The sleep time depends on the
-					* current operation mode:
-					* - SLEEP -> 0 seconds
+					* Reads the new result data and executes the callbacks with the new values.
+					* \throws HALException if reading result data failed.
+					*/
+					void service_data_ready();
+
+					//! Returns the time between two samples of the current operation mode.
+					/*!
+					* Returns the time between two samples of the current operation mode:
+					* - SLEEP -> 60 seconds (no samples, used as watchdog period only)
 					* - PULSE_60_S -> 60 seconds
 					* - PULSE_10_S -> 10 seconds
 					* - CONSTANT_POWER_1_S -> 1 second
 					* - CONSTANT_POWER_250_MS -> 0.25 seconds
+					* \returns the time between two samples in milliseconds.
+					*/
+					uint32_t get_mode_period_in_ms() const noexcept;
+
+					//! Returns the slowest operation mode that satisfies the fastest registered callback.
+					/*!
+					* Returns the slowest operation mode that satisfies the fastest registered callback.
+					* \returns the selected operation mode.
+					*/
+					OperationMode select_mode_for_subscribers() noexcept;
+
+					//! Switches to the operation mode selected by the registered callbacks.
+					/*!
+					* Switches to the operation mode selected by the registered callbacks if automatic mode selection is active.
+					* \returns 0 if the selected mode was set, a warning value otherwise (see <set_operation_mode>"()").
+					* \throws HALException if setting the selected operation mode fails.
+					*/
+					int8_t apply_subscriber_mode();
+
+					//! Updates the operation mode after a callback was added or removed.
+					/*!
+					* Updates the operation mode after a callback was added or removed. Errors are logged.
+					*/
+					void on_callbacks_changed() noexcept override;
+
+					//! Schedules the switch to a slower mode after the device idled long enough.
+					/*!
+					* Schedules the switch to a slower mode after the device idled long enough.
+					* \param[in] previous_mode: The mode the device ran in before it was put to idle.
+					* \param[in] mode: The mode to switch to.
+					* \param[in] interrupt_mode: True if interrupt mode should be used.
+					* \param[in] use_thresholds: True if thresholds should be used.
+					* \throws HALException if the timer could not be created.
+					*/
+					void schedule_pending_mode_switch(OperationMode previous_mode, OperationMode mode, bool interrupt_mode,
+																 bool use_thresholds);
+
+					//! Cancels a scheduled switch to a slower mode.
+					/*!
+					* Cancels a scheduled switch to a slower mode. Blocks until a running switch handler returned.
+					*/
+					void cancel_pending_mode_switch() noexcept;
+
+					//! Handler that is executed after the device idled long enough to switch to a slower mode.
+					/*!
+					* Handler that is executed after the device idled long enough to switch to a slower mode.
+					* \throws HALException if setting the pending operation mode fails.
+					*/
+					void on_pending_mode_switch();
+
+					//! Loads the baseline snapshots of all operation modes.
+					/*!
+					* Loads the baseline snapshots of all operation modes of this device. Missing, unreadable
+					* or outdated snapshots are skipped.
+					*/
+					void load_baseline_snapshots() noexcept;
+
+					//! Starts tracking the operating time of the current operation mode.
+					/*!
+					* Starts tracking the operating time of the current operation mode and schedules the next snapshot.
+					* \param[in] restore: True to write the stored baseline of the current mode to the device.
+					* \throws HALException if writing the baseline to the device fails.
+					*/
+					void begin_baseline_tracking(bool restore);
+
+					//! Schedules the next snapshot depending on the operating time of the current mode.
+					/*!
+					* Schedules the next snapshot depending on the operating time of the current mode.
+					* \throws HALException if the timer could not be created.
+					*/
+					void schedule_baseline_snapshot();
+
+					//! Cancels the next snapshot.
+					/*!
+					* Cancels the next snapshot. Blocks until a running snapshot handler returned.
+					*/
+					void stop_baseline_snapshots() noexcept;
+
+					//! Handler that is executed by the snapshot timer.
+					/*!
+					* Handler that is executed by the snapshot timer. Stores the current baseline and schedules the next snapshot.
+					* \throws HALException if reading the baseline or writing the snapshot fails.
 					*/
-					void mode_dependent_sleep() const noexcept;
+					void on_baseline_snapshot();
 
 					bool m_use_power_safe_mode{};
-					bool m_use_interrupt_mode{};
+					std::atomic_bool m_use_interrupt_mode = ATOMIC_VAR_INIT(false);
 					int m_wake_gpio_pin{};
 					int m_int_gpio_pin_nr{};
 					int m_file_handle{};
 					uint8_t m_dev_id{};
-					std::thread* m_interrupt_thread{};
-					std::thread* m_int_check_thread{};
+					std::shared_ptr<interfaces::IGPIOLine> m_int_line{};
+					std::shared_ptr<interfaces::IGPIOLine> m_wake_line{};
+					uint32_t m_int_watch_handle{};
+					uint32_t m_int_watchdog_handle{};
+					mutable std::recursive_timed_mutex m_mutex{};
+					mutable std::mutex m_wake_mutex{};
+					mutable uint32_t m_wake_depth{};
 					OperationMode m_current_mode = OperationMode::SLEEP;
+					std::atomic_bool m_auto_mode_selection = ATOMIC_VAR_INIT(false);
+					bool m_auto_interrupt_mode{};
+					bool m_auto_use_thresholds{};
+					std::atomic_bool m_mode_switch_pending = ATOMIC_VAR_INIT(false);
+					uint32_t m_mode_switch_timer_handle{};
+					OperationMode m_mode_before_switch = OperationMode::SLEEP;
+					OperationMode m_pending_mode = OperationMode::SLEEP;
+					bool m_pending_interrupt_mode{};
+					bool m_pending_use_thresholds{};
+					uint8_t m_hardware_id{};
+					std::unique_ptr<BaselineStore> m_baseline_store{};
+					std::string m_baseline_device_identifier{};
+					std::map<OperationMode, BaselineSnapshot> m_baseline_snapshots{};
+					std::atomic_bool m_baseline_tracking = ATOMIC_VAR_INIT(false);
+					uint32_t m_baseline_timer_handle{};
+					std::chrono::steady_clock::time_point m_mode_entered{};
+					uint64_t m_mode_operating_time_s{};
 				};
 			}
 		}
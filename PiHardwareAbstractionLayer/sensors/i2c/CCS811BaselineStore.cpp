@@ -0,0 +1,121 @@
+#include "CCS811BaselineStore.h"
+#include "CCS811Constants.h"
+
+#include "../../exceptions/HALException.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+hal::sensors::i2c::ccs811::BaselineStore::BaselineStore(const std::string& directory, const uint32_t max_age_in_s)
+	: m_directory(directory),
+		m_max_age_in_s(max_age_in_s)
+{
+}
+
+bool hal::sensors::i2c::ccs811::BaselineStore::load(const std::string& key, BaselineSnapshot& snapshot) const noexcept
+{
+	const auto file = fopen(path_of(key).c_str(), "r");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	unsigned int baseline;
+	unsigned int mode;
+	uint64_t operating_time;
+	int64_t saved_at;
+	const auto parsed = fscanf(file, "baseline=%x\nmode=%u\noperating_time=%" SCNu64 "\nsaved_at=%" SCNd64,
+										&baseline, &mode, &operating_time, &saved_at);
+	fclose(file);
+
+	if (parsed != 4 || baseline > 0xFFFF || mode > static_cast<unsigned int>(OperationMode::CONSTANT_POWER_250_MS))
+	{
+		return false;
+	}
+
+	// An old baseline no longer matches the sensor, restoring it would distort the measurements for days
+	const auto age = static_cast<int64_t>(time(nullptr)) - saved_at;
+	if (age < 0 || age > static_cast<int64_t>(m_max_age_in_s))
+	{
+		return false;
+	}
+
+	snapshot.baseline[0] = static_cast<uint8_t>(baseline >> 8);
+	snapshot.baseline[1] = static_cast<uint8_t>(baseline & 0xFF);
+	snapshot.mode = static_cast<OperationMode>(mode);
+	snapshot.operating_time_in_s = operating_time;
+	snapshot.saved_at = saved_at;
+	return true;
+}
+
+void hal::sensors::i2c::ccs811::BaselineStore::save(const std::string& key, const BaselineSnapshot& snapshot) const
+{
+	// Create the directory and its parents if necessary
+	for (auto pos = m_directory.find('/', 1); ; pos = m_directory.find('/', pos + 1))
+	{
+		const auto part = m_directory.substr(0, pos);
+		if (mkdir(part.c_str(), 0755) < 0 && errno != EEXIST)
+		{
+			throw exception::HALException("BaselineStore", "save",
+													std::string("Could not create directory '").append(part).append("': ").append(strerror(errno)));
+		}
+		if (pos == std::string::npos)
+		{
+			break;
+		}
+	}
+
+	// Write to a temporary file first and rename it afterwards. Renaming is atomic.
+	const auto path = path_of(key);
+	const auto tmp_path = std::string(path).append(".tmp");
+	const auto file = fopen(tmp_path.c_str(), "w");
+	if (file == nullptr)
+	{
+		throw exception::HALException("BaselineStore", "save",
+												std::string("Could not open '").append(tmp_path).append("': ").append(strerror(errno)));
+	}
+
+	const auto written = fprintf(file, "baseline=%04x\nmode=%u\noperating_time=%" PRIu64 "\nsaved_at=%" PRId64 "\n",
+										static_cast<unsigned int>((snapshot.baseline[0] << 8) | snapshot.baseline[1]),
+										static_cast<unsigned int>(snapshot.mode), snapshot.operating_time_in_s, snapshot.saved_at);
+	const auto flushed = fflush(file) == 0 && fsync(fileno(file)) == 0;
+	fclose(file);
+
+	if (written < 0 || !flushed || rename(tmp_path.c_str(), path.c_str()) < 0)
+	{
+		unlink(tmp_path.c_str());
+		throw exception::HALException("BaselineStore", "save",
+												std::string("Could not write snapshot '").append(path).append("': ").append(strerror(errno)));
+	}
+}
+
+std::string hal::sensors::i2c::ccs811::BaselineStore::make_key(const uint8_t hardware_id, const uint8_t device_address, const OperationMode mode,
+																					  const std::string& device_identifier)
+{
+	char prefix[16];
+	snprintf(prefix, sizeof(prefix), "ccs811_%02x_%02x_", hardware_id, device_address);
+	std::string key(prefix);
+
+	// The identifier becomes part of the file name
+	for (const auto character : device_identifier)
+	{
+		key.push_back(isalnum(static_cast<unsigned char>(character)) || character == '-' || character == '_' ? character : '_');
+	}
+	if (!device_identifier.empty())
+	{
+		key.push_back('_');
+	}
+	return key.append("mode").append(std::to_string(static_cast<unsigned int>(mode)));
+}
+
+std::string hal::sensors::i2c::ccs811::BaselineStore::path_of(const std::string& key) const
+{
+	return std::string(m_directory).append("/").append(key).append(BASELINE_FILE_EXTENSION);
+}
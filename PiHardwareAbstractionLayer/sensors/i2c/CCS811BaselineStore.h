@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "CCS811Constants.h"
+#include "CCS811Definitions.h"
+
+namespace hal
+{
+	namespace sensors
+	{
+		namespace i2c
+		{
+			namespace ccs811
+			{
+				//! Class that persists CCS811 baseline snapshots in small local files.
+				/*!
+				* This class stores one file per device and operation mode in a directory. Each file contains
+				* the raw baseline together with the accumulated operating time of the mode. Files are replaced
+				* atomically so a power loss during saving never corrupts an existing snapshot.
+				* Snapshots older than the maximum age are not loaded, the sensor then runs its normal burn-in.
+				*/
+				class BaselineStore
+				{
+				public:
+					BaselineStore() = delete;
+					BaselineStore(const BaselineStore&) = delete;
+					BaselineStore(BaselineStore&&) = delete;
+					~BaselineStore() = default;
+					BaselineStore& operator=(const BaselineStore&) = delete;
+					BaselineStore& operator=(BaselineStore&&) = delete;
+
+					/*!
+					* Constructor.
+					* \param[in] directory: The directory the snapshot files are stored in. Will be created if it does not exist.
+					* \param[in] max_age_in_s: The maximum age of a snapshot that is loaded.
+					*/
+					explicit BaselineStore(const std::string& directory, uint32_t max_age_in_s = BASELINE_MAX_AGE_IN_S);
+
+					//! Loads a snapshot.
+					/*!
+					* Loads a snapshot.
+					* \param[in] key: The key of the snapshot (see <make_key>"()").
+					* \param[out] snapshot: The loaded snapshot.
+					* \returns True if a valid snapshot was found that is not older than the maximum age, false otherwise.
+					* Snapshots with a save time in the future are rejected as well because their age is unknown.
+					*/
+					bool load(const std::string& key, BaselineSnapshot& snapshot) const noexcept;
+
+					//! Saves a snapshot.
+					/*!
+					* Saves a snapshot and replaces an existing one with the same key.
+					* \param[in] key: The key of the snapshot (see <make_key>"()").
+					* \param[in] snapshot: The snapshot to save.
+					* \throws HALException if the directory could not be created.
+					* \throws HALException if the snapshot file could not be written.
+					*/
+					void save(const std::string& key, const BaselineSnapshot& snapshot) const;
+
+					//! Builds the key of a snapshot.
+					/*!
+					* Builds the key of a snapshot from the hardware id and the i2c address of the device, an optional
+					* identifier and the operation mode the baseline belongs to. The hardware id is the same for every
+					* CCS811 (0x81), so without an identifier a sensor that is replaced by another one at the same
+					* address gets the baseline of its predecessor (limited by the maximum age).
+					* \param[in] hardware_id: The hardware id of the device.
+					* \param[in] device_address: The i2c address of the device.
+					* \param[in] mode: The operation mode.
+					* \param[in] device_identifier: Identifier of the physical sensor chosen by the caller (e.g. a label or
+					* serial number). Characters other than letters, digits, '-' and '_' are replaced. Empty to leave it out.
+					* \returns the key of the snapshot.
+					*/
+					static std::string make_key(uint8_t hardware_id, uint8_t device_address, OperationMode mode,
+														 const std::string& device_identifier = "");
+
+				protected:
+					/*!
+					* Returns the path of the snapshot file with the given key.
+					* \param[in] key: The key of the snapshot.
+					* \returns the path of the snapshot file.
+					*/
+					std::string path_of(const std::string& key) const;
+
+					std::string m_directory;
+					uint32_t m_max_age_in_s;
+				};
+			}
+		}
+	}
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include "../../utils/RegisterField.h"
 
 namespace hal
 {
@@ -60,7 +61,7 @@ namespace hal
 				// Boot mode lengths
 				static constexpr uint8_t STATUS_BOOT_LEN = 1;
 				static constexpr uint8_t APP_ERASE_BOOT_LEN = 4;
-				static constexpr uint8_t APP_DATA_BOOT_LEN = 9;
+				static constexpr uint8_t APP_DATA_BOOT_LEN = 8;
 				static constexpr uint8_t APP_VERIFY_BOOT_LEN = 1;
 				static constexpr uint8_t APP_START_LEN = 1;
 
@@ -82,6 +83,30 @@ namespace hal
 				static constexpr uint8_t CONSTANT_POWER_250_MS = 4 << 4;
 				static constexpr uint8_t MODE_MASK = 0x70;
 
+				// Register fields
+				using ErrorFlag = utils::Flag<STATUS_REG, 0>;
+				using DataReadyFlag = utils::Flag<STATUS_REG, 3>;
+				using AppValidFlag = utils::Flag<STATUS_REG, 4>;
+				using FirmwareModeFlag = utils::Flag<STATUS_REG, 7>;
+				using DriveModeField = utils::Field<MODE_REG, 4, 3>;
+				using InterruptFlag = utils::Flag<MODE_REG, 3>;
+				using ThresholdFlag = utils::Flag<MODE_REG, 2>;
+				using RawCurrentField = utils::Field<RESULT_DATA_REG, 2, 6, 6>;
+				using RawVoltageHighField = utils::Field<RESULT_DATA_REG, 0, 2, 6>;
+				using HardwareVersionMajorField = utils::Field<HARDWARE_VERSION_REG, 4, 4>;
+				using HardwareVersionMinorField = utils::Field<HARDWARE_VERSION_REG, 0, 4>;
+				using FirmwareVersionMajorField = utils::Field<FIRMWARE_VERSION_REG, 4, 4>;
+				using FirmwareVersionMinorField = utils::Field<FIRMWARE_VERSION_REG, 0, 4>;
+				using ApplicationVersionMajorField = utils::Field<APPLICATION_VERSION_REG, 4, 4>;
+				using ApplicationVersionMinorField = utils::Field<APPLICATION_VERSION_REG, 0, 4>;
+				using WriteRegisterInvalidFlag = utils::Flag<ERROR_REG, 0>;
+				using ReadRegisterInvalidFlag = utils::Flag<ERROR_REG, 1>;
+				using MeasureModeInvalidFlag = utils::Flag<ERROR_REG, 2>;
+				using MaxResistanceFlag = utils::Flag<ERROR_REG, 3>;
+				using HeaterFaultFlag = utils::Flag<ERROR_REG, 4>;
+				using HeaterSupplyFlag = utils::Flag<ERROR_REG, 5>;
+				static_assert(DriveModeField::MASK == MODE_MASK, "The register field does not match the bit mask.");
+
 				// Extrema
 				static constexpr uint16_t LOW_MEDIUM_DEFAULT_THRES = 1500;
 				static constexpr uint16_t MEDIUM_HIGH_DEFAULT_THRES = 2500;
@@ -91,6 +116,9 @@ namespace hal
 				static constexpr uint16_t TVOC_MAX = 1187;
 				static constexpr uint16_t TVOC_MIN = 0;
 				static constexpr uint8_t TEMPERATURE_BASELINE = 25;
+				static constexpr uint16_t ENV_DATA_RESOLUTION = 512; // Environment data is transmitted in 1/512 steps
+				static constexpr uint16_t ENV_TEMPERATURE_MAX = 10299; // Largest temperature (x100) whose (T + 25) * 512 fits 16 bit
+				static constexpr uint16_t ENV_HUMIDITY_MAX = 10000; // 100% (x100)
 
 				// Time constants
 				static constexpr uint32_t NEW_SENSOR_BURN_IN_TIME_IN_S = 172800; // 48h in seconds (for new sensors only)
@@ -105,6 +133,42 @@ namespace hal
 				// 75 micro seconds. Data-sheet says it takes minimum 50 micro seconds to awake the processor, so I decided to give him a little bit more time
 				static constexpr uint32_t DWAKE_TIME_IN_US = 45;
 				// 35 micro seconds. Data-sheet says the minimum time to deassert awake is 20 micro seconds to, so I decided to give it a little bit more time
+				static constexpr uint32_t MODE_SWITCH_IDLE_TIME_IN_S = 600;
+				// 10min in seconds. The device has to idle this long before it is switched to a slower mode
+				static constexpr uint32_t BASELINE_WARM_UP_TIME_IN_S = 1200;
+				// 20min in seconds. Baselines are not saved until the sensor ran this long in the current mode
+				static constexpr uint32_t BASELINE_MAX_AGE_IN_S = 604800;
+				// 7d in seconds. Older snapshots are not restored (one day more than the late save interval)
+				static constexpr uint32_t INTERRUPT_WATCHDOG_PERIODS = 2;
+				// Number of sample periods without a falling edge on nINT before the pin level is checked manually
+				static constexpr uint32_t INTERRUPT_LOCK_RETRY_IN_MS = 10;
+				// Time the interrupt handler waits for the device lock before it checks whether interrupt mode was stopped
+
+				static constexpr uint32_t FIRMWARE_RESET_TIME_IN_MS = 20;
+				// 20ms. Time the device needs to restart into BOOT mode after a software reset
+				static constexpr uint32_t FIRMWARE_ERASE_TIMEOUT_IN_MS = 1000;
+				// Maximum time to wait until the APP_ERASE bit of the status register is set
+				static constexpr uint32_t FIRMWARE_BLOCK_WRITE_TIME_IN_MS = 50;
+				// 50ms. Time the bootloader needs to program one APP_DATA block. The status register has no bit that
+				// signals the end of a block write, so the reference flashing flow (e.g. ccs811flash) waits this long
+				static constexpr uint32_t FIRMWARE_WRITE_TIMEOUT_IN_MS = 100;
+				// Maximum time to wait until the status register can be read again after a firmware block
+				static constexpr uint32_t FIRMWARE_VERIFY_TIMEOUT_IN_MS = 1000;
+				// Maximum time to wait until the APP_VERIFY bit of the status register is set
+				static constexpr uint32_t FIRMWARE_POLL_INTERVAL_IN_MS = 1;
+				// Time between two reads of the status register while waiting for a firmware operation
+				static constexpr uint32_t FIRMWARE_PROGRESS_INTERVAL_IN_BYTES = 512;
+				// The progress of a firmware update is reported every time this amount of bytes was written
+
+				// Boot mode status bits
+				static constexpr uint8_t STATUS_ERROR_MASK = 1 << 0;
+				static constexpr uint8_t STATUS_APP_VALID_MASK = 1 << 4;
+				static constexpr uint8_t STATUS_APP_ERASE_MASK = 1 << 5;
+				static constexpr uint8_t STATUS_APP_VERIFY_MASK = 1 << 6;
+
+				// Baseline store
+				static constexpr const char* DEFAULT_BASELINE_STORE_PATH = "/var/lib/pidashboard/ccs811";
+				static constexpr const char* BASELINE_FILE_EXTENSION = ".baseline";
 
 				// Warnings
 				static constexpr int8_t MODE_SWITCH_WARNING = 34;
@@ -1,4 +1,7 @@
 #pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace hal
 {
@@ -77,6 +80,21 @@ namespace hal
 					uint8_t error_id;
 					RawData raw_data;
 				};
+
+				struct FirmwareProgress
+				{
+					uint32_t bytes_written;
+					uint32_t total_bytes;
+					double bytes_per_second;
+				};
+
+				struct BaselineSnapshot
+				{
+					uint8_t baseline[2]; // Raw value of the baseline register (BASELINE_LEN bytes)
+					OperationMode mode; // The baselines of different operation modes are not interchangeable
+					uint64_t operating_time_in_s; // Accumulated operating time in this mode
+					int64_t saved_at; // Unix timestamp of the snapshot
+				};
 			}
 		}
 	}
@@ -2,6 +2,7 @@
 #include "../../utils/BitManipulation.h"
 #include "../../utils/EnumConverter.h"
 #include "../../utils/I2CManager.h"
+#include "../../utils/RegisterMap.h"
 #include <regex>
 #include <ctime>
 #include <iomanip>
@@ -213,67 +214,52 @@ void hal::sensors::i2c::ds3231::DS3231::sync_time()
 	auto now = time(nullptr);
 	const auto now_tm = gmtime(&now);
 
+	// The time registers are adjacent, so they are read and written with one burst each
+	RegisterMap time_registers(SECONDS_REGISTER, YEAR_REGISTER - SECONDS_REGISTER + 1, RegisterAccess::AUTO_INCREMENT);
 	try
 	{
+		time_registers.load(m_file_handle);
+
 		// Seconds
-		auto bcd_seconds = BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_sec));
-		I2CManager::write_to_device(m_file_handle, SECONDS_REGISTER, &bcd_seconds, 1);
+		time_registers.set<SecondsField>(BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_sec)));
 
 		// Minutes
-		auto bcd_minutes = BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_min));
-		I2CManager::write_to_device(m_file_handle, MINUTES_REGISTER, &bcd_minutes, 1);
+		time_registers.set<MinutesField>(BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_min)));
 
 		// Hours
-		const auto bcd_hours = BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_hour));
-		uint8_t hour_data[1];
-		I2CManager::read_from_device(m_file_handle, HOURS_REGISTER, hour_data, 1);
-		BitManipulation::set_bits(hour_data[0], 0, static_cast<uint8_t>(63)); // Clean all existing hour data
-		if (get_hour_format() == HourFormat::HOUR_FORMAT_12) // 12 Hour format
+		if (time_registers.get<HourFormatFlag, bool>()) // 12 Hour format
 		{
-			if (now_tm->tm_hour > 12)
-			{
-				now_tm->tm_hour = now_tm->tm_hour - 12;
-				BitManipulation::set_bit(hour_data[0], AM_PM_INDEX, true); // PM
-			}
-			else
-			{
-				if (now_tm->tm_hour == 0)
-				{
-					now_tm->tm_hour = 12;
-				}
-				BitManipulation::set_bit(hour_data[0], AM_PM_INDEX, false); // AM
-			}
-			hour_data[0] = BitManipulation::combine(hour_data[0], bcd_hours);
+			time_registers.set<AmPmFlag>(now_tm->tm_hour >= 12);
+			const auto hours = now_tm->tm_hour % 12 == 0 ? 12 : now_tm->tm_hour % 12;
+			time_registers.set<Hours12Field>(BitManipulation::to_bcd(static_cast<uint8_t>(hours)));
 		}
 		else // 24 Hour format
 		{
-			hour_data[0] = BitManipulation::combine(hour_data[0], bcd_hours);
+			time_registers.set<Hours24Field>(BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_hour)));
 		}
-		I2CManager::write_to_device(m_file_handle, HOURS_REGISTER, &hour_data[0], 1);
 
 		// Month
-		const auto bcd_month = BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_mon));
-		uint8_t month_data[1];
-		I2CManager::read_from_device(m_file_handle, MONTH_REGISTER, month_data, 1);
-		BitManipulation::set_bits(month_data[0], 0, static_cast<uint8_t>(127));
-		month_data[0] = BitManipulation::combine(month_data[0], bcd_month);
-		I2CManager::write_to_device(m_file_handle, MONTH_REGISTER, &month_data[0], 1);
+		time_registers.set<MonthField>(BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_mon)));
 
 		// Year
 		// Need to do modulo 100 because tm stores year as current year - 1900
 		// e.g. the year 2020 = 2020 - 1900 = 120 in tm struct
 		// 120 % 100 = 20 = last two digits of the year and independent of current century
-		auto bcd_year = BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_year % 100));
-		I2CManager::write_to_device(m_file_handle, YEAR_REGISTER, &bcd_year, 1);
+		time_registers.set<YearField>(BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_year % 100)));
 
 		// Date (day in month)
-		auto bcd_date = BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_mday));
-		I2CManager::write_to_device(m_file_handle, DATE_REGISTER, &bcd_date, 1);
+		time_registers.set<DateField>(BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_mday)));
 
 		// Week day
 		// Need to add one because tm struct stores weekdays from 0 to 6 and RTC awaits a value from 1 to 7.
-		auto bcd_day = BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_wday + 1));
-		I2CManager::write_to_device(m_file_handle, DAY_REGISTER, &bcd_day, 1);
+		time_registers.set<DayField>(BitManipulation::to_bcd(static_cast<uint8_t>(now_tm->tm_wday + 1)));
+
+		// The clock kept running since the registers were read, so all of them are written even if they seem unchanged
+		for (auto reg = SECONDS_REGISTER; reg <= YEAR_REGISTER; reg++)
+		{
+			time_registers.touch(reg);
+		}
+		time_registers.apply(m_file_handle);
 
 		m_synced_during_this_run = true;
 	}
@@ -297,24 +283,16 @@ void hal::sensors::i2c::ds3231::DS3231::set_hour_format(const HourFormat format)
 				ex.to_string()));
 	}
 
-	try
-	{
-		switch (format)
-		{
-		case HourFormat::HOUR_FORMAT_12:
-			BitManipulation::set_bit(reg_data[0], HOUR_FORMAT_INDEX, true);
-			break;
-		case HourFormat::HOUR_FORMAT_24:
-			BitManipulation::set_bit(reg_data[0], HOUR_FORMAT_INDEX, false);
-			break;
-		default:
-			throw exception::HALException("DS3231", "set_hour_format", "Invalid value for HourFormat enum.");
-		}
-	}
-	catch (exception::HALException& ex)
+	switch (format)
 	{
-		throw exception::HALException("DS3231", "set_hour_format", std::string("Could not change hour format bit:\n").append(
-			ex.to_string()));
+	case HourFormat::HOUR_FORMAT_12:
+		HourFormatFlag::set(reg_data[0], true);
+		break;
+	case HourFormat::HOUR_FORMAT_24:
+		HourFormatFlag::set(reg_data[0], false);
+		break;
+	default:
+		throw exception::HALException("DS3231", "set_hour_format", "Invalid value for HourFormat enum.");
 	}
 
 	try
@@ -343,20 +321,11 @@ hal::sensors::i2c::ds3231::HourFormat hal::sensors::i2c::ds3231::DS3231::get_hou
 				ex.to_string()));
 	}
 
-	try
+	if (HourFormatFlag::is_set(reg_data[0]))
 	{
-		if (BitManipulation::is_bit_set(reg_data[0], HOUR_FORMAT_INDEX))
-		{
-			return HourFormat::HOUR_FORMAT_12;
-		}
-		return HourFormat::HOUR_FORMAT_24;
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_hour_format",
-			std::string("Could not check bit status because bit index is out of bounds:\n").append(
-				ex.to_string()));
+		return HourFormat::HOUR_FORMAT_12;
 	}
+	return HourFormat::HOUR_FORMAT_24;
 }
 
 void hal::sensors::i2c::ds3231::DS3231::set_oscillator_state(OscillatorState state) const
@@ -373,26 +342,17 @@ void hal::sensors::i2c::ds3231::DS3231::set_oscillator_state(OscillatorState sta
 				ex.to_string()));
 	}
 
-	try
-	{
-		switch (state)
-		{
-		case OscillatorState::START:
-			BitManipulation::set_bit(reg_data, EOSC_INDEX, false);
-			break;
-		case OscillatorState::STOP:
-			BitManipulation::set_bit(reg_data, EOSC_INDEX, true);
-			break;
-		default:
-			throw exception::HALException("DS3231", "set_oscillator_state",
-				"Invalid value for OscillatorState enum.");
-		}
-	}
-	catch (exception::HALException& ex)
+	switch (state)
 	{
+	case OscillatorState::START:
+		OscillatorDisabledFlag::set(reg_data, false);
+		break;
+	case OscillatorState::STOP:
+		OscillatorDisabledFlag::set(reg_data, true);
+		break;
+	default:
 		throw exception::HALException("DS3231", "set_oscillator_state",
-			std::string("Could not change oscillator state bit:\n").append(
-				ex.to_string()));
+			"Invalid value for OscillatorState enum.");
 	}
 
 	try
@@ -420,20 +380,11 @@ hal::sensors::i2c::ds3231::OscillatorState hal::sensors::i2c::ds3231::DS3231::ge
 			std::string("Could not read status register:\n").append(ex.to_string()));
 	}
 
-	try
+	if (OscillatorStoppedFlag::is_set(reg_data))
 	{
-		if (BitManipulation::is_bit_set(reg_data, OSF_INDEX))
-		{
-			return OscillatorState::STOP;
-		}
-		return OscillatorState::START;
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_oscillator_state",
-			std::string("Could not check bit status because bit index is out of bounds:\n").append(
-				ex.to_string()));
+		return OscillatorState::STOP;
 	}
+	return OscillatorState::START;
 }
 
 void hal::sensors::i2c::ds3231::DS3231::set_square_wave_state(SquareWaveState state) const
@@ -449,27 +400,19 @@ void hal::sensors::i2c::ds3231::DS3231::set_square_wave_state(SquareWaveState st
 			std::string("Could not read control register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		switch (state)
-		{
-		case SquareWaveState::STOP:
-			BitManipulation::set_bit(reg_data, EOSC_INDEX, false);
-			BitManipulation::set_bit(reg_data, INTCN_INDEX, true);
-			break;
-		case SquareWaveState::START:
-			BitManipulation::set_bit(reg_data, EOSC_INDEX, true);
-			BitManipulation::set_bit(reg_data, INTCN_INDEX, false);
-			break;
-		default:
-			throw exception::HALException("DS3231", "set_square_wave_state",
-				"Invalid value for SquareWaveState enum.");
-		}
-	}
-	catch (exception::HALException& ex)
+	switch (state)
 	{
+	case SquareWaveState::STOP:
+		OscillatorDisabledFlag::set(reg_data, false);
+		InterruptControlFlag::set(reg_data, true);
+		break;
+	case SquareWaveState::START:
+		OscillatorDisabledFlag::set(reg_data, true);
+		InterruptControlFlag::set(reg_data, false);
+		break;
+	default:
 		throw exception::HALException("DS3231", "set_square_wave_state",
-			std::string("Could not change square wave state bit:\n").append(ex.to_string()));
+			"Invalid value for SquareWaveState enum.");
 	}
 
 	try
@@ -496,20 +439,11 @@ hal::sensors::i2c::ds3231::SquareWaveState hal::sensors::i2c::ds3231::DS3231::ge
 			std::string("Could not read status register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		if (BitManipulation::is_bit_set(reg_data, EN32KHZ_INDEX))
-		{
-			return SquareWaveState::START;
-		}
-		return SquareWaveState::STOP;
-	}
-	catch (exception::HALException& ex)
+	if (Enable32kHzFlag::is_set(reg_data))
 	{
-		throw exception::HALException("DS3231", "get_square_wave_state",
-			std::string("Could not check bit status because bit index is out of bounds:\n").append(
-				ex.to_string()));
+		return SquareWaveState::START;
 	}
+	return SquareWaveState::STOP;
 }
 
 void hal::sensors::i2c::ds3231::DS3231::set_square_wave_rate(SquareWaveRate rate) const
@@ -525,15 +459,7 @@ void hal::sensors::i2c::ds3231::DS3231::set_square_wave_rate(SquareWaveRate rate
 			std::string("Could not read control register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		BitManipulation::set_bits(reg_data, static_cast<uint8_t>(rate), SQUARE_WAVE_RATE_MASK);
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "set_square_wave_rate",
-			std::string("Could not change square wave rate bits:\n").append(ex.to_string()));
-	}
+	SquareWaveRateField::set(reg_data, rate);
 
 	try
 	{
@@ -551,38 +477,16 @@ hal::sensors::i2c::ds3231::SquareWaveRate hal::sensors::i2c::ds3231::DS3231::get
 	uint8_t reg_data;
 	try
 	{
-		reg_data = read_status_register();
+		reg_data = read_control_register();
 	}
 	catch (exception::HALException& ex)
 	{
-		throw exception::I2CException("DS3231", "get_square_wave_rate", m_dev_id, STATUS_REGISTER,
-			std::string("Could not read status register:\n").append(ex.to_string()));
+		throw exception::I2CException("DS3231", "get_square_wave_rate", m_dev_id, CONTROL_REGISTER,
+			std::string("Could not read control register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		const auto value = BitManipulation::value_of_bits(reg_data, RS1_INDEX, RS2_INDEX);
-		switch (value)
-		{
-		case 0:
-			return SquareWaveRate::RATE_1_Hz;
-		case 1:
-			return SquareWaveRate::RATE_1024_kHz;
-		case 2:
-			return SquareWaveRate::RATE_4096_kHz;
-		case 3:
-			return SquareWaveRate::RATE_8192_kHz;
-		default:
-			throw exception::HALException("DS3231", "get_square_wave_rate",
-				std::string("Invalid value for square wave rate value: ").append(std::to_string(value)));
-		}
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_square_wave_rate",
-			std::string("Could not check bit status because bit index is out of bounds:\n").append(
-				ex.to_string()));
-	}
+	// Both rate select bits are decoded, so every value maps to a rate
+	return SquareWaveRateField::decode<SquareWaveRate>(reg_data);
 }
 
 void hal::sensors::i2c::ds3231::DS3231::set_timezone(const WorldTimezones timezone) noexcept
@@ -666,17 +570,7 @@ uint8_t hal::sensors::i2c::ds3231::DS3231::get_seconds() const
 			std::string("Could not read seconds register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		return BitManipulation::from_bcd(BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END),
-			BitManipulation::value_of_bits(reg_data[0], SECOND_DECIMAL_BEGIN, SECOND_DECIMAL_END_1));
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_seconds",
-			std::string("Could not combine both BCD parts to the resulting seconds value:\n").append(
-				ex.to_string()));
-	}
+	return BitManipulation::from_bcd(SecondsUnitsField::decode(reg_data[0]), SecondsTensField::decode(reg_data[0]));
 }
 
 uint8_t hal::sensors::i2c::ds3231::DS3231::get_minutes() const
@@ -692,17 +586,7 @@ uint8_t hal::sensors::i2c::ds3231::DS3231::get_minutes() const
 			std::string("Could not read minutes register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		return BitManipulation::from_bcd(BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END),
-			BitManipulation::value_of_bits(reg_data[0], SECOND_DECIMAL_BEGIN, SECOND_DECIMAL_END_1));
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_minutes",
-			std::string("Could not combine both BCD parts to the resulting minutes value:\n").append(
-				ex.to_string()));
-	}
+	return BitManipulation::from_bcd(MinutesUnitsField::decode(reg_data[0]), MinutesTensField::decode(reg_data[0]));
 }
 
 uint8_t hal::sensors::i2c::ds3231::DS3231::get_hours() const
@@ -723,17 +607,16 @@ uint8_t hal::sensors::i2c::ds3231::DS3231::get_hours() const
 		switch (get_hour_format())
 		{
 		case HourFormat::HOUR_FORMAT_12:
-			return BitManipulation::from_bcd(BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END),
-				BitManipulation::is_bit_set(reg_data[0], HOUR_10_DECIMAL_INDEX) ? 0x01 : 0x00);
+			return BitManipulation::from_bcd(HoursUnitsField::decode(reg_data[0]), Hours10Flag::is_set(reg_data[0]) ? 0x01 : 0x00);
 		case HourFormat::HOUR_FORMAT_24:
-			switch (BitManipulation::value_of_bits(reg_data[0], HOUR_10_DECIMAL_INDEX, HOUR_20_DECIMAL_INDEX))
+			switch (Hours10Flag::decode(reg_data[0]) | Hours20Flag::decode(reg_data[0]) << 1)
 			{
 			case 0: // resulting value is between 0 and 9 -> 10-Hours = 0 and 20-Hours = 0
-				return BitManipulation::from_bcd(BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END), 0x00);
+				return BitManipulation::from_bcd(HoursUnitsField::decode(reg_data[0]), 0x00);
 			case 1: // resulting value is between 10 and 19 -> 10-Hours = 1 and 20-Hours = 0
-				return BitManipulation::from_bcd(BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END), 0x01);
+				return BitManipulation::from_bcd(HoursUnitsField::decode(reg_data[0]), 0x01);
 			case 2: // resulting value is between 20 and 23 -> 10-Hours = 0 and 20-Hours = 1
-				return BitManipulation::from_bcd(BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END), 0x02);
+				return BitManipulation::from_bcd(HoursUnitsField::decode(reg_data[0]), 0x02);
 			default:// invalid case since only one of both places can be 1 -> 10-Hours = 1 and 20-Hours = 1
 				throw exception::HALException("DS3231", "get_hours",
 					"Could not combine both BCD parts to the resulting hours value, since 10-Hours bit and 20-Hours bit are 1 with is invalid");
@@ -763,15 +646,7 @@ hal::sensors::i2c::ds3231::AmPm hal::sensors::i2c::ds3231::DS3231::get_am_pm() c
 			std::string("Could not read hours register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		return BitManipulation::is_bit_set(reg_data[0], AM_PM_INDEX) ? AmPm::PM : AmPm::AM;
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_am_pm",
-			std::string("Could not check daytime bit:\n").append(ex.to_string()));
-	}
+	return AmPmFlag::is_set(reg_data[0]) ? AmPm::PM : AmPm::AM;
 }
 
 uint8_t hal::sensors::i2c::ds3231::DS3231::get_day() const
@@ -787,15 +662,7 @@ uint8_t hal::sensors::i2c::ds3231::DS3231::get_day() const
 			std::string("Could not read day register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		return BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END);
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_day",
-			std::string("Could not read day bits:\n").append(ex.to_string()));
-	}
+	return DayField::decode(reg_data[0]);
 }
 
 uint8_t hal::sensors::i2c::ds3231::DS3231::get_date() const
@@ -811,17 +678,7 @@ uint8_t hal::sensors::i2c::ds3231::DS3231::get_date() const
 			std::string("Could not read date register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		return BitManipulation::from_bcd(BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END),
-			BitManipulation::value_of_bits(reg_data[0], SECOND_DECIMAL_BEGIN, SECOND_DECIMAL_END_1));
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_date",
-			std::string("Could not combine both BCD parts to the resulting date value:\n").append(
-				ex.to_string()));
-	}
+	return BitManipulation::from_bcd(DateUnitsField::decode(reg_data[0]), DateTensField::decode(reg_data[0]));
 }
 
 uint8_t hal::sensors::i2c::ds3231::DS3231::get_month() const
@@ -837,17 +694,7 @@ uint8_t hal::sensors::i2c::ds3231::DS3231::get_month() const
 			std::string("Could not read month register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		return BitManipulation::from_bcd(BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END),
-			BitManipulation::value_of_bits(reg_data[0], SECOND_DECIMAL_BEGIN, SECOND_DECIMAL_END_1));
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_month",
-			std::string("Could not combine both BCD parts to the resulting month value:\n").append(
-				ex.to_string()));
-	}
+	return BitManipulation::from_bcd(MonthUnitsField::decode(reg_data[0]), MonthTensField::decode(reg_data[0]));
 }
 
 uint8_t hal::sensors::i2c::ds3231::DS3231::get_year() const
@@ -863,17 +710,7 @@ uint8_t hal::sensors::i2c::ds3231::DS3231::get_year() const
 			std::string("Could not read month register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		return BitManipulation::from_bcd(BitManipulation::value_of_bits(reg_data[0], FIRST_DECIMAL_BEGIN, FIRST_DECIMAL_END),
-			BitManipulation::value_of_bits(reg_data[0], SECOND_DECIMAL_BEGIN, SECOND_DECIMAL_END_3));
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_year",
-			std::string("Could not combine both BCD parts to the resulting year value:\n").append(
-				ex.to_string()));
-	}
+	return BitManipulation::from_bcd(YearUnitsField::decode(reg_data[0]), YearTensField::decode(reg_data[0]));
 }
 
 void hal::sensors::i2c::ds3231::DS3231::calibrate_to_current_temperature()
@@ -886,7 +723,7 @@ void hal::sensors::i2c::ds3231::DS3231::calibrate_to_current_temperature()
 		{
 			usleep(100);
 			try_count++;
-		} while (BitManipulation::is_bit_set(read_status_register(), BSY_INDEX) && try_count < 10);
+		} while (BusyFlag::is_set(read_status_register()) && try_count < 10);
 
 		if (try_count >= 10)
 		{
@@ -898,7 +735,7 @@ void hal::sensors::i2c::ds3231::DS3231::calibrate_to_current_temperature()
 			try
 			{
 				auto control_reg = read_control_register();
-				BitManipulation::set_bit(control_reg, CONV_INDEX, true);
+				ConvertTemperatureFlag::set(control_reg, true);
 				I2CManager::write_to_device(m_file_handle, CONTROL_REGISTER, &control_reg, 1);
 			}
 			catch (exception::HALException& ex)
@@ -939,18 +776,10 @@ double hal::sensors::i2c::ds3231::DS3231::get_current_device_temperature() const
 			std::string("Could not read fractional part of temperature from register:\n").append(ex.to_string()));
 	}
 
-	try
-	{
-		const auto value = static_cast<double>(BitManipulation::value_of_bits(decimal[0], TEMPERATURE_DECIMAL_BEGIN, TEMPERATURE_DECIMAL_END)) +
-			static_cast<double>(BitManipulation::value_of_bits(fraction[0], TEMPERATURE_FRACTION_BEGIN, TEMPERATURE_FRACTION_END) / 100.0);
-		return BitManipulation::is_bit_set(decimal[0], SIGN_INDEX) ? value * -1.0 : value;
-	}
-	catch (exception::HALException& ex)
-	{
-		throw exception::HALException("DS3231", "get_current_device_temperature",
-			std::string("Could not combine decimal and fractional parts to the resulting temperature value:\n").append(
-				ex.to_string()));
-	}
+	// The fractional part counts quarter degrees
+	const auto value = static_cast<double>(TemperatureIntegerField::decode(decimal[0])) +
+		static_cast<double>(TemperatureFractionField::decode(fraction[0])) * 0.25;
+	return TemperatureSignFlag::is_set(decimal[0]) ? value * -1.0 : value;
 }
 
 uint8_t hal::sensors::i2c::ds3231::DS3231::read_control_register() const
@@ -101,8 +101,9 @@ namespace hal
 					//! Tries to sync the RTCs time with the current system time.
 					/*!
 					* Tries to sync the RTCs time with the current system time. If the RTC sets the 
-					* system time and no wifi connection is available this method will have no effect.
-					* \throws I2CException if writing the corrected time and date to the device fails.
+					* system time and no wifi connection is available this method will have no effect. The time registers
+					* are read and written with one burst each.
+					* \throws HALException if reading or writing the time and date registers fails.
 					*/
 					void sync_time();
 
@@ -111,7 +112,7 @@ namespace hal
 					* Writes the hour format setting to the device.
 					* \param[in] format: The new hour format to set.
 					* \throws I2CException if reading the current hour format setting from the device fails.
-					* \throws HALException if manipulating the hour format bit fails.
+					* \throws HALException if the hour format value is invalid.
 					* \throws I2CException if writing the new hour format setting to the device fails.
 					*/
 					void set_hour_format(HourFormat format) const;
@@ -121,7 +122,6 @@ namespace hal
 					* Gets the current hour format.
 					* \returns the current hour format.
 					* \throws I2CException if reading the current hour format from the device fails.
-					* \throws HALException if checking the hour format bit fails.
 					*/
 					HourFormat get_hour_format() const;
 
@@ -130,7 +130,7 @@ namespace hal
 					* Changes the oscillator state of the device.
 					* \param[in] state: The new oscillator state to set.
 					* \throws I2CException if reading the current oscillator state from the device fails.
-					* \throws HALException if manipulating the oscillator state bit fails.
+					* \throws HALException if the oscillator state value is invalid.
 					* \throws I2CException if writing the new oscillator state to the device fails.
 					*/
 					void set_oscillator_state(OscillatorState state) const;
@@ -140,7 +140,6 @@ namespace hal
 					* Gets the current oscillator state.
 					* \returns the current oscillator state.
 					* \throws I2CException if reading the current oscillator state from the device fails.
-					* \throws HALException if checking the oscillator bit fails.
 					*/
 					OscillatorState get_oscillator_state() const;
 
@@ -149,7 +148,7 @@ namespace hal
 					* Changes the square wave state of the device.
 					* \param[in] state: The new square wave state to set.
 					* \throws I2CException if reading the current square wave state from the device fails.
-					* \throws HALException if manipulating the square wave state bit fails.
+					* \throws HALException if the square wave state value is invalid.
 					* \throws I2CException if writing the new square wave state to the device fails.
 					*/
 					void set_square_wave_state(SquareWaveState state) const;
@@ -159,7 +158,6 @@ namespace hal
 					* Gets the current square wave state.
 					* \returns the current square wave state.
 					* \throws I2CException if reading the current square wave state from the device fails.
-					* \throws HALException if checking the square wave state bit fails.
 					*/
 					SquareWaveState get_square_wave_state() const;
 
@@ -168,7 +166,6 @@ namespace hal
 					* Changes the square wave rate of the device.
 					* \param[in] rate: The new square wave rate to set.
 					* \throws I2CException if reading the current square wave rate from the device fails.
-					* \throws HALException if manipulating the square wave rate bit fails.
 					* \throws I2CException if writing the new square wave rate to the device fails.
 					*/
 					void set_square_wave_rate(SquareWaveRate rate) const;
@@ -178,7 +175,6 @@ namespace hal
 					* Gets the current square wave rate.
 					* \returns the current square wave rate.
 					* \throws I2CException if reading the current square wave rate from the device fails.
-					* \throws HALException if checking the square wave rate bit fails.
 					*/
 					SquareWaveRate get_square_wave_rate() const;
 
@@ -231,7 +227,7 @@ namespace hal
 					* Changes all device settings at once.
 					* \param[in] settings: The new device settings.
 					* \throws I2CException if reading the current settings from the device fails.
-					* \throws HALException if manipulating the setting bits fails.
+					* \throws HALException if a setting value is invalid.
 					* \throws I2CException if writing the new settings to the device fails.
 					*/
 					void set_settings(const SettingsData& settings);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../utils/RegisterField.h"
+
 namespace hal
 {
 	namespace sensors
@@ -66,6 +68,43 @@ namespace hal
 				static constexpr uint8_t BSY_INDEX = 2;
 				static constexpr uint8_t A2F_INDEX = 1;
 				static constexpr uint8_t A1F_INDEX = 0;
+
+				// Register fields
+				using SecondsUnitsField = utils::Field<SECONDS_REGISTER, FIRST_DECIMAL_BEGIN, 4>;
+				using SecondsTensField = utils::Field<SECONDS_REGISTER, SECOND_DECIMAL_BEGIN, 3>;
+				using SecondsField = utils::Field<SECONDS_REGISTER, FIRST_DECIMAL_BEGIN, 7>;
+				using MinutesUnitsField = utils::Field<MINUTES_REGISTER, FIRST_DECIMAL_BEGIN, 4>;
+				using MinutesTensField = utils::Field<MINUTES_REGISTER, SECOND_DECIMAL_BEGIN, 3>;
+				using MinutesField = utils::Field<MINUTES_REGISTER, FIRST_DECIMAL_BEGIN, 7>;
+				using HoursUnitsField = utils::Field<HOURS_REGISTER, FIRST_DECIMAL_BEGIN, 4>;
+				using Hours10Flag = utils::Flag<HOURS_REGISTER, HOUR_10_DECIMAL_INDEX>;
+				using Hours20Flag = utils::Flag<HOURS_REGISTER, HOUR_20_DECIMAL_INDEX>;
+				using Hours12Field = utils::Field<HOURS_REGISTER, FIRST_DECIMAL_BEGIN, 5>;
+				using Hours24Field = utils::Field<HOURS_REGISTER, FIRST_DECIMAL_BEGIN, 6>;
+				using AmPmFlag = utils::Flag<HOURS_REGISTER, AM_PM_INDEX>;
+				using HourFormatFlag = utils::Flag<HOURS_REGISTER, HOUR_FORMAT_INDEX>;
+				using DayField = utils::Field<DAY_REGISTER, FIRST_DECIMAL_BEGIN, 3>;
+				using DateUnitsField = utils::Field<DATE_REGISTER, FIRST_DECIMAL_BEGIN, 4>;
+				using DateTensField = utils::Field<DATE_REGISTER, SECOND_DECIMAL_BEGIN, 2>;
+				using DateField = utils::Field<DATE_REGISTER, FIRST_DECIMAL_BEGIN, 6>;
+				using MonthField = utils::Field<MONTH_REGISTER, FIRST_DECIMAL_BEGIN, 5>;
+				using MonthUnitsField = utils::Field<MONTH_REGISTER, FIRST_DECIMAL_BEGIN, 4>;
+				using MonthTensField = utils::Field<MONTH_REGISTER, SECOND_DECIMAL_BEGIN, 1>;
+				using CenturyFlag = utils::Flag<MONTH_REGISTER, CENTURY_INDEX>;
+				using YearUnitsField = utils::Field<YEAR_REGISTER, FIRST_DECIMAL_BEGIN, 4>;
+				using YearTensField = utils::Field<YEAR_REGISTER, SECOND_DECIMAL_BEGIN, 4>;
+				using YearField = utils::Field<YEAR_REGISTER, FIRST_DECIMAL_BEGIN, 8>;
+				using OscillatorDisabledFlag = utils::Flag<CONTROL_REGISTER, EOSC_INDEX>;
+				using ConvertTemperatureFlag = utils::Flag<CONTROL_REGISTER, CONV_INDEX>;
+				using SquareWaveRateField = utils::Field<CONTROL_REGISTER, RS1_INDEX, 2>;
+				using InterruptControlFlag = utils::Flag<CONTROL_REGISTER, INTCN_INDEX>;
+				using OscillatorStoppedFlag = utils::Flag<STATUS_REGISTER, OSF_INDEX>;
+				using Enable32kHzFlag = utils::Flag<STATUS_REGISTER, EN32KHZ_INDEX>;
+				using BusyFlag = utils::Flag<STATUS_REGISTER, BSY_INDEX>;
+				using TemperatureIntegerField = utils::Field<TEMPERATURE_MSB_REGISTER, TEMPERATURE_DECIMAL_BEGIN, 7>;
+				using TemperatureSignFlag = utils::Flag<TEMPERATURE_MSB_REGISTER, SIGN_INDEX>;
+				using TemperatureFractionField = utils::Field<TEMPERATURE_LSB_REGISTER, TEMPERATURE_FRACTION_BEGIN, 2>;
+				static_assert(SquareWaveRateField::MASK == SQUARE_WAVE_RATE_MASK, "The register field does not match the bit mask.");
 			}
 		}
 	}
@@ -0,0 +1,274 @@
+#include "SimulatedADS1115.h"
+#include "../exceptions/HALException.h"
+#include "../sensors/i2c/ADS1115Constants.h"
+#include "../utils/GPIOSimulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace hal::sensors::i2c::ads1115;
+
+namespace
+{
+	constexpr uint16_t OPERATIONAL_STATUS_BIT = 0x8000;
+	constexpr uint16_t SINGLE_SHOT_BIT = 0x0100;
+	constexpr uint16_t WINDOW_COMPARATOR_BIT = 0x0010;
+	constexpr uint16_t ACTIVE_HIGH_BIT = 0x0008;
+	constexpr uint16_t LATCHING_BIT = 0x0004;
+	constexpr uint16_t QUEUE_DISABLED = 0x0003;
+	constexpr uint16_t THRESHOLD_MSB = 0x8000;
+	constexpr uint32_t READY_PULSE_IN_US = 8;
+
+	// Register value -> samples per second
+	constexpr uint32_t DATA_RATES[] = {8, 16, 32, 64, 128, 250, 475, 860};
+
+	// Register value -> full scale range in volt
+	constexpr double FULL_SCALE_RANGES[] = {6.144, 4.096, 2.048, 1.024, 0.512, 0.256, 0.256, 0.256};
+
+	// Comparator queue register value -> conversions until the comparator asserts
+	constexpr uint32_t QUEUE_CONVERSIONS[] = {1, 2, 4};
+}
+
+hal::simulation::SimulatedADS1115::~SimulatedADS1115()
+{
+	if (m_alert_pin >= 0)
+	{
+		utils::GPIOSimulator::instance().stop(m_alert_pin);
+	}
+}
+
+bool hal::simulation::SimulatedADS1115::write(const uint8_t* data, const size_t length)
+{
+	if (length == 0)
+	{
+		return true;
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_pointer = data[0] & 0x03;
+	if (length >= 3)
+	{
+		write_register16(m_pointer, static_cast<uint16_t>(data[1] << 8 | data[2]), now);
+	}
+	return true;
+}
+
+bool hal::simulation::SimulatedADS1115::read(uint8_t* data, const size_t length)
+{
+	const auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto value = read_register16(m_pointer, now);
+
+	// Reading more than two bytes repeats the register
+	for (size_t i = 0; i < length; i++)
+	{
+		data[i] = static_cast<uint8_t>(i % 2 == 0 ? value >> 8 : value);
+	}
+	return true;
+}
+
+void hal::simulation::SimulatedADS1115::set_input_voltage(const uint8_t channel, const double voltage)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (channel < m_inputs.size())
+	{
+		m_inputs[channel] = voltage;
+		update_alert_pin(std::chrono::steady_clock::now());
+	}
+}
+
+void hal::simulation::SimulatedADS1115::set_alert_pin(const int pin)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_alert_pin >= 0 && m_alert_pin != pin)
+	{
+		utils::GPIOSimulator::instance().stop(m_alert_pin);
+	}
+	m_alert_pin = pin;
+	update_alert_pin(std::chrono::steady_clock::now());
+}
+
+void hal::simulation::SimulatedADS1115::update(const std::chrono::steady_clock::time_point now)
+{
+	if (m_converting && now >= m_conversion_end)
+	{
+		m_conversion = convert();
+		m_converting = false;
+	}
+	if (is_continuous() && now - m_continuous_start >= conversion_period())
+	{
+		m_conversion = convert();
+	}
+}
+
+void hal::simulation::SimulatedADS1115::write_register16(const uint8_t reg, const uint16_t value, const std::chrono::steady_clock::time_point now)
+{
+	update(now);
+	switch (reg)
+	{
+	case CONFIG_REG:
+		m_config = value & ~OPERATIONAL_STATUS_BIT;
+		if (is_continuous())
+		{
+			// Every write restarts the continuous conversions
+			m_converting = false;
+			m_continuous_start = now;
+		}
+		else if ((value & OPERATIONAL_STATUS_BIT) != 0 && !m_converting)
+		{
+			m_converting = true;
+			m_conversion_end = now + conversion_period();
+		}
+		break;
+	case LOW_THRESHOLD_REG:
+		m_low_threshold = value;
+		break;
+	case HIGH_THRESHOLD_REG:
+		m_high_threshold = value;
+		break;
+	default:
+		// The conversion register is read only
+		return;
+	}
+	update_alert_pin(now);
+}
+
+uint16_t hal::simulation::SimulatedADS1115::read_register16(const uint8_t reg, const std::chrono::steady_clock::time_point now)
+{
+	update(now);
+	switch (reg)
+	{
+	case CONVERSION_REG:
+		if ((m_config & LATCHING_BIT) != 0 && m_comparator_asserted)
+		{
+			// Reading the conversion register releases a latched comparator
+			m_comparator_asserted = false;
+			update_alert_pin(now);
+		}
+		return static_cast<uint16_t>(m_conversion);
+	case CONFIG_REG:
+		// OS reads 1 if no conversion is running, which never happens in continuous mode
+		return !is_continuous() && !m_converting ? static_cast<uint16_t>(m_config | OPERATIONAL_STATUS_BIT) : m_config;
+	case LOW_THRESHOLD_REG:
+		return m_low_threshold;
+	default:
+		return m_high_threshold;
+	}
+}
+
+int16_t hal::simulation::SimulatedADS1115::convert() const
+{
+	double voltage;
+	const auto multiplexer = (m_config >> 12) & 0x07;
+	switch (multiplexer)
+	{
+	case 0:
+		voltage = m_inputs[0] - m_inputs[1];
+		break;
+	case 1:
+		voltage = m_inputs[0] - m_inputs[3];
+		break;
+	case 2:
+		voltage = m_inputs[1] - m_inputs[3];
+		break;
+	case 3:
+		voltage = m_inputs[2] - m_inputs[3];
+		break;
+	default:
+		voltage = m_inputs[multiplexer - 4];
+		break;
+	}
+
+	const auto full_scale_range = FULL_SCALE_RANGES[(m_config >> 9) & 0x07];
+	const auto raw_value = std::lround(voltage / full_scale_range * 32768.0);
+	return static_cast<int16_t>(std::clamp<long>(raw_value, RAW_MIN_VALUE, RAW_MAX_VALUE));
+}
+
+std::chrono::nanoseconds hal::simulation::SimulatedADS1115::conversion_period() const
+{
+	return std::chrono::nanoseconds(NANOSECONDS_PER_SECOND / DATA_RATES[(m_config >> 5) & 0x07]);
+}
+
+bool hal::simulation::SimulatedADS1115::is_continuous() const
+{
+	return (m_config & SINGLE_SHOT_BIT) == 0;
+}
+
+void hal::simulation::SimulatedADS1115::update_alert_pin(const std::chrono::steady_clock::time_point now)
+{
+	if (m_alert_pin < 0)
+	{
+		return;
+	}
+
+	const auto active = (m_config & ACTIVE_HIGH_BIT) != 0 ? 1 : 0;
+	const auto inactive = 1 - active;
+	const auto queue = m_config & QUEUE_DISABLED;
+	const auto period_in_us = static_cast<uint32_t>(std::max<int64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(conversion_period()).count(), READY_PULSE_IN_US + 1));
+	const auto remaining_in_us = static_cast<uint32_t>(m_converting && m_conversion_end > now
+																		? std::chrono::duration_cast<std::chrono::microseconds>(m_conversion_end - now).count()
+																		: 0);
+
+	try
+	{
+		auto& simulator = utils::GPIOSimulator::instance();
+		simulator.stop(m_alert_pin);
+		if (queue == QUEUE_DISABLED)
+		{
+			m_comparator_asserted = false;
+			simulator.set_level(m_alert_pin, inactive);
+			return;
+		}
+
+		if ((m_high_threshold & THRESHOLD_MSB) != 0 && (m_low_threshold & THRESHOLD_MSB) == 0)
+		{
+			// Conversion ready mode
+			simulator.set_level(m_alert_pin, inactive);
+			if (is_continuous())
+			{
+				simulator.play(m_alert_pin, {WaveformStep{period_in_us - READY_PULSE_IN_US, active}, WaveformStep{READY_PULSE_IN_US, inactive}}, 0);
+			}
+			else if (m_converting)
+			{
+				simulator.play(m_alert_pin, {WaveformStep{remaining_in_us, active}});
+			}
+			return;
+		}
+
+		// Comparator mode: The result is known in advance since the inputs only change via set_input_voltage
+		const auto value = convert();
+		const auto high_threshold = static_cast<int16_t>(m_high_threshold);
+		const auto low_threshold = static_cast<int16_t>(m_low_threshold);
+		bool assert;
+		if ((m_config & WINDOW_COMPARATOR_BIT) != 0)
+		{
+			assert = value > high_threshold || value < low_threshold;
+		}
+		else
+		{
+			// Traditional comparator with hysteresis between the thresholds
+			assert = value > high_threshold || (value > low_threshold && m_comparator_asserted);
+		}
+		if ((m_config & LATCHING_BIT) != 0 && m_comparator_asserted)
+		{
+			assert = true;
+		}
+
+		if (!is_continuous() && !m_converting)
+		{
+			simulator.set_level(m_alert_pin, m_comparator_asserted ? active : inactive);
+			return;
+		}
+
+		const auto delay_in_us = is_continuous() ? period_in_us * (assert ? QUEUE_CONVERSIONS[queue] : 1) : remaining_in_us;
+		m_comparator_asserted = assert;
+		simulator.play(m_alert_pin, {WaveformStep{delay_in_us, assert ? active : inactive}});
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "SimulatedADS1115 [update_alert_pin] Could not drive the ALERT/RDY pin:\n" << ex.to_string() << std::endl;
+	}
+}
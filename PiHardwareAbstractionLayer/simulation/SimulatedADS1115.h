@@ -0,0 +1,118 @@
+#pragma once
+
+#include "SimulatedI2CDevice.h"
+
+#include <array>
+
+namespace hal
+{
+	namespace simulation
+	{
+		//! Register map model of the ADS1115.
+		/*!
+		* Register map model of the ADS1115 with its four 16 bit registers. Conversions take one period of the selected data
+		* rate: in single-shot mode the OS bit starts a conversion and reads 0 until it completed, in continuous mode the
+		* conversion register is updated once per period. The result is calculated from the simulated input voltages with the
+		* selected multiplexer and gain and saturates like on the chip.
+		*
+		* Optionally the ALERT/RDY output is wired to a pin of \sa { HAL::Utils::GPIOSimulator }. In conversion ready mode
+		* (MSB of the high threshold set, MSB of the low threshold cleared) the pin pulses for 8 microseconds after every
+		* continuous conversion or is asserted at the end of a single-shot conversion. In comparator mode the pin follows the
+		* thresholds after the number of conversions selected by the queue. The inputs only change via <set_input_voltage>"()",
+		* so the comparator is evaluated whenever an input or a register changes.
+		*/
+		class SimulatedADS1115 final : public SimulatedI2CDevice
+		{
+		public:
+			//! Creates a converter with the power on configuration and all inputs at 0 V.
+			SimulatedADS1115() = default;
+
+			/*!
+			* Destructor. Stops driving the ALERT/RDY pin.
+			*/
+			~SimulatedADS1115() override;
+
+			SimulatedADS1115(const SimulatedADS1115&) = delete;
+			SimulatedADS1115(SimulatedADS1115&&) = delete;
+			SimulatedADS1115& operator=(const SimulatedADS1115&) = delete;
+			SimulatedADS1115& operator=(SimulatedADS1115&&) = delete;
+
+			bool write(const uint8_t* data, size_t length) override;
+
+			bool read(uint8_t* data, size_t length) override;
+
+			//! Changes the voltage of an analog input.
+			/*!
+			* Changes the voltage of an analog input. Applies to the next conversion.
+			* \param[in] channel: The input AIN0 to AIN3.
+			* \param[in] voltage: The voltage against GND in volt.
+			*/
+			void set_input_voltage(uint8_t channel, double voltage);
+
+			//! Wires the ALERT/RDY output to a simulated GPIO pin.
+			/*!
+			* Wires the ALERT/RDY output to a simulated GPIO pin.
+			* \param[in] pin: The wiringPi pin number or -1 to leave ALERT/RDY unconnected.
+			*/
+			void set_alert_pin(int pin);
+
+		private:
+			/*!
+			* Completes conversions whose conversion time expired. The mutex is locked by the caller.
+			* \param[in] now: The time of the transaction.
+			*/
+			void update(std::chrono::steady_clock::time_point now);
+
+			/*!
+			* Writes a register. The mutex is locked by the caller.
+			* \param[in] reg: The register address.
+			* \param[in] value: The written value.
+			* \param[in] now: The time of the transaction.
+			*/
+			void write_register16(uint8_t reg, uint16_t value, std::chrono::steady_clock::time_point now);
+
+			/*!
+			* Returns the content of a register. The mutex is locked by the caller.
+			* \param[in] reg: The register address.
+			* \param[in] now: The time of the transaction.
+			* \returns the content of the register.
+			*/
+			uint16_t read_register16(uint8_t reg, std::chrono::steady_clock::time_point now);
+
+			/*!
+			* Converts the inputs with the current configuration.
+			* \returns the conversion result.
+			*/
+			int16_t convert() const;
+
+			/*!
+			* Returns the conversion time of the selected data rate.
+			* \returns the conversion time.
+			*/
+			std::chrono::nanoseconds conversion_period() const;
+
+			/*!
+			* Checks whether the device converts continuously.
+			* \returns True in continuous mode, false in single-shot mode.
+			*/
+			bool is_continuous() const;
+
+			/*!
+			* Restarts the ALERT/RDY waveform for the current configuration. The mutex is locked by the caller.
+			* \param[in] now: The time of the change.
+			*/
+			void update_alert_pin(std::chrono::steady_clock::time_point now);
+
+			uint16_t m_config = 0x8583;
+			uint16_t m_low_threshold = 0x8000;
+			uint16_t m_high_threshold = 0x7FFF;
+			int16_t m_conversion{};
+			std::array<double, 4> m_inputs{};
+			bool m_converting{};
+			std::chrono::steady_clock::time_point m_conversion_end{};
+			std::chrono::steady_clock::time_point m_continuous_start{};
+			bool m_comparator_asserted{};
+			int m_alert_pin = -1;
+		};
+	}
+}
@@ -0,0 +1,222 @@
+#include "SimulatedBME280.h"
+#include "../sensors/i2c/BME280Constants.h"
+
+using namespace hal::sensors::i2c::bme280;
+
+namespace
+{
+	constexpr uint8_t SLEEP_MODE = 0x00;
+	constexpr uint8_t NORMAL_MODE = 0x03;
+	constexpr uint8_t MEASURING_BIT = 0x08;
+	constexpr uint32_t SKIPPED_VALUE = 0x80000;
+	constexpr uint16_t SKIPPED_HUMIDITY_VALUE = 0x8000;
+	constexpr auto NVM_COPY_TIME = std::chrono::microseconds(2000);
+
+	// Example calibration of the datasheet (chapter 8.1), little endian like on the chip
+	constexpr uint8_t TEMPERATURE_PRESSURE_CALIBRATION[] = {
+		0x70, 0x6B, 0x43, 0x67, 0x18, 0xFC, // dig_T1 = 27504, dig_T2 = 26435, dig_T3 = -1000
+		0x7D, 0x8E, 0x43, 0xD6, 0xD0, 0x0B, // dig_P1 = 36477, dig_P2 = -10685, dig_P3 = 3024
+		0x27, 0x0B, 0x8C, 0x00, 0xF9, 0xFF, // dig_P4 = 2855, dig_P5 = 140, dig_P6 = -7
+		0x8C, 0x3C, 0xF8, 0xC6, 0x70, 0x17, // dig_P7 = 15500, dig_P8 = -14600, dig_P9 = 6000
+		0x00, 0x4B // reserved, dig_H1 = 75
+	};
+	constexpr uint8_t HUMIDITY_CALIBRATION[] = {
+		0x6A, 0x01, 0x00, // dig_H2 = 362, dig_H3 = 0
+		0x14, 0x24, 0x03, // dig_H4 = 324, dig_H5 = 50 (12 bit values sharing 0xE5)
+		0x1E // dig_H6 = 30
+	};
+
+	// Oversampling register value -> number of samples
+	constexpr uint32_t OVERSAMPLING[] = {0, 1, 2, 4, 8, 16, 16, 16};
+
+	// Standby time register value -> standby time in microseconds
+	constexpr uint32_t STANDBY_TIME_IN_US[] = {500, 62500, 125000, 250000, 500000, 1000000, 10000, 20000};
+}
+
+hal::simulation::SimulatedBME280::SimulatedBME280()
+{
+	for (size_t i = 0; i < sizeof(TEMPERATURE_PRESSURE_CALIBRATION); i++)
+	{
+		m_registers[TEMPERATURE_CALIBRATION_REG_1 + i] = TEMPERATURE_PRESSURE_CALIBRATION[i];
+	}
+	for (size_t i = 0; i < sizeof(HUMIDITY_CALIBRATION); i++)
+	{
+		m_registers[HUMIDITY_CALIBRATION_REG_2 + i] = HUMIDITY_CALIBRATION[i];
+	}
+	m_registers[CHIP_ID_REG] = CHIP_ID;
+	reset(std::chrono::steady_clock::time_point{});
+}
+
+bool hal::simulation::SimulatedBME280::write(const uint8_t* data, const size_t length)
+{
+	if (length == 0)
+	{
+		return true;
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_pointer = data[0];
+	for (size_t i = 0; i + 1 < length; i += 2)
+	{
+		write_register(data[i], data[i + 1], now);
+	}
+	return true;
+}
+
+void hal::simulation::SimulatedBME280::set_raw_values(const uint32_t temperature, const uint32_t pressure, const uint16_t humidity)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_raw_temperature = temperature & 0xFFFFF;
+	m_raw_pressure = pressure & 0xFFFFF;
+	m_raw_humidity = humidity;
+}
+
+uint8_t hal::simulation::SimulatedBME280::read_register(const uint8_t reg, const std::chrono::steady_clock::time_point now)
+{
+	update(now);
+	switch (reg)
+	{
+	case HUMIDITY_OVERSAMPLING_REG:
+		return m_ctrl_hum;
+	case MODE_REG:
+		return m_ctrl_meas;
+	case CONFIG_REG:
+		return m_config;
+	case STATUS_REG:
+	{
+		uint8_t status = now < m_nvm_copy_end ? STATUS_DURING_UPDATE : 0;
+		const auto mode = m_ctrl_meas & SENSOR_MODE_MASK;
+		if (mode == NORMAL_MODE)
+		{
+			const auto cycle = measurement_time() + standby_time();
+			if ((now - m_measurement_start) % cycle < measurement_time())
+			{
+				status |= MEASURING_BIT;
+			}
+		}
+		else if (mode != SLEEP_MODE)
+		{
+			status |= MEASURING_BIT;
+		}
+		return status;
+	}
+	case SOFT_RESET_REG:
+		return 0;
+	default:
+		return m_registers[reg];
+	}
+}
+
+void hal::simulation::SimulatedBME280::write_register(const uint8_t reg, const uint8_t value, const std::chrono::steady_clock::time_point now)
+{
+	update(now);
+	switch (reg)
+	{
+	case SOFT_RESET_REG:
+		if (value == SOFT_RESET_VALUE)
+		{
+			reset(now);
+		}
+		break;
+	case HUMIDITY_OVERSAMPLING_REG:
+		// Only becomes effective after a write to the measurement register
+		m_ctrl_hum = value & HUMIDITY_MASK;
+		break;
+	case MEASUREMENT_OVERSAMPLING_REG:
+	{
+		m_ctrl_meas = value;
+		m_active_ctrl_hum = m_ctrl_hum;
+		const auto mode = m_ctrl_meas & SENSOR_MODE_MASK;
+		if (mode != SLEEP_MODE)
+		{
+			m_measurement_start = now;
+			m_measurement_end = now + measurement_time();
+		}
+		break;
+	}
+	case CONFIG_REG:
+		m_config = value;
+		break;
+	default:
+		// Calibration, id and data registers are read only
+		break;
+	}
+}
+
+void hal::simulation::SimulatedBME280::reset(const std::chrono::steady_clock::time_point now)
+{
+	m_ctrl_hum = 0;
+	m_active_ctrl_hum = 0;
+	m_ctrl_meas = 0;
+	m_config = 0;
+	m_nvm_copy_end = now + NVM_COPY_TIME;
+	m_measurement_start = now;
+	m_measurement_end = now;
+
+	// The data registers contain the values of skipped measurements until the first measurement completed
+	m_registers[DATA_REG] = static_cast<uint8_t>(SKIPPED_VALUE >> 12);
+	m_registers[DATA_REG + 1] = static_cast<uint8_t>(SKIPPED_VALUE >> 4);
+	m_registers[DATA_REG + 2] = static_cast<uint8_t>(SKIPPED_VALUE << 4);
+	m_registers[DATA_REG + 3] = static_cast<uint8_t>(SKIPPED_VALUE >> 12);
+	m_registers[DATA_REG + 4] = static_cast<uint8_t>(SKIPPED_VALUE >> 4);
+	m_registers[DATA_REG + 5] = static_cast<uint8_t>(SKIPPED_VALUE << 4);
+	m_registers[DATA_REG + 6] = static_cast<uint8_t>(SKIPPED_HUMIDITY_VALUE >> 8);
+	m_registers[DATA_REG + 7] = static_cast<uint8_t>(SKIPPED_HUMIDITY_VALUE);
+}
+
+void hal::simulation::SimulatedBME280::update(const std::chrono::steady_clock::time_point now)
+{
+	const auto mode = m_ctrl_meas & SENSOR_MODE_MASK;
+	if (mode == SLEEP_MODE || now < m_measurement_end)
+	{
+		return;
+	}
+
+	latch_data();
+	if (mode != NORMAL_MODE)
+	{
+		// Forced mode returns to sleep mode after one measurement
+		m_ctrl_meas &= ~SENSOR_MODE_MASK;
+	}
+}
+
+void hal::simulation::SimulatedBME280::latch_data()
+{
+	const auto pressure = ((m_ctrl_meas & PRESSURE_MASK) >> PRESSURE_POS) != 0 ? m_raw_pressure : SKIPPED_VALUE;
+	const auto temperature = ((m_ctrl_meas & TEMPERATURE_MASK) >> TEMPERATURE_POS) != 0 ? m_raw_temperature : SKIPPED_VALUE;
+	const auto humidity = (m_active_ctrl_hum & HUMIDITY_MASK) != 0 ? m_raw_humidity : SKIPPED_HUMIDITY_VALUE;
+
+	m_registers[DATA_REG] = static_cast<uint8_t>(pressure >> 12);
+	m_registers[DATA_REG + 1] = static_cast<uint8_t>(pressure >> 4);
+	m_registers[DATA_REG + 2] = static_cast<uint8_t>(pressure << 4);
+	m_registers[DATA_REG + 3] = static_cast<uint8_t>(temperature >> 12);
+	m_registers[DATA_REG + 4] = static_cast<uint8_t>(temperature >> 4);
+	m_registers[DATA_REG + 5] = static_cast<uint8_t>(temperature << 4);
+	m_registers[DATA_REG + 6] = static_cast<uint8_t>(humidity >> 8);
+	m_registers[DATA_REG + 7] = static_cast<uint8_t>(humidity);
+}
+
+std::chrono::microseconds hal::simulation::SimulatedBME280::measurement_time() const
+{
+	// Typical measurement time of the datasheet (chapter 9.1)
+	const auto temperature = OVERSAMPLING[(m_ctrl_meas & TEMPERATURE_MASK) >> TEMPERATURE_POS];
+	const auto pressure = OVERSAMPLING[(m_ctrl_meas & PRESSURE_MASK) >> PRESSURE_POS];
+	const auto humidity = OVERSAMPLING[m_active_ctrl_hum & HUMIDITY_MASK];
+
+	uint32_t time_in_us = 1000 + 2000 * temperature;
+	if (pressure != 0)
+	{
+		time_in_us += 2000 * pressure + 500;
+	}
+	if (humidity != 0)
+	{
+		time_in_us += 2000 * humidity + 500;
+	}
+	return std::chrono::microseconds(time_in_us);
+}
+
+std::chrono::microseconds hal::simulation::SimulatedBME280::standby_time() const
+{
+	return std::chrono::microseconds(STANDBY_TIME_IN_US[(m_config & STANDBY_MASK) >> STANDBY_POS]);
+}
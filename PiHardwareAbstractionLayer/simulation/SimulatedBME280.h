@@ -0,0 +1,99 @@
+#pragma once
+
+#include "SimulatedI2CDevice.h"
+
+#include <array>
+
+namespace hal
+{
+	namespace simulation
+	{
+		//! Register map model of the BME280.
+		/*!
+		* Register map model of the BME280. Provides the chip id, the calibration blocks at 0x88 and 0xE1 (the example
+		* values of the datasheet), soft reset with NVM copy time, the oversampling and filter registers and forced and normal
+		* mode. A measurement takes the typical measurement time of the datasheet for the selected oversampling, the measuring
+		* bit of the status register is set meanwhile and the data registers are updated afterwards. Disabled measurements
+		* read as 0x80000 (0x8000 for humidity) like on the real chip. The default raw values result in 25.08 degree
+		* celsius, 1006.53 hPa and 51.08 % relative humidity.
+		*/
+		class SimulatedBME280 final : public SimulatedI2CDevice
+		{
+		public:
+			//! Creates a sensor in sleep mode with the default raw values.
+			SimulatedBME280();
+
+			~SimulatedBME280() override = default;
+			SimulatedBME280(const SimulatedBME280&) = delete;
+			SimulatedBME280(SimulatedBME280&&) = delete;
+			SimulatedBME280& operator=(const SimulatedBME280&) = delete;
+			SimulatedBME280& operator=(SimulatedBME280&&) = delete;
+
+			//! Writes register/value pairs.
+			/*!
+			* Writes register/value pairs. Unlike reads the BME280 does not increment the register while writing,
+			* every value is preceded by its register address.
+			* \param[in] data: The register address followed by the value and further register/value pairs.
+			* \param[in] length: The number of bytes.
+			* \returns Always true.
+			*/
+			bool write(const uint8_t* data, size_t length) override;
+
+			//! Changes the values of the analog to digital converters.
+			/*!
+			* Changes the values of the analog to digital converters. Applies to the next measurement.
+			* \param[in] temperature: The 20 bit temperature value.
+			* \param[in] pressure: The 20 bit pressure value.
+			* \param[in] humidity: The 16 bit humidity value.
+			*/
+			void set_raw_values(uint32_t temperature, uint32_t pressure, uint16_t humidity);
+
+		protected:
+			uint8_t read_register(uint8_t reg, std::chrono::steady_clock::time_point now) override;
+
+			void write_register(uint8_t reg, uint8_t value, std::chrono::steady_clock::time_point now) override;
+
+		private:
+			/*!
+			* Restores the power on state of the registers.
+			* \param[in] now: The time of the reset.
+			*/
+			void reset(std::chrono::steady_clock::time_point now);
+
+			/*!
+			* Completes measurements whose measurement time expired.
+			* \param[in] now: The time of the transaction.
+			*/
+			void update(std::chrono::steady_clock::time_point now);
+
+			/*!
+			* Copies the values of the converters into the data registers, like at the end of a measurement.
+			*/
+			void latch_data();
+
+			/*!
+			* Returns the typical measurement time for the current oversampling settings.
+			* \returns the measurement time.
+			*/
+			std::chrono::microseconds measurement_time() const;
+
+			/*!
+			* Returns the standby time between two measurements in normal mode.
+			* \returns the standby time.
+			*/
+			std::chrono::microseconds standby_time() const;
+
+			std::array<uint8_t, 256> m_registers{};
+			uint8_t m_ctrl_hum{};
+			uint8_t m_active_ctrl_hum{};
+			uint8_t m_ctrl_meas{};
+			uint8_t m_config{};
+			std::chrono::steady_clock::time_point m_nvm_copy_end{};
+			std::chrono::steady_clock::time_point m_measurement_start{};
+			std::chrono::steady_clock::time_point m_measurement_end{};
+			uint32_t m_raw_temperature = 519888;
+			uint32_t m_raw_pressure = 415148;
+			uint16_t m_raw_humidity = 30000;
+		};
+	}
+}
@@ -0,0 +1,349 @@
+#include "SimulatedCCS811.h"
+#include "../exceptions/HALException.h"
+#include "../sensors/i2c/CCS811Constants.h"
+#include "../utils/GPIOSimulator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using namespace hal::sensors::i2c::ccs811;
+
+namespace
+{
+	constexpr uint8_t RAW_DATA_REG = 0x03;
+	constexpr uint8_t HARDWARE_VERSION = 0x12;
+	constexpr uint8_t FIRMWARE_VERSION[] = {0x10, 0x00};
+	constexpr uint8_t APPLICATION_VERSION[] = {0x20, 0x00};
+
+	constexpr uint8_t ERROR_BIT = 0x01;
+	constexpr uint8_t DATA_READY_BIT = 0x08;
+	constexpr uint8_t APP_VALID_BIT = 0x10;
+	constexpr uint8_t FW_MODE_BIT = 0x80;
+	constexpr uint8_t INTERRUPT_BIT = 0x08;
+	constexpr uint8_t THRESHOLD_BIT = 0x04;
+
+	constexpr uint8_t MEASUREMENT_MODE_INVALID = 1 << 2;
+
+	// Raw sensor data of the result mailbox: 6 bit current in uA and 10 bit ADC value
+	constexpr uint8_t RAW_CURRENT = 10;
+	constexpr uint16_t RAW_VOLTAGE = 500;
+	constexpr uint8_t NTC_DATA[] = {0x03, 0x20, 0x03, 0x20};
+}
+
+hal::simulation::SimulatedCCS811::~SimulatedCCS811()
+{
+	if (m_interrupt_pin >= 0)
+	{
+		utils::GPIOSimulator::instance().stop(m_interrupt_pin);
+	}
+}
+
+bool hal::simulation::SimulatedCCS811::write(const uint8_t* data, const size_t length)
+{
+	if (!is_awake())
+	{
+		return false;
+	}
+	if (length == 0)
+	{
+		return true;
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_pointer = data[0];
+	write_mailbox(data[0], data + 1, length - 1, now);
+	return true;
+}
+
+bool hal::simulation::SimulatedCCS811::read(uint8_t* data, const size_t length)
+{
+	if (!is_awake())
+	{
+		return false;
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto mailbox = read_mailbox(m_pointer, now);
+	memset(data, 0, length);
+	memcpy(data, mailbox.data(), std::min(length, mailbox.size()));
+	return true;
+}
+
+void hal::simulation::SimulatedCCS811::set_air_quality(const uint16_t eco2, const uint16_t tvoc)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_eco2 = eco2;
+	m_tvoc = tvoc;
+}
+
+void hal::simulation::SimulatedCCS811::set_interrupt_pin(const int pin)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_interrupt_pin >= 0 && m_interrupt_pin != pin)
+	{
+		utils::GPIOSimulator::instance().stop(m_interrupt_pin);
+	}
+	m_interrupt_pin = pin;
+}
+
+void hal::simulation::SimulatedCCS811::set_wake_pin(const int pin)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_wake_pin = pin;
+}
+
+bool hal::simulation::SimulatedCCS811::is_awake()
+{
+	int wake_pin;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		wake_pin = m_wake_pin;
+	}
+	if (wake_pin < 0)
+	{
+		return true;
+	}
+
+	try
+	{
+		return utils::GPIOSimulator::instance().get_level(wake_pin) == 0;
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "SimulatedCCS811 [is_awake] Could not read the nWAKE pin:\n" << ex.to_string() << std::endl;
+		return true;
+	}
+}
+
+void hal::simulation::SimulatedCCS811::write_mailbox(const uint8_t mailbox, const uint8_t* data, const size_t length,
+																	  const std::chrono::steady_clock::time_point now)
+{
+	if (mailbox == APP_START_BOOT_REG && !m_application_mode)
+	{
+		if (m_application_valid)
+		{
+			m_application_mode = true;
+			m_mode = 0;
+			m_mode_start = now;
+			m_consumed_samples = 0;
+		}
+		return;
+	}
+
+	// Without data the write only selects the mailbox for the next read
+	if (length == 0)
+	{
+		return;
+	}
+
+	if (mailbox == RESET_REG)
+	{
+		if (length == 4 && data[0] == RESET_1 && data[1] == RESET_2 && data[2] == RESET_3 && data[3] == RESET_4)
+		{
+			m_application_mode = false;
+			m_mode = 0;
+			m_error_id = 0;
+			update_interrupt_pin();
+		}
+		return;
+	}
+
+	if (!m_application_mode)
+	{
+		switch (mailbox)
+		{
+		case APP_ERASE_BOOT_REG:
+			if (length == 4 && data[0] == ERASE_1 && data[1] == ERASE_2 && data[2] == ERASE_3 && data[3] == ERASE_4)
+			{
+				m_application_valid = false;
+			}
+			return;
+		case APP_DATA_BOOT_REG:
+			return;
+		case APP_VERIFY_BOOT_REG:
+			m_application_valid = true;
+			return;
+		default:
+			set_error(WRITE_REG_INVALID);
+			return;
+		}
+	}
+
+	switch (mailbox)
+	{
+	case MODE_REG:
+	{
+		const auto drive_mode = (data[0] & MODE_MASK) >> 4;
+		if (drive_mode > 4)
+		{
+			set_error(MEASUREMENT_MODE_INVALID);
+			return;
+		}
+		m_mode = data[0] & (MODE_MASK | INTERRUPT_BIT | THRESHOLD_BIT);
+		m_mode_start = now;
+		m_consumed_samples = 0;
+		update_interrupt_pin();
+		return;
+	}
+	case ENV_DATA_REG:
+		memcpy(m_environment_data.data(), data, std::min(length, m_environment_data.size()));
+		return;
+	case THRESHOLDS_REG:
+		memcpy(m_thresholds.data(), data, std::min(length, m_thresholds.size()));
+		return;
+	case BASELINE_REG:
+		memcpy(m_baseline.data(), data, std::min(length, m_baseline.size()));
+		return;
+	default:
+		set_error(WRITE_REG_INVALID);
+		return;
+	}
+}
+
+std::vector<uint8_t> hal::simulation::SimulatedCCS811::read_mailbox(const uint8_t mailbox, const std::chrono::steady_clock::time_point now)
+{
+	switch (mailbox)
+	{
+	case STATUS_REG:
+		return {status(now)};
+	case HARDWARE_ID_REG:
+		return {HARDWARE_ID_VALUE};
+	case HARDWARE_VERSION_REG:
+		return {HARDWARE_VERSION};
+	case FIRMWARE_VERSION_REG:
+		return {FIRMWARE_VERSION[0], FIRMWARE_VERSION[1]};
+	case APPLICATION_VERSION_REG:
+		return {APPLICATION_VERSION[0], APPLICATION_VERSION[1]};
+	case ERROR_REG:
+	{
+		// Reading the error id clears it
+		const auto error_id = m_error_id;
+		m_error_id = 0;
+		return {error_id};
+	}
+	default:
+		break;
+	}
+
+	if (!m_application_mode)
+	{
+		set_error(READ_REG_INVALID);
+		return {};
+	}
+
+	const auto raw_data = static_cast<uint16_t>(RAW_CURRENT << 10 | RAW_VOLTAGE);
+	switch (mailbox)
+	{
+	case MODE_REG:
+		return {m_mode};
+	case RESULT_DATA_REG:
+	{
+		const auto current_status = status(now);
+		m_consumed_samples = sample_count(now);
+		if (m_interrupt_pin >= 0 && (m_mode & INTERRUPT_BIT) != 0)
+		{
+			// Reading the results releases nINT until the next sample
+			utils::GPIOSimulator::instance().set_level(m_interrupt_pin, 1);
+		}
+		return {
+			static_cast<uint8_t>(m_eco2 >> 8), static_cast<uint8_t>(m_eco2),
+			static_cast<uint8_t>(m_tvoc >> 8), static_cast<uint8_t>(m_tvoc),
+			current_status, m_error_id,
+			static_cast<uint8_t>(raw_data >> 8), static_cast<uint8_t>(raw_data)
+		};
+	}
+	case RAW_DATA_REG:
+		return {static_cast<uint8_t>(raw_data >> 8), static_cast<uint8_t>(raw_data)};
+	case NTC_REG:
+		return {NTC_DATA[0], NTC_DATA[1], NTC_DATA[2], NTC_DATA[3]};
+	case BASELINE_REG:
+		return {m_baseline[0], m_baseline[1]};
+	default:
+		set_error(READ_REG_INVALID);
+		return {};
+	}
+}
+
+uint8_t hal::simulation::SimulatedCCS811::status(const std::chrono::steady_clock::time_point now) const
+{
+	uint8_t status = 0;
+	if (m_error_id != 0)
+	{
+		status |= ERROR_BIT;
+	}
+	if (m_application_valid)
+	{
+		status |= APP_VALID_BIT;
+	}
+	if (m_application_mode)
+	{
+		status |= FW_MODE_BIT;
+		if (sample_count(now) > m_consumed_samples)
+		{
+			status |= DATA_READY_BIT;
+		}
+	}
+	return status;
+}
+
+uint64_t hal::simulation::SimulatedCCS811::sample_count(const std::chrono::steady_clock::time_point now) const
+{
+	const auto period = sample_period();
+	if (period.count() == 0 || now < m_mode_start)
+	{
+		return 0;
+	}
+	return static_cast<uint64_t>((now - m_mode_start) / period);
+}
+
+std::chrono::milliseconds hal::simulation::SimulatedCCS811::sample_period() const
+{
+	switch (m_mode & MODE_MASK)
+	{
+	case CONSTANT_POWER_1_S:
+		return std::chrono::milliseconds(1000);
+	case PULSE_10_S:
+		return std::chrono::milliseconds(10000);
+	case PULSE_60_S:
+		return std::chrono::milliseconds(60000);
+	case CONSTANT_POWER_250_MS:
+		return std::chrono::milliseconds(250);
+	default:
+		return std::chrono::milliseconds(0);
+	}
+}
+
+void hal::simulation::SimulatedCCS811::update_interrupt_pin()
+{
+	if (m_interrupt_pin < 0)
+	{
+		return;
+	}
+
+	try
+	{
+		auto& simulator = utils::GPIOSimulator::instance();
+		simulator.stop(m_interrupt_pin);
+		simulator.set_level(m_interrupt_pin, 1);
+
+		const auto period = sample_period();
+		if (m_application_mode && (m_mode & INTERRUPT_BIT) != 0 && period.count() != 0)
+		{
+			// The pin is pulled LOW once per sample period. It stays LOW if the results were not read in between.
+			const auto period_in_us = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(period).count());
+			simulator.play(m_interrupt_pin, {WaveformStep{period_in_us, 0}}, 0);
+		}
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "SimulatedCCS811 [update_interrupt_pin] Could not drive the nINT pin:\n" << ex.to_string() << std::endl;
+	}
+}
+
+void hal::simulation::SimulatedCCS811::set_error(const uint8_t error)
+{
+	m_error_id |= error;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "SimulatedI2CDevice.h"
+
+#include <array>
+#include <vector>
+
+namespace hal
+{
+	namespace simulation
+	{
+		//! Mailbox model of the CCS811.
+		/*!
+		* Mailbox model of the CCS811. The chip starts in boot mode with a valid application, APP_START switches to
+		* application mode and the software reset sequence returns to boot mode. Erasing, writing and verifying the
+		* application only change the APP_VALID bit. In application mode a new sample becomes available after every
+		* period of the selected drive mode, which sets DATA_READY until ALG_RESULT_DATA is read. Accesses to mailboxes
+		* that are not available in the current mode set the ERROR bit and the matching ERROR_ID bit like on the chip.
+		*
+		* Optionally the model is wired to pins of \sa { HAL::Utils::GPIOSimulator }: the nINT pin is pulled LOW for every
+		* new sample if data ready interrupts are enabled (threshold interrupts are not modeled) and released by reading
+		* the results, and the chip does not acknowledge any transaction while the nWAKE pin is HIGH.
+		*/
+		class SimulatedCCS811 final : public SimulatedI2CDevice
+		{
+		public:
+			//! Creates a sensor in boot mode.
+			SimulatedCCS811() = default;
+
+			/*!
+			* Destructor. Stops driving the nINT pin.
+			*/
+			~SimulatedCCS811() override;
+
+			SimulatedCCS811(const SimulatedCCS811&) = delete;
+			SimulatedCCS811(SimulatedCCS811&&) = delete;
+			SimulatedCCS811& operator=(const SimulatedCCS811&) = delete;
+			SimulatedCCS811& operator=(SimulatedCCS811&&) = delete;
+
+			bool write(const uint8_t* data, size_t length) override;
+
+			bool read(uint8_t* data, size_t length) override;
+
+			//! Changes the values of the next samples.
+			/*!
+			* Changes the values of the next samples.
+			* \param[in] eco2: The equivalent CO2 value in ppm.
+			* \param[in] tvoc: The total volatile organic compounds value in ppb.
+			*/
+			void set_air_quality(uint16_t eco2, uint16_t tvoc);
+
+			//! Wires the nINT output to a simulated GPIO pin.
+			/*!
+			* Wires the nINT output to a simulated GPIO pin. Applies to the next change of the measurement mode.
+			* \param[in] pin: The wiringPi pin number or -1 to leave nINT unconnected.
+			*/
+			void set_interrupt_pin(int pin);
+
+			//! Wires the nWAKE input to a simulated GPIO pin.
+			/*!
+			* Wires the nWAKE input to a simulated GPIO pin.
+			* \param[in] pin: The wiringPi pin number or -1 to keep the chip awake.
+			*/
+			void set_wake_pin(int pin);
+
+		private:
+			/*!
+			* Checks whether the nWAKE pin is LOW.
+			* \returns True if the chip acknowledges transactions, false otherwise.
+			*/
+			bool is_awake();
+
+			/*!
+			* Executes a write to a mailbox. The mutex is locked by the caller.
+			* \param[in] mailbox: The mailbox id.
+			* \param[in] data: The written data without the mailbox id.
+			* \param[in] length: The number of data bytes.
+			* \param[in] now: The time of the transaction.
+			*/
+			void write_mailbox(uint8_t mailbox, const uint8_t* data, size_t length, std::chrono::steady_clock::time_point now);
+
+			/*!
+			* Returns the content of a mailbox. The mutex is locked by the caller.
+			* \param[in] mailbox: The mailbox id.
+			* \param[in] now: The time of the transaction.
+			* \returns the content of the mailbox.
+			*/
+			std::vector<uint8_t> read_mailbox(uint8_t mailbox, std::chrono::steady_clock::time_point now);
+
+			/*!
+			* Returns the STATUS register. The mutex is locked by the caller.
+			* \param[in] now: The time of the transaction.
+			* \returns the STATUS register.
+			*/
+			uint8_t status(std::chrono::steady_clock::time_point now) const;
+
+			/*!
+			* Returns the number of samples since the measurement mode was changed. The mutex is locked by the caller.
+			* \param[in] now: The time of the transaction.
+			* \returns the number of samples.
+			*/
+			uint64_t sample_count(std::chrono::steady_clock::time_point now) const;
+
+			/*!
+			* Returns the sample period of the current drive mode.
+			* \returns the sample period or 0 if no samples are taken.
+			*/
+			std::chrono::milliseconds sample_period() const;
+
+			/*!
+			* Restarts the nINT waveform for the current mode. The mutex is locked by the caller.
+			*/
+			void update_interrupt_pin();
+
+			/*!
+			* Sets ERROR_ID bits. The mutex is locked by the caller.
+			* \param[in] error: The bits to set.
+			*/
+			void set_error(uint8_t error);
+
+			bool m_application_mode{};
+			bool m_application_valid = true;
+			uint8_t m_mode{};
+			uint8_t m_error_id{};
+			uint16_t m_eco2 = 400;
+			uint16_t m_tvoc{};
+			std::array<uint8_t, 2> m_baseline{{0x84, 0x3B}};
+			std::array<uint8_t, 4> m_environment_data{{0x64, 0x00, 0x64, 0x00}};
+			std::array<uint8_t, 5> m_thresholds{};
+			std::chrono::steady_clock::time_point m_mode_start{};
+			uint64_t m_consumed_samples{};
+			int m_interrupt_pin = -1;
+			int m_wake_pin = -1;
+		};
+	}
+}
@@ -0,0 +1,194 @@
+#include "SimulatedDS3231.h"
+#include "../sensors/i2c/DS3231Constants.h"
+
+#include <cmath>
+
+using namespace hal::sensors::i2c::ds3231;
+
+namespace
+{
+	constexpr auto CONVERSION_TIME = std::chrono::milliseconds(125);
+	constexpr auto AUTOMATIC_CONVERSION_PERIOD = std::chrono::seconds(64);
+	constexpr std::time_t SECONDS_PER_DAY = 86400;
+
+	uint8_t to_bcd(const int value)
+	{
+		return static_cast<uint8_t>(((value / 10) << 4) | (value % 10));
+	}
+
+	int from_bcd(const uint8_t value)
+	{
+		return (value >> 4) * 10 + (value & 0x0F);
+	}
+}
+
+hal::simulation::SimulatedDS3231::SimulatedDS3231()
+	: m_base_time(std::time(nullptr)),
+		m_base_steady(std::chrono::steady_clock::now()),
+		m_power_on(m_base_steady)
+{
+}
+
+void hal::simulation::SimulatedDS3231::set_time(const std::time_t time)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_base_time = time;
+	m_base_steady = std::chrono::steady_clock::now();
+}
+
+std::time_t hal::simulation::SimulatedDS3231::get_time()
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	return current_time(std::chrono::steady_clock::now());
+}
+
+void hal::simulation::SimulatedDS3231::set_temperature(const double temperature)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_temperature_in_quarters = static_cast<int16_t>(std::lround(temperature * 4));
+}
+
+uint8_t hal::simulation::SimulatedDS3231::read_register(const uint8_t reg, const std::chrono::steady_clock::time_point now)
+{
+	const auto time = current_time(now);
+	std::tm date{};
+	gmtime_r(&time, &date);
+
+	switch (reg)
+	{
+	case SECONDS_REGISTER:
+		return to_bcd(date.tm_sec);
+	case MINUTES_REGISTER:
+		return to_bcd(date.tm_min);
+	case HOURS_REGISTER:
+	{
+		if (!m_12_hour_format)
+		{
+			return to_bcd(date.tm_hour);
+		}
+		const auto hour = date.tm_hour % 12 == 0 ? 12 : date.tm_hour % 12;
+		return static_cast<uint8_t>(1 << HOUR_FORMAT_INDEX | (date.tm_hour >= 12 ? 1 << AM_PM_INDEX : 0) | to_bcd(hour));
+	}
+	case DAY_REGISTER:
+		return static_cast<uint8_t>((time / SECONDS_PER_DAY + m_day_offset) % 7 + 1);
+	case DATE_REGISTER:
+		return to_bcd(date.tm_mday);
+	case MONTH_REGISTER:
+		return static_cast<uint8_t>((date.tm_year >= 200 ? 1 << CENTURY_INDEX : 0) | to_bcd(date.tm_mon + 1));
+	case YEAR_REGISTER:
+		return to_bcd(date.tm_year % 100);
+	case CONTROL_REGISTER:
+		return is_converting(now) ? static_cast<uint8_t>(m_control | 1 << CONV_INDEX) : m_control;
+	case STATUS_REGISTER:
+		return is_converting(now) ? static_cast<uint8_t>(m_status | 1 << BSY_INDEX) : m_status;
+	case AGING_OFFSET_REGISTER:
+		return m_aging_offset;
+	case TEMPERATURE_MSB_REGISTER:
+		return static_cast<uint8_t>(m_temperature_in_quarters >> 2);
+	case TEMPERATURE_LSB_REGISTER:
+		return static_cast<uint8_t>((m_temperature_in_quarters & 0x03) << 6);
+	default:
+		if (reg >= ALARM_1_SECONDS_REGISTER && reg <= ALARM_2_DAY_AND_DATE_REGISTER)
+		{
+			return m_alarms[reg - ALARM_1_SECONDS_REGISTER];
+		}
+		return 0;
+	}
+}
+
+void hal::simulation::SimulatedDS3231::write_register(const uint8_t reg, const uint8_t value, const std::chrono::steady_clock::time_point now)
+{
+	if (reg <= YEAR_REGISTER)
+	{
+		write_time_register(reg, value, now);
+	}
+	else if (reg <= ALARM_2_DAY_AND_DATE_REGISTER)
+	{
+		m_alarms[reg - ALARM_1_SECONDS_REGISTER] = value;
+	}
+	else if (reg == CONTROL_REGISTER)
+	{
+		if ((value & 1 << CONV_INDEX) != 0 && !is_converting(now))
+		{
+			m_conversion_end = now + CONVERSION_TIME;
+		}
+		m_control = static_cast<uint8_t>(value & ~(1 << CONV_INDEX));
+	}
+	else if (reg == STATUS_REGISTER)
+	{
+		// The flags can only be cleared, EN32kHz can be changed and BSY is read only
+		const uint8_t flags = 1 << OSF_INDEX | 1 << A2F_INDEX | 1 << A1F_INDEX;
+		m_status = static_cast<uint8_t>((m_status & value & flags) | (value & 1 << EN32KHZ_INDEX));
+	}
+	else if (reg == AGING_OFFSET_REGISTER)
+	{
+		m_aging_offset = value;
+	}
+}
+
+std::time_t hal::simulation::SimulatedDS3231::current_time(const std::chrono::steady_clock::time_point now) const
+{
+	return m_base_time + static_cast<std::time_t>(std::chrono::duration_cast<std::chrono::seconds>(now - m_base_steady).count());
+}
+
+void hal::simulation::SimulatedDS3231::write_time_register(const uint8_t reg, const uint8_t value, const std::chrono::steady_clock::time_point now)
+{
+	const auto time = current_time(now);
+	std::tm date{};
+	gmtime_r(&time, &date);
+
+	// Writing the seconds restarts the current second, the other fields keep it running
+	auto elapsed_in_second = (now - m_base_steady) % std::chrono::seconds(1);
+	switch (reg)
+	{
+	case SECONDS_REGISTER:
+		date.tm_sec = from_bcd(value & 0x7F);
+		elapsed_in_second = std::chrono::steady_clock::duration::zero();
+		break;
+	case MINUTES_REGISTER:
+		date.tm_min = from_bcd(value & 0x7F);
+		break;
+	case HOURS_REGISTER:
+		m_12_hour_format = (value & 1 << HOUR_FORMAT_INDEX) != 0;
+		if (m_12_hour_format)
+		{
+			date.tm_hour = from_bcd(value & 0x1F) % 12 + ((value & 1 << AM_PM_INDEX) != 0 ? 12 : 0);
+		}
+		else
+		{
+			date.tm_hour = from_bcd(value & 0x3F);
+		}
+		break;
+	case DAY_REGISTER:
+	{
+		// The day of the week is only a counter that advances at midnight
+		const auto day = static_cast<int>((value & 0x07) == 0 ? 1 : value & 0x07) - 1;
+		m_day_offset = static_cast<int>(((day - time / SECONDS_PER_DAY) % 7 + 7) % 7);
+		return;
+	}
+	case DATE_REGISTER:
+		date.tm_mday = from_bcd(value & 0x3F);
+		break;
+	case MONTH_REGISTER:
+		date.tm_mon = from_bcd(value & 0x1F) - 1;
+		date.tm_year = date.tm_year % 100 + ((value & 1 << CENTURY_INDEX) != 0 ? 200 : 100);
+		break;
+	case YEAR_REGISTER:
+		date.tm_year = date.tm_year - date.tm_year % 100 + from_bcd(value);
+		break;
+	default:
+		return;
+	}
+
+	// The day of the week does not follow changes of the date
+	const auto new_time = timegm(&date);
+	m_day_offset = static_cast<int>(((m_day_offset - (new_time / SECONDS_PER_DAY - time / SECONDS_PER_DAY)) % 7 + 7) % 7);
+	m_base_time = new_time;
+	m_base_steady = now - elapsed_in_second;
+}
+
+bool hal::simulation::SimulatedDS3231::is_converting(const std::chrono::steady_clock::time_point now) const
+{
+	const auto elapsed = now - m_power_on;
+	return now < m_conversion_end || (elapsed >= AUTOMATIC_CONVERSION_PERIOD && elapsed % AUTOMATIC_CONVERSION_PERIOD < CONVERSION_TIME);
+}
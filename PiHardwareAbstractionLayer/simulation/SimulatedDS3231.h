@@ -0,0 +1,93 @@
+#pragma once
+
+#include "SimulatedI2CDevice.h"
+
+#include <array>
+#include <ctime>
+
+namespace hal
+{
+	namespace simulation
+	{
+		//! Register map model of the DS3231.
+		/*!
+		* Register map model of the DS3231. The time and date registers are BCD encoded and advance with the steady clock,
+		* starting at the current system time. Writing a time register changes the time from then on, the 12/24 hour format
+		* and the day of the week behave like on the chip. A temperature conversion (triggered by CONV or automatically every
+		* 64 seconds) keeps BSY set for the typical conversion time. The alarm registers are stored but not evaluated.
+		*/
+		class SimulatedDS3231 final : public SimulatedI2CDevice
+		{
+		public:
+			//! Creates a clock that starts at the current system time.
+			SimulatedDS3231();
+
+			~SimulatedDS3231() override = default;
+			SimulatedDS3231(const SimulatedDS3231&) = delete;
+			SimulatedDS3231(SimulatedDS3231&&) = delete;
+			SimulatedDS3231& operator=(const SimulatedDS3231&) = delete;
+			SimulatedDS3231& operator=(SimulatedDS3231&&) = delete;
+
+			//! Sets the time of the clock.
+			/*!
+			* Sets the time of the clock.
+			* \param[in] time: The new time in seconds since the epoch (UTC).
+			*/
+			void set_time(std::time_t time);
+
+			//! Returns the time of the clock.
+			/*!
+			* Returns the time of the clock.
+			* \returns the current time of the clock in seconds since the epoch (UTC).
+			*/
+			std::time_t get_time();
+
+			//! Sets the temperature of the internal sensor.
+			/*!
+			* Sets the temperature of the internal sensor. The registers have a resolution of 0.25 degree celsius.
+			* \param[in] temperature: The temperature in degree celsius.
+			*/
+			void set_temperature(double temperature);
+
+		protected:
+			uint8_t read_register(uint8_t reg, std::chrono::steady_clock::time_point now) override;
+
+			void write_register(uint8_t reg, uint8_t value, std::chrono::steady_clock::time_point now) override;
+
+		private:
+			/*!
+			* Returns the time of the clock. The mutex is locked by the caller.
+			* \param[in] now: The time of the transaction.
+			* \returns the time of the clock in seconds since the epoch.
+			*/
+			std::time_t current_time(std::chrono::steady_clock::time_point now) const;
+
+			/*!
+			* Writes one field of the time. The mutex is locked by the caller.
+			* \param[in] reg: The time register.
+			* \param[in] value: The written value.
+			* \param[in] now: The time of the transaction.
+			*/
+			void write_time_register(uint8_t reg, uint8_t value, std::chrono::steady_clock::time_point now);
+
+			/*!
+			* Checks whether a temperature conversion is running. The mutex is locked by the caller.
+			* \param[in] now: The time of the transaction.
+			* \returns True if the temperature is converted, false otherwise.
+			*/
+			bool is_converting(std::chrono::steady_clock::time_point now) const;
+
+			std::time_t m_base_time{};
+			std::chrono::steady_clock::time_point m_base_steady{};
+			std::chrono::steady_clock::time_point m_power_on{};
+			std::chrono::steady_clock::time_point m_conversion_end{};
+			bool m_12_hour_format{};
+			int m_day_offset{};
+			std::array<uint8_t, 7> m_alarms{};
+			uint8_t m_control = 0x1C;
+			uint8_t m_status = 0x88;
+			uint8_t m_aging_offset{};
+			int16_t m_temperature_in_quarters = 100;
+		};
+	}
+}
@@ -0,0 +1,39 @@
+#include "SimulatedI2CDevice.h"
+
+bool hal::simulation::SimulatedI2CDevice::write(const uint8_t* data, const size_t length)
+{
+	// A write without data only checks whether the device is present
+	if (length == 0)
+	{
+		return true;
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_pointer = data[0];
+	for (size_t i = 1; i < length; i++)
+	{
+		write_register(m_pointer++, data[i], now);
+	}
+	return true;
+}
+
+bool hal::simulation::SimulatedI2CDevice::read(uint8_t* data, const size_t length)
+{
+	const auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(m_mutex);
+	for (size_t i = 0; i < length; i++)
+	{
+		data[i] = read_register(m_pointer++, now);
+	}
+	return true;
+}
+
+uint8_t hal::simulation::SimulatedI2CDevice::read_register(uint8_t, std::chrono::steady_clock::time_point)
+{
+	return 0;
+}
+
+void hal::simulation::SimulatedI2CDevice::write_register(uint8_t, uint8_t, std::chrono::steady_clock::time_point)
+{
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace hal
+{
+	namespace simulation
+	{
+		//! Base class of the register map models that are attached to \sa { HAL::Utils::I2CSimulator }.
+		/*!
+		* Base class of the register map models that are attached to \sa { HAL::Utils::I2CSimulator }. The default
+		* implementation behaves like most i2c chips: the first written byte selects the register, following bytes are
+		* written to it and the next registers, reads continue at the selected register and increment it after each byte.
+		* Models with a different protocol (e.g. 16 bit registers or mailboxes) override <write>"()" and <read>"()".
+		* Models keep no threads of their own. Conversion timing is evaluated against the steady clock whenever a register
+		* is accessed, so a model costs nothing while the driver does not talk to it.
+		*/
+		class SimulatedI2CDevice
+		{
+		public:
+			SimulatedI2CDevice() = default;
+			SimulatedI2CDevice(const SimulatedI2CDevice&) = delete;
+			SimulatedI2CDevice(SimulatedI2CDevice&&) = delete;
+			virtual ~SimulatedI2CDevice() = default;
+			SimulatedI2CDevice& operator=(const SimulatedI2CDevice&) = delete;
+			SimulatedI2CDevice& operator=(SimulatedI2CDevice&&) = delete;
+
+			//! Handles a write transaction.
+			/*!
+			* Handles a write transaction. Executed by the simulator.
+			* \param[in] data: The bytes the master wrote.
+			* \param[in] length: The number of bytes.
+			* \returns True if the device acknowledged the bytes, false otherwise.
+			*/
+			virtual bool write(const uint8_t* data, size_t length);
+
+			//! Handles a read transaction.
+			/*!
+			* Handles a read transaction. Executed by the simulator.
+			* \param[out] data: The buffer to fill.
+			* \param[in] length: The number of bytes the master reads.
+			* \returns True if the device acknowledged the request, false otherwise.
+			*/
+			virtual bool read(uint8_t* data, size_t length);
+
+		protected:
+			/*!
+			* Returns the content of a register. The mutex is locked by the caller. Reads 0 unless overridden.
+			* \param[in] reg: The register address.
+			* \param[in] now: The time of the transaction.
+			* \returns the content of the register.
+			*/
+			virtual uint8_t read_register(uint8_t reg, std::chrono::steady_clock::time_point now);
+
+			/*!
+			* Writes a register. The mutex is locked by the caller. Ignores the value unless overridden.
+			* \param[in] reg: The register address.
+			* \param[in] value: The written value.
+			* \param[in] now: The time of the transaction.
+			*/
+			virtual void write_register(uint8_t reg, uint8_t value, std::chrono::steady_clock::time_point now);
+
+			std::mutex m_mutex{};
+			uint8_t m_pointer{};
+		};
+	}
+}
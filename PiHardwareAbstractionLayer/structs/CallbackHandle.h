@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <string>
 
 namespace hal
 {
@@ -13,9 +14,10 @@ namespace hal
 		/*!
 		* Default constructor.
 		*/
-		CallbackHandle(const std::function<void(std::string)>& callback, const uint32_t handle)
+		CallbackHandle(const std::function<void(std::string)>& callback, const uint32_t handle, const uint32_t interval_in_ms = 0)
 			: callback(callback),
-				callback_handle(handle)
+				callback_handle(handle),
+				interval_in_ms(interval_in_ms)
 		{
 		}
 
@@ -24,5 +26,8 @@ namespace hal
 
 		/*! A unique handle that is used to clearly identify its corresponding callback function. */
 		const uint32_t callback_handle;
+
+		/*! The time between two values the owner of the callback expects. 0 if the owner accepts any data rate. */
+		const uint32_t interval_in_ms;
 	};
 }
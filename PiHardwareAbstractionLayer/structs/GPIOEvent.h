@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../enums/GPIOEdge.h"
+
+#include <cstdint>
+
+namespace hal
+{
+	/*!
+	* Data structure describing one edge that was detected on a GPIO line.
+	*/
+	struct GPIOEvent
+	{
+		/*! The detected edge (RISING or FALLING). */
+		GPIOEdge edge = GPIOEdge::NONE;
+
+		/*! The time the edge was detected in nanoseconds (CLOCK_MONOTONIC). */
+		uint64_t timestamp_ns = 0;
+	};
+}
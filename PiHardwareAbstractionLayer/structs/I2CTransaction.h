@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../enums/I2COperation.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace hal
+{
+	/*!
+	* Data structure describing one recorded call of an i2c transport.
+	*/
+	struct I2CTransaction
+	{
+		/*! The time the call completed in microseconds since the recording started. */
+		uint64_t timestamp_in_us = 0;
+
+		/*! The kind of call. */
+		I2COperation operation = I2COperation::OPEN;
+
+		/*! The i2c address of the device. */
+		uint8_t address = 0;
+
+		/*! The register of the device: the first written byte or, for reads, the register selected by the last write. */
+		uint8_t reg = 0;
+
+		/*! The errno of a failed call, 0 otherwise. */
+		uint8_t error = 0;
+
+		/*! The return value of the call (handle, 0 or the number of transferred bytes, -1 on failure). */
+		int32_t result = 0;
+
+		/*! The written bytes or the bytes that were read. */
+		std::vector<uint8_t> data{};
+	};
+}
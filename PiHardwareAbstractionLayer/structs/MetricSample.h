@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../enums/MetricKind.h"
+#include "../enums/SensorType.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+	/*!
+	* Data structure describing the value of one metric at the time a snapshot was taken.
+	*/
+	struct MetricSample
+	{
+		/*! The name of the metric, e.g. "i2c.read_latency_ns". */
+		std::string name{};
+
+		/*! The kind of the metric. */
+		MetricKind kind = MetricKind::COUNTER;
+
+		/*! The i2c address of the device or the pin of the sensor (0 if the metric is not recorded per device). */
+		uint8_t device = 0;
+
+		/*! True if the metric is recorded per measurement type, false otherwise. */
+		bool has_sensor_type = false;
+
+		/*! The measurement type (only meaningful if has_sensor_type is true). */
+		SensorType sensor_type = SensorType::CONVERTER;
+
+		/*! The value of a counter or gauge. */
+		int64_t value = 0;
+
+		/*! The number of durations recorded by a histogram. */
+		uint64_t count = 0;
+
+		/*! The sum of all durations recorded by a histogram in nanoseconds. */
+		uint64_t sum = 0;
+
+		/*! The number of durations of each bucket of a histogram. Bucket i counts durations below 2^i nanoseconds
+		 * that do not fit into a lower bucket, the last bucket counts all remaining durations. */
+		std::vector<uint64_t> buckets{};
+	};
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace hal
+{
+	/*!
+	* Data structure describing one period in which motions were detected without a pause longer than the hold-off time.
+	*/
+	struct OccupancyInterval
+	{
+		/*! The start of the first motion of the interval. */
+		std::chrono::system_clock::time_point start{};
+
+		/*! The end of the last motion of the interval. */
+		std::chrono::system_clock::time_point end{};
+
+		/*! The number of motions that started within the interval. */
+		uint32_t event_count = 0;
+	};
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hal
+{
+	/*!
+	* Data structure describing one traced operation (e.g. an i2c transfer or the conversion wait of a sensor).
+	*/
+	struct TraceEvent
+	{
+		/*! The name of the operation (string literal), e.g. "i2c.read". */
+		const char* name = "";
+
+		/*! The category of the operation (string literal), e.g. "i2c". */
+		const char* category = "";
+
+		/*! The number of the thread that executed the operation (assigned in the order the threads traced first). */
+		uint32_t thread_id = 0;
+
+		/*! The i2c address of the device or the pin of the sensor (0 if not known). */
+		uint8_t device = 0;
+
+		/*! The start of the operation in nanoseconds of std::chrono::steady_clock. */
+		uint64_t start_ns = 0;
+
+		/*! The duration of the operation in nanoseconds. */
+		uint64_t duration_ns = 0;
+	};
+}
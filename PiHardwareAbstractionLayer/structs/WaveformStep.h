@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hal
+{
+	/*!
+	* Data structure describing one step of a scripted waveform that is played by \sa { HAL::Utils::GPIOSimulator }.
+	*/
+	struct WaveformStep
+	{
+		/*! The time between the previous step (or the start of the waveform) and this step in microseconds. */
+		uint32_t delay_in_us = 0;
+
+		/*! The level the line changes to: 0 for LOW, any other value for HIGH. */
+		int level = 0;
+	};
+}
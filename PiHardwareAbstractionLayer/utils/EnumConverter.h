@@ -1302,6 +1302,8 @@ namespace hal
 					return "Comparator Queue";
 				case SensorSetting::DATA_RATE:
 					return "Data Rate";
+				case SensorSetting::DEBOUNCE_TIME:
+					return "Debounce Time";
 				case SensorSetting::ENVIRONMENT_DATA:
 					return "Environment Data";
 				case SensorSetting::FILTER:
@@ -1314,6 +1316,8 @@ namespace hal
 					return "Oversampling";
 				case SensorSetting::PIN_POLARITY:
 					return "Pin Polarity";
+				case SensorSetting::RETRIGGER_TIME:
+					return "Retrigger Time";
 				case SensorSetting::THRESHOLD:
 					return "Threshold";
 				default:
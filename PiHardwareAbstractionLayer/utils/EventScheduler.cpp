@@ -0,0 +1,245 @@
+#include "EventScheduler.h"
+
+#include "../exceptions/HALException.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+hal::utils::EventScheduler& hal::utils::EventScheduler::instance()
+{
+	static EventScheduler inst;
+	return inst;
+}
+
+hal::utils::EventScheduler::EventScheduler()
+{
+	m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (m_epoll_fd < 0)
+	{
+		throw exception::HALException("EventScheduler", "EventScheduler",
+												std::string("Could not create epoll instance: ").append(strerror(errno)));
+	}
+
+	m_wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.u32 = 0; // Handle 0 is reserved for the wake up descriptor
+	if (m_wake_fd < 0 || epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wake_fd, &event) < 0)
+	{
+		const auto error = errno;
+		if (m_wake_fd >= 0)
+		{
+			close(m_wake_fd);
+		}
+		close(m_epoll_fd);
+		throw exception::HALException("EventScheduler", "EventScheduler",
+												std::string("Could not create wake up descriptor: ").append(strerror(error)));
+	}
+
+	m_is_running = true;
+	m_thread = new std::thread(&EventScheduler::thread_loop, this);
+}
+
+hal::utils::EventScheduler::~EventScheduler()
+{
+	m_is_running = false;
+	const uint64_t wake = 1;
+	// EAGAIN means the counter is full, the descriptor is readable anyway
+	if (write(m_wake_fd, &wake, sizeof(wake)) < 0 && errno != EAGAIN)
+	{
+		std::cerr << "EventScheduler [~EventScheduler] Could not wake up the thread: " << strerror(errno) << std::endl;
+	}
+	if (m_thread != nullptr)
+	{
+		m_thread->join();
+		delete m_thread;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		while (!m_registrations.empty())
+		{
+			remove_locked(m_registrations.begin()->first);
+		}
+	}
+	close(m_wake_fd);
+	close(m_epoll_fd);
+}
+
+uint32_t hal::utils::EventScheduler::watch_fd(const int fd, const std::function<void()>& callback)
+{
+	return add_registration(std::make_shared<Registration>(Registration{fd, false, true, callback}));
+}
+
+uint32_t hal::utils::EventScheduler::add_timer(const uint32_t interval_ms, const bool periodic, const std::function<void()>& callback)
+{
+	const auto timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+	if (timer_fd < 0)
+	{
+		throw exception::HALException("EventScheduler", "add_timer", std::string("Could not create timer: ").append(strerror(errno)));
+	}
+
+	itimerspec spec{};
+	spec.it_value.tv_sec = interval_ms / 1000;
+	spec.it_value.tv_nsec = static_cast<long>(interval_ms % 1000) * 1000000L;
+	if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+	{
+		spec.it_value.tv_nsec = 1; // A zero value would disarm the timer
+	}
+	if (periodic)
+	{
+		spec.it_interval = spec.it_value;
+	}
+
+	if (timerfd_settime(timer_fd, 0, &spec, nullptr) < 0)
+	{
+		close(timer_fd);
+		throw exception::HALException("EventScheduler", "add_timer", std::string("Could not arm timer: ").append(strerror(errno)));
+	}
+
+	try
+	{
+		return add_registration(std::make_shared<Registration>(Registration{timer_fd, true, periodic, callback}));
+	}
+	catch (exception::HALException&)
+	{
+		close(timer_fd);
+		throw;
+	}
+}
+
+void hal::utils::EventScheduler::remove(const uint32_t handle) noexcept
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (m_thread != nullptr && std::this_thread::get_id() != m_thread->get_id())
+	{
+		// Wait until a running callback of this registration returned.
+		m_cv.wait(lock, [this, handle] { return m_running_handle != handle; });
+	}
+	remove_locked(handle);
+}
+
+void hal::utils::EventScheduler::thread_loop() noexcept
+{
+	static constexpr int MAX_EVENTS = 16;
+	epoll_event events[MAX_EVENTS];
+
+	while (m_is_running)
+	{
+		const auto count = epoll_wait(m_epoll_fd, events, MAX_EVENTS, -1);
+		if (count < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			std::cerr << "EventScheduler [thread_loop] epoll_wait failed: " << strerror(errno) << std::endl;
+			return;
+		}
+
+		for (auto i = 0; i < count && m_is_running; ++i)
+		{
+			if (events[i].data.u32 == 0)
+			{
+				// The value is not needed, reading only resets the counter. EAGAIN means it was reset already.
+				uint64_t value;
+				if (read(m_wake_fd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+				{
+					std::cerr << "EventScheduler [thread_loop] Could not reset the wake up descriptor: " << strerror(errno) << std::endl;
+				}
+				continue;
+			}
+			dispatch(events[i].data.u32);
+		}
+	}
+}
+
+void hal::utils::EventScheduler::dispatch(const uint32_t handle) noexcept
+{
+	std::shared_ptr<Registration> registration;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		const auto it = m_registrations.find(handle);
+		if (it == m_registrations.end())
+		{
+			return; // Removed while the event was pending
+		}
+		registration = it->second;
+
+		if (registration->is_timer)
+		{
+			uint64_t expirations;
+			if (read(registration->fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+			{
+				return; // Timer was rearmed in the meantime
+			}
+		}
+		m_running_handle = handle;
+	}
+
+	try
+	{
+		registration->callback();
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "EventScheduler [dispatch] Callback of registration #" << handle << " failed:\n" << ex.to_string() << std::endl;
+	}
+	catch (std::exception& ex)
+	{
+		std::cerr << "EventScheduler [dispatch] Callback of registration #" << handle << " failed: " << ex.what() << std::endl;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_running_handle = 0;
+		if (registration->is_timer && !registration->periodic)
+		{
+			remove_locked(handle);
+		}
+	}
+	m_cv.notify_all();
+}
+
+void hal::utils::EventScheduler::remove_locked(const uint32_t handle) noexcept
+{
+	const auto it = m_registrations.find(handle);
+	if (it == m_registrations.end())
+	{
+		return;
+	}
+
+	epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->second->fd, nullptr);
+	if (it->second->is_timer)
+	{
+		close(it->second->fd);
+	}
+	m_registrations.erase(it);
+}
+
+uint32_t hal::utils::EventScheduler::add_registration(const std::shared_ptr<Registration>& registration)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto handle = m_next_handle++;
+	if (m_next_handle == 0)
+	{
+		m_next_handle = 1;
+	}
+
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.u32 = handle;
+	if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, registration->fd, &event) < 0)
+	{
+		throw exception::HALException("EventScheduler", "add_registration",
+												std::string("Could not watch file descriptor #").append(std::to_string(registration->fd))
+																											.append(": ").append(strerror(errno)));
+	}
+	m_registrations[handle] = registration;
+	return handle;
+}
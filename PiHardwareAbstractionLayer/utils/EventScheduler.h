@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Class that services file descriptor events and timers of all devices with one thread.
+		/*!
+		* This class owns a single epoll thread. Devices register the file descriptors they want to be
+		* notified about (e.g. the event fd of a GPIO line) and timers (backed by timerfd). Whenever a
+		* descriptor becomes readable or a timer expires the registered callback is executed on the
+		* scheduler thread. This way devices do not need a thread of their own to wait for hardware.
+		* Callbacks should return quickly since they block the handling of all other registrations.
+		*/
+		class EventScheduler
+		{
+		public:
+			/*!
+			* Access the singleton instance of this class.
+			* \returns the singleton instance of this class.
+			* \throws HALException if the epoll instance could not be created.
+			*/
+			static EventScheduler& instance();
+
+			EventScheduler(const EventScheduler&) = delete;
+			EventScheduler(EventScheduler&&) = delete;
+			EventScheduler& operator=(const EventScheduler&) = delete;
+			EventScheduler& operator=(EventScheduler&&) = delete;
+
+			//! Watches a file descriptor for readability.
+			/*!
+			* Watches a file descriptor for readability. The callback is executed as long as the descriptor
+			* stays readable (level triggered). Therefore the callback has to consume the pending data.
+			* The file descriptor is not closed by the scheduler.
+			* \param[in] fd: The file descriptor to watch.
+			* \param[in] callback: The function to execute if the descriptor is readable.
+			* \returns a handle that identifies the registration.
+			* \throws HALException if the descriptor could not be added to the epoll instance.
+			*/
+			uint32_t watch_fd(int fd, const std::function<void()>& callback);
+
+			//! Adds a new timer.
+			/*!
+			* Adds a new timer that executes the given callback after the given interval.
+			* \param[in] interval_ms: The time until the callback is executed in milliseconds.
+			* \param[in] periodic: True to repeat the timer, false to remove it after it expired once.
+			* \param[in] callback: The function to execute if the timer expires.
+			* \returns a handle that identifies the registration.
+			* \throws HALException if the timer could not be created.
+			*/
+			uint32_t add_timer(uint32_t interval_ms, bool periodic, const std::function<void()>& callback);
+
+			//! Removes a registration.
+			/*!
+			* Removes a file descriptor watch or a timer. If the callback of the registration is currently
+			* executed by another thread this method blocks until the callback returned. Afterwards the
+			* callback will not be executed anymore. Unknown handles are ignored.
+			* \param[in] handle: The handle returned by \sa { EventScheduler::watch_fd() } or \sa { EventScheduler::add_timer() }.
+			*/
+			void remove(uint32_t handle) noexcept;
+
+		protected:
+			EventScheduler();
+			~EventScheduler();
+
+			/*! Data structure storing one registration. */
+			struct Registration
+			{
+				int fd;
+				bool is_timer;
+				bool periodic;
+				std::function<void()> callback;
+			};
+
+			/*!
+			* The function that is executed by the scheduler thread.
+			*/
+			void thread_loop() noexcept;
+
+			/*!
+			* Executes the callback that belongs to the given handle.
+			* \param[in] handle: The handle of the registration that became ready.
+			*/
+			void dispatch(uint32_t handle) noexcept;
+
+			/*!
+			* Removes a registration. The mutex has to be locked by the caller.
+			* \param[in] handle: The handle of the registration to remove.
+			*/
+			void remove_locked(uint32_t handle) noexcept;
+
+			/*!
+			* Adds a file descriptor to the epoll instance and stores the registration.
+			* \param[in] registration: The registration to add.
+			* \returns the handle of the registration.
+			* \throws HALException if the descriptor could not be added to the epoll instance.
+			*/
+			uint32_t add_registration(const std::shared_ptr<Registration>& registration);
+
+			int m_epoll_fd = -1;
+			int m_wake_fd = -1;
+			uint32_t m_next_handle = 1;
+			uint32_t m_running_handle = 0;
+			std::thread* m_thread{};
+			std::atomic_bool m_is_running = ATOMIC_VAR_INIT(false);
+			std::mutex m_mutex{};
+			std::condition_variable m_cv{};
+			std::map<uint32_t, std::shared_ptr<Registration>> m_registrations{};
+		};
+	}
+}
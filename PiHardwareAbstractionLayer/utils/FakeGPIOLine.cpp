@@ -0,0 +1,105 @@
+#include "FakeGPIOLine.h"
+
+#include "../exceptions/GPIOException.h"
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+hal::utils::FakeGPIOLine::FakeGPIOLine(const GPIOEdge edge, const int initial_value)
+	: m_edge(edge),
+		m_value(initial_value == 0 ? 0 : 1)
+{
+	m_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+	if (m_event_fd < 0)
+	{
+		throw exception::GPIOException("FakeGPIOLine", "FakeGPIOLine", 0,
+												std::string("Could not create eventfd: ").append(strerror(errno)));
+	}
+}
+
+hal::utils::FakeGPIOLine::~FakeGPIOLine()
+{
+	close();
+}
+
+int hal::utils::FakeGPIOLine::get_value()
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	return m_value;
+}
+
+void hal::utils::FakeGPIOLine::set_value(const int value)
+{
+	set_level(value);
+}
+
+int hal::utils::FakeGPIOLine::get_event_fd() const noexcept
+{
+	return m_edge == GPIOEdge::NONE ? -1 : m_event_fd;
+}
+
+bool hal::utils::FakeGPIOLine::read_event(GPIOEvent& event)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_events.empty())
+	{
+		return false;
+	}
+
+	uint64_t counter;
+	if (read(m_event_fd, &counter, sizeof(counter)) != sizeof(counter))
+	{
+		return false;
+	}
+
+	event = m_events.front();
+	m_events.pop_front();
+	return true;
+}
+
+void hal::utils::FakeGPIOLine::close() noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_event_fd >= 0)
+	{
+		::close(m_event_fd);
+		m_event_fd = -1;
+	}
+	m_events.clear();
+}
+
+void hal::utils::FakeGPIOLine::set_level(const int value)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto new_value = value == 0 ? 0 : 1;
+	if (new_value == m_value)
+	{
+		return;
+	}
+	m_value = new_value;
+
+	const auto edge = new_value == 1 ? GPIOEdge::RISING : GPIOEdge::FALLING;
+	if (m_event_fd < 0 || (m_edge != GPIOEdge::BOTH && m_edge != edge))
+	{
+		return;
+	}
+
+	timespec now{};
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	GPIOEvent event;
+	event.edge = edge;
+	event.timestamp_ns = static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+	m_events.push_back(event);
+
+	const uint64_t increment = 1;
+	write(m_event_fd, &increment, sizeof(increment));
+}
+
+size_t hal::utils::FakeGPIOLine::pending_events() noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	return m_events.size();
+}
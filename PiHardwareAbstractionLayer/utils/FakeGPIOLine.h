@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../enums/GPIOEdge.h"
+#include "../interfaces/IGPIOLine.h"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! GPIO line that only exists in memory.
+		/*!
+		* This class behaves like a GPIO line that was requested with edge detection but its level is
+		* changed by calling \sa { FakeGPIOLine::set_level() } from code. It can replace the real line
+		* of a sensor in tests or on machines without GPIO hardware. Its event file descriptor is an
+		* eventfd and therefore can be watched by \sa { HAL::Utils::EventScheduler } like a real line.
+		*/
+		class FakeGPIOLine final : public interfaces::IGPIOLine
+		{
+		public:
+			FakeGPIOLine(const FakeGPIOLine&) = delete;
+			FakeGPIOLine(FakeGPIOLine&&) = delete;
+			FakeGPIOLine& operator=(const FakeGPIOLine&) = delete;
+			FakeGPIOLine& operator=(FakeGPIOLine&&) = delete;
+
+			//! Creates a new fake line.
+			/*!
+			* Creates a new fake line.
+			* \param[in] edge: The edges that are reported as events.
+			* \param[in] initial_value: The level of the line after creation.
+			* \throws GPIOException if the event file descriptor could not be created.
+			*/
+			explicit FakeGPIOLine(GPIOEdge edge = GPIOEdge::BOTH, int initial_value = 1);
+
+			~FakeGPIOLine();
+
+			/*!
+			* Returns the current level of the line.
+			* \returns 0 if the line is LOW, 1 if it is HIGH.
+			*/
+			int get_value() override;
+
+			/*!
+			* Sets the level of the line like a connected device would do. Same as \sa { FakeGPIOLine::set_level() }.
+			* \param[in] value: 0 for LOW, any other value for HIGH.
+			*/
+			void set_value(int value) override;
+
+			/*!
+			* Returns the eventfd that becomes readable if an edge is pending.
+			* \returns the event file descriptor.
+			*/
+			int get_event_fd() const noexcept override;
+
+			/*!
+			* Pops the oldest pending edge event.
+			* \param[out] event: The edge and its timestamp.
+			* \returns True if an event was pending, false otherwise.
+			*/
+			bool read_event(GPIOEvent& event) override;
+
+			/*!
+			* Closes the event file descriptor.
+			*/
+			void close() noexcept override;
+
+			//! Changes the level of the line.
+			/*!
+			* Changes the level of the line. If the level changes and the resulting edge matches the
+			* requested edges an event is queued and the event file descriptor becomes readable.
+			* \param[in] value: 0 for LOW, any other value for HIGH.
+			*/
+			void set_level(int value);
+
+			//! Returns the number of queued but not yet read events.
+			/*!
+			* Returns the number of queued but not yet read events.
+			* \returns the number of pending events.
+			*/
+			size_t pending_events() noexcept;
+
+		private:
+			GPIOEdge m_edge;
+			int m_value;
+			int m_event_fd = -1;
+			std::deque<GPIOEvent> m_events{};
+			std::mutex m_mutex{};
+		};
+	}
+}
@@ -0,0 +1,144 @@
+#include "GPIOChardevLine.h"
+
+#include "../exceptions/GPIOException.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+hal::utils::GPIOChardevLine::GPIOChardevLine(
+	const std::string& chip_path,
+	const uint32_t line_offset,
+	const bool output,
+	const GPIOEdge edge,
+	const std::string& consumer)
+	: m_line_offset(line_offset),
+		m_has_events(!output && edge != GPIOEdge::NONE)
+{
+	const auto chip_fd = open(chip_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (chip_fd < 0)
+	{
+		throw exception::GPIOException("GPIOChardevLine", "GPIOChardevLine", static_cast<uint8_t>(line_offset),
+												std::string("Could not open gpiochip '").append(chip_path).append("': ").append(strerror(errno)));
+	}
+
+	auto result = 0;
+	if (m_has_events)
+	{
+		gpioevent_request request{};
+		request.lineoffset = line_offset;
+		request.handleflags = GPIOHANDLE_REQUEST_INPUT;
+		switch (edge)
+		{
+		case GPIOEdge::RISING:
+			request.eventflags = GPIOEVENT_REQUEST_RISING_EDGE;
+			break;
+		case GPIOEdge::FALLING:
+			request.eventflags = GPIOEVENT_REQUEST_FALLING_EDGE;
+			break;
+		default:
+			request.eventflags = GPIOEVENT_REQUEST_BOTH_EDGES;
+			break;
+		}
+		strncpy(request.consumer_label, consumer.c_str(), sizeof(request.consumer_label) - 1);
+		result = ioctl(chip_fd, GPIO_GET_LINEEVENT_IOCTL, &request);
+		m_line_fd = request.fd;
+	}
+	else
+	{
+		gpiohandle_request request{};
+		request.lineoffsets[0] = line_offset;
+		request.lines = 1;
+		request.flags = output ? GPIOHANDLE_REQUEST_OUTPUT : GPIOHANDLE_REQUEST_INPUT;
+		strncpy(request.consumer_label, consumer.c_str(), sizeof(request.consumer_label) - 1);
+		result = ioctl(chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &request);
+		m_line_fd = request.fd;
+	}
+
+	const auto request_errno = errno;
+	::close(chip_fd);
+	if (result < 0 || m_line_fd < 0)
+	{
+		m_line_fd = -1;
+		throw exception::GPIOException("GPIOChardevLine", "GPIOChardevLine", static_cast<uint8_t>(line_offset),
+												std::string("Could not request line: ").append(strerror(request_errno)));
+	}
+}
+
+hal::utils::GPIOChardevLine::~GPIOChardevLine()
+{
+	close();
+}
+
+int hal::utils::GPIOChardevLine::get_value()
+{
+	gpiohandle_data data{};
+	if (ioctl(m_line_fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) < 0)
+	{
+		throw exception::GPIOException("GPIOChardevLine", "get_value", static_cast<uint8_t>(m_line_offset),
+												std::string("Could not read line value: ").append(strerror(errno)));
+	}
+	return data.values[0];
+}
+
+void hal::utils::GPIOChardevLine::set_value(const int value)
+{
+	gpiohandle_data data{};
+	data.values[0] = value == 0 ? 0 : 1;
+	if (ioctl(m_line_fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) < 0)
+	{
+		throw exception::GPIOException("GPIOChardevLine", "set_value", static_cast<uint8_t>(m_line_offset),
+												std::string("Could not write line value: ").append(strerror(errno)));
+	}
+}
+
+int hal::utils::GPIOChardevLine::get_event_fd() const noexcept
+{
+	return m_has_events ? m_line_fd : -1;
+}
+
+bool hal::utils::GPIOChardevLine::read_event(GPIOEvent& event)
+{
+	if (!m_has_events || m_line_fd < 0)
+	{
+		return false;
+	}
+
+	gpioevent_data data{};
+	if (read(m_line_fd, &data, sizeof(data)) != sizeof(data))
+	{
+		return false;
+	}
+
+	event.edge = data.id == GPIOEVENT_EVENT_RISING_EDGE ? GPIOEdge::RISING : GPIOEdge::FALLING;
+	event.timestamp_ns = data.timestamp;
+	return true;
+}
+
+void hal::utils::GPIOChardevLine::close() noexcept
+{
+	if (m_line_fd >= 0)
+	{
+		::close(m_line_fd);
+		m_line_fd = -1;
+	}
+}
+
+uint32_t hal::utils::GPIOChardevLine::wiring_pi_to_bcm(const int wiring_pi_pin)
+{
+	// Pin layout of the 40 pin header (board revision 2 and later).
+	static constexpr uint8_t WIRING_PI_TO_BCM[32] = {
+		17, 18, 27, 22, 23, 24, 25, 4, 2, 3, 8, 7, 10, 9, 11, 14,
+		15, 28, 29, 30, 31, 5, 6, 13, 19, 26, 12, 16, 20, 21, 0, 1
+	};
+
+	if (wiring_pi_pin < 0 || wiring_pi_pin >= 32)
+	{
+		throw exception::GPIOException("GPIOChardevLine", "wiring_pi_to_bcm", static_cast<uint8_t>(wiring_pi_pin),
+												"Pin number is not a valid wiringPi pin.");
+	}
+	return WIRING_PI_TO_BCM[wiring_pi_pin];
+}
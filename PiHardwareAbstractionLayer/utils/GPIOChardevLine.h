@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../enums/GPIOEdge.h"
+#include "../interfaces/IGPIOLine.h"
+
+#include <cstdint>
+#include <string>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Class that accesses a single GPIO line via the Linux GPIO character device.
+		/*!
+		* This class requests one line of a gpiochip (e.g. /dev/gpiochip0). If edge detection is requested
+		* the kernel timestamps every edge and queues it until it is read. The returned file descriptor can
+		* be watched with poll/epoll which avoids any polling of the pin state.
+		*/
+		class GPIOChardevLine final : public interfaces::IGPIOLine
+		{
+		public:
+			GPIOChardevLine() = delete;
+			GPIOChardevLine(const GPIOChardevLine&) = delete;
+			GPIOChardevLine(GPIOChardevLine&&) = delete;
+			GPIOChardevLine& operator=(const GPIOChardevLine&) = delete;
+			GPIOChardevLine& operator=(GPIOChardevLine&&) = delete;
+
+			//! Requests a GPIO line from the kernel.
+			/*!
+			* Requests a GPIO line from the kernel.
+			* \param[in] chip_path: The path of the gpiochip the line belongs to (e.g. /dev/gpiochip0).
+			* \param[in] line_offset: The offset of the line on the chip. On the Raspberry Pi this is the BCM number.
+			* \param[in] output: True to request the line as output, false to request it as input.
+			* \param[in] edge: The edges to report. Only used for input lines.
+			* \param[in] consumer: A label that is shown by tools like gpioinfo.
+			* \throws GPIOException if the gpiochip could not be opened.
+			* \throws GPIOException if the line could not be requested.
+			*/
+			GPIOChardevLine(const std::string& chip_path, uint32_t line_offset, bool output, GPIOEdge edge, const std::string& consumer);
+
+			~GPIOChardevLine();
+
+			/*!
+			* Returns the current logical value of the line.
+			* \returns 0 if the line is LOW, 1 if it is HIGH.
+			* \throws GPIOException if the value could not be read.
+			*/
+			int get_value() override;
+
+			/*!
+			* Sets the logical value of an output line.
+			* \param[in] value: 0 to drive the line LOW, any other value to drive it HIGH.
+			* \throws GPIOException if the value could not be written.
+			*/
+			void set_value(int value) override;
+
+			/*!
+			* Returns the file descriptor that becomes readable if an edge was detected.
+			* \returns the event file descriptor or -1 if the line was not requested with edge detection.
+			*/
+			int get_event_fd() const noexcept override;
+
+			/*!
+			* Reads the next pending edge event from the kernel queue.
+			* \param[out] event: The detected edge and its timestamp.
+			* \returns True if an event was read, false otherwise.
+			*/
+			bool read_event(GPIOEvent& event) override;
+
+			/*!
+			* Releases the line.
+			*/
+			void close() noexcept override;
+
+			//! Converts a wiringPi pin number to the BCM number of the Raspberry Pi.
+			/*!
+			* Converts a wiringPi pin number to the BCM number of the Raspberry Pi. The sensors of this project
+			* are configured with wiringPi numbers while the GPIO character device expects BCM line offsets.
+			* \param[in] wiring_pi_pin: The wiringPi pin number (0 - 31).
+			* \returns the BCM number of the pin.
+			* \throws GPIOException if the pin number is out of range.
+			*/
+			static uint32_t wiring_pi_to_bcm(int wiring_pi_pin);
+
+			/*! The default path of the gpiochip that holds the header pins of the Raspberry Pi. */
+			inline static std::string DEFAULT_PI_GPIO_CHIP_PATH = "/dev/gpiochip0";
+
+		private:
+			uint32_t m_line_offset;
+			bool m_has_events;
+			int m_line_fd = -1;
+		};
+	}
+}
@@ -0,0 +1,56 @@
+#include "GPIOFactory.h"
+
+#include "GPIOChardevLine.h"
+#include "GPIOSimulator.h"
+#include "WiringPiGPIOLine.h"
+
+#include <cstdlib>
+#include <iostream>
+
+void hal::utils::GPIOFactory::set_backend(const GPIOBackend backend) noexcept
+{
+	GPIOFactory::backend() = backend;
+}
+
+hal::GPIOBackend hal::utils::GPIOFactory::get_backend() noexcept
+{
+	return backend();
+}
+
+std::shared_ptr<hal::interfaces::IGPIOLine> hal::utils::GPIOFactory::open_line(const int wiring_pi_pin, const bool output, const GPIOEdge edge,
+																										  const std::string& consumer)
+{
+	switch (get_backend())
+	{
+	case GPIOBackend::WIRING_PI:
+		return std::make_shared<WiringPiGPIOLine>(wiring_pi_pin, output, edge);
+	case GPIOBackend::SIMULATED:
+		return GPIOSimulator::instance().get_line(wiring_pi_pin, output ? GPIOEdge::NONE : edge);
+	default:
+		return std::make_shared<GPIOChardevLine>(GPIOChardevLine::DEFAULT_PI_GPIO_CHIP_PATH, GPIOChardevLine::wiring_pi_to_bcm(wiring_pi_pin),
+															  output, edge, consumer);
+	}
+}
+
+std::atomic<hal::GPIOBackend>& hal::utils::GPIOFactory::backend() noexcept
+{
+	static std::atomic<GPIOBackend> backend([]()
+	{
+		const auto value = std::getenv(BACKEND_ENVIRONMENT_VARIABLE.c_str());
+		if (value == nullptr || std::string(value) == "chardev")
+		{
+			return GPIOBackend::CHARDEV;
+		}
+		if (std::string(value) == "wiringpi")
+		{
+			return GPIOBackend::WIRING_PI;
+		}
+		if (std::string(value) == "simulated")
+		{
+			return GPIOBackend::SIMULATED;
+		}
+		std::cerr << "GPIOFactory [backend] Unknown GPIO backend '" << value << "'. Using the GPIO character device." << std::endl;
+		return GPIOBackend::CHARDEV;
+	}());
+	return backend;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../enums/GPIOBackend.h"
+#include "../enums/GPIOEdge.h"
+#include "../interfaces/IGPIOLine.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Class that creates GPIO lines with the selected backend.
+		/*!
+		* Sensors request their GPIO lines via this class instead of creating a specific implementation. This way
+		* the same sensor code runs on the Linux GPIO character device, on wiringPi or against the in-process
+		* \sa { HAL::Utils::GPIOSimulator }. The backend defaults to CHARDEV and can be changed by code or by the
+		* environment variable HAL_GPIO_BACKEND ("chardev", "wiringpi" or "simulated") before the first line is opened.
+		*/
+		class GPIOFactory
+		{
+		public:
+			GPIOFactory() = delete;
+			GPIOFactory(const GPIOFactory&) = delete;
+			GPIOFactory(GPIOFactory&&) = delete;
+			GPIOFactory& operator=(const GPIOFactory&) = delete;
+			GPIOFactory& operator=(GPIOFactory&&) = delete;
+
+			//! Selects the backend for lines that are opened afterwards.
+			/*!
+			* Selects the backend for lines that are opened afterwards. Lines that are already open keep their backend.
+			* \param[in] backend: The backend to use.
+			*/
+			static void set_backend(GPIOBackend backend) noexcept;
+
+			//! Returns the selected backend.
+			/*!
+			* Returns the selected backend.
+			* \returns the backend new lines are opened with.
+			*/
+			static GPIOBackend get_backend() noexcept;
+
+			//! Opens a GPIO line with the selected backend.
+			/*!
+			* Opens a GPIO line with the selected backend.
+			* \param[in] wiring_pi_pin: The GPIO pin to use. Use WiringPi simplified pin numbering (http://wiringpi.com/pins/).
+			* \param[in] output: True to request the line as output, false to request it as input.
+			* \param[in] edge: The edges to report. Only used for input lines.
+			* \param[in] consumer: A label that is shown by tools like gpioinfo. Only used by the CHARDEV backend.
+			* \returns the opened line.
+			* \throws GPIOException if the line could not be opened.
+			*/
+			static std::shared_ptr<interfaces::IGPIOLine> open_line(int wiring_pi_pin, bool output, GPIOEdge edge, const std::string& consumer);
+
+			/*! The environment variable that selects the initial backend. */
+			inline static const std::string BACKEND_ENVIRONMENT_VARIABLE = "HAL_GPIO_BACKEND";
+
+		private:
+			/*!
+			* Returns the selected backend. Initialized from the environment variable on first use.
+			* \returns the selected backend.
+			*/
+			static std::atomic<GPIOBackend>& backend() noexcept;
+		};
+	}
+}
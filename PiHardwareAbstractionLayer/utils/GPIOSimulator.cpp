@@ -0,0 +1,132 @@
+#include "GPIOSimulator.h"
+
+#include "../exceptions/HALException.h"
+
+#include <chrono>
+
+hal::utils::GPIOSimulator& hal::utils::GPIOSimulator::instance()
+{
+	static GPIOSimulator instance;
+	return instance;
+}
+
+hal::utils::GPIOSimulator::~GPIOSimulator()
+{
+	reset();
+}
+
+std::shared_ptr<hal::utils::FakeGPIOLine> hal::utils::GPIOSimulator::get_line(const int pin, const GPIOEdge edge, const int initial_value)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	auto& line = m_lines[pin];
+
+	// A closed line has no event descriptor anymore. Sensors that request the pin again get a new one.
+	if (line == nullptr || (edge != GPIOEdge::NONE && line->get_event_fd() < 0))
+	{
+		line = std::make_shared<FakeGPIOLine>(edge, initial_value);
+	}
+	return line;
+}
+
+void hal::utils::GPIOSimulator::set_level(const int pin, const int level)
+{
+	get_line(pin)->set_level(level);
+}
+
+int hal::utils::GPIOSimulator::get_level(const int pin)
+{
+	return get_line(pin)->get_value();
+}
+
+void hal::utils::GPIOSimulator::play(const int pin, const std::vector<WaveformStep>& waveform, const uint32_t repetitions)
+{
+	if (waveform.empty())
+	{
+		throw exception::HALException("GPIOSimulator", "play", "The waveform is empty.");
+	}
+
+	stop(pin);
+	auto line = get_line(pin);
+	auto player = std::make_shared<Player>();
+
+	std::lock_guard<std::mutex> guard(m_mutex);
+	player->thread = std::thread(&GPIOSimulator::run_waveform, line, waveform, repetitions, player);
+	m_players[pin] = player;
+}
+
+void hal::utils::GPIOSimulator::stop(const int pin) noexcept
+{
+	finish_player(pin, true);
+}
+
+void hal::utils::GPIOSimulator::wait(const int pin) noexcept
+{
+	finish_player(pin, false);
+}
+
+void hal::utils::GPIOSimulator::reset() noexcept
+{
+	std::vector<int> pins;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		for (const auto& player : m_players)
+		{
+			pins.push_back(player.first);
+		}
+	}
+
+	for (const auto pin : pins)
+	{
+		stop(pin);
+	}
+
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_lines.clear();
+}
+
+void hal::utils::GPIOSimulator::run_waveform(const std::shared_ptr<FakeGPIOLine> line, const std::vector<WaveformStep> waveform,
+															const uint32_t repetitions, const std::shared_ptr<Player> player) noexcept
+{
+	auto next_step = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; repetitions == 0 || i < repetitions; i++)
+	{
+		for (const auto& step : waveform)
+		{
+			next_step += std::chrono::microseconds(step.delay_in_us);
+			{
+				std::unique_lock<std::mutex> lock(player->mutex);
+				if (player->cv.wait_until(lock, next_step, [&player]() { return player->stop_requested; }))
+				{
+					return;
+				}
+			}
+			line->set_level(step.level);
+		}
+	}
+}
+
+void hal::utils::GPIOSimulator::finish_player(const int pin, const bool stop_playing) noexcept
+{
+	std::shared_ptr<Player> player;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		const auto iterator = m_players.find(pin);
+		if (iterator == m_players.end())
+		{
+			return;
+		}
+		player = iterator->second;
+		m_players.erase(iterator);
+	}
+
+	if (stop_playing)
+	{
+		std::lock_guard<std::mutex> guard(player->mutex);
+		player->stop_requested = true;
+		player->cv.notify_all();
+	}
+	if (player->thread.joinable())
+	{
+		player->thread.join();
+	}
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "FakeGPIOLine.h"
+#include "../enums/GPIOEdge.h"
+#include "../structs/WaveformStep.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Class that simulates the GPIO pins of the Raspberry Pi in process.
+		/*!
+		* This class owns one \sa { HAL::Utils::FakeGPIOLine } per (wiringPi) pin number. \sa { HAL::Utils::GPIOFactory }
+		* hands these lines to the sensors if the SIMULATED backend is selected, so the interrupt driven code paths
+		* run unchanged on a machine without GPIO hardware. Input levels can be set directly or played as scripted
+		* waveforms with microsecond delays; each waveform runs on a thread of its own and every level change becomes
+		* an edge event with a CLOCK_MONOTONIC timestamp, which allows to time the handling latency of the sensors.
+		*/
+		class GPIOSimulator
+		{
+		public:
+			/*!
+			* Access the singleton instance of this class.
+			* \returns the singleton instance of this class.
+			*/
+			static GPIOSimulator& instance();
+
+			GPIOSimulator(const GPIOSimulator&) = delete;
+			GPIOSimulator(GPIOSimulator&&) = delete;
+			GPIOSimulator& operator=(const GPIOSimulator&) = delete;
+			GPIOSimulator& operator=(GPIOSimulator&&) = delete;
+
+			//! Returns the line of a pin.
+			/*!
+			* Returns the line of a pin. The line is created if the pin was not used yet or its line was closed.
+			* An existing line keeps its edges and level, so tests can prepare a pin before a sensor requests it.
+			* \param[in] pin: The wiringPi pin number.
+			* \param[in] edge: The edges the line reports if it is created.
+			* \param[in] initial_value: The level of the line if it is created.
+			* \returns the line of the pin.
+			* \throws GPIOException if the line could not be created.
+			*/
+			std::shared_ptr<FakeGPIOLine> get_line(int pin, GPIOEdge edge = GPIOEdge::BOTH, int initial_value = 0);
+
+			//! Changes the level of a pin.
+			/*!
+			* Changes the level of a pin. Queues an edge event if the level changed.
+			* \param[in] pin: The wiringPi pin number.
+			* \param[in] level: 0 for LOW, any other value for HIGH.
+			* \throws GPIOException if the line of the pin could not be created.
+			*/
+			void set_level(int pin, int level);
+
+			//! Returns the level of a pin.
+			/*!
+			* Returns the level of a pin. For output pins this is the level the sensor wrote last.
+			* \param[in] pin: The wiringPi pin number.
+			* \returns 0 if the pin is LOW, 1 if it is HIGH.
+			* \throws GPIOException if the line of the pin could not be created.
+			*/
+			int get_level(int pin);
+
+			//! Plays a waveform on a pin.
+			/*!
+			* Plays a waveform on a pin on a thread of its own. A waveform that is still playing on the pin is stopped first.
+			* The delays of the steps add up from the start, so the timing does not drift if setting a level takes longer.
+			* \param[in] pin: The wiringPi pin number.
+			* \param[in] waveform: The level changes to play.
+			* \param[in] repetitions: How often the waveform is played. 0 repeats it until <stop>"()" is called.
+			* \throws HALException if the waveform is empty.
+			* \throws GPIOException if the line of the pin could not be created.
+			*/
+			void play(int pin, const std::vector<WaveformStep>& waveform, uint32_t repetitions = 1);
+
+			//! Stops the waveform of a pin.
+			/*!
+			* Stops the waveform of a pin and waits for its thread. The pin keeps its current level.
+			* \param[in] pin: The wiringPi pin number.
+			*/
+			void stop(int pin) noexcept;
+
+			//! Waits until the waveform of a pin was played completely.
+			/*!
+			* Waits until the waveform of a pin was played completely. Returns immediately if no waveform is playing.
+			* Never returns for waveforms that repeat until they are stopped.
+			* \param[in] pin: The wiringPi pin number.
+			*/
+			void wait(int pin) noexcept;
+
+			//! Stops all waveforms and forgets all lines.
+			/*!
+			* Stops all waveforms and forgets all lines. Lines that are still used by sensors keep working but are not
+			* driven by the simulator anymore.
+			*/
+			void reset() noexcept;
+
+		private:
+			GPIOSimulator() = default;
+
+			~GPIOSimulator();
+
+			//! State of a waveform that is played on a thread.
+			struct Player
+			{
+				std::thread thread{};
+				std::mutex mutex{};
+				std::condition_variable cv{};
+				bool stop_requested{};
+			};
+
+			/*!
+			* Plays a waveform. Executed on the thread of the player.
+			* \param[in] line: The line to drive.
+			* \param[in] waveform: The level changes to play.
+			* \param[in] repetitions: How often the waveform is played. 0 repeats it until the player is stopped.
+			* \param[in] player: The player that owns the thread.
+			*/
+			static void run_waveform(std::shared_ptr<FakeGPIOLine> line, std::vector<WaveformStep> waveform, uint32_t repetitions,
+											 std::shared_ptr<Player> player) noexcept;
+
+			/*!
+			* Removes the player of a pin and waits for its thread.
+			* \param[in] pin: The wiringPi pin number.
+			* \param[in] stop_playing: True to stop the waveform, false to wait until it was played completely.
+			*/
+			void finish_player(int pin, bool stop_playing) noexcept;
+
+			std::mutex m_mutex{};
+			std::map<int, std::shared_ptr<FakeGPIOLine>> m_lines{};
+			std::map<int, std::shared_ptr<Player>> m_players{};
+		};
+	}
+}
@@ -0,0 +1,41 @@
+#include "I2CDevTransport.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+
+int hal::utils::I2CDevTransport::open_device(const std::string& path, const uint8_t address)
+{
+	const auto handle = ::open(path.c_str(), O_RDWR);
+	if (handle < 0)
+	{
+		return -1;
+	}
+
+	if (ioctl(handle, I2C_SLAVE, address) < 0)
+	{
+		// Keeps the errno of ioctl for the caller
+		const auto error = errno;
+		::close(handle);
+		errno = error;
+		return -1;
+	}
+	return handle;
+}
+
+int hal::utils::I2CDevTransport::close_device(const int handle)
+{
+	return ::close(handle);
+}
+
+ssize_t hal::utils::I2CDevTransport::write(const int handle, const uint8_t* data, const size_t length)
+{
+	return ::write(handle, data, length);
+}
+
+ssize_t hal::utils::I2CDevTransport::read(const int handle, uint8_t* data, const size_t length)
+{
+	return ::read(handle, data, length);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../interfaces/II2CTransport.h"
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Transport that talks to the i2c bus via the Linux i2c-dev interface.
+		/*!
+		* Transport that talks to the i2c bus via the Linux i2c-dev interface. Each handle is a file descriptor of the bus
+		* that was bound to one device address with ioctl(I2C_SLAVE). This is the default transport of \sa { HAL::Utils::I2CManager }.
+		*/
+		class I2CDevTransport final : public interfaces::II2CTransport
+		{
+		public:
+			I2CDevTransport() = default;
+			~I2CDevTransport() override = default;
+			I2CDevTransport(const I2CDevTransport&) = delete;
+			I2CDevTransport(I2CDevTransport&&) = delete;
+			I2CDevTransport& operator=(const I2CDevTransport&) = delete;
+			I2CDevTransport& operator=(I2CDevTransport&&) = delete;
+
+			int open_device(const std::string& path, uint8_t address) override;
+
+			int close_device(int handle) override;
+
+			ssize_t write(int handle, const uint8_t* data, size_t length) override;
+
+			ssize_t read(int handle, uint8_t* data, size_t length) override;
+		};
+	}
+}
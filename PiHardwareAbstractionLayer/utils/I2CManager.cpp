@@ -1,39 +1,32 @@
 #include "I2CManager.h"
+#include "I2CDevTransport.h"
+#include "I2CRecorder.h"
+#include "I2CReplayer.h"
+#include "I2CSimulator.h"
 #include <cerrno>
 #include <cstdio>
 #include <iostream>
 #include <cstdlib>
-#include <unistd.h>
-#include <fcntl.h>
 #include <cstring>
-#include <sys/stat.h>
-#include <sys/ioctl.h>
-#include <sys/types.h>
-#include <linux/i2c-dev.h>
 
 #include "../exceptions/HALException.h"
 #include "../exceptions/I2CException.h"
 
 void hal::utils::I2CManager::open_device(const std::string path, const uint8_t address, int& handle)
 {
-	handle = open(path.c_str(), O_RDWR);
+	handle = get_transport()->open_device(path, address);
 
 	if (!device_open(handle))
 	{
 		throw exception::HALException("I2CManager", "open_device", std::string("Could not load I2C-Module! '")
 																						.append(path).append("': ").append(strerror(errno)));
 	}
-
-	if (ioctl(handle, I2C_SLAVE, address) < 0)
-	{
-		throw exception::I2CException("I2CManager", "open_device", static_cast<uint8_t>(handle), address,
-												std::string("ioctl error: ").append(strerror(errno)));
-	}
+	register_metrics(handle, address);
 }
 
 void hal::utils::I2CManager::close_device(int& handle)
 {
-	if (device_open(handle) && close(handle) < 0)
+	if (device_open(handle) && get_transport()->close_device(handle) < 0)
 	{
 		throw exception::HALException("I2CManager", "close_device",
 												std::string("Could not close device #").append(std::to_string(handle)).append("."));
@@ -55,56 +48,243 @@ void hal::utils::I2CManager::read_from_device_sp(
 }
 
 void hal::utils::I2CManager::read_from_device(const int handle, const uint8_t address, uint8_t* data, const uint16_t length)
+{
+	try_read_from_device(handle, address, data, length).or_raise();
+}
+
+void hal::utils::I2CManager::write_to_device_sp(
+	const int handle,
+	const uint8_t address,
+	const std::unique_ptr<uint8_t[]>& data,
+	const uint16_t length)
+{
+	write_to_device(handle, address, data.get(), length);
+}
+
+void hal::utils::I2CManager::write_to_device(const int handle, const uint8_t address, const uint8_t* data, const uint16_t length)
+{
+	try_write_to_device(handle, address, data, length).or_raise();
+}
+
+hal::utils::Result<void> hal::utils::I2CManager::try_read_from_device(const int handle, const uint8_t address, uint8_t* data,
+																							 const uint16_t length) noexcept
 {
 	if (!device_open(handle))
 	{
-		throw exception::HALException("I2CManager", "read_from_device",
-												std::string("Device #").append(std::to_string(handle)).append(" is not open."));
+		return Error{ErrorCode::DEVICE_NOT_OPEN, 0, static_cast<uint8_t>(handle), address, "I2CManager", "read_from_device"};
 	}
 
+	const auto transport = get_transport();
+	const auto start = std::chrono::steady_clock::now();
 	data[0] = address;
-	if (write(handle, data, 1) != 1)
+	if (transport->write(handle, data, 1) != 1)
 	{
-		throw exception::I2CException("I2CManager", "read_from_device", static_cast<uint8_t>(handle), address,
-												std::string("Could not get to read position. Error: ")
-												.append(strerror(errno)));
+		const auto error = errno;
+		record_transfer(handle, I2COperation::READ, start, true);
+		return Error{ErrorCode::WRITE_FAILED, error, static_cast<uint8_t>(handle), address, "I2CManager", "read_from_device"};
 	}
-	if (read(handle, data, length) < 0)
+	if (transport->read(handle, data, length) < 0)
 	{
-		throw exception::I2CException("I2CManager", "read_from_device", static_cast<uint8_t>(handle), address, std::string("Could not read ")
-																																				.append(std::to_string(length)).
-																																				append(
-																																					" bytes. Error: ").append(
-																																					strerror(errno)));
+		const auto error = errno;
+		record_transfer(handle, I2COperation::READ, start, true);
+		return Error{ErrorCode::READ_FAILED, error, static_cast<uint8_t>(handle), address, "I2CManager", "read_from_device"};
 	}
+	record_transfer(handle, I2COperation::READ, start, false);
+	return {};
 }
 
-void hal::utils::I2CManager::write_to_device_sp(
-	const int handle,
-	const uint8_t address,
-	const std::unique_ptr<uint8_t[]>& data,
-	const uint16_t length)
+hal::utils::Result<void> hal::utils::I2CManager::try_write_to_device(const int handle, const uint8_t address, const uint8_t* data,
+																							const uint16_t length) noexcept
 {
-	write_to_device(handle, address, data.get(), length);
+	if (!device_open(handle))
+	{
+		return Error{ErrorCode::DEVICE_NOT_OPEN, 0, static_cast<uint8_t>(handle), address, "I2CManager", "write_to_device"};
+	}
+
+	// The register address and the data are sent in one transaction. Register writes are short, so the
+	// buffer lives on the stack.
+	uint8_t buffer[MAX_WRITE_LENGTH + 1];
+	if (length > MAX_WRITE_LENGTH)
+	{
+		return Error{ErrorCode::INVALID_ARGUMENT, 0, static_cast<uint8_t>(handle), address, "I2CManager", "write_to_device"};
+	}
+	buffer[0] = address;
+	memcpy(buffer + 1, data, length);
+	const auto transport = get_transport();
+	const auto start = std::chrono::steady_clock::now();
+	if (transport->write(handle, buffer, length + 1) < length)
+	{
+		const auto error = errno;
+		record_transfer(handle, I2COperation::WRITE, start, true);
+		return Error{ErrorCode::WRITE_FAILED, error, static_cast<uint8_t>(handle), address, "I2CManager", "write_to_device"};
+	}
+	record_transfer(handle, I2COperation::WRITE, start, false);
+	return {};
 }
 
-void hal::utils::I2CManager::write_to_device(const int handle, const uint8_t address, const uint8_t* data, const uint16_t length)
+uint64_t hal::utils::I2CManager::get_failure_count() noexcept
 {
-	if (!device_open(handle))
+	return m_failure_count;
+}
+
+void hal::utils::I2CManager::reset_failure_count() noexcept
+{
+	m_failure_count = 0;
+}
+
+ssize_t hal::utils::I2CManager::write_raw(const int handle, const uint8_t* data, const uint16_t length)
+{
+	const auto transport = get_transport();
+	const auto start = std::chrono::steady_clock::now();
+	const auto result = transport->write(handle, data, length);
+	const auto error = errno;
+	record_transfer(handle, I2COperation::WRITE, start, result != length);
+	errno = error;
+	return result;
+}
+
+ssize_t hal::utils::I2CManager::read_raw(const int handle, uint8_t* data, const uint16_t length)
+{
+	const auto transport = get_transport();
+	const auto start = std::chrono::steady_clock::now();
+	const auto result = transport->read(handle, data, length);
+	const auto error = errno;
+	record_transfer(handle, I2COperation::READ, start, result != length);
+	errno = error;
+	return result;
+}
+
+void hal::utils::I2CManager::set_transport(const std::shared_ptr<interfaces::II2CTransport>& transport)
+{
+	std::lock_guard<std::mutex> guard(m_transport_mutex);
+	I2CManager::transport() = transport;
+}
+
+std::shared_ptr<hal::interfaces::II2CTransport> hal::utils::I2CManager::get_transport()
+{
+	std::lock_guard<std::mutex> guard(m_transport_mutex);
+	return transport();
+}
+
+void hal::utils::I2CManager::start_recording(const std::string& path)
+{
+	std::lock_guard<std::mutex> guard(m_transport_mutex);
+	auto& current = transport();
+	const auto recorder = std::dynamic_pointer_cast<I2CRecorder>(current);
+	current = std::make_shared<I2CRecorder>(recorder != nullptr ? recorder->get_transport() : current, path);
+}
+
+void hal::utils::I2CManager::stop_recording()
+{
+	std::lock_guard<std::mutex> guard(m_transport_mutex);
+	auto& current = transport();
+	const auto recorder = std::dynamic_pointer_cast<I2CRecorder>(current);
+	if (recorder != nullptr)
+	{
+		current = recorder->get_transport();
+	}
+}
+
+void hal::utils::I2CManager::register_metrics(const int handle, const uint8_t address)
+{
+	if (handle >= MAX_METRIC_HANDLES)
+	{
+		return;
+	}
+
+	auto& registry = MetricsRegistry::instance();
+	auto& metrics = m_device_metrics[handle];
+	metrics.address = address;
+	metrics.read_latency = &registry.histogram("i2c.read_latency_ns", address);
+	metrics.write_latency = &registry.histogram("i2c.write_latency_ns", address);
+	metrics.read_errors = &registry.counter("i2c.read_errors", address);
+	metrics.write_errors = &registry.counter("i2c.write_errors", address);
+}
+
+void hal::utils::I2CManager::record_transfer(const int handle, const I2COperation operation,
+															const std::chrono::steady_clock::time_point start, const bool failed) noexcept
+{
+	if (failed)
+	{
+		++m_failure_count;
+	}
+	if (handle <= 0 || handle >= MAX_METRIC_HANDLES || m_device_metrics[handle].read_latency == nullptr)
+	{
+		return;
+	}
+
+	const auto& metrics = m_device_metrics[handle];
+	const auto end = std::chrono::steady_clock::now();
+	const auto duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	if (operation == I2COperation::READ)
+	{
+		metrics.read_latency->record(duration);
+		if (failed)
+		{
+			metrics.read_errors->add();
+		}
+		Tracer::record("i2c.read", "i2c", metrics.address, start, end);
+	}
+	else
+	{
+		metrics.write_latency->record(duration);
+		if (failed)
+		{
+			metrics.write_errors->add();
+		}
+		Tracer::record("i2c.write", "i2c", metrics.address, start, end);
+	}
+}
+
+std::shared_ptr<hal::interfaces::II2CTransport>& hal::utils::I2CManager::transport()
+{
+	static std::shared_ptr<interfaces::II2CTransport> transport(create_transport());
+	return transport;
+}
+
+std::shared_ptr<hal::interfaces::II2CTransport> hal::utils::I2CManager::create_transport()
+{
+	std::shared_ptr<interfaces::II2CTransport> transport;
+	const auto value = std::getenv(TRANSPORT_ENVIRONMENT_VARIABLE.c_str());
+	if (value == nullptr || std::string(value) == "i2c-dev")
+	{
+		transport = std::make_shared<I2CDevTransport>();
+	}
+	else if (std::string(value) == "simulated")
+	{
+		transport = I2CSimulator::create_default();
+	}
+	else if (std::string(value) == "replay")
+	{
+		const auto file = std::getenv(REPLAY_FILE_ENVIRONMENT_VARIABLE.c_str());
+		const auto speed = std::getenv(REPLAY_SPEED_ENVIRONMENT_VARIABLE.c_str());
+		try
+		{
+			transport = std::make_shared<I2CReplayer>(file != nullptr ? file : "", speed != nullptr ? std::atof(speed) : 1.0);
+		}
+		catch (exception::HALException& ex)
+		{
+			std::cerr << "I2CManager [create_transport] Could not load the replay log. Using the i2c-dev interface:\n" << ex.to_string() << std::endl;
+			transport = std::make_shared<I2CDevTransport>();
+		}
+	}
+	else
 	{
-		throw exception::HALException("I2CManager", "write_to_device",
-												std::string("Device #").append(std::to_string(handle)).append(" is not open."));
+		std::cerr << "I2CManager [create_transport] Unknown I2C backend '" << value << "'. Using the i2c-dev interface." << std::endl;
+		transport = std::make_shared<I2CDevTransport>();
 	}
 
-	const auto buf = static_cast<int8_t*>(malloc(length + 1));
-	buf[0] = address;
-	memcpy(buf + 1, data, length);
-	if (write(handle, buf, length + 1) < length)
+	const auto record_file = std::getenv(RECORD_FILE_ENVIRONMENT_VARIABLE.c_str());
+	if (record_file != nullptr)
 	{
-		throw exception::I2CException("I2CManager", "write_to_device", static_cast<uint8_t>(handle), address,
-												std::string("Could not write data of length '")
-												.append(std::to_string(length)).append("'. Error: ").
-												append(strerror(errno)));
+		try
+		{
+			transport = std::make_shared<I2CRecorder>(transport, record_file);
+		}
+		catch (exception::HALException& ex)
+		{
+			std::cerr << "I2CManager [create_transport] Could not start recording:\n" << ex.to_string() << std::endl;
+		}
 	}
-	free(buf);
+	return transport;
 }
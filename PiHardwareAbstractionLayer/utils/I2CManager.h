@@ -1,8 +1,18 @@
 #pragma once
 
+#include "Metrics.h"
+#include "Result.h"
+#include "Tracer.h"
+#include "../enums/I2COperation.h"
+#include "../interfaces/II2CTransport.h"
+
+#include <atomic>
 #include <bitset>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <sys/types.h>
 
 namespace hal
 {
@@ -10,7 +20,12 @@ namespace hal
 	{
 		//! Class that allows communication over the i2c bus.
 		/*!
-		* This class implements various functions to communicate via the i2c bus.
+		* This class implements various functions to communicate via the i2c bus. The bytes are transferred by an
+		* \sa { HAL::Interfaces::II2CTransport }: by default the Linux i2c-dev interface, optionally the in-process
+		* \sa { HAL::Utils::I2CSimulator } or the \sa { HAL::Utils::I2CReplayer } of a recorded log. The transport can be
+		* changed by code or by the environment variable HAL_I2C_BACKEND ("i2c-dev", "simulated" or "replay" with the log in
+		* HAL_I2C_REPLAY_FILE and the speed in HAL_I2C_REPLAY_SPEED) before the first device is opened. If HAL_I2C_RECORD_FILE
+		* is set, all transactions are recorded into this file.
 		*/
 		class I2CManager
 		{
@@ -30,7 +45,6 @@ namespace hal
 			* \param[out] handle: The handle that will be used to communicate over the i2c bus.
 			* \returns 0 if opening the connection was successful, a negative error value otherwise.
 			* \throws HALException if the device could not be opened.
-			* \throws I2CException if calling ioctl failed.
 			*/
 			static void open_device(std::string path, uint8_t address, int& handle);
 
@@ -104,8 +118,158 @@ namespace hal
 			*/
 			static void write_to_device(int handle, uint8_t address, const uint8_t* data, uint16_t length);
 
+			//! Reads content from the given address to the buffer without throwing.
+			/*!
+			*  Like <read_from_device>"()", but reports failures with the returned result instead of an exception.
+			*  Use this on the acquisition path, where a transient bus error must not unwind the stack.
+			* \param[in] handle: The handle that will be used to communicate over the i2c bus.
+			* \param[in] address: The file address to read from.
+			* \param[out] data: The buffer to which the file content will be read.
+			* \param[in] length: The number of bytes to read.
+			* \returns the result of the transfer.
+			*/
+			static Result<void> try_read_from_device(int handle, uint8_t address, uint8_t* data, uint16_t length) noexcept;
+
+			//! Writes content to the given address from a buffer without throwing.
+			/*!
+			*  Like <write_to_device>"()", but reports failures with the returned result instead of an exception.
+			* \param[in] handle: The handle that will be used to communicate over the i2c bus.
+			* \param[in] address: The file address to write to.
+			* \param[in] data: The buffer containing the content to write.
+			* \param[in] length: The number of bytes to write.
+			* \returns the result of the transfer.
+			*/
+			static Result<void> try_write_to_device(int handle, uint8_t address, const uint8_t* data, uint16_t length) noexcept;
+
+			//! Returns the number of failed transfers.
+			/*!
+			*  Returns the number of read and write transfers of all devices that failed since the start of the
+			*  process or the last <reset_failure_count>"()".
+			* \returns the number of failed transfers.
+			*/
+			static uint64_t get_failure_count() noexcept;
+
+			//! Resets the number of failed transfers.
+			static void reset_failure_count() noexcept;
+
+			//! Writes raw bytes to the device.
+			/*!
+			*  Writes raw bytes to the device in one transaction, e.g. only a register address to select the register
+			*  that following <read_raw>"()" calls read from.
+			* \param[in] handle: The handle that will be used to communicate over the i2c bus.
+			* \param[in] data: The bytes to write.
+			* \param[in] length: The number of bytes to write.
+			* \returns the number of written bytes or -1 with errno set.
+			*/
+			static ssize_t write_raw(int handle, const uint8_t* data, uint16_t length);
+
+			//! Reads raw bytes from the device.
+			/*!
+			*  Reads raw bytes from the current register of the device in one transaction.
+			* \param[in] handle: The handle that will be used to communicate over the i2c bus.
+			* \param[out] data: The buffer to which the bytes will be read.
+			* \param[in] length: The number of bytes to read.
+			* \returns the number of read bytes or -1 with errno set.
+			*/
+			static ssize_t read_raw(int handle, uint8_t* data, uint16_t length);
+
+			//! Replaces the transport.
+			/*!
+			*  Replaces the transport for all following calls. Handles that were opened with the previous transport
+			*  become invalid, so the transport has to be selected before the sensors are initialized.
+			* \param[in] transport: The new transport.
+			*/
+			static void set_transport(const std::shared_ptr<interfaces::II2CTransport>& transport);
+
+			//! Returns the transport.
+			/*!
+			*  Returns the transport. Initialized from the environment variable on first use.
+			* \returns the transport that transfers the bytes.
+			*/
+			static std::shared_ptr<interfaces::II2CTransport> get_transport();
+
+			//! Starts recording all transactions.
+			/*!
+			*  Starts recording all transactions of the current transport into a log (see \sa { HAL::Utils::I2CRecorder }).
+			*  Devices should be opened after the recording started, otherwise their transactions are recorded without address.
+			* \param[in] path: The path of the log file.
+			* \throws HALException if the log file could not be opened.
+			*/
+			static void start_recording(const std::string& path);
+
+			//! Stops recording the transactions.
+			/*!
+			*  Stops recording the transactions and writes the remaining records to the log. Open handles stay valid.
+			*/
+			static void stop_recording();
+
+			/*! The environment variable that selects the initial transport. */
+			inline static const std::string TRANSPORT_ENVIRONMENT_VARIABLE = "HAL_I2C_BACKEND";
+
+			/*! The environment variable that contains the log the "replay" transport replays. */
+			inline static const std::string REPLAY_FILE_ENVIRONMENT_VARIABLE = "HAL_I2C_REPLAY_FILE";
+
+			/*! The environment variable that contains the speed of the "replay" transport (default 1, 0 = as fast as possible). */
+			inline static const std::string REPLAY_SPEED_ENVIRONMENT_VARIABLE = "HAL_I2C_REPLAY_SPEED";
+
+			/*! The environment variable that contains the log all transactions are recorded into. */
+			inline static const std::string RECORD_FILE_ENVIRONMENT_VARIABLE = "HAL_I2C_RECORD_FILE";
+
 			/*! The default path for i2c device registers. */
 			inline static std::string DEFAULT_PI_I2C_PATH = "/dev/i2c-1";
+
+			/*! The maximum number of data bytes of a single register write. */
+			static constexpr uint16_t MAX_WRITE_LENGTH = 64;
+
+			/*! Transfers of handles below this value are recorded in the \sa { HAL::Utils::MetricsRegistry }. */
+			static constexpr int MAX_METRIC_HANDLES = 256;
+
+		private:
+			/*!
+			* Returns the transport variable. Initialized from the environment variable on first use.
+			* \returns the transport variable.
+			*/
+			static std::shared_ptr<interfaces::II2CTransport>& transport();
+
+			/*!
+			* Creates the initial transport from the environment variables.
+			* \returns the initial transport.
+			*/
+			static std::shared_ptr<interfaces::II2CTransport> create_transport();
+
+			/*!
+			* The metrics of the device behind one handle. The pointers are null (static storage) if the handle was not opened.
+			*/
+			struct DeviceMetrics
+			{
+				uint8_t address;
+				Histogram* read_latency;
+				Histogram* write_latency;
+				Counter* read_errors;
+				Counter* write_errors;
+			};
+
+			/*!
+			* Registers the metrics of a newly opened device ("i2c.read_latency_ns", "i2c.write_latency_ns",
+			* "i2c.read_errors" and "i2c.write_errors" with the i2c address of the device).
+			* \param[in] handle: The handle of the device.
+			* \param[in] address: The i2c address of the device.
+			*/
+			static void register_metrics(int handle, uint8_t address);
+
+			/*!
+			* Records the duration and the outcome of a transfer in the metrics of the device and traces it as
+			* "i2c.read" or "i2c.write".
+			* \param[in] handle: The handle of the device.
+			* \param[in] operation: READ or WRITE.
+			* \param[in] start: The point of time the transfer started.
+			* \param[in] failed: True if the transfer failed, false otherwise.
+			*/
+			static void record_transfer(int handle, I2COperation operation, std::chrono::steady_clock::time_point start, bool failed) noexcept;
+
+			inline static std::mutex m_transport_mutex{};
+			inline static DeviceMetrics m_device_metrics[MAX_METRIC_HANDLES]{};
+			inline static std::atomic_uint64_t m_failure_count = ATOMIC_VAR_INIT(0);
 		};
 	}
 }
@@ -0,0 +1,172 @@
+#include "I2CRecorder.h"
+#include "../exceptions/HALException.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+
+namespace
+{
+	// The buffer is written to the log when it exceeds this size
+	constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+	void append_le(std::vector<uint8_t>& buffer, const uint64_t value, const size_t bytes)
+	{
+		for (size_t i = 0; i < bytes; i++)
+		{
+			buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+		}
+	}
+}
+
+hal::utils::I2CRecorder::I2CRecorder(std::shared_ptr<interfaces::II2CTransport> transport, const std::string& path)
+	: m_transport(std::move(transport)),
+		m_file(path, std::ios::binary | std::ios::trunc),
+		m_last_record(std::chrono::steady_clock::now())
+{
+	if (!m_file.is_open())
+	{
+		throw exception::HALException("I2CRecorder", "I2CRecorder", std::string("Could not open the log file '").append(path).append("'."));
+	}
+
+	m_buffer.reserve(BUFFER_SIZE + RECORD_HEADER_SIZE + UINT16_MAX);
+	m_buffer.insert(m_buffer.end(), std::begin(LOG_MAGIC), std::end(LOG_MAGIC));
+	append_le(m_buffer, LOG_VERSION, sizeof(LOG_VERSION));
+}
+
+hal::utils::I2CRecorder::~I2CRecorder()
+{
+	flush();
+}
+
+int hal::utils::I2CRecorder::open_device(const std::string& path, const uint8_t address)
+{
+	const auto handle = m_transport->open_device(path, address);
+	const auto error = errno;
+	if (handle > 0)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_handles[handle] = HandleState{address, 0};
+	}
+	record(I2COperation::OPEN, HandleState{address, 0}, handle, error, nullptr, 0);
+	errno = error;
+	return handle;
+}
+
+int hal::utils::I2CRecorder::close_device(const int handle)
+{
+	const auto state = get_state(handle);
+	const auto result = m_transport->close_device(handle);
+	const auto error = errno;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_handles.erase(handle);
+	}
+	record(I2COperation::CLOSE, state, result, error, nullptr, 0);
+	errno = error;
+	return result;
+}
+
+ssize_t hal::utils::I2CRecorder::write(const int handle, const uint8_t* data, const size_t length)
+{
+	const auto result = m_transport->write(handle, data, length);
+	const auto error = errno;
+	auto state = get_state(handle);
+	if (length > 0)
+	{
+		state.reg = data[0];
+		std::lock_guard<std::mutex> guard(m_mutex);
+		const auto known = m_handles.find(handle);
+		if (known != m_handles.end())
+		{
+			known->second.reg = data[0];
+		}
+	}
+	record(I2COperation::WRITE, state, static_cast<int32_t>(result), error, data, length);
+	errno = error;
+	return result;
+}
+
+ssize_t hal::utils::I2CRecorder::read(const int handle, uint8_t* data, const size_t length)
+{
+	const auto result = m_transport->read(handle, data, length);
+	const auto error = errno;
+	record(I2COperation::READ, get_state(handle), static_cast<int32_t>(result), error, data, result > 0 ? static_cast<size_t>(result) : 0);
+	errno = error;
+	return result;
+}
+
+void hal::utils::I2CRecorder::flush()
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	write_buffer();
+	m_file.flush();
+}
+
+std::shared_ptr<hal::interfaces::II2CTransport> hal::utils::I2CRecorder::get_transport() const noexcept
+{
+	return m_transport;
+}
+
+uint64_t hal::utils::I2CRecorder::get_recorded_transactions() const noexcept
+{
+	return m_recorded_transactions;
+}
+
+hal::utils::I2CRecorder::HandleState hal::utils::I2CRecorder::get_state(const int handle)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto known = m_handles.find(handle);
+	return known != m_handles.end() ? known->second : HandleState{};
+}
+
+void hal::utils::I2CRecorder::record(
+	const I2COperation operation,
+	const HandleState state,
+	const int32_t result,
+	const int error,
+	const uint8_t* data,
+	const size_t length)
+{
+	// Longer transfers are truncated, no driver transfers more than a few hundred bytes at once
+	const auto recorded_length = std::min<size_t>(length, UINT16_MAX);
+
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto now = std::chrono::steady_clock::now();
+	const auto elapsed_in_us = std::chrono::duration_cast<std::chrono::microseconds>(now - m_last_record).count();
+	m_last_record = now;
+
+	append_le(m_buffer, static_cast<uint64_t>(std::min<int64_t>(elapsed_in_us, UINT32_MAX)), 4);
+	m_buffer.push_back(static_cast<uint8_t>(operation));
+	m_buffer.push_back(state.address);
+	m_buffer.push_back(state.reg);
+	m_buffer.push_back(static_cast<uint8_t>(result < 0 ? error : 0));
+	append_le(m_buffer, static_cast<uint32_t>(result), 4);
+	append_le(m_buffer, recorded_length, 2);
+	if (recorded_length > 0)
+	{
+		m_buffer.insert(m_buffer.end(), data, data + recorded_length);
+	}
+	m_recorded_transactions++;
+
+	if (m_buffer.size() >= BUFFER_SIZE)
+	{
+		write_buffer();
+	}
+}
+
+void hal::utils::I2CRecorder::write_buffer()
+{
+	if (m_buffer.empty())
+	{
+		return;
+	}
+
+	m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+	if (!m_file)
+	{
+		std::cerr << "I2CRecorder [write_buffer] Could not write " << m_buffer.size() << " bytes to the log file." << std::endl;
+		m_file.clear();
+	}
+	m_buffer.clear();
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "../enums/I2COperation.h"
+#include "../interfaces/II2CTransport.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Transport that records the traffic of another transport into a binary log.
+		/*!
+		* Transport that forwards all calls to another transport and records each of them (time, address, register,
+		* bytes and result) into a binary log that \sa { HAL::Utils::I2CReplayer } feeds back to the drivers. The records
+		* are collected in memory and written in blocks, so recording adds no file access to most transactions.
+		*
+		* The log starts with the 6 byte magic "HALI2C" and a 16 bit version. Each record consists of a 14 byte header
+		* (32 bit microseconds since the previous record, operation, address, register, errno, 32 bit result, 16 bit data
+		* length) followed by the data bytes. All values are little endian.
+		*/
+		class I2CRecorder final : public interfaces::II2CTransport
+		{
+		public:
+			I2CRecorder() = delete;
+
+			/*!
+			* Constructor.
+			* \param[in] transport: The transport that transfers the bytes.
+			* \param[in] path: The path of the log file. An existing file is overwritten.
+			* \throws HALException if the log file could not be opened.
+			*/
+			I2CRecorder(std::shared_ptr<interfaces::II2CTransport> transport, const std::string& path);
+
+			/*!
+			* Destructor. Writes the remaining records to the log.
+			*/
+			~I2CRecorder() override;
+
+			I2CRecorder(const I2CRecorder&) = delete;
+			I2CRecorder(I2CRecorder&&) = delete;
+			I2CRecorder& operator=(const I2CRecorder&) = delete;
+			I2CRecorder& operator=(I2CRecorder&&) = delete;
+
+			int open_device(const std::string& path, uint8_t address) override;
+
+			int close_device(int handle) override;
+
+			ssize_t write(int handle, const uint8_t* data, size_t length) override;
+
+			ssize_t read(int handle, uint8_t* data, size_t length) override;
+
+			//! Writes the collected records to the log.
+			/*!
+			* Writes the collected records to the log, e.g. before a unit is expected to lose power.
+			*/
+			void flush();
+
+			//! Returns the transport that transfers the bytes.
+			/*!
+			* Returns the transport that transfers the bytes. Its handles stay valid when the recording stops.
+			* \returns the recorded transport.
+			*/
+			std::shared_ptr<interfaces::II2CTransport> get_transport() const noexcept;
+
+			//! Returns the number of recorded transactions.
+			/*!
+			* Returns the number of recorded calls.
+			* \returns the number of recorded calls.
+			*/
+			uint64_t get_recorded_transactions() const noexcept;
+
+			/*! The first bytes of every log. */
+			static constexpr char LOG_MAGIC[] = {'H', 'A', 'L', 'I', '2', 'C'};
+
+			/*! The version of the log format. */
+			static constexpr uint16_t LOG_VERSION = 1;
+
+			/*! The size of the log header in bytes. */
+			static constexpr size_t LOG_HEADER_SIZE = sizeof(LOG_MAGIC) + sizeof(LOG_VERSION);
+
+			/*! The size of a record header in bytes. */
+			static constexpr size_t RECORD_HEADER_SIZE = 14;
+
+		private:
+			/*! The device address and the last selected register of an open handle. */
+			struct HandleState
+			{
+				uint8_t address = 0;
+				uint8_t reg = 0;
+			};
+
+			/*!
+			* Returns the address and register of a handle. Unknown handles (opened before the recording started)
+			* are recorded with address 0.
+			* \param[in] handle: The handle of the call.
+			* \returns the address and register of the handle.
+			*/
+			HandleState get_state(int handle);
+
+			/*!
+			* Appends a record to the buffer and writes the buffer to the log if it is full.
+			* \param[in] operation: The kind of call.
+			* \param[in] state: The address and register of the call.
+			* \param[in] result: The return value of the call.
+			* \param[in] error: The errno of a failed call.
+			* \param[in] data: The transferred bytes.
+			* \param[in] length: The number of transferred bytes.
+			*/
+			void record(I2COperation operation, HandleState state, int32_t result, int error, const uint8_t* data, size_t length);
+
+			/*!
+			* Writes the buffer to the log. The mutex is locked by the caller.
+			*/
+			void write_buffer();
+
+			const std::shared_ptr<interfaces::II2CTransport> m_transport;
+			std::ofstream m_file{};
+			std::mutex m_mutex{};
+			std::vector<uint8_t> m_buffer{};
+			std::map<int, HandleState> m_handles{};
+			std::chrono::steady_clock::time_point m_last_record{};
+			std::atomic_uint64_t m_recorded_transactions = ATOMIC_VAR_INIT(0);
+		};
+	}
+}
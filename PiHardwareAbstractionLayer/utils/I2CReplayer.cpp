@@ -0,0 +1,302 @@
+#include "I2CReplayer.h"
+#include "I2CRecorder.h"
+#include "../exceptions/HALException.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+namespace
+{
+	uint64_t read_le(const std::vector<uint8_t>& buffer, const size_t position, const size_t bytes)
+	{
+		uint64_t value = 0;
+		for (size_t i = 0; i < bytes; i++)
+		{
+			value |= static_cast<uint64_t>(buffer[position + i]) << (8 * i);
+		}
+		return value;
+	}
+}
+
+hal::utils::I2CReplayer::I2CReplayer(const std::string& path, const double speed)
+	: m_transactions(load(path)),
+		m_speed(speed)
+{
+	for (size_t i = 0; i < m_transactions.size(); i++)
+	{
+		m_queues[m_transactions[i].address].push_back(i);
+	}
+}
+
+std::vector<hal::I2CTransaction> hal::utils::I2CReplayer::load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		throw exception::HALException("I2CReplayer", "load", std::string("Could not open the log file '").append(path).append("'."));
+	}
+	const std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	if (buffer.size() < I2CRecorder::LOG_HEADER_SIZE
+		|| !std::equal(std::begin(I2CRecorder::LOG_MAGIC), std::end(I2CRecorder::LOG_MAGIC), buffer.begin()))
+	{
+		throw exception::HALException("I2CReplayer", "load", std::string("'").append(path).append("' is no i2c traffic log."));
+	}
+	const auto version = read_le(buffer, sizeof(I2CRecorder::LOG_MAGIC), sizeof(I2CRecorder::LOG_VERSION));
+	if (version != I2CRecorder::LOG_VERSION)
+	{
+		throw exception::HALException("I2CReplayer", "load", std::string("Unsupported log version ").append(std::to_string(version)).append("."));
+	}
+
+	std::vector<I2CTransaction> transactions;
+	uint64_t timestamp_in_us = 0;
+	auto position = I2CRecorder::LOG_HEADER_SIZE;
+	while (position < buffer.size())
+	{
+		if (position + I2CRecorder::RECORD_HEADER_SIZE > buffer.size()
+			|| position + I2CRecorder::RECORD_HEADER_SIZE + read_le(buffer, position + 12, 2) > buffer.size())
+		{
+			// The unit lost power while writing the log
+			std::cerr << "I2CReplayer [load] '" << path << "' ends with an incomplete record. Ignoring it." << std::endl;
+			break;
+		}
+
+		I2CTransaction transaction;
+		timestamp_in_us += read_le(buffer, position, 4);
+		transaction.timestamp_in_us = timestamp_in_us;
+		transaction.operation = static_cast<I2COperation>(buffer[position + 4]);
+		transaction.address = buffer[position + 5];
+		transaction.reg = buffer[position + 6];
+		transaction.error = buffer[position + 7];
+		transaction.result = static_cast<int32_t>(read_le(buffer, position + 8, 4));
+		const auto length = read_le(buffer, position + 12, 2);
+		position += I2CRecorder::RECORD_HEADER_SIZE;
+		transaction.data.assign(buffer.begin() + position, buffer.begin() + position + length);
+		position += length;
+		transactions.push_back(std::move(transaction));
+	}
+	return transactions;
+}
+
+int hal::utils::I2CReplayer::open_device(const std::string&, const uint8_t address)
+{
+	const I2CTransaction* transaction;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		transaction = next(address, I2COperation::OPEN, 0);
+	}
+	if (transaction == nullptr)
+	{
+		errno = ENXIO;
+		return -1;
+	}
+
+	wait_for(*transaction);
+	if (transaction->result < 0)
+	{
+		return replay_result(*transaction);
+	}
+
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto handle = m_next_handle++;
+	m_handles[handle] = HandleState{address, 0};
+	return handle;
+}
+
+int hal::utils::I2CReplayer::close_device(const int handle)
+{
+	HandleState state;
+	const I2CTransaction* transaction;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		const auto known = m_handles.find(handle);
+		if (known == m_handles.end())
+		{
+			errno = EBADF;
+			return -1;
+		}
+		state = known->second;
+		m_handles.erase(known);
+		transaction = next(state.address, I2COperation::CLOSE, 0);
+	}
+
+	// Closing always succeeds, so shutting down does not depend on the log
+	if (transaction != nullptr)
+	{
+		wait_for(*transaction);
+	}
+	return 0;
+}
+
+ssize_t hal::utils::I2CReplayer::write(const int handle, const uint8_t* data, const size_t length)
+{
+	const I2CTransaction* transaction;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		const auto known = m_handles.find(handle);
+		if (known == m_handles.end())
+		{
+			errno = EBADF;
+			return -1;
+		}
+		if (length > 0)
+		{
+			known->second.reg = data[0];
+		}
+		transaction = next(known->second.address, I2COperation::WRITE, known->second.reg);
+	}
+	if (transaction == nullptr)
+	{
+		errno = ENXIO;
+		return -1;
+	}
+
+	if (transaction->data.size() != length || !std::equal(transaction->data.begin(), transaction->data.end(), data))
+	{
+		m_divergences++;
+	}
+	wait_for(*transaction);
+	return replay_result(*transaction);
+}
+
+ssize_t hal::utils::I2CReplayer::read(const int handle, uint8_t* data, const size_t length)
+{
+	const I2CTransaction* transaction;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		const auto known = m_handles.find(handle);
+		if (known == m_handles.end())
+		{
+			errno = EBADF;
+			return -1;
+		}
+		transaction = next(known->second.address, I2COperation::READ, known->second.reg);
+	}
+	if (transaction == nullptr)
+	{
+		errno = ENXIO;
+		return -1;
+	}
+
+	if (transaction->data.size() != length && transaction->result >= 0)
+	{
+		m_divergences++;
+	}
+	wait_for(*transaction);
+	const auto copied = std::min(length, transaction->data.size());
+	std::copy_n(transaction->data.begin(), copied, data);
+	return transaction->result >= 0 ? static_cast<ssize_t>(copied) : replay_result(*transaction);
+}
+
+void hal::utils::I2CReplayer::set_speed(const double speed) noexcept
+{
+	m_speed = speed;
+
+	// The following transactions are timed relative to the first one at the new speed
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_started = false;
+}
+
+void hal::utils::I2CReplayer::rewind()
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_positions.clear();
+	m_started = false;
+}
+
+uint64_t hal::utils::I2CReplayer::get_replayed_transactions() const noexcept
+{
+	return m_replayed_transactions;
+}
+
+uint64_t hal::utils::I2CReplayer::get_divergences() const noexcept
+{
+	return m_divergences;
+}
+
+bool hal::utils::I2CReplayer::finished()
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	for (const auto& queue : m_queues)
+	{
+		if (m_positions[queue.first] < queue.second.size())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+const hal::I2CTransaction* hal::utils::I2CReplayer::next(const uint8_t address, const I2COperation operation, const uint8_t reg)
+{
+	const auto queue = m_queues.find(address);
+	if (queue == m_queues.end())
+	{
+		m_divergences++;
+		return nullptr;
+	}
+
+	auto& position = m_positions[address];
+	for (auto index = position; index < queue->second.size(); index++)
+	{
+		const auto& transaction = m_transactions[queue->second[index]];
+		if (transaction.operation != operation || transaction.reg != reg)
+		{
+			continue;
+		}
+
+		if (index != position)
+		{
+			m_divergences++;
+			std::cerr << "I2CReplayer [next] Device 0x" << std::hex << static_cast<int>(address) << std::dec << " skipped "
+				<< index - position << " recorded transactions to find the requested one." << std::endl;
+		}
+		position = index + 1;
+
+		if (!m_started)
+		{
+			m_started = true;
+			m_start = std::chrono::steady_clock::now();
+			m_start_timestamp_in_us = transaction.timestamp_in_us;
+		}
+		m_replayed_transactions++;
+		return &transaction;
+	}
+
+	m_divergences++;
+	return nullptr;
+}
+
+void hal::utils::I2CReplayer::wait_for(const I2CTransaction& transaction)
+{
+	const double speed = m_speed;
+	if (speed <= 0)
+	{
+		return;
+	}
+
+	std::chrono::steady_clock::time_point target;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (transaction.timestamp_in_us <= m_start_timestamp_in_us)
+		{
+			return;
+		}
+		target = m_start + std::chrono::microseconds(static_cast<int64_t>((transaction.timestamp_in_us - m_start_timestamp_in_us) / speed));
+	}
+	std::this_thread::sleep_until(target);
+}
+
+int32_t hal::utils::I2CReplayer::replay_result(const I2CTransaction& transaction)
+{
+	if (transaction.result < 0)
+	{
+		errno = transaction.error != 0 ? transaction.error : EIO;
+	}
+	return transaction.result;
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "../interfaces/II2CTransport.h"
+#include "../structs/I2CTransaction.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Transport that answers the drivers with the transactions of a recorded log.
+		/*!
+		* Transport that feeds a log of \sa { HAL::Utils::I2CRecorder } back to the drivers, e.g. to reproduce the behaviour
+		* of a field unit or to benchmark driver and pipeline changes with the same input. The transactions are replayed per
+		* device address in the recorded order, so the interleaving of the sensor threads does not change the data a driver
+		* receives. Each call returns the recorded result, errno and read bytes at the recorded time divided by the speed,
+		* or immediately with speed 0.
+		*
+		* A call that does not match the next recorded transaction of its device (different operation or register)
+		* skips forward to the next matching one and counts a divergence. Written bytes that differ from the log are counted
+		* as a divergence as well, but the recorded result is returned. If no matching transaction is left, the device stops
+		* acknowledging (ENXIO).
+		*/
+		class I2CReplayer final : public interfaces::II2CTransport
+		{
+		public:
+			I2CReplayer() = delete;
+
+			/*!
+			* Constructor. Loads the complete log into memory.
+			* \param[in] path: The path of the log file.
+			* \param[in] speed: The replay speed (1 = recorded timing, 2 = twice as fast, 0 = as fast as possible).
+			* \throws HALException if the log could not be read.
+			*/
+			explicit I2CReplayer(const std::string& path, double speed = 1.0);
+
+			~I2CReplayer() override = default;
+			I2CReplayer(const I2CReplayer&) = delete;
+			I2CReplayer(I2CReplayer&&) = delete;
+			I2CReplayer& operator=(const I2CReplayer&) = delete;
+			I2CReplayer& operator=(I2CReplayer&&) = delete;
+
+			//! Reads a log.
+			/*!
+			* Reads all transactions of a log, e.g. to inspect the traffic of a field unit.
+			* \param[in] path: The path of the log file.
+			* \returns the transactions in the recorded order.
+			* \throws HALException if the file could not be opened or is no valid log.
+			*/
+			static std::vector<I2CTransaction> load(const std::string& path);
+
+			int open_device(const std::string& path, uint8_t address) override;
+
+			int close_device(int handle) override;
+
+			ssize_t write(int handle, const uint8_t* data, size_t length) override;
+
+			ssize_t read(int handle, uint8_t* data, size_t length) override;
+
+			//! Changes the replay speed.
+			/*!
+			* Changes the replay speed for the following transactions.
+			* \param[in] speed: The replay speed (1 = recorded timing, 2 = twice as fast, 0 = as fast as possible).
+			*/
+			void set_speed(double speed) noexcept;
+
+			//! Starts the replay from the beginning of the log.
+			/*!
+			* Starts the replay from the beginning of the log, e.g. to run a benchmark several times. Open handles stay valid.
+			*/
+			void rewind();
+
+			//! Returns the number of replayed transactions.
+			/*!
+			* Returns the number of calls that were answered from the log.
+			* \returns the number of replayed transactions.
+			*/
+			uint64_t get_replayed_transactions() const noexcept;
+
+			//! Returns the number of divergences.
+			/*!
+			* Returns the number of calls that did not match the log.
+			* \returns the number of divergences.
+			*/
+			uint64_t get_divergences() const noexcept;
+
+			//! Checks whether all transactions were replayed.
+			/*!
+			* Checks whether all transactions of the log were replayed or skipped.
+			* \returns True if the log is exhausted, false otherwise.
+			*/
+			bool finished();
+
+		private:
+			/*! The device address and the last selected register of an open handle. */
+			struct HandleState
+			{
+				uint8_t address = 0;
+				uint8_t reg = 0;
+			};
+
+			/*!
+			* Consumes the next transaction of a device that matches the call. The mutex is locked by the caller.
+			* \param[in] address: The i2c address of the device.
+			* \param[in] operation: The kind of call.
+			* \param[in] reg: The register of the call.
+			* \returns the matching transaction or nullptr if none is left.
+			*/
+			const I2CTransaction* next(uint8_t address, I2COperation operation, uint8_t reg);
+
+			/*!
+			* Waits until the replay time of a transaction. The mutex must not be locked by the caller.
+			* \param[in] transaction: The replayed transaction.
+			*/
+			void wait_for(const I2CTransaction& transaction);
+
+			/*!
+			* Returns the result of a replayed transaction and sets errno accordingly.
+			* \param[in] transaction: The replayed transaction.
+			* \returns the recorded result.
+			*/
+			static int32_t replay_result(const I2CTransaction& transaction);
+
+			const std::vector<I2CTransaction> m_transactions;
+			std::map<uint8_t, std::vector<size_t>> m_queues{};
+			std::map<uint8_t, size_t> m_positions{};
+			std::map<int, HandleState> m_handles{};
+			int m_next_handle = 1;
+			std::mutex m_mutex{};
+			bool m_started{};
+			std::chrono::steady_clock::time_point m_start{};
+			uint64_t m_start_timestamp_in_us{};
+			std::atomic<double> m_speed;
+			std::atomic_uint64_t m_replayed_transactions = ATOMIC_VAR_INIT(0);
+			std::atomic_uint64_t m_divergences = ATOMIC_VAR_INIT(0);
+		};
+	}
+}
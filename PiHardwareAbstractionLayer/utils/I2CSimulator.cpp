@@ -0,0 +1,196 @@
+#include "I2CSimulator.h"
+
+#include "../exceptions/HALException.h"
+#include "../sensors/i2c/ADS1115Constants.h"
+#include "../sensors/i2c/BME280Constants.h"
+#include "../sensors/i2c/CCS811Constants.h"
+#include "../sensors/i2c/DS3231Constants.h"
+#include "../simulation/SimulatedADS1115.h"
+#include "../simulation/SimulatedBME280.h"
+#include "../simulation/SimulatedCCS811.h"
+#include "../simulation/SimulatedDS3231.h"
+
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+	constexpr uint32_t CLOCK_CYCLES_PER_BYTE = 9;
+	constexpr auto SPIN_TIME = std::chrono::microseconds(100);
+}
+
+std::shared_ptr<hal::utils::I2CSimulator> hal::utils::I2CSimulator::create_default()
+{
+	auto simulator = std::make_shared<I2CSimulator>();
+	simulator->attach(sensors::i2c::bme280::SENSOR_PRIMARY_I2C_REG, std::make_shared<simulation::SimulatedBME280>());
+	simulator->attach(sensors::i2c::ccs811::SENSOR_PRIMARY_I2C_REG, std::make_shared<simulation::SimulatedCCS811>());
+	simulator->attach(sensors::i2c::ds3231::SENSOR_PRIMARY_I2C_REG, std::make_shared<simulation::SimulatedDS3231>());
+	simulator->attach(sensors::i2c::ads1115::CONVERTER_ADDR_IS_GND_I2C_REG, std::make_shared<simulation::SimulatedADS1115>());
+	return simulator;
+}
+
+int hal::utils::I2CSimulator::open_device(const std::string&, const uint8_t address)
+{
+	// Like ioctl(I2C_SLAVE), opening succeeds without a device. The first transaction is not acknowledged then.
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto handle = m_next_handle++;
+	m_handles[handle] = address;
+	return handle;
+}
+
+int hal::utils::I2CSimulator::close_device(const int handle)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_handles.erase(handle) == 0)
+	{
+		errno = EBADF;
+		return -1;
+	}
+	return 0;
+}
+
+ssize_t hal::utils::I2CSimulator::write(const int handle, const uint8_t* data, const size_t length)
+{
+	std::shared_ptr<simulation::SimulatedI2CDevice> device;
+	if (!find_device(handle, device))
+	{
+		errno = EBADF;
+		return -1;
+	}
+
+	std::lock_guard<std::mutex> guard(m_bus_mutex);
+	m_transaction_count++;
+	transfer(length);
+	try
+	{
+		if (device == nullptr || !device->write(data, length))
+		{
+			errno = ENXIO;
+			return -1;
+		}
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "I2CSimulator [write] Device model failed:\n" << ex.to_string() << std::endl;
+		errno = EIO;
+		return -1;
+	}
+	m_transferred_bytes += length;
+	return static_cast<ssize_t>(length);
+}
+
+ssize_t hal::utils::I2CSimulator::read(const int handle, uint8_t* data, const size_t length)
+{
+	std::shared_ptr<simulation::SimulatedI2CDevice> device;
+	if (!find_device(handle, device))
+	{
+		errno = EBADF;
+		return -1;
+	}
+
+	std::lock_guard<std::mutex> guard(m_bus_mutex);
+	m_transaction_count++;
+	transfer(length);
+	try
+	{
+		if (device == nullptr || !device->read(data, length))
+		{
+			errno = ENXIO;
+			return -1;
+		}
+	}
+	catch (exception::HALException& ex)
+	{
+		std::cerr << "I2CSimulator [read] Device model failed:\n" << ex.to_string() << std::endl;
+		errno = EIO;
+		return -1;
+	}
+	m_transferred_bytes += length;
+	return static_cast<ssize_t>(length);
+}
+
+void hal::utils::I2CSimulator::attach(const uint8_t address, const std::shared_ptr<simulation::SimulatedI2CDevice>& device)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_devices[address] = device;
+}
+
+void hal::utils::I2CSimulator::detach(const uint8_t address)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_devices.erase(address);
+}
+
+std::shared_ptr<hal::simulation::SimulatedI2CDevice> hal::utils::I2CSimulator::get_device(const uint8_t address)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto device = m_devices.find(address);
+	return device != m_devices.end() ? device->second : nullptr;
+}
+
+void hal::utils::I2CSimulator::set_transaction_latency(const uint32_t latency_in_us) noexcept
+{
+	m_latency_in_us = latency_in_us;
+}
+
+void hal::utils::I2CSimulator::set_bus_frequency(const uint32_t frequency_in_hz) noexcept
+{
+	m_frequency_in_hz = frequency_in_hz;
+}
+
+uint64_t hal::utils::I2CSimulator::get_transaction_count() const noexcept
+{
+	return m_transaction_count;
+}
+
+uint64_t hal::utils::I2CSimulator::get_transferred_bytes() const noexcept
+{
+	return m_transferred_bytes;
+}
+
+void hal::utils::I2CSimulator::reset_statistics() noexcept
+{
+	m_transaction_count = 0;
+	m_transferred_bytes = 0;
+}
+
+bool hal::utils::I2CSimulator::find_device(const int handle, std::shared_ptr<simulation::SimulatedI2CDevice>& device)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	const auto address = m_handles.find(handle);
+	if (address == m_handles.end())
+	{
+		return false;
+	}
+
+	const auto found = m_devices.find(address->second);
+	device = found != m_devices.end() ? found->second : nullptr;
+	return true;
+}
+
+void hal::utils::I2CSimulator::transfer(const size_t length) const
+{
+	const uint64_t frequency_in_hz = m_frequency_in_hz;
+	auto duration = std::chrono::nanoseconds(static_cast<uint64_t>(m_latency_in_us) * 1000);
+	if (frequency_in_hz != 0)
+	{
+		// The address byte is transferred in addition to the data
+		duration += std::chrono::nanoseconds((length + 1) * CLOCK_CYCLES_PER_BYTE * 1000000000ULL / frequency_in_hz);
+	}
+	if (duration.count() == 0)
+	{
+		return;
+	}
+
+	// Sleeping alone overshoots by tens of microseconds, so the end of the transaction is awaited actively
+	const auto end = std::chrono::steady_clock::now() + duration;
+	if (duration > SPIN_TIME)
+	{
+		std::this_thread::sleep_until(end - SPIN_TIME);
+	}
+	while (std::chrono::steady_clock::now() < end)
+	{
+	}
+}
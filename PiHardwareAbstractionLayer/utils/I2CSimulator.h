@@ -0,0 +1,134 @@
+#pragma once
+
+#include "../interfaces/II2CTransport.h"
+#include "../simulation/SimulatedI2CDevice.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Transport that simulates an i2c bus in process.
+		/*!
+		* Transport that simulates an i2c bus in process. Register map models (see \sa { HAL::Simulation::SimulatedI2CDevice })
+		* are attached at their i2c address and answer the transactions of the unchanged drivers, so complete HAL pipelines
+		* run on machines without i2c hardware. All handles share one bus regardless of the path they were opened with.
+		* Transactions are serialized like on a real bus and each of them takes the configured latency plus the time the
+		* bytes need at the configured bus clock. The transactions and transferred bytes are counted, so benchmarks can
+		* detect changes in the number of bus accesses of a driver.
+		*/
+		class I2CSimulator final : public interfaces::II2CTransport
+		{
+		public:
+			//! Creates an empty bus without latency.
+			I2CSimulator() = default;
+
+			~I2CSimulator() override = default;
+			I2CSimulator(const I2CSimulator&) = delete;
+			I2CSimulator(I2CSimulator&&) = delete;
+			I2CSimulator& operator=(const I2CSimulator&) = delete;
+			I2CSimulator& operator=(I2CSimulator&&) = delete;
+
+			//! Creates a bus with all supported devices at their default addresses.
+			/*!
+			* Creates a bus with a BME280 (0x76), a CCS811 (0x5A), a DS3231 (0x68) and an ADS1115 (0x48).
+			* \returns the simulated bus.
+			*/
+			static std::shared_ptr<I2CSimulator> create_default();
+
+			int open_device(const std::string& path, uint8_t address) override;
+
+			int close_device(int handle) override;
+
+			ssize_t write(int handle, const uint8_t* data, size_t length) override;
+
+			ssize_t read(int handle, uint8_t* data, size_t length) override;
+
+			//! Attaches a device model to the bus.
+			/*!
+			* Attaches a device model to the bus. Replaces a model that was attached to the same address before.
+			* \param[in] address: The i2c address of the device.
+			* \param[in] device: The device model.
+			*/
+			void attach(uint8_t address, const std::shared_ptr<simulation::SimulatedI2CDevice>& device);
+
+			//! Removes a device model from the bus.
+			/*!
+			* Removes a device model from the bus. Following transactions with this address are not acknowledged.
+			* \param[in] address: The i2c address of the device.
+			*/
+			void detach(uint8_t address);
+
+			//! Returns the device model at an address.
+			/*!
+			* Returns the device model at an address, e.g. to change the simulated measurement values.
+			* \param[in] address: The i2c address of the device.
+			* \returns the device model or nullptr if no model is attached at the address.
+			*/
+			std::shared_ptr<simulation::SimulatedI2CDevice> get_device(uint8_t address);
+
+			//! Changes the time each transaction takes.
+			/*!
+			* Changes the time each transaction takes in addition to the transfer time of the bytes. Use this to model the
+			* syscall and driver overhead of the real bus.
+			* \param[in] latency_in_us: The latency of a transaction in microseconds.
+			*/
+			void set_transaction_latency(uint32_t latency_in_us) noexcept;
+
+			//! Changes the bus clock.
+			/*!
+			* Changes the bus clock that is used to calculate the transfer time of the bytes (9 clock cycles per byte
+			* including the address byte).
+			* \param[in] frequency_in_hz: The bus clock (e.g. 100000 or 400000) or 0 to transfer instantly.
+			*/
+			void set_bus_frequency(uint32_t frequency_in_hz) noexcept;
+
+			//! Returns the number of transactions.
+			/*!
+			* Returns the number of read and write transactions since the creation or the last <reset_statistics>"()".
+			* \returns the number of transactions.
+			*/
+			uint64_t get_transaction_count() const noexcept;
+
+			//! Returns the number of transferred bytes.
+			/*!
+			* Returns the number of read and written data bytes since the creation or the last <reset_statistics>"()".
+			* \returns the number of transferred bytes.
+			*/
+			uint64_t get_transferred_bytes() const noexcept;
+
+			//! Resets the transaction and byte counters.
+			void reset_statistics() noexcept;
+
+		private:
+			/*!
+			* Returns the device model of a handle.
+			* \param[in] handle: The handle returned by <open_device>"()".
+			* \param[out] device: The device model or nullptr if no model is attached at the address of the handle.
+			* \returns True if the handle is open, false otherwise.
+			*/
+			bool find_device(int handle, std::shared_ptr<simulation::SimulatedI2CDevice>& device);
+
+			/*!
+			* Waits the duration of a transaction. The bus mutex is locked by the caller.
+			* \param[in] length: The number of data bytes.
+			*/
+			void transfer(size_t length) const;
+
+			std::mutex m_mutex{};
+			std::mutex m_bus_mutex{};
+			std::map<uint8_t, std::shared_ptr<simulation::SimulatedI2CDevice>> m_devices{};
+			std::map<int, uint8_t> m_handles{};
+			int m_next_handle = 1;
+			std::atomic_uint32_t m_latency_in_us = ATOMIC_VAR_INIT(0);
+			std::atomic_uint32_t m_frequency_in_hz = ATOMIC_VAR_INIT(0);
+			std::atomic_uint64_t m_transaction_count = ATOMIC_VAR_INIT(0);
+			std::atomic_uint64_t m_transferred_bytes = ATOMIC_VAR_INIT(0);
+		};
+	}
+}
@@ -0,0 +1,114 @@
+#include "Metrics.h"
+
+#include "../exceptions/HALException.h"
+
+hal::utils::MetricsRegistry& hal::utils::MetricsRegistry::instance()
+{
+	static MetricsRegistry inst;
+	return inst;
+}
+
+hal::utils::Counter& hal::utils::MetricsRegistry::counter(const std::string& name, const uint8_t device)
+{
+	return *find_or_add(name, MetricKind::COUNTER, device, false, SensorType::CONVERTER).counter;
+}
+
+hal::utils::Counter& hal::utils::MetricsRegistry::counter(const std::string& name, const uint8_t device, const SensorType type)
+{
+	return *find_or_add(name, MetricKind::COUNTER, device, true, type).counter;
+}
+
+hal::utils::Gauge& hal::utils::MetricsRegistry::gauge(const std::string& name, const uint8_t device)
+{
+	return *find_or_add(name, MetricKind::GAUGE, device, false, SensorType::CONVERTER).gauge;
+}
+
+hal::utils::Gauge& hal::utils::MetricsRegistry::gauge(const std::string& name, const uint8_t device, const SensorType type)
+{
+	return *find_or_add(name, MetricKind::GAUGE, device, true, type).gauge;
+}
+
+hal::utils::Histogram& hal::utils::MetricsRegistry::histogram(const std::string& name, const uint8_t device)
+{
+	return *find_or_add(name, MetricKind::HISTOGRAM, device, false, SensorType::CONVERTER).histogram;
+}
+
+hal::utils::Histogram& hal::utils::MetricsRegistry::histogram(const std::string& name, const uint8_t device, const SensorType type)
+{
+	return *find_or_add(name, MetricKind::HISTOGRAM, device, true, type).histogram;
+}
+
+std::vector<hal::MetricSample> hal::utils::MetricsRegistry::snapshot() const
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	std::vector<MetricSample> samples;
+	samples.reserve(m_entries.size());
+	for (const auto& entry : m_entries)
+	{
+		auto sample = entry->key;
+		switch (sample.kind)
+		{
+		case MetricKind::COUNTER:
+			sample.value = static_cast<int64_t>(entry->counter->get());
+			break;
+		case MetricKind::GAUGE:
+			sample.value = entry->gauge->get();
+			break;
+		case MetricKind::HISTOGRAM:
+			sample.sum = entry->histogram->sum();
+			sample.buckets.resize(Histogram::BUCKET_COUNT);
+			for (uint8_t i = 0; i < Histogram::BUCKET_COUNT; i++)
+			{
+				sample.buckets[i] = entry->histogram->bucket(i);
+				sample.count += sample.buckets[i];
+			}
+			break;
+		}
+		samples.push_back(std::move(sample));
+	}
+	return samples;
+}
+
+hal::utils::MetricsRegistry::Entry& hal::utils::MetricsRegistry::find_or_add(const std::string& name, const MetricKind kind,
+																									 const uint8_t device, const bool has_sensor_type,
+																									 const SensorType type)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	for (auto& entry : m_entries)
+	{
+		if (entry->key.name != name)
+		{
+			continue;
+		}
+		if (entry->key.kind != kind)
+		{
+			throw exception::HALException("MetricsRegistry", "find_or_add",
+													std::string("The metric '").append(name).append("' is already registered with another kind."));
+		}
+		if (entry->key.device == device && entry->key.has_sensor_type == has_sensor_type && (!has_sensor_type || entry->key.sensor_type == type))
+		{
+			return *entry;
+		}
+	}
+
+	auto entry = std::make_unique<Entry>();
+	entry->key.name = name;
+	entry->key.kind = kind;
+	entry->key.device = device;
+	entry->key.has_sensor_type = has_sensor_type;
+	entry->key.sensor_type = type;
+	switch (kind)
+	{
+	case MetricKind::COUNTER:
+		entry->counter = std::make_unique<Counter>();
+		break;
+	case MetricKind::GAUGE:
+		entry->gauge = std::make_unique<Gauge>();
+		break;
+	case MetricKind::HISTOGRAM:
+		entry->histogram = std::make_unique<Histogram>();
+		break;
+	}
+	m_entries.push_back(std::move(entry));
+	return *m_entries.back();
+}
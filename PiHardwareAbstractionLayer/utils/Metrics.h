@@ -0,0 +1,276 @@
+#pragma once
+
+#include "../enums/MetricKind.h"
+#include "../enums/SensorType.h"
+#include "../structs/MetricSample.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! A value that only grows.
+		/*!
+		* A value that only grows. Adding is a single relaxed atomic operation and never blocks.
+		*/
+		class Counter
+		{
+		public:
+			/*!
+			* Adds to the counter.
+			* \param[in] value: The value to add.
+			*/
+			void add(const uint64_t value = 1) noexcept { m_value.fetch_add(value, std::memory_order_relaxed); }
+
+			/*!
+			* Returns the current value.
+			* \returns the current value.
+			*/
+			uint64_t get() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+		private:
+			std::atomic_uint64_t m_value = ATOMIC_VAR_INIT(0);
+		};
+
+		//! A value that describes the current state.
+		/*!
+		* A value that describes the current state. Setting is a single relaxed atomic operation and never blocks.
+		*/
+		class Gauge
+		{
+		public:
+			/*!
+			* Sets the gauge.
+			* \param[in] value: The new value.
+			*/
+			void set(const int64_t value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+
+			/*!
+			* Adds to the gauge.
+			* \param[in] value: The value to add (may be negative).
+			*/
+			void add(const int64_t value) noexcept { m_value.fetch_add(value, std::memory_order_relaxed); }
+
+			/*!
+			* Returns the current value.
+			* \returns the current value.
+			*/
+			int64_t get() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+		private:
+			std::atomic<int64_t> m_value = ATOMIC_VAR_INIT(0);
+		};
+
+		//! A distribution of durations.
+		/*!
+		* A distribution of durations in nanoseconds. The buckets are fixed powers of two, so recording needs no
+		* configuration, no lock and no search: two relaxed atomic additions (the count is the sum of the buckets).
+		* The resolution (a factor of two) is enough to tell a 100 us transfer from a 1 ms one, and percentiles can
+		* be estimated from the buckets.
+		*/
+		class Histogram
+		{
+		public:
+			/*! The number of buckets. The last bucket counts all durations of 2^(BUCKET_COUNT - 2) ns (about 1 s) and more. */
+			static constexpr uint8_t BUCKET_COUNT = 32;
+
+			/*!
+			* Records a duration.
+			* \param[in] nanoseconds: The duration in nanoseconds.
+			*/
+			void record(const uint64_t nanoseconds) noexcept
+			{
+				m_buckets[bucket_of(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+				m_sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+			}
+
+			/*!
+			* Records the time that passed since the given point of time.
+			* \param[in] start: The point of time the measured operation started.
+			*/
+			void record_since(const std::chrono::steady_clock::time_point start) noexcept
+			{
+				const auto elapsed = std::chrono::steady_clock::now() - start;
+				record(elapsed.count() > 0 ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) : 0);
+			}
+
+			/*!
+			* Returns the number of recorded durations.
+			* \returns the number of recorded durations.
+			*/
+			uint64_t count() const noexcept
+			{
+				uint64_t count = 0;
+				for (const auto& bucket : m_buckets)
+				{
+					count += bucket.load(std::memory_order_relaxed);
+				}
+				return count;
+			}
+
+			/*!
+			* Returns the sum of all recorded durations.
+			* \returns the sum in nanoseconds.
+			*/
+			uint64_t sum() const noexcept { return m_sum.load(std::memory_order_relaxed); }
+
+			/*!
+			* Returns the number of durations of a bucket.
+			* \param[in] bucket: The index of the bucket.
+			* \returns the number of durations of the bucket.
+			*/
+			uint64_t bucket(const uint8_t bucket) const noexcept { return m_buckets[bucket].load(std::memory_order_relaxed); }
+
+			/*!
+			* Returns the index of the bucket a duration is counted in: 0 for 0 ns, otherwise the number of
+			* significant bits, limited to the last bucket.
+			* \param[in] nanoseconds: The duration in nanoseconds.
+			* \returns the index of the bucket.
+			*/
+			static uint8_t bucket_of(const uint64_t nanoseconds) noexcept
+			{
+				const auto bits = nanoseconds == 0 ? 0 : 64 - __builtin_clzll(nanoseconds);
+				return static_cast<uint8_t>(bits < BUCKET_COUNT ? bits : BUCKET_COUNT - 1);
+			}
+
+		private:
+			std::atomic_uint64_t m_buckets[BUCKET_COUNT]{};
+			std::atomic_uint64_t m_sum = ATOMIC_VAR_INIT(0);
+		};
+
+		//! Registry of the runtime metrics of the HAL.
+		/*!
+		* Registry of the runtime metrics of the HAL (i2c latencies and errors, conversion wait times, tick lateness,
+		* callback durations, ...). A metric is identified by its name, the device (i2c address or pin) and optionally
+		* the measurement type.
+		*
+		* Looking up a metric takes a lock and should be done once during setup. The returned reference stays valid
+		* for the lifetime of the process, so recording on the acquisition path is lock free. <snapshot>"()" copies
+		* all values for an exporter.
+		*/
+		class MetricsRegistry
+		{
+		public:
+			/*!
+			* Access the singleton instance of this class.
+			* \returns the singleton instance of this class.
+			*/
+			static MetricsRegistry& instance();
+
+			MetricsRegistry(const MetricsRegistry&) = delete;
+			MetricsRegistry(MetricsRegistry&&) = delete;
+			MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+			MetricsRegistry& operator=(MetricsRegistry&&) = delete;
+
+			//! Returns a counter, creating it on first use.
+			/*!
+			* Returns a counter, creating it on first use.
+			* \param[in] name: The name of the metric.
+			* \param[in] device: The i2c address of the device or the pin of the sensor (0 if not recorded per device).
+			* \returns the counter.
+			* \throws HALException if a metric of another kind is registered with the same name.
+			*/
+			Counter& counter(const std::string& name, uint8_t device = 0);
+
+			//! Returns a counter of a measurement type, creating it on first use.
+			/*!
+			* Returns a counter of a measurement type, creating it on first use.
+			* \param[in] name: The name of the metric.
+			* \param[in] device: The i2c address of the device or the pin of the sensor.
+			* \param[in] type: The measurement type.
+			* \returns the counter.
+			* \throws HALException if a metric of another kind is registered with the same name.
+			*/
+			Counter& counter(const std::string& name, uint8_t device, SensorType type);
+
+			//! Returns a gauge, creating it on first use.
+			/*!
+			* Returns a gauge, creating it on first use.
+			* \param[in] name: The name of the metric.
+			* \param[in] device: The i2c address of the device or the pin of the sensor (0 if not recorded per device).
+			* \returns the gauge.
+			* \throws HALException if a metric of another kind is registered with the same name.
+			*/
+			Gauge& gauge(const std::string& name, uint8_t device = 0);
+
+			//! Returns a gauge of a measurement type, creating it on first use.
+			/*!
+			* Returns a gauge of a measurement type, creating it on first use.
+			* \param[in] name: The name of the metric.
+			* \param[in] device: The i2c address of the device or the pin of the sensor.
+			* \param[in] type: The measurement type.
+			* \returns the gauge.
+			* \throws HALException if a metric of another kind is registered with the same name.
+			*/
+			Gauge& gauge(const std::string& name, uint8_t device, SensorType type);
+
+			//! Returns a histogram, creating it on first use.
+			/*!
+			* Returns a histogram, creating it on first use.
+			* \param[in] name: The name of the metric.
+			* \param[in] device: The i2c address of the device or the pin of the sensor (0 if not recorded per device).
+			* \returns the histogram.
+			* \throws HALException if a metric of another kind is registered with the same name.
+			*/
+			Histogram& histogram(const std::string& name, uint8_t device = 0);
+
+			//! Returns a histogram of a measurement type, creating it on first use.
+			/*!
+			* Returns a histogram of a measurement type, creating it on first use.
+			* \param[in] name: The name of the metric.
+			* \param[in] device: The i2c address of the device or the pin of the sensor.
+			* \param[in] type: The measurement type.
+			* \returns the histogram.
+			* \throws HALException if a metric of another kind is registered with the same name.
+			*/
+			Histogram& histogram(const std::string& name, uint8_t device, SensorType type);
+
+			//! Copies the current values of all metrics.
+			/*!
+			* Copies the current values of all metrics in the order they were registered. Recording continues while
+			* the snapshot is taken, so the values of different metrics may be a few events apart.
+			* \returns the values of all metrics.
+			*/
+			std::vector<MetricSample> snapshot() const;
+
+		private:
+			/*!
+			* Default constructor.
+			*/
+			MetricsRegistry() = default;
+
+			/*!
+			* One registered metric. Only the member that matches the kind is set.
+			*/
+			struct Entry
+			{
+				MetricSample key{};
+				std::unique_ptr<Counter> counter{};
+				std::unique_ptr<Gauge> gauge{};
+				std::unique_ptr<Histogram> histogram{};
+			};
+
+			/*!
+			* Returns the entry of a metric, creating it on first use.
+			* \param[in] name: The name of the metric.
+			* \param[in] kind: The kind of the metric.
+			* \param[in] device: The i2c address of the device or the pin of the sensor.
+			* \param[in] has_sensor_type: True if the metric is recorded per measurement type.
+			* \param[in] type: The measurement type.
+			* \returns the entry.
+			* \throws HALException if a metric of another kind is registered with the same name.
+			*/
+			Entry& find_or_add(const std::string& name, MetricKind kind, uint8_t device, bool has_sensor_type, SensorType type);
+
+			mutable std::mutex m_mutex{};
+			std::vector<std::unique_ptr<Entry>> m_entries{};
+		};
+	}
+}
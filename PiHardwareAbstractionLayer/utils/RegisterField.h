@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Compile-time description of a bit field inside a device register.
+		/*!
+		* Compile-time description of a bit field inside a device register. The position and width are template parameters,
+		* so fields that do not fit into their byte are rejected by the compiler and all masks are constants. Encoding and
+		* decoding are a shift and a mask without branches or exceptions, which replaces the runtime checks of
+		* \sa { HAL::Utils::BitManipulation } on the hot paths of the drivers.
+		*
+		* The first bit is the right most bit of the byte and has the index 0. Registers wider than one byte are described
+		* per byte: <Byte> is the index of the byte inside the transferred register data (0 for the first transferred byte).
+		* Drivers describe their fields once in their constants header, e.g.
+		* "using PressureOversamplingField = utils::Field<MEASUREMENT_OVERSAMPLING_REG, 2, 3>;".
+		*
+		* \tparam Reg: The register address.
+		* \tparam Pos: The index of the lowest bit of the field.
+		* \tparam Width: The number of bits of the field.
+		* \tparam Byte: The index of the byte inside a multi byte register.
+		*/
+		template <uint8_t Reg, uint8_t Pos, uint8_t Width, uint8_t Byte = 0>
+		struct Field
+		{
+			static_assert(Width >= 1, "A register field needs at least one bit.");
+			static_assert(Pos + Width <= 8, "The register field does not fit into its byte.");
+
+			static constexpr uint8_t REGISTER = Reg;
+			static constexpr uint8_t POSITION = Pos;
+			static constexpr uint8_t WIDTH = Width;
+			static constexpr uint8_t BYTE = Byte;
+			static constexpr uint8_t MAX_VALUE = static_cast<uint8_t>((1U << Width) - 1U);
+			static constexpr uint8_t MASK = static_cast<uint8_t>(MAX_VALUE << Pos);
+
+			//! Returns the byte with the field replaced by the given value.
+			/*!
+			* Returns the byte with the field replaced by the given value. The other bits are kept. Bits of the value that
+			* do not fit into the field are dropped.
+			* \param[in] byte: The current content of the register byte.
+			* \param[in] value: The new value of the field (integer or enum).
+			* \returns the new content of the register byte.
+			*/
+			template <typename T>
+			static constexpr uint8_t encode(const uint8_t byte, const T value) noexcept
+			{
+				static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "Only integers and enums can be encoded.");
+				return static_cast<uint8_t>((byte & static_cast<uint8_t>(~MASK)) | ((static_cast<uint8_t>(value) << Pos) & MASK));
+			}
+
+			//! Replaces the field inside the given byte.
+			/*!
+			* Replaces the field inside the given byte. The other bits are kept.
+			* \param[out] byte: The register byte to manipulate.
+			* \param[in] value: The new value of the field (integer or enum).
+			*/
+			template <typename T>
+			static constexpr void set(uint8_t& byte, const T value) noexcept
+			{
+				byte = encode(byte, value);
+			}
+
+			//! Extracts the field from the given byte.
+			/*!
+			* Extracts the field from the given byte and shifts it to bit 0.
+			* \param[in] byte: The content of the register byte.
+			* \returns the value of the field, converted to T (e.g. the settings enum of the field).
+			*/
+			template <typename T = uint8_t>
+			static constexpr T decode(const uint8_t byte) noexcept
+			{
+				return static_cast<T>((byte & MASK) >> Pos);
+			}
+
+			//! Checks if a single bit field is set.
+			/*!
+			* Checks if a single bit field is set. Only available for fields with a width of 1.
+			* \param[in] byte: The content of the register byte.
+			* \returns True if the bit is set (1) and false if the bit is not set (0).
+			*/
+			static constexpr bool is_set(const uint8_t byte) noexcept
+			{
+				static_assert(Width == 1, "is_set is only available for single bit fields.");
+				return (byte & MASK) != 0;
+			}
+
+			//! Returns a field value at its position inside the byte.
+			/*!
+			* Returns a field value at its position inside the byte, e.g. to combine constant register contents.
+			* Values that do not fit into the field are rejected by the compiler.
+			* \tparam Value: The value of the field.
+			* \returns the value shifted to the position of the field.
+			*/
+			template <uint8_t Value>
+			static constexpr uint8_t value() noexcept
+			{
+				static_assert(Value <= MAX_VALUE, "The value does not fit into the register field.");
+				return static_cast<uint8_t>(Value << Pos);
+			}
+		};
+
+		//! Compile-time description of a single bit inside a device register.
+		template <uint8_t Reg, uint8_t Bit, uint8_t Byte = 0>
+		using Flag = Field<Reg, Bit, 1, Byte>;
+	}
+}
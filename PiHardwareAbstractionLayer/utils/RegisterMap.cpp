@@ -0,0 +1,165 @@
+#include "RegisterMap.h"
+#include "I2CManager.h"
+
+#include "../exceptions/HALException.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+hal::utils::RegisterMap::RegisterMap(const uint8_t first_register, const uint8_t register_count, const RegisterAccess access,
+												 const uint8_t register_width)
+	: m_first_register(first_register), m_register_count(register_count), m_register_width(register_width), m_access(access)
+{
+	if (register_count == 0 || register_width == 0 || first_register + register_count > 0x100)
+	{
+		throw exception::HALException("RegisterMap", "RegisterMap", "The register block has to contain at least one register of one byte.");
+	}
+	if (access == RegisterAccess::ADDRESS_DATA_PAIRS && register_width != 1)
+	{
+		throw exception::HALException("RegisterMap", "RegisterMap", "Address/data pairs require registers of one byte.");
+	}
+
+	m_shadow.resize(static_cast<size_t>(register_count) * register_width, 0);
+	m_dirty.resize(register_count, false);
+	m_valid.resize(register_count, false);
+}
+
+void hal::utils::RegisterMap::load(const int handle)
+{
+	if (m_access == RegisterAccess::SINGLE_REGISTER)
+	{
+		for (uint8_t i = 0; i < m_register_count; i++)
+		{
+			load_register(handle, static_cast<uint8_t>(m_first_register + i));
+		}
+		return;
+	}
+
+	I2CManager::read_from_device(handle, m_first_register, m_shadow.data(), static_cast<uint16_t>(m_shadow.size()));
+	std::fill(m_dirty.begin(), m_dirty.end(), false);
+	std::fill(m_valid.begin(), m_valid.end(), true);
+}
+
+void hal::utils::RegisterMap::load_register(const int handle, const uint8_t reg)
+{
+	uint8_t data[0x100];
+	I2CManager::read_from_device(handle, reg, data, m_register_width);
+	store(reg, data);
+}
+
+uint8_t hal::utils::RegisterMap::apply(const int handle)
+{
+	return try_apply(handle).value_or_raise();
+}
+
+hal::utils::Result<uint8_t> hal::utils::RegisterMap::try_apply(const int handle) noexcept
+{
+	uint8_t transactions = 0;
+	if (m_access == RegisterAccess::ADDRESS_DATA_PAIRS)
+	{
+		uint8_t pairs[0x200];
+		uint16_t length = 0;
+		for (uint8_t i = 0; i < m_register_count; i++)
+		{
+			if (m_dirty[i])
+			{
+				pairs[length++] = static_cast<uint8_t>(m_first_register + i);
+				pairs[length++] = m_shadow[i];
+			}
+		}
+		if (length == 0)
+		{
+			return transactions;
+		}
+
+		if (!I2CManager::device_open(handle))
+		{
+			return Error{ErrorCode::DEVICE_NOT_OPEN, 0, static_cast<uint8_t>(handle), pairs[0], "RegisterMap", "apply"};
+		}
+		if (I2CManager::write_raw(handle, pairs, length) != length)
+		{
+			return Error{ErrorCode::WRITE_FAILED, errno, static_cast<uint8_t>(handle), pairs[0], "RegisterMap", "apply"};
+		}
+		std::fill(m_dirty.begin(), m_dirty.end(), false);
+		return static_cast<uint8_t>(1);
+	}
+
+	// Auto increment: one write per run of adjacent dirty registers. Single register: one write per dirty register.
+	uint8_t i = 0;
+	while (i < m_register_count)
+	{
+		if (!m_dirty[i])
+		{
+			i++;
+			continue;
+		}
+
+		auto end = static_cast<uint8_t>(i + 1);
+		while (m_access == RegisterAccess::AUTO_INCREMENT && end < m_register_count && m_dirty[end])
+		{
+			end++;
+		}
+
+		const auto reg = static_cast<uint8_t>(m_first_register + i);
+		const auto written = I2CManager::try_write_to_device(handle, reg, &m_shadow[offset_of(reg)],
+																			  static_cast<uint16_t>((end - i) * m_register_width));
+		if (!written)
+		{
+			return written.error();
+		}
+		std::fill(m_dirty.begin() + i, m_dirty.begin() + end, false);
+		transactions++;
+		i = end;
+	}
+	return transactions;
+}
+
+void hal::utils::RegisterMap::store(const uint8_t reg, const uint8_t* data) noexcept
+{
+	memcpy(&m_shadow[offset_of(reg)], data, m_register_width);
+	m_dirty[reg - m_first_register] = false;
+	m_valid[reg - m_first_register] = true;
+}
+
+void hal::utils::RegisterMap::set_register(const uint8_t reg, const uint8_t* data) noexcept
+{
+	const auto index = reg - m_first_register;
+	if (!m_valid[index] || memcmp(&m_shadow[offset_of(reg)], data, m_register_width) != 0)
+	{
+		memcpy(&m_shadow[offset_of(reg)], data, m_register_width);
+		m_dirty[index] = true;
+		m_valid[index] = true;
+	}
+}
+
+const uint8_t* hal::utils::RegisterMap::get_register(const uint8_t reg) const noexcept
+{
+	return &m_shadow[offset_of(reg)];
+}
+
+void hal::utils::RegisterMap::touch(const uint8_t reg) noexcept
+{
+	m_dirty[reg - m_first_register] = true;
+}
+
+void hal::utils::RegisterMap::invalidate() noexcept
+{
+	std::fill(m_dirty.begin(), m_dirty.end(), false);
+	std::fill(m_valid.begin(), m_valid.end(), false);
+}
+
+bool hal::utils::RegisterMap::is_valid(const uint8_t reg) const noexcept
+{
+	return m_valid[reg - m_first_register];
+}
+
+bool hal::utils::RegisterMap::is_dirty(const uint8_t reg) const noexcept
+{
+	return m_dirty[reg - m_first_register];
+}
+
+size_t hal::utils::RegisterMap::offset_of(const uint8_t reg) const noexcept
+{
+	return static_cast<size_t>(reg - m_first_register) * m_register_width;
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "Result.h"
+#include "../enums/RegisterAccess.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Shadow copy of a block of adjacent device registers.
+		/*!
+		* Shadow copy of a block of adjacent device registers. Drivers change the fields of the copy with the descriptors
+		* of \sa { HAL::Utils::Field } and <apply>"()" writes only the registers whose content changed. Dirty registers are
+		* combined according to the write access of the device: adjacent registers into one auto increment write, all of
+		* them into one transaction of address/data pairs or one transaction per register. A configuration change thereby
+		* needs no read-modify-write cycles and usually a single bus transaction.
+		*
+		* The copy is only correct as long as the registers are changed through the map. Registers that the device changes
+		* by itself (e.g. status bits) have to be left out or written with <touch>"()", writes that bypass the map have to
+		* be reported with <store>"()". The class is not thread safe, the driver serializes the accesses.
+		*/
+		class RegisterMap
+		{
+		public:
+			RegisterMap() = delete;
+
+			/*!
+			* Constructor. The registers are invalid until they are loaded or set.
+			* \param[in] first_register: The address of the first register of the block.
+			* \param[in] register_count: The number of adjacent registers.
+			* \param[in] access: How the device accepts writes to several registers.
+			* \param[in] register_width: The number of bytes of each register.
+			* \throws HALException if the block is empty or address/data pairs are used with registers wider than one byte.
+			*/
+			RegisterMap(uint8_t first_register, uint8_t register_count, RegisterAccess access, uint8_t register_width = 1);
+
+			//! Reads all registers from the device.
+			/*!
+			* Reads all registers from the device into the copy, with one burst read or one read per register for
+			* devices with single register access. Pending changes are discarded.
+			* \param[in] handle: The handle that will be used to communicate over the i2c bus.
+			* \throws HALException if the device is not open.
+			* \throws I2CException if reading the registers fails.
+			*/
+			void load(int handle);
+
+			//! Reads one register from the device.
+			/*!
+			* Reads one register from the device into the copy. A pending change of the register is discarded.
+			* \param[in] handle: The handle that will be used to communicate over the i2c bus.
+			* \param[in] reg: The address of the register.
+			* \throws HALException if the device is not open.
+			* \throws I2CException if reading the register fails.
+			*/
+			void load_register(int handle, uint8_t reg);
+
+			//! Writes all changed registers to the device.
+			/*!
+			* Writes all changed registers to the device with as few transactions as the write access of the device
+			* allows. The registers are written in ascending order. The changes stay pending if a write fails.
+			* \param[in] handle: The handle that will be used to communicate over the i2c bus.
+			* \returns the number of write transactions (0 if nothing changed).
+			* \throws HALException if the device is not open.
+			* \throws I2CException if writing the registers fails.
+			*/
+			uint8_t apply(int handle);
+
+			//! Writes all changed registers to the device without throwing.
+			/*!
+			* Like <apply>"()", but reports failures with the returned result instead of an exception.
+			* \param[in] handle: The handle that will be used to communicate over the i2c bus.
+			* \returns the number of write transactions (0 if nothing changed) or the error of the failed write.
+			*/
+			Result<uint8_t> try_apply(int handle) noexcept;
+
+			//! Updates the copy with a register content that was transferred without the map.
+			/*!
+			* Updates the copy with a register content that was read from or written to the device without the map.
+			* The register becomes valid and a pending change of it is discarded.
+			* \param[in] reg: The address of the register.
+			* \param[in] data: The content of the register (register width bytes).
+			*/
+			void store(uint8_t reg, const uint8_t* data) noexcept;
+
+			//! Replaces the content of a whole register.
+			/*!
+			* Replaces the content of a whole register. The register becomes valid and is written by the next
+			* <apply>"()" if the content changed or was not known before.
+			* \param[in] reg: The address of the register.
+			* \param[in] data: The new content of the register (register width bytes).
+			*/
+			void set_register(uint8_t reg, const uint8_t* data) noexcept;
+
+			//! Returns the content of a register.
+			/*!
+			* Returns the content of a register from the copy without accessing the device.
+			* \param[in] reg: The address of the register.
+			* \returns a pointer to the register width bytes of the register.
+			*/
+			const uint8_t* get_register(uint8_t reg) const noexcept;
+
+			//! Marks a register to be written by the next apply.
+			/*!
+			* Marks a register to be written by the next <apply>"()" even if its content did not change, e.g. because
+			* writing it has a side effect like starting a measurement.
+			* \param[in] reg: The address of the register.
+			*/
+			void touch(uint8_t reg) noexcept;
+
+			//! Marks all registers as unknown.
+			/*!
+			* Marks all registers as unknown and discards pending changes, e.g. after a reset of the device.
+			*/
+			void invalidate() noexcept;
+
+			//! Checks if a register is known.
+			/*!
+			* Checks if the content of a register is known, i.e. was loaded, stored or set completely.
+			* \param[in] reg: The address of the register.
+			* \returns True if the register is known, false otherwise.
+			*/
+			bool is_valid(uint8_t reg) const noexcept;
+
+			//! Checks if a register will be written by the next apply.
+			/*!
+			* Checks if a register will be written by the next <apply>"()".
+			* \param[in] reg: The address of the register.
+			* \returns True if the register has a pending change, false otherwise.
+			*/
+			bool is_dirty(uint8_t reg) const noexcept;
+
+			//! Changes a field of the copy.
+			/*!
+			* Changes a field of the copy. The register is only written by the next <apply>"()" if its content changed.
+			* The other fields of the register keep their content, so the register should be valid before.
+			* \tparam F: The field descriptor (\sa { HAL::Utils::Field }). The register has to be part of the block.
+			* \param[in] value: The new value of the field (integer or enum).
+			*/
+			template <typename F, typename T>
+			void set(const T value) noexcept
+			{
+				auto& byte = m_shadow[offset_of(F::REGISTER) + F::BYTE];
+				const auto changed = F::encode(byte, value);
+				if (changed != byte)
+				{
+					byte = changed;
+					m_dirty[F::REGISTER - m_first_register] = true;
+				}
+			}
+
+			//! Returns a field of the copy.
+			/*!
+			* Returns a field of the copy without accessing the device.
+			* \tparam F: The field descriptor (\sa { HAL::Utils::Field }). The register has to be part of the block.
+			* \returns the value of the field, converted to T (e.g. the settings enum of the field).
+			*/
+			template <typename F, typename T = uint8_t>
+			T get() const noexcept
+			{
+				return F::template decode<T>(m_shadow[offset_of(F::REGISTER) + F::BYTE]);
+			}
+
+		private:
+			/*!
+			* Returns the index of the first byte of a register in the copy.
+			* \param[in] reg: The address of the register.
+			* \returns the index of the first byte.
+			*/
+			size_t offset_of(uint8_t reg) const noexcept;
+
+			uint8_t m_first_register;
+			uint8_t m_register_count;
+			uint8_t m_register_width;
+			RegisterAccess m_access;
+			std::vector<uint8_t> m_shadow{};
+			std::vector<bool> m_dirty{};
+			std::vector<bool> m_valid{};
+		};
+	}
+}
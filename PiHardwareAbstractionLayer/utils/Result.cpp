@@ -0,0 +1,70 @@
+#include "Result.h"
+
+#include "../exceptions/HALException.h"
+#include "../exceptions/I2CException.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	const char* describe(const hal::ErrorCode code) noexcept
+	{
+		switch (code)
+		{
+		case hal::ErrorCode::NONE:
+			return "No error.";
+		case hal::ErrorCode::DEVICE_NOT_OPEN:
+			return "The device is not open.";
+		case hal::ErrorCode::WRITE_FAILED:
+			return "Could not write to the device.";
+		case hal::ErrorCode::READ_FAILED:
+			return "Could not read from the device.";
+		case hal::ErrorCode::TIMEOUT:
+			return "The device did not finish in time.";
+		case hal::ErrorCode::DEVICE_ERROR:
+			return "The device reported an error.";
+		case hal::ErrorCode::INVALID_ARGUMENT:
+			return "Invalid argument.";
+		case hal::ErrorCode::EXCEPTION:
+			return "An exception was thrown.";
+		default:
+			return "Unknown error.";
+		}
+	}
+}
+
+hal::utils::Error hal::utils::Error::with_context(const char* new_cls, const char* new_func, const uint8_t new_device) const noexcept
+{
+	auto error = *this;
+	error.cls = new_cls;
+	error.func = new_func;
+	error.device = new_device;
+	return error;
+}
+
+std::string hal::utils::Error::to_string() const
+{
+	char location[48];
+	snprintf(location, sizeof(location), " (device 0x%02X, register 0x%02X)", device, reg);
+
+	auto message = std::string(describe(code)).append(location);
+	if (system_error != 0)
+	{
+		message.append(" Error: ").append(strerror(system_error));
+	}
+	if (details != nullptr)
+	{
+		message.append("\n").append(*details);
+	}
+	return message;
+}
+
+void hal::utils::Error::raise() const
+{
+	if (code == ErrorCode::WRITE_FAILED || code == ErrorCode::READ_FAILED)
+	{
+		throw exception::I2CException(cls, func, device, reg, to_string());
+	}
+	throw exception::HALException(cls, func, to_string());
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "../enums/ErrorCode.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Describes why a call failed.
+		/*!
+		* Describes why a call failed without formatting a message: the context consists of string literals and
+		* integers, so creating and passing an error never allocates. The message is only formatted by
+		* <to_string>"()" when somebody actually reads it, e.g. a log.
+		*/
+		struct Error
+		{
+			/*! Why the call failed. */
+			ErrorCode code = ErrorCode::NONE;
+			/*! The errno of the failed system call or 0. */
+			int system_error = 0;
+			/*! The i2c address of the device (or the handle of the connection if the address is not known). */
+			uint8_t device = 0;
+			/*! The register that was accessed. */
+			uint8_t reg = 0;
+			/*! The name of the class that detected the failure (string literal). */
+			const char* cls = "";
+			/*! The name of the function that detected the failure (string literal). */
+			const char* func = "";
+			/*! Optional description, e.g. the text of a caught exception. Only set on slow paths. */
+			std::shared_ptr<const std::string> details{};
+
+			//! Returns a copy of the error reported by another function.
+			/*!
+			* Returns a copy of the error with the class, function and device of the caller, e.g. to report a failed
+			* bus transfer as a failure of the driver. The code, errno, register and details are kept.
+			* \param[in] new_cls: The name of the reporting class (string literal).
+			* \param[in] new_func: The name of the reporting function (string literal).
+			* \param[in] new_device: The i2c address of the device.
+			* \returns the error with the new context.
+			*/
+			Error with_context(const char* new_cls, const char* new_func, uint8_t new_device) const noexcept;
+
+			//! Formats the error as a message.
+			/*!
+			* Formats the error as a message.
+			* \returns the message.
+			*/
+			std::string to_string() const;
+
+			//! Throws the exception that matches the error.
+			/*!
+			* Throws the exception that matches the error, for callers that report failures with exceptions.
+			* \throws I2CException if a bus transfer failed.
+			* \throws HALException for all other errors.
+			*/
+			[[noreturn]] void raise() const;
+		};
+
+		//! Either the value of a successful call or the error of a failed call.
+		/*!
+		* Either the value of a successful call or the error of a failed call, similar to std::expected. Functions on
+		* the acquisition path return results instead of throwing, so a transient bus error costs a comparison
+		* instead of stack unwinding and message formatting in every layer.
+		* \tparam T: The type of the value. It has to be default constructible.
+		*/
+		template <typename T>
+		class Result
+		{
+		public:
+			/*!
+			* Creates a successful result.
+			* \param[in] value: The value.
+			*/
+			Result(T value) noexcept : m_value(std::move(value))
+			{
+			}
+
+			/*!
+			* Creates a failed result.
+			* \param[in] error: The error.
+			*/
+			Result(Error error) noexcept : m_error(std::move(error))
+			{
+			}
+
+			/*!
+			* Checks if the call succeeded.
+			* \returns True if the result holds a value, false if it holds an error.
+			*/
+			bool ok() const noexcept { return m_error.code == ErrorCode::NONE; }
+
+			/*!
+			* Checks if the call succeeded.
+			* \returns True if the result holds a value, false if it holds an error.
+			*/
+			explicit operator bool() const noexcept { return ok(); }
+
+			/*!
+			* Returns the value. Only meaningful if the call succeeded.
+			* \returns the value.
+			*/
+			const T& value() const noexcept { return m_value; }
+
+			/*!
+			* Returns the error. Only meaningful if the call failed.
+			* \returns the error.
+			*/
+			const Error& error() const noexcept { return m_error; }
+
+			/*!
+			* Returns the value or throws the exception that matches the error.
+			* \returns the value.
+			* \throws HALException if the call failed.
+			*/
+			const T& value_or_raise() const
+			{
+				if (!ok())
+				{
+					m_error.raise();
+				}
+				return m_value;
+			}
+
+		private:
+			T m_value{};
+			Error m_error{};
+		};
+
+		//! The result of a call without a value.
+		template <>
+		class Result<void>
+		{
+		public:
+			/*!
+			* Creates a successful result.
+			*/
+			Result() noexcept = default;
+
+			/*!
+			* Creates a failed result.
+			* \param[in] error: The error.
+			*/
+			Result(Error error) noexcept : m_error(std::move(error))
+			{
+			}
+
+			/*!
+			* Checks if the call succeeded.
+			* \returns True if the call succeeded, false otherwise.
+			*/
+			bool ok() const noexcept { return m_error.code == ErrorCode::NONE; }
+
+			/*!
+			* Checks if the call succeeded.
+			* \returns True if the call succeeded, false otherwise.
+			*/
+			explicit operator bool() const noexcept { return ok(); }
+
+			/*!
+			* Returns the error. Only meaningful if the call failed.
+			* \returns the error.
+			*/
+			const Error& error() const noexcept { return m_error; }
+
+			/*!
+			* Throws the exception that matches the error if the call failed.
+			* \throws HALException if the call failed.
+			*/
+			void or_raise() const
+			{
+				if (!ok())
+				{
+					m_error.raise();
+				}
+			}
+
+		private:
+			Error m_error{};
+		};
+	}
+}
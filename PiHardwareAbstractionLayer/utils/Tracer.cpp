@@ -0,0 +1,290 @@
+#include "Tracer.h"
+
+#include "../exceptions/HALException.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+struct hal::utils::Tracer::ThreadBuffer
+{
+	/*!
+	* One event of the ring buffer. The fields are atomics because <get_events>"()" may read a slot while the
+	* thread overwrites it; such slots are detected with the write counter and left out.
+	*/
+	struct Slot
+	{
+		std::atomic<const char*> name{""};
+		std::atomic<const char*> category{""};
+		std::atomic<uint64_t> start_ns{0};
+		std::atomic<uint64_t> duration_ns{0};
+		std::atomic<uint8_t> device{0};
+	};
+
+	uint32_t thread_id = 0;
+	std::string thread_name{};
+	bool in_use = true;
+	std::unique_ptr<Slot[]> slots{new Slot[BUFFER_CAPACITY]};
+	std::atomic_uint64_t written = ATOMIC_VAR_INIT(0);
+};
+
+struct hal::utils::Tracer::ThreadBufferOwner
+{
+	ThreadBuffer* buffer = nullptr;
+
+	~ThreadBufferOwner();
+};
+
+namespace
+{
+	thread_local std::string t_thread_name{};
+	thread_local bool t_thread_exiting = false;
+
+	uint64_t to_nanoseconds(const std::chrono::steady_clock::time_point time) noexcept
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+	}
+
+	void append_escaped(std::string& json, const std::string& text)
+	{
+		for (const auto character : text)
+		{
+			if (character == '"' || character == '\\')
+			{
+				json.push_back('\\');
+			}
+			if (static_cast<unsigned char>(character) >= 0x20)
+			{
+				json.push_back(character);
+			}
+		}
+	}
+
+	void append_microseconds(std::string& json, const uint64_t nanoseconds)
+	{
+		char buffer[32];
+		snprintf(buffer, sizeof(buffer), "%llu.%03llu", static_cast<unsigned long long>(nanoseconds / 1000),
+					static_cast<unsigned long long>(nanoseconds % 1000));
+		json.append(buffer);
+	}
+}
+
+std::atomic_bool hal::utils::Tracer::m_enabled(std::getenv(ENABLE_ENVIRONMENT_VARIABLE.c_str()) != nullptr);
+thread_local hal::utils::Tracer::ThreadBuffer* hal::utils::Tracer::m_thread_buffer = nullptr;
+
+hal::utils::Tracer& hal::utils::Tracer::instance()
+{
+	static Tracer inst;
+	return inst;
+}
+
+void hal::utils::Tracer::set_enabled(const bool enabled) noexcept
+{
+	m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void hal::utils::Tracer::record(const char* name, const char* category, const uint8_t device,
+										  const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end) noexcept
+{
+	if (!is_enabled())
+	{
+		return;
+	}
+
+	auto buffer = m_thread_buffer;
+	if (buffer == nullptr)
+	{
+		buffer = instance().add_thread_buffer();
+		if (buffer == nullptr)
+		{
+			return;
+		}
+	}
+
+	// Only this thread writes the buffer, the release store publishes the slot to get_events()
+	const auto index = buffer->written.load(std::memory_order_relaxed);
+	auto& slot = buffer->slots[index % BUFFER_CAPACITY];
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.category.store(category, std::memory_order_relaxed);
+	slot.start_ns.store(to_nanoseconds(start), std::memory_order_relaxed);
+	slot.duration_ns.store(end > start ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) : 0,
+								  std::memory_order_relaxed);
+	slot.device.store(device, std::memory_order_relaxed);
+	buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void hal::utils::Tracer::set_thread_name(const std::string& name)
+{
+	t_thread_name = name;
+	if (m_thread_buffer != nullptr)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_thread_buffer->thread_name = name;
+	}
+}
+
+std::vector<hal::TraceEvent> hal::utils::Tracer::get_events() const
+{
+	std::vector<TraceEvent> events;
+	std::lock_guard<std::mutex> guard(m_mutex);
+	for (const auto& buffer : m_buffers)
+	{
+		const auto written = buffer->written.load(std::memory_order_acquire);
+		const auto first = written > BUFFER_CAPACITY ? written - BUFFER_CAPACITY : 0;
+		const auto copied = events.size();
+		for (auto i = first; i < written; i++)
+		{
+			const auto& slot = buffer->slots[i % BUFFER_CAPACITY];
+			TraceEvent event;
+			event.name = slot.name.load(std::memory_order_relaxed);
+			event.category = slot.category.load(std::memory_order_relaxed);
+			event.thread_id = buffer->thread_id;
+			event.device = slot.device.load(std::memory_order_relaxed);
+			event.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+			event.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+			events.push_back(event);
+		}
+
+		// Slots the thread reached again meanwhile (including the one it may be writing) are not reliable
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const auto reached = buffer->written.load(std::memory_order_relaxed) + 1;
+		const auto valid = reached > BUFFER_CAPACITY ? reached - BUFFER_CAPACITY : 0;
+		if (valid > first)
+		{
+			const auto invalid = static_cast<size_t>(std::min(valid, written) - first);
+			events.erase(events.begin() + static_cast<std::ptrdiff_t>(copied),
+							 events.begin() + static_cast<std::ptrdiff_t>(copied + invalid));
+		}
+	}
+
+	std::sort(events.begin(), events.end(), [](const TraceEvent& lhs, const TraceEvent& rhs)
+	{
+		return lhs.start_ns < rhs.start_ns;
+	});
+	return events;
+}
+
+std::string hal::utils::Tracer::to_chrome_json() const
+{
+	const auto events = get_events();
+	const auto pid = std::to_string(getpid());
+
+	std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	auto first = true;
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		for (const auto& buffer : m_buffers)
+		{
+			json.append(first ? "\n" : ",\n");
+			first = false;
+			json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":").append(pid)
+				 .append(",\"tid\":").append(std::to_string(buffer->thread_id)).append(",\"args\":{\"name\":\"");
+			append_escaped(json, buffer->thread_name.empty() ? std::string("thread ").append(std::to_string(buffer->thread_id)) : buffer->thread_name);
+			json.append("\"}}");
+		}
+	}
+
+	char device[8];
+	for (const auto& event : events)
+	{
+		json.append(first ? "\n" : ",\n");
+		first = false;
+		json.append("{\"name\":\"");
+		append_escaped(json, event.name);
+		json.append("\",\"cat\":\"");
+		append_escaped(json, event.category);
+		json.append("\",\"ph\":\"X\",\"pid\":").append(pid).append(",\"tid\":").append(std::to_string(event.thread_id)).append(",\"ts\":");
+		append_microseconds(json, event.start_ns);
+		json.append(",\"dur\":");
+		append_microseconds(json, event.duration_ns);
+		snprintf(device, sizeof(device), "0x%02X", event.device);
+		json.append(",\"args\":{\"device\":\"").append(device).append("\"}}");
+	}
+	json.append("\n]}\n");
+	return json;
+}
+
+void hal::utils::Tracer::dump(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file.is_open())
+	{
+		throw exception::HALException("Tracer", "dump", std::string("Could not open the trace file '").append(path).append("'."));
+	}
+
+	file << to_chrome_json();
+	if (!file.good())
+	{
+		throw exception::HALException("Tracer", "dump", std::string("Could not write the trace file '").append(path).append("'."));
+	}
+}
+
+void hal::utils::Tracer::clear() noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	for (auto& buffer : m_buffers)
+	{
+		buffer->written.store(0, std::memory_order_release);
+	}
+}
+
+hal::utils::Tracer::ThreadBufferOwner::~ThreadBufferOwner()
+{
+	// Events recorded by later thread_local destructors of this thread are dropped
+	t_thread_exiting = true;
+	if (buffer != nullptr)
+	{
+		instance().release_thread_buffer(buffer);
+		m_thread_buffer = nullptr;
+	}
+}
+
+hal::utils::Tracer::ThreadBuffer* hal::utils::Tracer::add_thread_buffer() noexcept
+{
+	if (t_thread_exiting)
+	{
+		return nullptr;
+	}
+
+	try
+	{
+		static thread_local ThreadBufferOwner owner;
+
+		std::lock_guard<std::mutex> guard(m_mutex);
+		const auto free_buffer = std::find_if(m_buffers.begin(), m_buffers.end(), [](const std::shared_ptr<ThreadBuffer>& buffer)
+		{
+			return !buffer->in_use;
+		});
+		ThreadBuffer* buffer;
+		if (free_buffer != m_buffers.end())
+		{
+			// The events of the exited thread are discarded
+			buffer = free_buffer->get();
+			buffer->written.store(0, std::memory_order_release);
+		}
+		else
+		{
+			m_buffers.push_back(std::make_shared<ThreadBuffer>());
+			buffer = m_buffers.back().get();
+		}
+		buffer->in_use = true;
+		buffer->thread_id = ++m_thread_count;
+		buffer->thread_name = t_thread_name;
+
+		owner.buffer = buffer;
+		m_thread_buffer = buffer;
+		return buffer;
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+void hal::utils::Tracer::release_thread_buffer(ThreadBuffer* buffer) noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	buffer->in_use = false;
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "../structs/TraceEvent.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Records traced operations of all threads and exports them as Chrome trace.
+		/*!
+		* Records traced operations (tick, lock wait, i2c transfers, conversion waits, compensation, callbacks, ...)
+		* with steady_clock timestamps. Each thread writes into a ring buffer of its own, so recording takes no lock
+		* and never blocks: a few relaxed atomic stores. If a buffer is full the oldest events are overwritten. The
+		* buffer of a thread that exited is kept for the export until a new thread takes it over.
+		*
+		* Tracing is switched on and off at runtime with <set_enabled>"()" (or the environment variable
+		* "HAL_TRACE" at startup). While it is off an operation costs one relaxed atomic load. The buffers of all
+		* threads can be written as Chrome trace JSON, which chrome://tracing and https://ui.perfetto.dev display.
+		*/
+		class Tracer
+		{
+		public:
+			/*!
+			* Access the singleton instance of this class.
+			* \returns the singleton instance of this class.
+			*/
+			static Tracer& instance();
+
+			Tracer(const Tracer&) = delete;
+			Tracer(Tracer&&) = delete;
+			Tracer& operator=(const Tracer&) = delete;
+			Tracer& operator=(Tracer&&) = delete;
+
+			/*!
+			* Checks if tracing is switched on.
+			* \returns True if operations are recorded, false otherwise.
+			*/
+			static bool is_enabled() noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+			/*!
+			* Switches tracing on or off. Recorded events are kept.
+			* \param[in] enabled: True to record operations, false to stop recording.
+			*/
+			static void set_enabled(bool enabled) noexcept;
+
+			//! Records an operation of the calling thread.
+			/*!
+			* Records an operation of the calling thread if tracing is switched on. The buffer of the thread is
+			* taken over from an exited thread or created with the first event. Use \sa { HAL::Utils::TraceScope } to trace a block.
+			* \param[in] name: The name of the operation (string literal).
+			* \param[in] category: The category of the operation (string literal).
+			* \param[in] device: The i2c address of the device or the pin of the sensor (0 if not known).
+			* \param[in] start: The start of the operation.
+			* \param[in] end: The end of the operation.
+			*/
+			static void record(const char* name, const char* category, uint8_t device, std::chrono::steady_clock::time_point start,
+									 std::chrono::steady_clock::time_point end) noexcept;
+
+			//! Names the calling thread in the exported trace.
+			/*!
+			* Names the calling thread in the exported trace, e.g. after the sensor it serves.
+			* \param[in] name: The name of the thread.
+			*/
+			void set_thread_name(const std::string& name);
+
+			//! Returns the recorded events of all threads.
+			/*!
+			* Returns the recorded events of all threads sorted by their start. Tracing may go on meanwhile; events
+			* that are overwritten during the copy are left out.
+			* \returns the recorded events.
+			*/
+			std::vector<TraceEvent> get_events() const;
+
+			//! Formats the recorded events as Chrome trace JSON.
+			/*!
+			* Formats the recorded events of all threads as Chrome trace JSON (complete events and thread names).
+			* \returns the JSON document.
+			*/
+			std::string to_chrome_json() const;
+
+			//! Writes the recorded events to a Chrome trace JSON file.
+			/*!
+			* Writes the recorded events of all threads to a Chrome trace JSON file.
+			* \param[in] path: The path of the file. An existing file is replaced.
+			* \throws HALException if the file could not be written.
+			*/
+			void dump(const std::string& path) const;
+
+			//! Discards all recorded events.
+			/*!
+			* Discards all recorded events. Should be called while tracing is switched off, otherwise events that are
+			* recorded during the call may survive.
+			*/
+			void clear() noexcept;
+
+			/*! The number of events each thread keeps. */
+			static constexpr uint32_t BUFFER_CAPACITY = 4096;
+
+			/*! The environment variable that switches tracing on at startup (any value). */
+			inline static const std::string ENABLE_ENVIRONMENT_VARIABLE = "HAL_TRACE";
+
+		private:
+			/*!
+			* Default constructor.
+			*/
+			Tracer() = default;
+
+			/*!
+			* The ring buffer of one thread. Defined in the source file.
+			*/
+			struct ThreadBuffer;
+
+			/*!
+			* Hands the buffer back when its thread exits. Defined in the source file.
+			*/
+			struct ThreadBufferOwner;
+
+			/*!
+			* Assigns a buffer to the calling thread. The buffer of an exited thread is reused, otherwise a new one is created.
+			* \returns the buffer or nullptr if it could not be created.
+			*/
+			ThreadBuffer* add_thread_buffer() noexcept;
+
+			/*!
+			* Marks the buffer of an exiting thread as free. Its events are kept until the buffer is reused.
+			* \param[in] buffer: The buffer of the exiting thread.
+			*/
+			void release_thread_buffer(ThreadBuffer* buffer) noexcept;
+
+			mutable std::mutex m_mutex{};
+			std::vector<std::shared_ptr<ThreadBuffer>> m_buffers{};
+			uint32_t m_thread_count = 0;
+			static std::atomic_bool m_enabled;
+			static thread_local ThreadBuffer* m_thread_buffer;
+		};
+
+		//! Traces the enclosing block.
+		/*!
+		* Traces the enclosing block: the start is taken by the constructor, the event is recorded by the destructor.
+		* Nothing is recorded if tracing was switched off when the block started.
+		*/
+		class TraceScope
+		{
+		public:
+			TraceScope() = delete;
+			TraceScope(const TraceScope&) = delete;
+			TraceScope(TraceScope&&) = delete;
+			TraceScope& operator=(const TraceScope&) = delete;
+			TraceScope& operator=(TraceScope&&) = delete;
+
+			/*!
+			* Constructor that starts the traced block.
+			* \param[in] name: The name of the operation (string literal).
+			* \param[in] category: The category of the operation (string literal).
+			* \param[in] device: The i2c address of the device or the pin of the sensor (0 if not known).
+			*/
+			TraceScope(const char* name, const char* category, const uint8_t device = 0) noexcept
+				: m_name(name), m_category(category), m_device(device), m_active(Tracer::is_enabled())
+			{
+				if (m_active)
+				{
+					m_start = std::chrono::steady_clock::now();
+				}
+			}
+
+			/*!
+			* Destructor that records the traced block.
+			*/
+			~TraceScope()
+			{
+				if (m_active)
+				{
+					Tracer::record(m_name, m_category, m_device, m_start, std::chrono::steady_clock::now());
+				}
+			}
+
+		private:
+			const char* m_name;
+			const char* m_category;
+			uint8_t m_device;
+			bool m_active;
+			std::chrono::steady_clock::time_point m_start{};
+		};
+	}
+}
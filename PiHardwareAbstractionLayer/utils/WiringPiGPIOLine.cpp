@@ -0,0 +1,197 @@
+#include "WiringPiGPIOLine.h"
+
+#include "../exceptions/GPIOException.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#if __has_include(<wiringPi.h>)
+#include <wiringPi.h>
+#define HAL_HAS_WIRING_PI 1
+#else
+#define HAL_HAS_WIRING_PI 0
+#endif
+
+namespace
+{
+	constexpr int WIRING_PI_PIN_COUNT = 32;
+
+	// wiringPi handlers have no argument, so every pin gets its own handler that looks up the line here
+	std::array<std::atomic<hal::utils::WiringPiGPIOLine*>, WIRING_PI_PIN_COUNT> interrupt_lines{};
+
+	// Held while a handler forwards to its line, so a closing line can wait until it is not used anymore
+	std::array<std::mutex, WIRING_PI_PIN_COUNT> handler_mutexes{};
+
+	// wiringPi can not remove a handler. A pin keeps its handler and only the line it forwards to changes.
+	std::array<std::atomic_bool, WIRING_PI_PIN_COUNT> handler_installed{};
+
+	std::once_flag setup_flag{};
+	int setup_result = 0;
+}
+
+template <int Pin>
+void hal::utils::WiringPiGPIOLine::interrupt_handler()
+{
+	std::lock_guard<std::mutex> guard(handler_mutexes[Pin]);
+	auto line = interrupt_lines[Pin].load();
+	if (line != nullptr)
+	{
+		line->on_interrupt();
+	}
+}
+
+template <int... Pins>
+constexpr std::array<void (*)(), sizeof...(Pins)> hal::utils::WiringPiGPIOLine::make_interrupt_handlers(std::integer_sequence<int, Pins...>)
+{
+	return { &interrupt_handler<Pins>... };
+}
+
+hal::utils::WiringPiGPIOLine::WiringPiGPIOLine(const int wiring_pi_pin, const bool output, const GPIOEdge edge)
+	: m_pin(wiring_pi_pin),
+		m_edge(output ? GPIOEdge::NONE : edge)
+{
+#if HAL_HAS_WIRING_PI
+	if (m_pin < 0 || m_pin >= WIRING_PI_PIN_COUNT)
+	{
+		throw exception::GPIOException("WiringPiGPIOLine", "WiringPiGPIOLine", static_cast<uint8_t>(m_pin), "Invalid wiringPi pin number.");
+	}
+
+	std::call_once(setup_flag, []() { setup_result = wiringPiSetup(); });
+	if (setup_result != 0)
+	{
+		throw exception::GPIOException("WiringPiGPIOLine", "WiringPiGPIOLine", static_cast<uint8_t>(m_pin), "Could not initialize wiringPi.");
+	}
+
+	pinMode(m_pin, output ? OUTPUT : INPUT);
+	if (m_edge == GPIOEdge::NONE)
+	{
+		return;
+	}
+
+	m_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+	if (m_event_fd < 0)
+	{
+		throw exception::GPIOException("WiringPiGPIOLine", "WiringPiGPIOLine", static_cast<uint8_t>(m_pin),
+												std::string("Could not create eventfd: ").append(strerror(errno)));
+	}
+
+	WiringPiGPIOLine* expected = nullptr;
+	if (!interrupt_lines[m_pin].compare_exchange_strong(expected, this))
+	{
+		::close(m_event_fd);
+		m_event_fd = -1;
+		throw exception::GPIOException("WiringPiGPIOLine", "WiringPiGPIOLine", static_cast<uint8_t>(m_pin),
+												"Another line already watches the edges of this pin.");
+	}
+
+	// The handler always reports both edges, the line filters them. This way a pin can be reused with other edges.
+	static constexpr auto handlers = make_interrupt_handlers(std::make_integer_sequence<int, WIRING_PI_PIN_COUNT>{});
+	if (!handler_installed[m_pin].exchange(true) && wiringPiISR(m_pin, INT_EDGE_BOTH, handlers[m_pin]) < 0)
+	{
+		handler_installed[m_pin] = false;
+		interrupt_lines[m_pin] = nullptr;
+		::close(m_event_fd);
+		m_event_fd = -1;
+		throw exception::GPIOException("WiringPiGPIOLine", "WiringPiGPIOLine", static_cast<uint8_t>(m_pin),
+												"Could not install interrupt handler.");
+	}
+#else
+	throw exception::GPIOException("WiringPiGPIOLine", "WiringPiGPIOLine", static_cast<uint8_t>(wiring_pi_pin),
+											"The HAL was built without wiringPi.");
+#endif
+}
+
+hal::utils::WiringPiGPIOLine::~WiringPiGPIOLine()
+{
+	close();
+}
+
+int hal::utils::WiringPiGPIOLine::get_value()
+{
+#if HAL_HAS_WIRING_PI
+	return digitalRead(m_pin) == LOW ? 0 : 1;
+#else
+	return 0;
+#endif
+}
+
+void hal::utils::WiringPiGPIOLine::set_value(const int value)
+{
+#if HAL_HAS_WIRING_PI
+	digitalWrite(m_pin, value == 0 ? LOW : HIGH);
+#endif
+}
+
+int hal::utils::WiringPiGPIOLine::get_event_fd() const noexcept
+{
+	return m_edge == GPIOEdge::NONE ? -1 : m_event_fd;
+}
+
+bool hal::utils::WiringPiGPIOLine::read_event(GPIOEvent& event)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_events.empty())
+	{
+		return false;
+	}
+
+	uint64_t counter;
+	if (read(m_event_fd, &counter, sizeof(counter)) != sizeof(counter))
+	{
+		return false;
+	}
+
+	event = m_events.front();
+	m_events.pop_front();
+	return true;
+}
+
+void hal::utils::WiringPiGPIOLine::close() noexcept
+{
+	if (m_pin >= 0 && m_pin < WIRING_PI_PIN_COUNT)
+	{
+		// Waits for a handler that is still forwarding an edge to this line
+		std::lock_guard<std::mutex> handler_guard(handler_mutexes[m_pin]);
+		WiringPiGPIOLine* expected = this;
+		interrupt_lines[m_pin].compare_exchange_strong(expected, nullptr);
+	}
+
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_event_fd >= 0)
+	{
+		::close(m_event_fd);
+		m_event_fd = -1;
+	}
+	m_events.clear();
+}
+
+void hal::utils::WiringPiGPIOLine::on_interrupt() noexcept
+{
+	timespec now{};
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	// wiringPi does not pass the edge, the level right after the interrupt tells it
+	const auto edge = get_value() == 1 ? GPIOEdge::RISING : GPIOEdge::FALLING;
+	if (m_edge != GPIOEdge::BOTH && m_edge != edge)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_event_fd < 0)
+	{
+		return;
+	}
+
+	GPIOEvent event;
+	event.edge = edge;
+	event.timestamp_ns = static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+	m_events.push_back(event);
+
+	const uint64_t increment = 1;
+	write(m_event_fd, &increment, sizeof(increment));
+}
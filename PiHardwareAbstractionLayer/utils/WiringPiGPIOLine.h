@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../enums/GPIOEdge.h"
+#include "../interfaces/IGPIOLine.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace hal
+{
+	namespace utils
+	{
+		//! Class that accesses a single GPIO line via wiringPi.
+		/*!
+		* This class wraps the wiringPi calls the sensors used before the GPIO character device was supported.
+		* Edges are detected by a wiringPi interrupt handler which reads the level, timestamps the edge with
+		* CLOCK_MONOTONIC and queues it. Like the other lines the queue is signalled via an eventfd so it can be
+		* watched by \sa { HAL::Utils::EventScheduler }. wiringPi handlers can not be removed, so a closed line only
+		* stops queueing events. If the HAL is built without wiringPi the constructor throws.
+		*/
+		class WiringPiGPIOLine final : public interfaces::IGPIOLine
+		{
+		public:
+			WiringPiGPIOLine() = delete;
+			WiringPiGPIOLine(const WiringPiGPIOLine&) = delete;
+			WiringPiGPIOLine(WiringPiGPIOLine&&) = delete;
+			WiringPiGPIOLine& operator=(const WiringPiGPIOLine&) = delete;
+			WiringPiGPIOLine& operator=(WiringPiGPIOLine&&) = delete;
+
+			//! Configures a GPIO pin via wiringPi.
+			/*!
+			* Configures a GPIO pin via wiringPi. Initializes wiringPi on first use.
+			* \param[in] wiring_pi_pin: The wiringPi pin number (0 - 31).
+			* \param[in] output: True to use the pin as output, false to use it as input.
+			* \param[in] edge: The edges to report. Only used for input lines.
+			* \throws GPIOException if wiringPi is not available or could not be initialized.
+			* \throws GPIOException if the pin number is out of range or another line already watches its edges.
+			* \throws GPIOException if the event file descriptor or the interrupt handler could not be created.
+			*/
+			WiringPiGPIOLine(int wiring_pi_pin, bool output, GPIOEdge edge);
+
+			~WiringPiGPIOLine();
+
+			/*!
+			* Returns the current logical value of the line.
+			* \returns 0 if the line is LOW, 1 if it is HIGH.
+			*/
+			int get_value() override;
+
+			/*!
+			* Sets the logical value of an output line.
+			* \param[in] value: 0 to drive the line LOW, any other value to drive it HIGH.
+			*/
+			void set_value(int value) override;
+
+			/*!
+			* Returns the file descriptor that becomes readable if an edge was detected.
+			* \returns the event file descriptor or -1 if the line was not requested with edge detection.
+			*/
+			int get_event_fd() const noexcept override;
+
+			/*!
+			* Reads the next pending edge event from the queue.
+			* \param[out] event: The detected edge and its timestamp.
+			* \returns True if an event was read, false otherwise.
+			*/
+			bool read_event(GPIOEvent& event) override;
+
+			/*!
+			* Stops queueing events and closes the event file descriptor. Waits for an interrupt handler that is still
+			* forwarding an edge to this line, so the line can be destroyed afterwards.
+			*/
+			void close() noexcept override;
+
+		private:
+			//! Queues an edge that was detected by the interrupt handler of the pin.
+			/*!
+			* Queues an edge that was detected by the interrupt handler of the pin. Executed on the wiringPi interrupt thread.
+			*/
+			void on_interrupt() noexcept;
+
+			template <int Pin>
+			static void interrupt_handler();
+
+			template <int... Pins>
+			static constexpr std::array<void (*)(), sizeof...(Pins)> make_interrupt_handlers(std::integer_sequence<int, Pins...>);
+
+			int m_pin;
+			GPIOEdge m_edge;
+			int m_event_fd = -1;
+			std::deque<GPIOEvent> m_events{};
+			std::mutex m_mutex{};
+		};
+	}
+}
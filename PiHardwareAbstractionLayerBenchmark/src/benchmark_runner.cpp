@@ -0,0 +1,190 @@
+#include "benchmark_runner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <numeric>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace
+{
+	// Upper bound of the iterations so calibrating very cheap operations terminates
+	constexpr uint64_t MAX_ITERATIONS = 1000000000;
+
+	std::string escape_json(const std::string& value)
+	{
+		std::string escaped;
+		for (const auto c : value)
+		{
+			switch (c)
+			{
+			case '"':
+				escaped += "\\\"";
+				break;
+			case '\\':
+				escaped += "\\\\";
+				break;
+			case '\n':
+				escaped += "\\n";
+				break;
+			default:
+				if (static_cast<unsigned char>(c) >= 0x20)
+				{
+					escaped += c;
+				}
+				break;
+			}
+		}
+		return escaped;
+	}
+
+	double run_iterations(const benchmark::benchmark_runner::benchmark_function& function, benchmark::benchmark_state& state)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		function(state);
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	}
+}
+
+void benchmark::benchmark_runner::add(const std::string& name, const benchmark_function& function)
+{
+	m_benchmarks.emplace_back(name, function);
+}
+
+std::vector<std::string> benchmark::benchmark_runner::get_names() const
+{
+	std::vector<std::string> names;
+	for (const auto& benchmark : m_benchmarks)
+	{
+		names.push_back(benchmark.first);
+	}
+	return names;
+}
+
+std::vector<benchmark::benchmark_result> benchmark::benchmark_runner::run(const std::string& filter, std::ostream& progress) const
+{
+	std::vector<benchmark_result> results;
+	progress << std::left << std::setw(48) << "benchmark" << std::right << std::setw(14) << "median ns" << std::setw(14) << "min ns"
+		<< std::setw(12) << "iterations" << std::endl;
+	for (const auto& benchmark : m_benchmarks)
+	{
+		if (!filter.empty() && benchmark.first.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		try
+		{
+			results.push_back(run_one(benchmark.first, benchmark.second));
+		}
+		catch (std::exception& ex)
+		{
+			progress << std::left << std::setw(48) << benchmark.first << " failed: " << ex.what() << std::endl;
+			continue;
+		}
+
+		const auto& result = results.back();
+		progress << std::left << std::setw(48) << result.name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(14) << result.median_ns << std::setw(14) << result.min_ns << std::setw(12) << result.iterations;
+		for (const auto& counter : result.counters)
+		{
+			progress << "  " << counter.first << "=" << std::setprecision(2) << counter.second;
+		}
+		progress << std::endl;
+	}
+	return results;
+}
+
+benchmark::benchmark_result benchmark::benchmark_runner::run_one(const std::string& name, const benchmark_function& function) const
+{
+	// Increases the iterations until one run takes the minimum time
+	const auto min_time_ns = static_cast<double>(m_min_time_ms) * 1000000.0;
+	uint64_t iterations = 1;
+	while (true)
+	{
+		benchmark_state state;
+		state.iterations = iterations;
+		const auto elapsed_ns = run_iterations(function, state);
+		if (elapsed_ns >= min_time_ns || iterations >= MAX_ITERATIONS)
+		{
+			break;
+		}
+
+		const auto factor = elapsed_ns > 0 ? min_time_ns * 1.2 / elapsed_ns : 10.0;
+		iterations = std::min(MAX_ITERATIONS, static_cast<uint64_t>(static_cast<double>(iterations) * std::clamp(factor, 2.0, 10.0)));
+	}
+
+	std::vector<double> times;
+	std::map<std::string, double> counters;
+	for (uint32_t i = 0; i < m_repetitions; i++)
+	{
+		benchmark_state state;
+		state.iterations = iterations;
+		times.push_back(run_iterations(function, state) / static_cast<double>(iterations));
+		for (const auto& counter : state.counters)
+		{
+			counters[counter.first] += counter.second / static_cast<double>(iterations) / m_repetitions;
+		}
+	}
+
+	benchmark_result result;
+	result.name = name;
+	result.iterations = iterations;
+	result.repetitions = m_repetitions;
+	result.counters = counters;
+	result.mean_ns = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+	double variance = 0;
+	for (const auto time : times)
+	{
+		variance += (time - result.mean_ns) * (time - result.mean_ns);
+	}
+	result.stddev_ns = std::sqrt(variance / times.size());
+	std::sort(times.begin(), times.end());
+	result.min_ns = times.front();
+	result.max_ns = times.back();
+	result.median_ns = times.size() % 2 == 1 ? times[times.size() / 2] : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+	return result;
+}
+
+void benchmark::benchmark_runner::write_json(std::ostream& output, const std::vector<benchmark_result>& results, const std::string& label)
+{
+	char hostname[256] = {0};
+	gethostname(hostname, sizeof(hostname) - 1);
+	const auto now = std::time(nullptr);
+	std::tm date{};
+	gmtime_r(&now, &date);
+
+	output << std::setprecision(10);
+	output << "{\n  \"context\": {\n";
+	output << "    \"date\": \"" << std::put_time(&date, "%Y-%m-%dT%H:%M:%SZ") << "\",\n";
+	output << "    \"host\": \"" << escape_json(hostname) << "\",\n";
+	output << "    \"label\": \"" << escape_json(label) << "\",\n";
+	output << "    \"compiler\": \"" << escape_json(__VERSION__) << "\",\n";
+#ifdef NDEBUG
+	output << "    \"build_type\": \"release\"\n";
+#else
+	output << "    \"build_type\": \"debug\"\n";
+#endif
+	output << "  },\n  \"benchmarks\": [";
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const auto& result = results[i];
+		output << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << escape_json(result.name) << "\", \"iterations\": " << result.iterations
+			<< ", \"repetitions\": " << result.repetitions << ", \"median_ns\": " << result.median_ns << ", \"min_ns\": " << result.min_ns
+			<< ", \"mean_ns\": " << result.mean_ns << ", \"max_ns\": " << result.max_ns << ", \"stddev_ns\": " << result.stddev_ns;
+		if (!result.counters.empty())
+		{
+			output << ", \"counters\": {";
+			for (auto counter = result.counters.begin(); counter != result.counters.end(); ++counter)
+			{
+				output << (counter == result.counters.begin() ? "" : ", ") << "\"" << escape_json(counter->first) << "\": " << counter->second;
+			}
+			output << "}";
+		}
+		output << "}";
+	}
+	output << "\n  ]\n}" << std::endl;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+	//! Prevents the compiler from removing a computation whose result is not used.
+	/*!
+	* Prevents the compiler from removing a computation whose result is not used.
+	* \param[in] value: The result of the computation.
+	*/
+	template <typename T>
+	inline void do_not_optimize(const T& value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	//! State that is given to a benchmark function.
+	/*!
+	* State that is given to a benchmark function. The function has to execute the measured operation
+	* 'iterations' times and may report additional values per iteration (e.g. bus transactions).
+	*/
+	struct benchmark_state
+	{
+		/*! The number of times the measured operation has to be executed. */
+		uint64_t iterations = 0;
+
+		/*! Additional values of the run. They are divided by the number of iterations when reported. */
+		std::map<std::string, double> counters{};
+	};
+
+	//! The result of one benchmark.
+	/*!
+	* The result of one benchmark. All times are nanoseconds per iteration.
+	*/
+	struct benchmark_result
+	{
+		std::string name;
+		uint64_t iterations = 0;
+		uint32_t repetitions = 0;
+		double min_ns = 0;
+		double median_ns = 0;
+		double mean_ns = 0;
+		double max_ns = 0;
+		double stddev_ns = 0;
+		std::map<std::string, double> counters{};
+	};
+
+	//! Class that registers, runs and reports benchmarks.
+	/*!
+	* Class that registers, runs and reports benchmarks. The number of iterations of a benchmark is increased
+	* until one run takes at least the minimum time, afterwards the benchmark is repeated with this number of
+	* iterations. The median of the repetitions is the value to compare between commits.
+	*/
+	class benchmark_runner
+	{
+	public:
+		using benchmark_function = std::function<void(benchmark_state&)>;
+
+		//! Registers a benchmark.
+		/*!
+		* Registers a benchmark.
+		* \param[in] name: The unique name of the benchmark (e.g. "bme280/compensate_temperature").
+		* \param[in] function: The function that executes the measured operation.
+		*/
+		void add(const std::string& name, const benchmark_function& function);
+
+		//! Runs all benchmarks whose name contains the filter.
+		/*!
+		* Runs all benchmarks whose name contains the filter and prints the progress to the given stream.
+		* \param[in] filter: The part of the name to select benchmarks or "" to run all.
+		* \param[in] progress: The stream that receives the human readable results.
+		* \returns the results in registration order.
+		*/
+		std::vector<benchmark_result> run(const std::string& filter, std::ostream& progress) const;
+
+		//! Returns the names of all registered benchmarks.
+		std::vector<std::string> get_names() const;
+
+		//! Changes the minimum duration of one run.
+		void set_min_time_ms(uint32_t min_time_ms) noexcept { m_min_time_ms = min_time_ms; }
+
+		//! Changes the number of measured repetitions.
+		void set_repetitions(uint32_t repetitions) noexcept { m_repetitions = repetitions > 0 ? repetitions : 1; }
+
+		//! Writes the results as JSON.
+		/*!
+		* Writes the results as JSON object with a 'context' describing the run and a 'benchmarks' array.
+		* \param[in] output: The stream to write to.
+		* \param[in] results: The results to write.
+		* \param[in] label: A free text stored in the context (e.g. the commit hash).
+		*/
+		static void write_json(std::ostream& output, const std::vector<benchmark_result>& results, const std::string& label);
+
+	private:
+		/*!
+		* Runs one benchmark.
+		* \param[in] name: The name of the benchmark.
+		* \param[in] function: The function of the benchmark.
+		* \returns the result of the benchmark.
+		*/
+		benchmark_result run_one(const std::string& name, const benchmark_function& function) const;
+
+		std::vector<std::pair<std::string, benchmark_function>> m_benchmarks{};
+		uint32_t m_min_time_ms = 200;
+		uint32_t m_repetitions = 5;
+	};
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "benchmark_runner.h"
+
+namespace benchmark
+{
+	//! Registers the benchmarks of the BME280 compensation and parsing.
+	void add_bme280_benchmarks(benchmark_runner& runner);
+
+	//! Registers the benchmarks of the HAL utilities (bit manipulation, enum conversion, timezones, string parsing).
+	void add_utils_benchmarks(benchmark_runner& runner);
+
+	//! Registers the benchmarks of the callback fan-out and the sensor ticks against the simulated i2c bus.
+	void add_sensor_benchmarks(benchmark_runner& runner);
+}
@@ -0,0 +1,105 @@
+#include "benchmarks.h"
+#include "../../PiHardwareAbstractionLayer/sensors/i2c/BME280.h"
+
+#include <array>
+
+using namespace hal::sensors::i2c::bme280;
+
+namespace
+{
+	// Calibration of the datasheet example (chapter 8.1)
+	CalibrationData example_calibration()
+	{
+		auto calibration = CalibrationData();
+		calibration.temperature_calibration_reg_1 = 27504;
+		calibration.temperature_calibration_reg_2 = 26435;
+		calibration.temperature_calibration_reg_3 = -1000;
+		calibration.pressure_calibration_reg_1 = 36477;
+		calibration.pressure_calibration_reg_2 = -10685;
+		calibration.pressure_calibration_reg_3 = 3024;
+		calibration.pressure_calibration_reg_4 = 2855;
+		calibration.pressure_calibration_reg_5 = 140;
+		calibration.pressure_calibration_reg_6 = -7;
+		calibration.pressure_calibration_reg_7 = 15500;
+		calibration.pressure_calibration_reg_8 = -14600;
+		calibration.pressure_calibration_reg_9 = 6000;
+		calibration.humidity_calibration_reg_1 = 75;
+		calibration.humidity_calibration_reg_2 = 362;
+		calibration.humidity_calibration_reg_3 = 0;
+		calibration.humidity_calibration_reg_4 = 324;
+		calibration.humidity_calibration_reg_5 = 50;
+		calibration.humidity_calibration_reg_6 = 30;
+		return calibration;
+	}
+
+	// Raw values around the datasheet example so the compensation cannot be folded into a constant
+	template <size_t N>
+	std::array<int32_t, N> raw_values(const int32_t center, const int32_t step)
+	{
+		std::array<int32_t, N> values{};
+		for (size_t i = 0; i < N; i++)
+		{
+			values[i] = center + static_cast<int32_t>(i) * step - static_cast<int32_t>(N / 2) * step;
+		}
+		return values;
+	}
+}
+
+void benchmark::add_bme280_benchmarks(benchmark_runner& runner)
+{
+	runner.add("bme280/compensate_temperature", [](benchmark_state& state)
+	{
+		auto calibration = example_calibration();
+		const auto values = raw_values<64>(519888, 97);
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(BME280::compensate_temperature(calibration, values[i & 63]));
+		}
+	});
+
+	runner.add("bme280/compensate_pressure", [](benchmark_state& state)
+	{
+		auto calibration = example_calibration();
+		BME280::compensate_temperature(calibration, 519888);
+		const auto values = raw_values<64>(415148, 131);
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(BME280::compensate_pressure(calibration, values[i & 63]));
+		}
+	});
+
+	runner.add("bme280/compensate_humidity", [](benchmark_state& state)
+	{
+		auto calibration = example_calibration();
+		BME280::compensate_temperature(calibration, 519888);
+		const auto values = raw_values<64>(30000, 53);
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(BME280::compensate_humidity(calibration, values[i & 63]));
+		}
+	});
+
+	runner.add("bme280/parse_raw_data", [](benchmark_state& state)
+	{
+		uint8_t data[8] = {0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x75, 0x30};
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			data[2] = static_cast<uint8_t>(i << 4);
+			do_not_optimize(BME280::parse_raw_data(data));
+		}
+	});
+
+	runner.add("bme280/parse_and_compensate_all", [](benchmark_state& state)
+	{
+		auto calibration = example_calibration();
+		uint8_t data[8] = {0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x75, 0x30};
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			data[2] = static_cast<uint8_t>(i << 4);
+			const auto raw = BME280::parse_raw_data(data);
+			do_not_optimize(BME280::compensate_temperature(calibration, static_cast<int32_t>(raw->temperature)));
+			do_not_optimize(BME280::compensate_pressure(calibration, static_cast<int32_t>(raw->pressure)));
+			do_not_optimize(BME280::compensate_humidity(calibration, static_cast<int32_t>(raw->humidity)));
+		}
+	});
+}
@@ -0,0 +1,91 @@
+#include "benchmark_runner.h"
+#include "benchmarks.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	void print_usage()
+	{
+		std::cout << "Usage: PiHardwareAbstractionLayerBenchmark [options]\n"
+			<< "  --filter <text>       Runs only the benchmarks whose name contains the text.\n"
+			<< "  --json <path>         Writes the results as JSON to the file ('-' for stdout).\n"
+			<< "  --label <text>        Stores the text in the JSON context (e.g. the commit hash).\n"
+			<< "  --min-time-ms <ms>    Minimum duration of one measured run (default 200).\n"
+			<< "  --repetitions <n>     Number of measured runs per benchmark (default 5).\n"
+			<< "  --list                Prints the names of all benchmarks.\n";
+	}
+}
+
+int main(const int argc, char* argv[])
+{
+	benchmark::benchmark_runner runner;
+	benchmark::add_bme280_benchmarks(runner);
+	benchmark::add_utils_benchmarks(runner);
+	benchmark::add_sensor_benchmarks(runner);
+
+	std::string filter;
+	std::string json_path;
+	std::string label;
+	for (auto i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+		const auto has_value = i + 1 < argc;
+		if (argument == "--filter" && has_value)
+		{
+			filter = argv[++i];
+		}
+		else if (argument == "--json" && has_value)
+		{
+			json_path = argv[++i];
+		}
+		else if (argument == "--label" && has_value)
+		{
+			label = argv[++i];
+		}
+		else if (argument == "--min-time-ms" && has_value)
+		{
+			runner.set_min_time_ms(static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+		}
+		else if (argument == "--repetitions" && has_value)
+		{
+			runner.set_repetitions(static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+		}
+		else if (argument == "--list")
+		{
+			for (const auto& name : runner.get_names())
+			{
+				std::cout << name << "\n";
+			}
+			return 0;
+		}
+		else
+		{
+			print_usage();
+			return argument == "--help" ? 0 : 1;
+		}
+	}
+
+	// The table goes to stderr if the JSON is written to stdout, so the output can be piped
+	auto& progress = json_path == "-" ? std::cerr : std::cout;
+	const auto results = runner.run(filter, progress);
+
+	if (json_path == "-")
+	{
+		benchmark::benchmark_runner::write_json(std::cout, results, label);
+	}
+	else if (!json_path.empty())
+	{
+		std::ofstream file(json_path);
+		if (!file.is_open())
+		{
+			std::cerr << "Could not open '" << json_path << "'." << std::endl;
+			return 1;
+		}
+		benchmark::benchmark_runner::write_json(file, results, label);
+	}
+	return 0;
+}
@@ -0,0 +1,142 @@
+#include "benchmarks.h"
+#include "../../PiHardwareAbstractionLayer/Sensor.h"
+#include "../../PiHardwareAbstractionLayer/interfaces/ISensor.h"
+#include "../../PiHardwareAbstractionLayer/sensors/i2c/BME280.h"
+#include "../../PiHardwareAbstractionLayer/sensors/i2c/DS3231.h"
+#include "../../PiHardwareAbstractionLayer/utils/I2CManager.h"
+#include "../../PiHardwareAbstractionLayer/utils/I2CSimulator.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace hal;
+
+namespace
+{
+	// Latency and clock of a transaction on the Raspberry Pi bus, so the ticks include realistic bus times
+	constexpr uint32_t BUS_LATENCY_IN_US = 50;
+	constexpr uint32_t BUS_FREQUENCY_IN_HZ = 400000;
+
+	//! Sensor that only distributes a value to its callbacks like the drivers do after a measurement.
+	class fan_out_sensor final : public interfaces::ISensor
+	{
+	public:
+		void trigger_measurement(const SensorType type) override
+		{
+			m_value += 0.25;
+			for (const auto& handle : get_value_callbacks(type))
+			{
+				handle->callback(std::to_string(m_value));
+			}
+		}
+
+	private:
+		double m_value = 0;
+	};
+
+	std::shared_ptr<utils::I2CSimulator> use_simulated_bus()
+	{
+		static const auto simulator = []()
+		{
+			auto bus = utils::I2CSimulator::create_default();
+			bus->set_transaction_latency(BUS_LATENCY_IN_US);
+			bus->set_bus_frequency(BUS_FREQUENCY_IN_HZ);
+			utils::I2CManager::set_transport(bus);
+			return bus;
+		}();
+		return simulator;
+	}
+
+	void add_fan_out_benchmark(benchmark::benchmark_runner& runner, const uint32_t callbacks)
+	{
+		runner.add(std::string("isensor/callback_fan_out_").append(std::to_string(callbacks)), [callbacks](benchmark::benchmark_state& state)
+		{
+			fan_out_sensor sensor;
+			size_t received = 0;
+			for (uint32_t i = 0; i < callbacks; i++)
+			{
+				sensor.add_value_callback(SensorType::TEMPERATURE, std::make_shared<CallbackHandle>([&received](const std::string& value)
+				{
+					received += value.size();
+				}, i));
+			}
+
+			for (uint64_t i = 0; i < state.iterations; i++)
+			{
+				sensor.trigger_measurement(SensorType::TEMPERATURE);
+			}
+			benchmark::do_not_optimize(received);
+		});
+	}
+
+	//! Adds a benchmark that triggers measurements of an initialized driver with one callback.
+	template <typename T>
+	void add_trigger_benchmark(benchmark::benchmark_runner& runner, const std::string& name, const SensorType type)
+	{
+		runner.add(name, [type](benchmark::benchmark_state& state)
+		{
+			const auto bus = use_simulated_bus();
+			T sensor;
+			sensor.init();
+			size_t received = 0;
+			sensor.add_value_callback(type, std::make_shared<CallbackHandle>([&received](const std::string& value)
+			{
+				received += value.size();
+			}, 1));
+
+			const auto transactions = bus->get_transaction_count();
+			for (uint64_t i = 0; i < state.iterations; i++)
+			{
+				sensor.trigger_measurement(type);
+			}
+			state.counters["bus_transactions"] = static_cast<double>(bus->get_transaction_count() - transactions);
+			sensor.close();
+			benchmark::do_not_optimize(received);
+		});
+	}
+}
+
+void benchmark::add_sensor_benchmarks(benchmark_runner& runner)
+{
+	add_fan_out_benchmark(runner, 1);
+	add_fan_out_benchmark(runner, 8);
+	add_fan_out_benchmark(runner, 64);
+
+	add_trigger_benchmark<sensors::i2c::bme280::BME280>(runner, "sensor/bme280_trigger_measurement", SensorType::TEMPERATURE);
+	add_trigger_benchmark<sensors::i2c::ds3231::DS3231>(runner, "sensor/ds3231_trigger_measurement", SensorType::CLOCK);
+
+	// A complete tick of the sensor thread: callback bookkeeping, measurement and fan-out. Without delay the
+	// thread ticks back to back, so the time per callback is the cost of one tick.
+	runner.add("sensor/bme280_tick", [](benchmark_state& state)
+	{
+		const auto bus = use_simulated_bus();
+		auto driver = new sensors::i2c::bme280::BME280();
+		driver->init();
+
+		std::mutex mutex;
+		std::condition_variable done;
+		uint64_t ticks = 0;
+		const auto transactions = bus->get_transaction_count();
+		Sensor sensor(SensorType::TEMPERATURE, SensorName::BME280, 0, CommunicationType::I2C, "Bosch", nullptr, 0, driver);
+		sensor.add_value_callback([&](const std::string&)
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			if (++ticks == state.iterations)
+			{
+				done.notify_all();
+			}
+		});
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			done.wait(lock, [&]() { return ticks >= state.iterations; });
+		}
+		sensor.shutdown();
+		state.counters["bus_transactions"] = static_cast<double>(bus->get_transaction_count() - transactions);
+	});
+}
@@ -0,0 +1,240 @@
+#include "benchmarks.h"
+#include "../../PiHardwareAbstractionLayer/utils/BitManipulation.h"
+#include "../../PiHardwareAbstractionLayer/utils/EnumConverter.h"
+#include "../../PiHardwareAbstractionLayer/utils/Helper.h"
+#include "../../PiHardwareAbstractionLayer/utils/Metrics.h"
+#include "../../PiHardwareAbstractionLayer/utils/RegisterField.h"
+#include "../../PiHardwareAbstractionLayer/utils/Timezone.h"
+#include "../../PiHardwareAbstractionLayer/utils/Tracer.h"
+
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <vector>
+
+using namespace hal;
+using namespace hal::utils;
+
+void benchmark::add_utils_benchmarks(benchmark_runner& runner)
+{
+	runner.add("bit_manipulation/set_bits", [](benchmark_state& state)
+	{
+		uint8_t byte = 0;
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			BitManipulation::set_bits(byte, static_cast<uint8_t>(i & 0x07), 0x1C);
+			do_not_optimize(byte);
+		}
+	});
+
+	runner.add("bit_manipulation/value_of_bits", [](benchmark_state& state)
+	{
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(BitManipulation::value_of_bits(static_cast<uint8_t>(i), 2, 5));
+		}
+	});
+
+	runner.add("bit_manipulation/count_active_bits", [](benchmark_state& state)
+	{
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(BitManipulation::count_active_bits(static_cast<uint8_t>(i)));
+		}
+	});
+
+	runner.add("bit_manipulation/bcd_round_trip", [](benchmark_state& state)
+	{
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			const auto bcd = BitManipulation::to_bcd(static_cast<uint8_t>(i % 100));
+			do_not_optimize(BitManipulation::from_bcd(static_cast<uint8_t>(bcd & 0x0F), static_cast<uint8_t>(bcd >> 4)));
+		}
+	});
+
+	runner.add("bit_manipulation/combine_bytes", [](benchmark_state& state)
+	{
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(BitManipulation::combine_bytes(static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)));
+		}
+	});
+
+	runner.add("register_field/set", [](benchmark_state& state)
+	{
+		uint8_t byte = 0;
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			Field<0xF4, 2, 3>::set(byte, static_cast<uint8_t>(i & 0x07));
+			do_not_optimize(byte);
+		}
+	});
+
+	runner.add("register_field/decode", [](benchmark_state& state)
+	{
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(Field<0xF4, 2, 4>::decode(static_cast<uint8_t>(i)));
+		}
+	});
+
+	runner.add("enum_converter/string_to_data_rate", [](benchmark_state& state)
+	{
+		const std::string value = "RATE_860_SPS";
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(EnumConverter::string_to_data_rate(value));
+		}
+	});
+
+	// The timezones are compared one after another, so the first and the last value are the best and the worst case
+	runner.add("enum_converter/string_to_timezone_first", [](benchmark_state& state)
+	{
+		const std::string value = "ALPHA_TIME_ZONE__A__PLUS_H01M00";
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(EnumConverter::string_to_timezone(value));
+		}
+	});
+
+	runner.add("enum_converter/string_to_timezone_last", [](benchmark_state& state)
+	{
+		const std::string value = "ZULU_TIME_ZONE__Z__PLUS_H00M00";
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(EnumConverter::string_to_timezone(value));
+		}
+	});
+
+	runner.add("enum_converter/enum_to_string_timezone", [](benchmark_state& state)
+	{
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(EnumConverter::enum_to_string(WorldTimezones::ZULU_TIME_ZONE__Z__PLUS_H00M00));
+		}
+	});
+
+	runner.add("enum_converter/enum_to_string_data_rate", [](benchmark_state& state)
+	{
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			do_not_optimize(EnumConverter::enum_to_string(sensors::i2c::ads1115::DataRate::RATE_860_SPS));
+		}
+	});
+
+	runner.add("timezone/apply_timezone_now", [](benchmark_state& state)
+	{
+		Timezone timezone(WorldTimezones::CENTRAL_EUROPEAN_TIME__CET__PLUS_H01M00);
+		const auto now = std::time(nullptr);
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			auto time = now + static_cast<time_t>(i & 0xFFFF);
+			timezone.apply_timezone(time);
+			do_not_optimize(time);
+		}
+	});
+
+	runner.add("timezone/apply_timezone_now_tm", [](benchmark_state& state)
+	{
+		Timezone timezone(WorldTimezones::CENTRAL_EUROPEAN_TIME__CET__PLUS_H01M00);
+		const auto now = std::time(nullptr);
+		const auto date = *gmtime(&now);
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			auto time = date;
+			time.tm_min = static_cast<int>(i % 60);
+			timezone.apply_timezone(time);
+			do_not_optimize(time);
+		}
+	});
+
+	// Checks the daylight saving time with a Linux command for every call
+	runner.add("timezone/apply_timezone_at_time", [](benchmark_state& state)
+	{
+		Timezone timezone(WorldTimezones::CENTRAL_EUROPEAN_TIME__CET__PLUS_H01M00);
+		const auto now = std::time(nullptr);
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			auto time = now - static_cast<time_t>(i * 86400);
+			timezone.apply_timezone(time, false);
+			do_not_optimize(time);
+		}
+	});
+
+	runner.add("helper/string_to_array_uint8", [](benchmark_state& state)
+	{
+		const std::string setting = "1,2,5";
+		std::vector<uint8_t> output;
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			output.clear();
+			Helper::string_to_array(output, setting);
+			do_not_optimize(output.data());
+		}
+	});
+
+	runner.add("helper/string_to_array_double_16", [](benchmark_state& state)
+	{
+		const std::string setting = "0.1,1.2,2.3,3.4,4.5,5.6,6.7,7.8,8.9,9.1,10.2,11.3,12.4,13.5,14.6,15.7";
+		std::vector<double> output;
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			output.clear();
+			Helper::string_to_array(output, setting);
+			do_not_optimize(output.data());
+		}
+	});
+
+	runner.add("metrics/counter_add", [](benchmark_state& state)
+	{
+		auto& counter = MetricsRegistry::instance().counter("benchmark.counter");
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			counter.add();
+		}
+		do_not_optimize(counter.get());
+	});
+
+	runner.add("metrics/histogram_record", [](benchmark_state& state)
+	{
+		auto& histogram = MetricsRegistry::instance().histogram("benchmark.histogram");
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			histogram.record(i & 0xFFFFF);
+		}
+		do_not_optimize(histogram.count());
+	});
+
+	runner.add("metrics/histogram_record_since", [](benchmark_state& state)
+	{
+		auto& histogram = MetricsRegistry::instance().histogram("benchmark.histogram_since");
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			histogram.record_since(std::chrono::steady_clock::now());
+		}
+		do_not_optimize(histogram.count());
+	});
+
+	runner.add("tracer/scope_disabled", [](benchmark_state& state)
+	{
+		Tracer::set_enabled(false);
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			TraceScope trace("benchmark.scope", "benchmark");
+			do_not_optimize(i);
+		}
+	});
+
+	runner.add("tracer/scope_enabled", [](benchmark_state& state)
+	{
+		const auto enabled = Tracer::is_enabled();
+		Tracer::set_enabled(true);
+		for (uint64_t i = 0; i < state.iterations; i++)
+		{
+			TraceScope trace("benchmark.scope", "benchmark");
+			do_not_optimize(i);
+		}
+		Tracer::set_enabled(enabled);
+		Tracer::instance().clear();
+	});
+}